@@ -0,0 +1,237 @@
+// Copyright 2009-2023 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2023, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#ifndef SST_ARIEL_BATCH_H
+#define SST_ARIEL_BATCH_H
+
+/*
+ * Like ariel_shmem.h this file is compiled into the Pin3 pintool and must
+ * stay PinCRT compatible (no RTTI, no C++11, PinCRT-enabled includes only).
+ */
+
+#include <inttypes.h>
+#include <string.h>
+
+#include "ariel_shmem.h"
+
+namespace SST {
+namespace ArielComponent {
+
+/*
+ * An ARIEL_PERFORM_BATCH command carries several memory operations in the
+ * space of one ArielCommand. Each record starts with a flags byte
+ *
+ *   bits 0-1  ARIEL_BATCH_READ, ARIEL_BATCH_WRITE or ARIEL_BATCH_NOOP
+ *   START     first record of an instruction, followed by
+ *             uint8_t instClass, uint8_t simdElemCount
+ *   DELTA     address is an int32_t offset from the previous address in
+ *             the batch rather than a full uint64_t
+ *   PAYLOAD   the write data (size bytes, at most ARIEL_MAX_PAYLOAD_SIZE)
+ *             follows the address
+ *
+ * reads and writes then hold uint16_t size and the address. Records never
+ * span batches.
+ */
+enum ArielBatchKind_t {
+    ARIEL_BATCH_READ = 1,
+    ARIEL_BATCH_WRITE = 2,
+    ARIEL_BATCH_NOOP = 3,
+};
+
+#define ARIEL_BATCH_KIND_MASK 0x03
+#define ARIEL_BATCH_START     0x04
+#define ARIEL_BATCH_DELTA     0x08
+#define ARIEL_BATCH_PAYLOAD   0x10
+
+struct ArielBatchEntry {
+    uint32_t kind;
+    bool     start;
+    uint32_t instClass;
+    uint32_t simdElemCount;
+    uint32_t size;
+    uint64_t addr;
+    const uint8_t* payload;  // NULL when the write carries no data
+    uint32_t payloadSize;
+};
+
+/* Builds one batch command, used by the trace producers */
+class ArielBatchBuilder {
+public:
+    ArielBatchBuilder() { reset(); }
+
+    void reset() {
+        cmd.command = ARIEL_PERFORM_BATCH;
+        cmd.instPtr = 0;
+        cmd.batch.count = 0;
+        cmd.batch.length = 0;
+        lastAddr = 0;
+    }
+
+    bool empty() const { return 0 == cmd.batch.count; }
+    uint32_t count() const { return cmd.batch.count; }
+
+    /* True if the record fits, otherwise send the batch first */
+    bool fits(const uint64_t addr, const uint32_t size, const bool start, const bool withPayload) const {
+        const int64_t delta = (int64_t) (addr - lastAddr);
+
+        uint32_t length = 1 + 2;
+        length += start ? 2 : 0;
+        length += (delta == (int64_t) (int32_t) delta) ? 4 : 8;
+        length += withPayload ? ((size < ARIEL_MAX_PAYLOAD_SIZE) ? size : ARIEL_MAX_PAYLOAD_SIZE) : 0;
+
+        return (cmd.batch.length + length) <= ARIEL_BATCH_SIZE;
+    }
+
+    bool fitsNoOp() const { return cmd.batch.length < ARIEL_BATCH_SIZE; }
+
+    void addRead(const uint64_t addr, const uint32_t size, const bool start, const uint32_t instClass,
+            const uint32_t simdElemCount) {
+        addMemory(ARIEL_BATCH_READ, addr, size, NULL, start, instClass, simdElemCount);
+    }
+
+    /* payload may be NULL, otherwise it holds the first ARIEL_MAX_PAYLOAD_SIZE bytes written */
+    void addWrite(const uint64_t addr, const uint32_t size, const uint8_t* payload, const bool start,
+            const uint32_t instClass, const uint32_t simdElemCount) {
+        addMemory(ARIEL_BATCH_WRITE, addr, size, payload, start, instClass, simdElemCount);
+    }
+
+    void addNoOp() {
+        cmd.batch.data[cmd.batch.length++] = ARIEL_BATCH_NOOP;
+        cmd.batch.count++;
+    }
+
+    const ArielCommand& getCommand() const { return cmd; }
+
+private:
+    void addMemory(const uint8_t kind, const uint64_t addr, const uint32_t size, const uint8_t* payload,
+            const bool start, const uint32_t instClass, const uint32_t simdElemCount) {
+        const int64_t delta = (int64_t) (addr - lastAddr);
+        const bool useDelta = (delta == (int64_t) (int32_t) delta);
+        const uint32_t copySize = (size < ARIEL_MAX_PAYLOAD_SIZE) ? size : ARIEL_MAX_PAYLOAD_SIZE;
+
+        uint8_t flags = kind;
+        if (start) {
+            flags |= ARIEL_BATCH_START;
+        }
+        if (useDelta) {
+            flags |= ARIEL_BATCH_DELTA;
+        }
+        if (NULL != payload) {
+            flags |= ARIEL_BATCH_PAYLOAD;
+        }
+
+        put<uint8_t>(flags);
+
+        if (start) {
+            put<uint8_t>((uint8_t) instClass);
+            put<uint8_t>((uint8_t) simdElemCount);
+        }
+
+        put<uint16_t>((uint16_t) ((size < 0xFFFF) ? size : 0xFFFF));
+
+        if (useDelta) {
+            put<int32_t>((int32_t) delta);
+        } else {
+            put<uint64_t>(addr);
+        }
+
+        if (NULL != payload) {
+            memcpy(&cmd.batch.data[cmd.batch.length], payload, copySize);
+            cmd.batch.length += copySize;
+        }
+
+        lastAddr = addr;
+        cmd.batch.count++;
+    }
+
+    template<typename T>
+    void put(const T value) {
+        memcpy(&cmd.batch.data[cmd.batch.length], &value, sizeof(T));
+        cmd.batch.length += sizeof(T);
+    }
+
+    ArielCommand cmd;
+    uint64_t lastAddr;
+};
+
+/* Walks the records of a received batch command */
+class ArielBatchReader {
+public:
+    ArielBatchReader(const ArielCommand& batchCmd) : cmd(batchCmd), offset(0), remaining(batchCmd.batch.count),
+        lastAddr(0) {}
+
+    /* False once every record has been read */
+    bool next(ArielBatchEntry& entry) {
+        if (0 == remaining) {
+            return false;
+        }
+
+        const uint8_t flags = get<uint8_t>();
+
+        entry.kind = flags & ARIEL_BATCH_KIND_MASK;
+        entry.start = (flags & ARIEL_BATCH_START) != 0;
+        entry.instClass = 0;
+        entry.simdElemCount = 1;
+        entry.size = 0;
+        entry.addr = 0;
+        entry.payload = NULL;
+        entry.payloadSize = 0;
+
+        if (entry.start) {
+            entry.instClass = get<uint8_t>();
+            entry.simdElemCount = get<uint8_t>();
+        }
+
+        if (ARIEL_BATCH_NOOP != entry.kind) {
+            entry.size = get<uint16_t>();
+
+            if (flags & ARIEL_BATCH_DELTA) {
+                entry.addr = lastAddr + (uint64_t) (int64_t) get<int32_t>();
+            } else {
+                entry.addr = get<uint64_t>();
+            }
+
+            if (flags & ARIEL_BATCH_PAYLOAD) {
+                entry.payload = &cmd.batch.data[offset];
+                entry.payloadSize = (entry.size < ARIEL_MAX_PAYLOAD_SIZE) ? entry.size : ARIEL_MAX_PAYLOAD_SIZE;
+                offset += entry.payloadSize;
+            }
+
+            lastAddr = entry.addr;
+        }
+
+        remaining--;
+        return true;
+    }
+
+private:
+    template<typename T>
+    T get() {
+        T value;
+        memcpy(&value, &cmd.batch.data[offset], sizeof(T));
+        offset += sizeof(T);
+        return value;
+    }
+
+    const ArielCommand& cmd;
+    uint32_t offset;
+    uint32_t remaining;
+    uint64_t lastAddr;
+};
+
+}
+}
+
+#endif
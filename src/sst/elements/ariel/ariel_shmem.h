@@ -45,6 +45,10 @@
 
 #define ARIEL_MAX_PAYLOAD_SIZE 64
 
+// Bytes of packed records in a batch, sized so a batch takes no more space
+// in the tunnel than a single read or write (see ariel_batch.h)
+#define ARIEL_BATCH_SIZE (ARIEL_MAX_PAYLOAD_SIZE + 20)
+
 namespace SST {
 namespace ArielComponent {
 
@@ -68,6 +72,7 @@ enum ArielShmemCmd_t {
     ARIEL_ISSUE_RTL = 150,
     ARIEL_FLUSHLINE_INSTRUCTION = 154,
     ARIEL_FENCE_INSTRUCTION = 155,
+    ARIEL_PERFORM_BATCH = 160,
 };
 
 #ifdef HAVE_CUDA
@@ -175,6 +180,11 @@ struct ArielCommand {
         struct {
             uint64_t vaddr;
         } flushline;
+        struct {
+            uint16_t count;
+            uint16_t length;
+            uint8_t  data[ARIEL_BATCH_SIZE];
+        } batch;
         struct {
             void* inp_ptr;
             void* ctrl_ptr;
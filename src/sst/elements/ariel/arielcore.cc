@@ -59,7 +59,7 @@ ArielCore::ArielCore(ComponentId_t id, ArielTunnel *tunnel,
     memmgr = memMgr;
 
     writePayloads = params.find<int>("writepayloadtrace") == 0 ? false : true;
-    coreQ = new std::queue<ArielEvent*>();
+    coreQ = new ArielEventRing(maxQLength + ARIEL_BATCH_SIZE);
     pendingTransactions = new std::unordered_map<StandardMem::Request::id_t, StandardMem::Request*>();
     pending_transaction_count = 0;
 
@@ -125,6 +125,25 @@ ArielCore::ArielCore(ComponentId_t id, ArielTunnel *tunnel,
         traceGen->setCoreID(coreID);
     }
 
+    // Record the tunnel stream so ariel.frontend.replay can rerun it without Pin
+    std::string recordPrefix = params.find<std::string>("recordstream", "");
+    recorder = NULL;
+    unrecordedCommands = 0;
+
+    if("" != recordPrefix) {
+        const std::string recordFile = ArielStream::fileName(recordPrefix, coreID);
+        const bool recordCompress = params.find<int>("recordcompress", 1) != 0;
+
+        recorder = new ArielStreamWriter();
+
+        if(!recorder->open(recordFile, coreID, recordCompress)) {
+            output->fatal(CALL_INFO, -1, "Unable to open %s to record the command stream of core %" PRIu32 "\n",
+                    recordFile.c_str(), coreID);
+        }
+
+        output->verbose(CALL_INFO, 1, 0, "Recording the command stream of core %" PRIu32 " to %s\n", coreID, recordFile.c_str());
+    }
+
     currentCycles = 0;
 }
 
@@ -137,6 +156,13 @@ ArielCore::~ArielCore() {
         delete traceGen;
     }
 
+    while(!coreQ->empty()) {
+        delete coreQ->front().event;
+        coreQ->pop();
+    }
+
+    delete coreQ;
+    delete recorder;
     delete stdMemHandlers;
 }
 
@@ -552,6 +578,20 @@ void ArielCore::finishCore() {
         delete traceGen;
         traceGen = NULL;
     }
+
+    if(NULL != recorder) {
+        if(!recorder->close()) {
+            output->fatal(CALL_INFO, -1, "Writing the recorded command stream of core %" PRIu32 " failed\n", coreID);
+        }
+
+        delete recorder;
+        recorder = NULL;
+
+        if(unrecordedCommands > 0) {
+            output->verbose(CALL_INFO, 1, 0, "Core %" PRIu32 " did not record %" PRIu64 " CUDA/RTL commands, they cannot be replayed.\n",
+                    coreID, unrecordedCommands);
+        }
+    }
 }
 
 void ArielCore::halt(){
@@ -665,28 +705,38 @@ void ArielCore::handleSwitchPoolEvent(ArielSwitchPoolEvent* aSPE) {
 
 void ArielCore::createSwitchPoolEvent(uint32_t newPool) {
     ArielSwitchPoolEvent* ev = new ArielSwitchPoolEvent(newPool);
-    coreQ->push(ev);
+    pushEvent(ev);
 
     ARIEL_CORE_VERBOSE(4, output->verbose(CALL_INFO, 4, 0, "Generated a switch pool event on core %" PRIu32 ", new level is: %" PRIu32 "\n", coreID, newPool));
 }
 
+void ArielCore::pushEvent(ArielEvent* ev) {
+    ArielEventEntry& entry = coreQ->push();
+    entry.type = ev->getEventType();
+    entry.address = 0;
+    entry.length = 0;
+    entry.event = ev;
+}
+
 void ArielCore::createNoOpEvent() {
     ArielNoOpEvent* ev = new ArielNoOpEvent();
-    coreQ->push(ev);
+    pushEvent(ev);
 
     ARIEL_CORE_VERBOSE(4, output->verbose(CALL_INFO, 4, 0, "Generated a No Op event on core %" PRIu32 "\n", coreID));
 }
 
 void ArielCore::createReadEvent(uint64_t address, uint32_t length) {
-    ArielReadEvent* ev = new ArielReadEvent(address, length);
-    coreQ->push(ev);
+    ArielEventEntry& entry = coreQ->push();
+    entry.type = READ_ADDRESS;
+    entry.address = address;
+    entry.length = length;
 
     ARIEL_CORE_VERBOSE(4, output->verbose(CALL_INFO, 4, 0, "Generated a READ event, addr=%" PRIu64 ", length=%" PRIu32 "\n", address, length));
 }
 
 void ArielCore::createAllocateEvent(uint64_t vAddr, uint64_t length, uint32_t level, uint64_t instPtr) {
     ArielAllocateEvent* ev = new ArielAllocateEvent(vAddr, length, level, instPtr);
-    coreQ->push(ev);
+    pushEvent(ev);
 
     ARIEL_CORE_VERBOSE(2, output->verbose(CALL_INFO, 2, 0, "Generated an allocate event, vAddr(map)=%" PRIu64 ", length=%" PRIu64 " in level %" PRIu32 " from IP %" PRIx64 "\n",
                     vAddr, length, level, instPtr));
@@ -694,7 +744,7 @@ void ArielCore::createAllocateEvent(uint64_t vAddr, uint64_t length, uint32_t le
 
 void ArielCore::createMmapEvent(uint32_t fileID, uint64_t vAddr, uint64_t length, uint32_t level, uint64_t instPtr) {
     ArielMmapEvent* ev = new ArielMmapEvent(fileID, vAddr, length, level, instPtr);
-    coreQ->push(ev);
+    pushEvent(ev);
 
     ARIEL_CORE_VERBOSE(2, output->verbose(CALL_INFO, 2, 0, "Generated an mmap event, vAddr(map)=%" PRIu64 ", length=%" PRIu64 " in level %" PRIu32 " from IP %" PRIx64 "\n",
                     vAddr, length, level, instPtr));
@@ -702,35 +752,44 @@ void ArielCore::createMmapEvent(uint32_t fileID, uint64_t vAddr, uint64_t length
 
 void ArielCore::createFreeEvent(uint64_t vAddr) {
     ArielFreeEvent* ev = new ArielFreeEvent(vAddr);
-    coreQ->push(ev);
+    pushEvent(ev);
 
     ARIEL_CORE_VERBOSE(2, output->verbose(CALL_INFO, 2, 0, "Generated a free event for virtual address=%" PRIu64 "\n", vAddr));
 }
 
 void ArielCore::createWriteEvent(uint64_t address, uint32_t length, const uint8_t* payload) {
-    ArielWriteEvent* ev = new ArielWriteEvent(address, length, payload);
-    coreQ->push(ev);
+    ArielEventEntry& entry = coreQ->push();
+    entry.type = WRITE_ADDRESS;
+    entry.address = address;
+    entry.length = length;
+
+    // Only writes larger than a tunnel payload (e.g. xsave) need their own buffer
+    if(length <= ARIEL_MAX_PAYLOAD_SIZE) {
+        memcpy(entry.payload, payload, length);
+    } else {
+        entry.event = new ArielWriteEvent(address, length, payload);
+    }
 
     ARIEL_CORE_VERBOSE(4, output->verbose(CALL_INFO, 4, 0, "Generated a WRITE event, addr=%" PRIu64 ", length=%" PRIu32 "\n", address, length));
 }
 
 void ArielCore::createFlushEvent(uint64_t vAddr){
     ArielFlushEvent *ev = new ArielFlushEvent(vAddr, cacheLineSize);
-    coreQ->push(ev);
+    pushEvent(ev);
 
     ARIEL_CORE_VERBOSE(4, output->verbose(CALL_INFO,4,0, "Generated a FLUSH event.\n"));
 }
 
 void ArielCore::createFenceEvent(){
     ArielFenceEvent *ev = new ArielFenceEvent();
-    coreQ->push(ev);
+    pushEvent(ev);
 
     ARIEL_CORE_VERBOSE(4, output->verbose(CALL_INFO, 4, 0, "Generated a FENCE event.\n"));
 }
 
 void ArielCore::createExitEvent() {
     ArielExitEvent* xEv = new ArielExitEvent();
-    coreQ->push(xEv);
+    pushEvent(xEv);
 
     ARIEL_CORE_VERBOSE(4, output->verbose(CALL_INFO, 4, 0, "Generated an EXIT event.\n"));
 }
@@ -751,7 +810,7 @@ void ArielCore::createRtlEvent(void* inp_ptr, void* ctrl_ptr, void* updated_para
     Ev->set_rtl_inp_size(inp_size);
     Ev->set_rtl_ctrl_size(ctrl_size);
     Ev->set_updated_rtl_params_size(updated_rtl_params_size);
-    coreQ->push(Ev);
+    pushEvent(Ev);
 
     ARIEL_CORE_VERBOSE(4, output->verbose(CALL_INFO, 4, 0, "Generated a RTL event.\n"));
 }
@@ -759,7 +818,7 @@ void ArielCore::createRtlEvent(void* inp_ptr, void* ctrl_ptr, void* updated_para
 #ifdef HAVE_CUDA
 void ArielCore::createGpuEvent(GpuApi_t API, CudaArguments CA) {
     ArielGpuEvent* gEv = new ArielGpuEvent(API, CA);
-    coreQ->push(gEv);
+    pushEvent(gEv);
 
     ARIEL_CORE_VERBOSE(4, output->verbose(CALL_INFO, 4, 0, "Generated a CUDA event.\n"));
 }
@@ -834,6 +893,85 @@ bool ArielCore::hasDrainCompleted() const {
         return false;
 }
 
+void ArielCore::recordInstructionClass(uint32_t instClass, uint32_t simdElemCount) {
+    if(ARIEL_INST_SP_FP == instClass) {
+            statFPSPIns->addData(1);
+
+            if(simdElemCount > 1) {
+                statFPSPSIMDIns->addData(1);
+            } else {
+                statFPSPScalarIns->addData(1);
+            }
+
+            if(simdElemCount < 32)
+                statFPSPOps->addData(simdElemCount);
+    } else if(ARIEL_INST_DP_FP == instClass) {
+            statFPDPIns->addData(1);
+
+            if(simdElemCount > 1) {
+                statFPDPSIMDIns->addData(1);
+            } else {
+                statFPDPScalarIns->addData(1);
+            }
+
+            if(simdElemCount < 16)
+                statFPDPOps->addData(simdElemCount);
+    }
+}
+
+/* Decodes every record of a batch in one go, see ariel_batch.h */
+void ArielCore::createBatchEvents(const ArielCommand& ac) {
+    ArielBatchReader reader(ac);
+    ArielBatchEntry entry;
+
+    while(reader.next(entry)) {
+        if(entry.start) {
+            recordInstructionClass(entry.instClass, entry.simdElemCount);
+        }
+
+        switch(entry.kind) {
+            case ARIEL_BATCH_READ:
+                createReadEvent(entry.addr, entry.size);
+                break;
+
+            case ARIEL_BATCH_WRITE:
+                // writes without data (payload tracing is off) store zeros
+                batchWriteData.assign(entry.size, 0);
+
+                if(NULL != entry.payload) {
+                    memcpy(batchWriteData.data(), entry.payload, entry.payloadSize);
+                }
+
+                createWriteEvent(entry.addr, entry.size, batchWriteData.data());
+                break;
+
+            case ARIEL_BATCH_NOOP:
+                createNoOpEvent();
+                break;
+
+            default:
+                output->fatal(CALL_INFO, -1, "Error: Ariel did not understand batch record kind (%" PRIu32 ") on core %" PRIu32 ".\n", entry.kind, coreID);
+                break;
+        }
+    }
+
+    ARIEL_CORE_VERBOSE(16, output->verbose(CALL_INFO, 16, 0, "Decoded a batch of %" PRIu32 " records on core %" PRIu32 "\n", (uint32_t) ac.batch.count, coreID));
+}
+
+/* Commands that point into the traced process are left out of the recording */
+void ArielCore::recordCommand(const ArielCommand& ac) {
+    if(ARIEL_ISSUE_CUDA == ac.command || ARIEL_ISSUE_RTL == ac.command) {
+        unrecordedCommands++;
+        return;
+    }
+
+    recorder->write(ac);
+
+    if(!recorder->good()) {
+        output->fatal(CALL_INFO, -1, "Writing the recorded command stream of core %" PRIu32 " failed\n", coreID);
+    }
+}
+
 bool ArielCore::refillQueue() {
     ARIEL_CORE_VERBOSE(16, output->verbose(CALL_INFO, 16, 0, "Refilling event queue for core %" PRIu32 "...\n", coreID));
 
@@ -851,6 +989,10 @@ bool ArielCore::refillQueue() {
 
         ARIEL_CORE_VERBOSE(32, output->verbose(CALL_INFO, 32, 0, "Tunnel reads data on core: %" PRIu32 "\n", coreID));
 
+        if(NULL != recorder) {
+            recordCommand(ac);
+        }
+
         // There is data on the pipe
         switch(ac.command) {
             case ARIEL_OUTPUT_STATS:
@@ -859,33 +1001,15 @@ bool ArielCore::refillQueue() {
                 break;
 
             case ARIEL_START_INSTRUCTION:
-                if(ARIEL_INST_SP_FP == ac.inst.instClass) {
-                        statFPSPIns->addData(1);
-
-                        if(ac.inst.simdElemCount > 1) {
-                            statFPSPSIMDIns->addData(1);
-                        } else {
-                            statFPSPScalarIns->addData(1);
-                        }
-
-                        if(ac.inst.simdElemCount < 32)
-                            statFPSPOps->addData(ac.inst.simdElemCount);
-                } else if(ARIEL_INST_DP_FP == ac.inst.instClass) {
-                        statFPDPIns->addData(1);
-
-                        if(ac.inst.simdElemCount > 1) {
-                            statFPDPSIMDIns->addData(1);
-                        } else {
-                            statFPDPScalarIns->addData(1);
-                        }
-
-                        if(ac.inst.simdElemCount < 16)
-                            statFPDPOps->addData(ac.inst.simdElemCount);
-                }
+                recordInstructionClass(ac.inst.instClass, ac.inst.simdElemCount);
 
                 while(ac.command != ARIEL_END_INSTRUCTION) {
                         ac = tunnel->readMessage(coreID);
 
+                        if(NULL != recorder) {
+                            recordCommand(ac);
+                        }
+
                         switch(ac.command) {
                             case ARIEL_PERFORM_READ:
                                     createReadEvent(ac.inst.addr, ac.inst.size);
@@ -910,6 +1034,10 @@ bool ArielCore::refillQueue() {
 
                 break;
 
+            case ARIEL_PERFORM_BATCH:
+                createBatchEvents(ac);
+                break;
+
             case ARIEL_NOOP:
                 createNoOpEvent();
                 break;
@@ -969,10 +1097,13 @@ void ArielCore::handleFreeEvent(ArielFreeEvent* rFE) {
 }
 
 void ArielCore::handleReadRequest(ArielReadEvent* rEv) {
+    issueReadRequest(rEv->getAddress(), rEv->getLength());
+}
+
+void ArielCore::issueReadRequest(const uint64_t readAddress, const uint32_t length) {
     ARIEL_CORE_VERBOSE(4, output->verbose(CALL_INFO, 4, 0, "Core %" PRIu32 " processing a read event...\n", coreID));
 
-    const uint64_t readAddress = rEv->getAddress();
-    const uint64_t readLength  = std::min((uint64_t) rEv->getLength(), cacheLineSize); // Trim to cacheline size (occurs rarely for instructions such as xsave and fxsave)
+    const uint64_t readLength  = std::min((uint64_t) length, cacheLineSize); // Trim to cacheline size (occurs rarely for instructions such as xsave and fxsave)
 
     /* No longer neccessary due to trimming above
      * if(readLength > cacheLineSize) {
@@ -1043,10 +1174,13 @@ void ArielCore::handleReadRequest(ArielReadEvent* rEv) {
 }
 
 void ArielCore::handleWriteRequest(ArielWriteEvent* wEv) {
+    issueWriteRequest(wEv->getAddress(), wEv->getLength(), wEv->getPayload());
+}
+
+void ArielCore::issueWriteRequest(const uint64_t writeAddress, const uint32_t length, const uint8_t* payload) {
     ARIEL_CORE_VERBOSE(4, output->verbose(CALL_INFO, 4, 0, "Core %" PRIu32 " processing a write event...\n", coreID));
 
-    const uint64_t writeAddress = wEv->getAddress();
-    const uint64_t writeLength  = std::min((uint64_t) wEv->getLength(), cacheLineSize); // Trim to cacheline size (occurs rarely for instructions such as xsave and fxsave)
+    const uint64_t writeLength  = std::min((uint64_t) length, cacheLineSize); // Trim to cacheline size (occurs rarely for instructions such as xsave and fxsave)
 
     // No longer neccessary due to trimming above
 /*    if(writeLength > cacheLineSize) {
@@ -1076,8 +1210,7 @@ void ArielCore::handleWriteRequest(ArielWriteEvent* wEv) {
                             coreID, writeAddress, writeLength, physAddr));
 
         if( writePayloads ) {
-            uint8_t* payloadPtr = wEv->getPayload();
-            commitWriteEvent(physAddr, writeAddress, (uint32_t) writeLength, payloadPtr);
+            commitWriteEvent(physAddr, writeAddress, (uint32_t) writeLength, payload);
         } else {
             commitWriteEvent(physAddr, writeAddress, (uint32_t) writeLength, NULL);
         }
@@ -1116,9 +1249,8 @@ void ArielCore::handleWriteRequest(ArielWriteEvent* wEv) {
         }
 
         if( writePayloads ) {
-            uint8_t* payloadPtr = wEv->getPayload();
-            commitWriteEvent(physLeftAddr, leftAddr, (uint32_t) leftSize, payloadPtr);
-            commitWriteEvent(physRightAddr, rightAddr, (uint32_t) rightSize, &payloadPtr[leftSize]);
+            commitWriteEvent(physLeftAddr, leftAddr, (uint32_t) leftSize, payload);
+            commitWriteEvent(physRightAddr, rightAddr, (uint32_t) rightSize, &payload[leftSize]);
         } else {
             commitWriteEvent(physLeftAddr, leftAddr, (uint32_t) leftSize, NULL);
             commitWriteEvent(physRightAddr, rightAddr, (uint32_t) rightSize, NULL);
@@ -1428,10 +1560,11 @@ bool ArielCore::processNextEvent() {
 
     ARIEL_CORE_VERBOSE(8, output->verbose(CALL_INFO, 8, 0, "Processing next event in core %" PRIu32 "...\n", coreID));
 
-    ArielEvent* nextEvent = coreQ->front();
+    ArielEventEntry& nextEntry = coreQ->front();
+    ArielEvent* nextEvent = nextEntry.event;
     bool removeEvent = false;
 
-    switch(nextEvent->getEventType()) {
+    switch(nextEntry.type) {
         case NOOP:
                 ARIEL_CORE_VERBOSE(8, output->verbose(CALL_INFO, 8, 0, "Core %" PRIu32 " next event is NOOP\n", coreID));
                 statInstructionCount->addData(1);
@@ -1449,7 +1582,7 @@ bool ArielCore::processNextEvent() {
                     statInstructionCount->addData(1);
                     inst_count++;
                     removeEvent = true;
-                    handleReadRequest(dynamic_cast<ArielReadEvent*>(nextEvent));
+                    issueReadRequest(nextEntry.address, nextEntry.length);
                 } else {
                     ARIEL_CORE_VERBOSE(16, output->verbose(CALL_INFO, 16, 0, "Pending transaction queue is currently full for core %" PRIu32 ", core will stall for new events\n", coreID));
                     break;
@@ -1465,7 +1598,11 @@ bool ArielCore::processNextEvent() {
                     statInstructionCount->addData(1);
                     inst_count++;
                             removeEvent = true;
-                    handleWriteRequest(dynamic_cast<ArielWriteEvent*>(nextEvent));
+                    if(NULL == nextEvent) {
+                        issueWriteRequest(nextEntry.address, nextEntry.length, nextEntry.payload);
+                    } else {
+                        handleWriteRequest(dynamic_cast<ArielWriteEvent*>(nextEvent));
+                    }
                 } else {
                     ARIEL_CORE_VERBOSE(16, output->verbose(CALL_INFO, 16, 0, "Pending transaction queue is currently full for core %" PRIu32 ", core will stall for new events\n", coreID));
                     break;
@@ -1561,6 +1698,7 @@ bool ArielCore::processNextEvent() {
                             (uint32_t) coreQ->size()));
         coreQ->pop();
 
+        // Reads and writes are issued from the ring, only other events were allocated
         delete nextEvent;
         return true;
     } else {
@@ -34,6 +34,7 @@
 #include <string>
 #include <queue>
 #include <unordered_map>
+#include <vector>
 
 #include "arielmemmgr.h"
 #include "arielevent.h"
@@ -50,6 +51,9 @@
 #include "tb_header.h"
 
 #include "ariel_shmem.h"
+#include "ariel_batch.h"
+#include "arielstream.h"
+#include "arieleventring.h"
 #include "arieltracegen.h"
 
 #ifdef HAVE_CUDA
@@ -149,6 +153,8 @@ class ArielCore : public ComponentExtension {
         void handleEvent(StandardMem::Request* event);
         void handleReadRequest(ArielReadEvent* wEv);
         void handleWriteRequest(ArielWriteEvent* wEv);
+        void issueReadRequest(const uint64_t addr, const uint32_t length);
+        void issueWriteRequest(const uint64_t addr, const uint32_t length, const uint8_t* payload);
         void handleAllocationEvent(ArielAllocateEvent* aEv);
         void handleMmapEvent(ArielMmapEvent* aEv);
         void handleFreeEvent(ArielFreeEvent* aFE);
@@ -194,6 +200,11 @@ class ArielCore : public ComponentExtension {
     private:
         bool processNextEvent();
         bool refillQueue();
+        void recordInstructionClass(uint32_t instClass, uint32_t simdElemCount);
+        void createBatchEvents(const ArielCommand& ac);
+        void recordCommand(const ArielCommand& ac);
+        void pushEvent(ArielEvent* ev);
+        std::vector<uint8_t> batchWriteData;
         bool writePayloads;
         uint32_t coreID;
         uint32_t maxPendingTransactions;
@@ -217,7 +228,7 @@ class ArielCore : public ComponentExtension {
 #endif
 
         Output* output;
-        std::queue<ArielEvent*>* coreQ;
+        ArielEventRing* coreQ;
         bool isStalled;
         bool isHalted;
         bool isFenced;
@@ -255,6 +266,9 @@ class ArielCore : public ComponentExtension {
 
         ArielTraceGenerator* traceGen;
 
+        ArielStreamWriter* recorder;
+        uint64_t unrecordedCommands;
+
         Statistic<uint64_t>* statReadRequests;
         Statistic<uint64_t>* statWriteRequests;
         Statistic<uint64_t>* statFlushRequests;
@@ -77,6 +77,9 @@ class ArielCPU : public SST::Component {
         {"tracegen", "Select the trace generator for Ariel (which records traced memory operations", ""},
         {"memmgr", "Memory manager to use for address translation", "ariel.MemoryManagerSimple"},
         {"writepayloadtrace", "Trace write payloads and put real memory contents into the memory system", "0"},
+        {"recordstream", "Record the commands each core receives to <recordstream>-<core>.arielcmd for ariel.frontend.replay, empty disables", ""},
+        {"recordcompress", "Compress recorded command streams if libz is available", "1"},
+        {"batchrecords", "Pack up to this many memory operations into each tunnel command (0 = one command per operation)", "0"},
         {"instrument_instructions", "turn on or off instruction instrumentation in fesimple", "1"},
         {"gpu_enabled", "If enabled, gpu links will be set up", "0"})
 
@@ -0,0 +1,105 @@
+// Copyright 2009-2023 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2023, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#ifndef _H_SST_ARIEL_EVENT_RING
+#define _H_SST_ARIEL_EVENT_RING
+
+#include <stdint.h>
+#include <stddef.h>
+
+#include <vector>
+
+#include "arielevent.h"
+#include "ariel_shmem.h"
+
+namespace SST {
+namespace ArielComponent {
+
+/*
+ * One pending event of a core. Reads and writes of at most
+ * ARIEL_MAX_PAYLOAD_SIZE bytes are held by value and issued straight from
+ * the ring, every other event (and oversized writes) keeps its heap
+ * allocated ArielEvent in event.
+ */
+struct ArielEventEntry {
+    ArielEventType type;
+    uint32_t length;
+    uint64_t address;
+    ArielEvent* event;
+    uint8_t payload[ARIEL_MAX_PAYLOAD_SIZE];
+};
+
+/*
+ * FIFO of a core's pending events. The ring is sized for the core queue
+ * length up front; a single tunnel command can add several events so it
+ * doubles in the rare case it is full rather than rejecting an event.
+ */
+class ArielEventRing {
+public:
+    ArielEventRing(size_t capacity) : head(0), count(0) {
+        size_t slots = 1;
+        while (slots < capacity) {
+            slots <<= 1;
+        }
+
+        ring.resize(slots);
+        mask = slots - 1;
+    }
+
+    bool empty() const { return 0 == count; }
+    size_t size() const { return count; }
+
+    ArielEventEntry& front() { return ring[head]; }
+
+    /* Returns the new tail slot, the caller fills it in */
+    ArielEventEntry& push() {
+        if (count == ring.size()) {
+            grow();
+        }
+
+        ArielEventEntry& entry = ring[(head + count) & mask];
+        entry.event = NULL;
+        count++;
+        return entry;
+    }
+
+    void pop() {
+        head = (head + 1) & mask;
+        count--;
+    }
+
+private:
+    void grow() {
+        std::vector<ArielEventEntry> larger(ring.size() * 2);
+
+        for (size_t i = 0; i < count; i++) {
+            larger[i] = ring[(head + i) & mask];
+        }
+
+        ring.swap(larger);
+        mask = ring.size() - 1;
+        head = 0;
+    }
+
+    std::vector<ArielEventEntry> ring;
+    size_t mask;
+    size_t head;
+    size_t count;
+};
+
+}
+}
+
+#endif
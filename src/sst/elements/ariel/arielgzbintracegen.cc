@@ -19,18 +19,52 @@
 
 using namespace SST::ArielComponent;
 
+static const size_t recordLength = sizeof(uint64_t) + sizeof(char) + sizeof(uint64_t) + sizeof(uint32_t);
+
 ArielCompressedBinaryTraceGenerator::ArielCompressedBinaryTraceGenerator(Params& params) :
     ArielTraceGenerator() {
 
     tracePrefix = params.find<std::string>("trace_prefix", "ariel-core");
     coreID = 0;
+    traceFile = NULL;
+    shutdown = false;
+
+    blockSize = params.find<size_t>("trace_block_size", 1048576);
+    if (blockSize < recordLength) {
+        blockSize = recordLength;
+    }
+
+    const uint32_t blockCount = params.find<uint32_t>("trace_blocks", 4);
+    for (uint32_t i = 0; i < (blockCount > 2 ? blockCount : 2); ++i) {
+        blocks.push_back((char*) malloc(blockSize));
+        freeBlocks.push_back(blocks.back());
+    }
 
-    buffer = (char*) malloc(sizeof(uint64_t) + sizeof(uint64_t) + sizeof(char) + sizeof(uint32_t));
+    buffer = freeBlocks.front();
+    freeBlocks.pop_front();
+    bufferUsed = 0;
 }
 
 ArielCompressedBinaryTraceGenerator::~ArielCompressedBinaryTraceGenerator() {
-    gzclose(traceFile);
-    free(buffer);
+    if (compressor.joinable()) {
+        submitBlock();
+
+        {
+            std::lock_guard<std::mutex> lock(blockLock);
+            shutdown = true;
+        }
+
+        blockReady.notify_one();
+        compressor.join();
+    }
+
+    if (NULL != traceFile) {
+        gzclose(traceFile);
+    }
+
+    for (size_t i = 0; i < blocks.size(); ++i) {
+        free(blocks[i]);
+    }
 }
 
 void ArielCompressedBinaryTraceGenerator::publishEntry(const uint64_t picoS,
@@ -40,12 +74,18 @@ void ArielCompressedBinaryTraceGenerator::publishEntry(const uint64_t picoS,
 
     const char op_type = (READ == op) ? 'R' : 'W';
 
-    copy(&buffer[0], &picoS, sizeof(uint64_t));
-    copy(&buffer[sizeof(uint64_t)], &op_type, sizeof(char));
-    copy(&buffer[sizeof(uint64_t) + sizeof(char)], &physAddr, sizeof(uint64_t));
-    copy(&buffer[sizeof(uint64_t) + sizeof(char) + sizeof(uint64_t)], &reqLength, sizeof(uint32_t));
+    if (bufferUsed + recordLength > blockSize) {
+        submitBlock();
+    }
+
+    char* record = &buffer[bufferUsed];
 
-    gzwrite(traceFile, buffer, sizeof(uint64_t) + sizeof(char) + sizeof(uint64_t) + sizeof(uint32_t));
+    copy(&record[0], &picoS, sizeof(uint64_t));
+    copy(&record[sizeof(uint64_t)], &op_type, sizeof(char));
+    copy(&record[sizeof(uint64_t) + sizeof(char)], &physAddr, sizeof(uint64_t));
+    copy(&record[sizeof(uint64_t) + sizeof(char) + sizeof(uint64_t)], &reqLength, sizeof(uint32_t));
+
+    bufferUsed += recordLength;
 }
 
 void ArielCompressedBinaryTraceGenerator::setCoreID(const uint32_t core) {
@@ -57,6 +97,55 @@ void ArielCompressedBinaryTraceGenerator::setCoreID(const uint32_t core) {
     traceFile = gzopen(tracePath, "wb");
 
     free(tracePath);
+
+    if (NULL != traceFile && !compressor.joinable()) {
+        compressor = std::thread(&ArielCompressedBinaryTraceGenerator::compressBlocks, this);
+    }
+}
+
+/* Queues the current block for compression and waits for a free one if all are in flight */
+void ArielCompressedBinaryTraceGenerator::submitBlock() {
+    if (0 == bufferUsed) {
+        return;
+    }
+
+    // Without an open trace file there is nothing to compress into
+    if (!compressor.joinable()) {
+        bufferUsed = 0;
+        return;
+    }
+
+    std::unique_lock<std::mutex> lock(blockLock);
+    fullBlocks.push_back(std::make_pair(buffer, bufferUsed));
+    blockReady.notify_one();
+
+    blockWritten.wait(lock, [this] { return !freeBlocks.empty(); });
+    buffer = freeBlocks.front();
+    freeBlocks.pop_front();
+    bufferUsed = 0;
+}
+
+/* Body of the background thread, the gzip stream is the same as writing records one at a time */
+void ArielCompressedBinaryTraceGenerator::compressBlocks() {
+    std::unique_lock<std::mutex> lock(blockLock);
+
+    while (true) {
+        blockReady.wait(lock, [this] { return shutdown || !fullBlocks.empty(); });
+
+        if (fullBlocks.empty()) {
+            break;
+        }
+
+        std::pair<char*, size_t> block = fullBlocks.front();
+        fullBlocks.pop_front();
+
+        lock.unlock();
+        gzwrite(traceFile, block.first, (unsigned) block.second);
+        lock.lock();
+
+        freeBlocks.push_back(block.first);
+        blockWritten.notify_one();
+    }
 }
 
 void ArielCompressedBinaryTraceGenerator::copy(char* dest, const void* src, const size_t length) {
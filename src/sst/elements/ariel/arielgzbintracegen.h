@@ -19,6 +19,12 @@
 
 #include <climits>
 
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+
 #include <sst/core/params.h>
 #include "zlib.h"
 #include "arieltracegen.h"
@@ -40,7 +46,9 @@ class ArielCompressedBinaryTraceGenerator : public ArielTraceGenerator {
         )
 
         SST_ELI_DOCUMENT_PARAMS(
-            { "trace_prefix", "Sets the prefix for the trace file", "ariel-core-" }
+            { "trace_prefix", "Sets the prefix for the trace file", "ariel-core-" },
+            { "trace_block_size", "Size in bytes of the blocks handed to the background compression thread", "1048576" },
+            { "trace_blocks", "Number of trace blocks, recording stalls when all of them wait to be compressed", "4" }
         )
     
         ArielCompressedBinaryTraceGenerator(Params& params);
@@ -54,11 +62,30 @@ class ArielCompressedBinaryTraceGenerator : public ArielTraceGenerator {
 
     private:
         void copy(char* dest, const void* src, const size_t length);
+        void submitBlock();
+        void compressBlocks();
 
         gzFile traceFile;
         std::string tracePrefix;
         uint32_t coreID;
+
+        /*
+         * Records are collected in blocks; full blocks are compressed and
+         * written by a background thread so zlib never runs on the
+         * simulation thread unless every block is still queued.
+         */
+        size_t blockSize;
         char* buffer;
+        size_t bufferUsed;
+
+        std::vector<char*> blocks;
+        std::deque<std::pair<char*, size_t> > fullBlocks;
+        std::deque<char*> freeBlocks;
+        std::mutex blockLock;
+        std::condition_variable blockWritten;
+        std::condition_variable blockReady;
+        bool shutdown;
+        std::thread compressor;
 
 };
 
@@ -21,11 +21,13 @@
 #include <sst/core/rng/marsaglia.h>
 
 #include <stdint.h>
+#include <string.h>
 #include <deque>
 #include <vector>
 #include <unordered_map>
 
 #include "arielmemmgr.h"
+#include "arielpagetable.h"
 
 using namespace SST;
 using namespace SST::RNG;
@@ -47,12 +49,13 @@ class ArielMemoryManagerCache : public ArielMemoryManager{
     #define ARIEL_ELI_MEMMGR_CACHE_PARAMS {"verbose", "Verbosity for debugging. Increased numbers for increased verbosity.", "0"},\
         {"vtop_translate",  "Set to yes to perform virt-phys translation (TLB) or no to disable", "yes"},\
         {"pagemappolicy",   "Select the page mapping policy for Ariel [LINEAR|RANDOMIZED]", "LINEAR"},\
-        {"translatecacheentries", "Keep a translation cache of this many entries to improve emulated core performance", "4096"}
+        {"translatecacheentries", "Keep a direct-mapped translation cache (TLB) of this many pages, rounded up to a power of two, to improve emulated core performance", "4096"},\
+        {"hugepages",       "Map naturally aligned regions of 512 pages (1) or also 512*512 pages (2) with one page table entry when enough physically contiguous free pages are available, 0 maps base pages only. With 4KiB pages these are 2MiB and 1GiB mappings", "0"}
 
     #define ARIEL_ELI_MEMMGR_CACHE_STATS { "tlb_hits", "Hits in the simple Ariel TLB", "hits", 2 },\
         { "tlb_evicts",           "Number of evictions in the simple Ariel TLB", "evictions", 2 },\
         { "tlb_translate_queries","Number of TLB translations performed", "translations", 2 },\
-        { "tlb_shootdown",        "Number of TLB clears because of page-frees", "shootdowns", 2 },\
+        { "tlb_shootdown",        "Number of TLB clears because of page-frees and mallocs which shadow the page tables", "shootdowns", 2 },\
         { "tlb_page_allocs",      "Number of pages allocated by the memory manager", "pages", 2 }
 
         /* Constructor
@@ -82,17 +85,26 @@ class ArielMemoryManagerCache : public ArielMemoryManager{
             output->fatal(CALL_INFO, -8, "Ariel memory manager - unknown page mapping policy \"%s\"\n", mappingPolicy.c_str());
             }
 
-            // Set up translation cache
-            translationCache = new std::unordered_map<uint64_t, uint64_t>();
+            // The translation cache is created by the manager once it knows its page sizes
+            translationCache = NULL;
             translationCacheEntries = (uint32_t) params.find<uint32_t>("translatecacheentries", 4096);
 
+            hugePageLevels = params.find<uint32_t>("hugepages", 0);
+            if (hugePageLevels > 2) {
+                output->fatal(CALL_INFO, -8, "Ariel memory manager - hugepages must be 0, 1 or 2, found %" PRIu32 "\n", hugePageLevels);
+            }
+
             /* Statistics used by all memory managers; managers may also have their own */
         } // End constructor
 
-        ~ArielMemoryManagerCache() {};
+        ~ArielMemoryManagerCache() {
+            delete translationCache;
+        };
+
         void get_tlb_info(std::unordered_map<uint64_t, uint64_t>* translationcache, uint32_t& translationcacheentries, bool& translationenabled) {
-            memcpy((void*)translationcache, (void*)translationCache, sizeof(*translationCache));
-            translationcacheentries = translationCacheEntries;
+            translationcache->clear();
+            translationCache->exportTo(translationcache);
+            translationcacheentries = translationCache->capacity();
             translationenabled = translationEnabled;
 
             return;
@@ -106,11 +118,23 @@ class ArielMemoryManagerCache : public ArielMemoryManager{
         Statistic<uint64_t>* statTranslationShootdown;
         Statistic<uint64_t>* statPageAllocationCount;
 
-        std::unordered_map<uint64_t, uint64_t>* translationCache;
+        ArielTLB* translationCache;
         uint32_t translationCacheEntries;
+        uint32_t hugePageLevels;
         bool translationEnabled;
         ArielPageMappingPolicy mapPolicy;
 
+        /* Called by the managers with their smallest page size */
+        void createTranslationCache(uint64_t granule) {
+            translationCache = new ArielTLB(translationCacheEntries, granule);
+        }
+
+        void checkPageSize(uint64_t pageSize) {
+            if (!ArielPageTable::isPowerOfTwo(pageSize)) {
+                output->fatal(CALL_INFO, -8, "Ariel memory manager - page size %" PRIu64 " is not a power of two\n", pageSize);
+            }
+        }
+
         void mapPagesLinear(uint64_t pageCount, uint64_t pageSize, uint64_t startAddr, std::deque<uint64_t>* freePagePool) {
             output->verbose(CALL_INFO, 2, 0, "Page mapping policy is LINEAR map...\n");
             uint64_t nextMemoryAddress = startAddr;
@@ -153,45 +177,152 @@ class ArielMemoryManagerCache : public ArielMemoryManager{
             }
         }
 
-        void populatePageTable(std::string popFilePath, std::unordered_map<uint64_t, uint64_t> * pageTable, std::deque<uint64_t>* freePagePool, uint64_t pageSize) {
-            FILE * popFile = fopen(popFilePath.c_str(), "rt");
-            uint64_t pinAddr = 0;
+        /* True if the next count pages of the free pool are physically contiguous */
+        bool freePagesContiguous(std::deque<uint64_t>* freePagePool, uint64_t count, uint64_t pageSize) {
+            if (freePagePool->size() < count) {
+                return false;
+            }
 
-            while( ! feof(popFile) ) {
-                if (EOF == fscanf(popFile, "%" PRIu64 "\n", &pinAddr)) {
-                    break;
+            const uint64_t first = freePagePool->front();
+            for (uint64_t i = 1; i < count; i++) {
+                if ((*freePagePool)[i] != first + i * pageSize) {
+                    return false;
                 }
+            }
 
-                if (freePagePool->size() == 0) {
-                    output->fatal(CALL_INFO, -1, "Attempted to pin address %" PRIu64 " but no free pages.\n", pinAddr);
+            return true;
+        }
+
+        /*
+         * Maps the page at virtualAddress from the free pool. With huge pages
+         * enabled the largest aligned region holding the page is mapped with a
+         * single entry if it fits in [regionStart, regionEnd), nothing in it is
+         * mapped yet and the free pool can back it contiguously. Returns the
+         * number of pages taken from the pool (0 if the page was mapped).
+         */
+        uint64_t mapFreePages(ArielPageTable* pageTable, std::deque<uint64_t>* freePagePool, uint64_t virtualAddress,
+                uint64_t regionStart, uint64_t regionEnd) {
+            const uint64_t pageSize = pageTable->getPageSize();
+
+            for (uint32_t depth = hugePageLevels; depth > 0; depth--) {
+                const uint64_t span = pageTable->spanBytes(depth);
+                const uint64_t hugeStart = virtualAddress & ~(span - 1);
+
+                if (hugeStart < regionStart || (hugeStart + span - 1) > (regionEnd - 1) || depth >= pageTable->depthCount()) {
+                    continue;
                 }
 
-                if (pinAddr % pageSize > 0) {
-                    output->fatal(CALL_INFO, -1, "Attempted to pin address %" PRIu64 " but address is not page aligned to page size %" PRIu64 "\n",
-                            pinAddr, pageSize);
+                if (pageTable->isUnmapped(hugeStart, depth) &&
+                        freePagesContiguous(freePagePool, pageTable->spanPages(depth), pageSize)) {
+                    pageTable->map(hugeStart, freePagePool->front(), depth);
+                    freePagePool->erase(freePagePool->begin(), freePagePool->begin() + pageTable->spanPages(depth));
+
+                    output->verbose(CALL_INFO, 4, 0, "Allocating huge page of %" PRIu64 " bytes, virtual page=%" PRIu64 "\n",
+                            span, hugeStart);
+                    return pageTable->spanPages(depth);
                 }
+            }
+
+            uint64_t physAddr;
+            if (pageTable->lookup(virtualAddress, physAddr)) {
+                return 0;
+            }
+
+            const uint64_t nextPhysPage = freePagePool->front();
+            freePagePool->pop_front();
+            pageTable->map(virtualAddress, nextPhysPage, 0);
+
+            output->verbose(CALL_INFO, 4, 0, "Allocating memory page, physical page=%" PRIu64 ", virtual page=%" PRIu64 "\n",
+                    nextPhysPage, virtualAddress);
+            return 1;
+        }
+
+        /* Widens a single page demand allocation to the largest enabled huge page holding it */
+        void demandRegion(ArielPageTable* pageTable, uint64_t virtualAddress, uint64_t& regionStart, uint64_t& regionEnd) {
+            if (hugePageLevels > 0 && hugePageLevels < pageTable->depthCount()) {
+                const uint64_t span = pageTable->spanBytes(hugePageLevels);
+                regionStart = virtualAddress & ~(span - 1);
+                regionEnd = regionStart + span;
+            }
+        }
+
+        /*
+         * Pins the pages listed in popFilePath. The file is either text, one
+         * page address per line, or binary: the 8 bytes "ARIELPOP" followed by
+         * native uint64_t page addresses. Consecutive addresses are mapped as
+         * one region so huge pages can be used.
+         */
+        void populatePageTable(std::string popFilePath, ArielPageTable* pageTable, std::deque<uint64_t>* freePagePool, uint64_t pageSize) {
+            FILE * popFile = fopen(popFilePath.c_str(), "rb");
+            if (NULL == popFile) {
+                output->fatal(CALL_INFO, -1, "Unable to open page populate file %s\n", popFilePath.c_str());
+            }
 
-                const uint64_t freePhysical = freePagePool->front();
-                freePagePool->pop_front();
+            char magic[8];
+            const bool binary = (1 == fread(magic, sizeof(magic), 1, popFile)) && (0 == memcmp(magic, "ARIELPOP", sizeof(magic)));
+            std::vector<uint64_t> pinAddrs;
 
-                output->verbose(CALL_INFO, 4, 0, "Pinning address %" PRIu64 " (physical=%" PRIu64 "\n",
-                            pinAddr, freePhysical);
+            if (binary) {
+                uint64_t block[4096];
+                size_t count;
+
+                while ((count = fread(block, sizeof(uint64_t), 4096, popFile)) > 0) {
+                    pinAddrs.insert(pinAddrs.end(), block, block + count);
+                }
+            } else {
+                uint64_t pinAddr = 0;
+                rewind(popFile);
 
-                pageTable->insert( std::pair<uint64_t, uint64_t>( pinAddr, freePhysical ) );
+                while (EOF != fscanf(popFile, "%" PRIu64 "\n", &pinAddr)) {
+                    pinAddrs.push_back(pinAddr);
+                }
             }
 
             fclose(popFile);
+
+            output->verbose(CALL_INFO, 1, 0, "Read %" PRIu64 " page addresses from %s populate file\n",
+                    (uint64_t) pinAddrs.size(), binary ? "binary" : "text");
+
+            size_t next = 0;
+            while (next < pinAddrs.size()) {
+                const uint64_t regionStart = pinAddrs[next];
+                size_t runEnd = next + 1;
+
+                while (runEnd < pinAddrs.size() && pinAddrs[runEnd] == pinAddrs[runEnd - 1] + pageSize) {
+                    runEnd++;
+                }
+
+                const uint64_t regionEnd = regionStart + (runEnd - next) * pageSize;
+
+                for (uint64_t pinAddr = regionStart; pinAddr != regionEnd; pinAddr += pageSize) {
+                    if (pinAddr % pageSize > 0) {
+                        output->fatal(CALL_INFO, -1, "Attempted to pin address %" PRIu64 " but address is not page aligned to page size %" PRIu64 "\n",
+                                pinAddr, pageSize);
+                    }
+
+                    uint64_t physAddr;
+                    if (pageTable->lookup(pinAddr, physAddr)) {
+                        continue;
+                    }
+
+                    if (freePagePool->size() == 0) {
+                        output->fatal(CALL_INFO, -1, "Attempted to pin address %" PRIu64 " but no free pages.\n", pinAddr);
+                    }
+
+                    output->verbose(CALL_INFO, 4, 0, "Pinning address %" PRIu64 " (physical=%" PRIu64 "\n",
+                                pinAddr, freePagePool->front());
+
+                    mapFreePages(pageTable, freePagePool, pinAddr, regionStart, regionEnd);
+                }
+
+                next = runEnd;
+            }
         }
 
         void cacheTranslation(uint64_t virtualA, uint64_t physicalA) {
-            // Remove the oldest entry if we do not have enough slots TODO is begin() really the oldest...?
-            if(translationCache->size() == translationCacheEntries) {
-            statTranslationCacheEvict->addData(1);
-            translationCache->erase(translationCache->begin());
+            if (translationCache->insert(virtualA, physicalA)) {
+                statTranslationCacheEvict->addData(1);
             }
-
-            // Insert the translated entry into the cache
-            translationCache->insert(std::pair<uint64_t, uint64_t>(virtualA, physicalA));
         }
 
 };
@@ -33,10 +33,9 @@ ArielMemoryManagerMalloc::ArielMemoryManagerMalloc(ComponentId_t id, Params& par
 
     // PageAllocation and PageTable structures
     pageAllocations = (std::unordered_map<uint64_t, uint64_t>**) malloc(sizeof(std::unordered_map<uint64_t, uint64_t>*) * memoryLevels);
-    pageTables = (std::unordered_map<uint64_t, uint64_t>**) malloc(sizeof(std::unordered_map<uint64_t, uint64_t>*) * memoryLevels);
+    pageTables = (ArielPageTable**) malloc(sizeof(ArielPageTable*) * memoryLevels);
     for (uint32_t i = 0; i <memoryLevels; ++i) {
         pageAllocations[i] = new std::unordered_map<uint64_t, uint64_t>();
-        pageTables[i] = new std::unordered_map<uint64_t, uint64_t>();
     }
 
     // Initialize data structures
@@ -48,6 +47,8 @@ ArielMemoryManagerMalloc::ArielMemoryManagerMalloc(ComponentId_t id, Params& par
         snprintf(level_buffer, level_buffer_size, "pagesize%" PRIu32, i);
         pageSizes[i] = (uint64_t) params.find<uint64_t>(level_buffer, 4096);
         output->verbose(CALL_INFO, 2, 0, "Level %" PRIu32 " page size is %" PRIu64 "\n", i, pageSizes[i]);
+        checkPageSize(pageSizes[i]);
+        pageTables[i] = new ArielPageTable(pageSizes[i]);
 
         // Page count
         snprintf(level_buffer, level_buffer_size, "pagecount%" PRIu32, i);
@@ -82,9 +83,19 @@ ArielMemoryManagerMalloc::ArielMemoryManagerMalloc(ComponentId_t id, Params& par
     }
 
     free(level_buffer);
+
+    // The translation cache works on the smallest page size, which divides every other one
+    minPageSize = pageSizes[0];
+    for (uint32_t i = 1; i < memoryLevels; ++i) {
+        if (pageSizes[i] < minPageSize) minPageSize = pageSizes[i];
+    }
+    createTranslationCache(minPageSize);
 }
 
 ArielMemoryManagerMalloc::~ArielMemoryManagerMalloc() {
+    for (uint32_t i = 0; i < memoryLevels; ++i) {
+        delete pageTables[i];
+    }
 }
 
 
@@ -133,8 +144,21 @@ void ArielMemoryManagerMalloc::allocate(const uint64_t size, const uint32_t leve
 
     statDemandAllocs[level]->addData(roundedSize/pageSize);
 
-    uint64_t nextVirtPage = virtualAddress;
-    for(uint64_t bytesLeft = 0; bytesLeft < roundedSize; bytesLeft += pageSize) {
+    // Map the region page by page, pages inside a huge mapping are skipped once it is made
+    const uint64_t allocEnd = virtualAddress + roundedSize;
+    uint64_t regionStart = virtualAddress;
+    uint64_t regionEnd = allocEnd;
+
+    if (roundedSize == pageSize) {
+        demandRegion(pageTables[level], virtualAddress, regionStart, regionEnd);
+    }
+
+    for(uint64_t nextVirtPage = virtualAddress; nextVirtPage < allocEnd; nextVirtPage += pageSize) {
+        uint64_t physAddr;
+        if (pageTables[level]->lookup(nextVirtPage, physAddr)) {
+            continue;
+        }
+
         if(freePages[level]->empty()) {
                 output->verbose(CALL_INFO, 4, 0, "Requesting a memory allocation at level: %" PRIu32 " which will fail due to not having enough free pages\n",
                     level);
@@ -145,15 +169,7 @@ void ArielMemoryManagerMalloc::allocate(const uint64_t size, const uint32_t leve
                             level, size);
         }
 
-        const uint64_t nextPhysPage = freePages[level]->front();
-        freePages[level]->pop_front();
-
-        pageTables[level]->insert( std::pair<uint64_t, uint64_t>(nextVirtPage, nextPhysPage) );
-
-        output->verbose(CALL_INFO, 4, 0, "Allocating memory page, physical page=%" PRIu64 ", virtual page=%" PRIu64 "\n",
-                nextPhysPage, nextVirtPage);
-
-        nextVirtPage += pageSize;
+        mapFreePages(pageTables[level], freePages[level], nextVirtPage, regionStart, regionEnd);
     }
 
     output->verbose(CALL_INFO, 4, 0, "Request leaves: %" PRIu32 " free pages at level: %" PRIu32 "\n",
@@ -216,6 +232,10 @@ bool ArielMemoryManagerMalloc::allocateMalloc(const uint64_t size, const uint32_
 
     output->verbose(CALL_INFO, 4, 0, "Malloc mapped %" PRIu64 " to [%" PRIu64 ", %" PRIu64 "] (%" PRIu64 " pages).\n", virtualAddress, firstPhysAddr, lastPhysAddr, pageCount);
 
+    // The malloc now shadows the page tables for its range, drop any cached translations
+    translationCache->flush();
+    statTranslationShootdown->addData(1);
+
     // Record malloc
     mallocInformation.insert(std::make_pair(virtualAddress, mallocInfo(size, level, virtualPages)));
 
@@ -244,6 +264,9 @@ void ArielMemoryManagerMalloc::freeMalloc(const uint64_t virtualAddress) {
     // Remove mallocInformation entry
     delete myKeys;
     mallocInformation.erase(virtualAddress);
+
+    translationCache->flush();
+    statTranslationShootdown->addData(1);
 }
 
 
@@ -262,10 +285,9 @@ uint64_t ArielMemoryManagerMalloc::translateAddress(uint64_t virtAddr) {
     output->verbose(CALL_INFO, 4, 0, "Page Table: translate virtual address %" PRIu64 "\n", virtAddr);
 
     // Check the translation cache otherwise carry on
-    auto checkCache = translationCache->find(virtAddr);
-    if(checkCache != translationCache->end()) {
+    if(translationCache->lookup(virtAddr, physAddr)) {
         statTranslationCacheHits->addData(1);
-        return checkCache->second;
+        return physAddr;
     }
 
     // Check malloc mappings
@@ -276,37 +298,33 @@ uint64_t ArielMemoryManagerMalloc::translateAddress(uint64_t virtAddr) {
 
         if (it != mallocTranslations.end() && (it->first <= virtAddr)) {
             uint64_t primaryAddr = mallocPrimaryVAMap.find(it->first)->second;
-            if (virtAddr < (primaryAddr + (mallocInformation.find(primaryAddr)->second).size)) {
+            const mallocInfo& info = mallocInformation.find(primaryAddr)->second;
+            const uint64_t mallocEnd = primaryAddr + info.size;
+            if (virtAddr < mallocEnd) {
                 uint64_t offset = virtAddr - it->first;
                 physAddr = offset + it->second;
-                found = true;
+
+                const uint64_t pageEnd = it->first + pageSizes[info.level];
+                cacheMallocTranslation(virtAddr, physAddr, it->first, pageEnd < mallocEnd ? pageEnd : mallocEnd);
+                return physAddr;
             }
         }
     }
 
     // We will have to search every memory level to find where the address lies
     for(uint32_t i = 0; i < memoryLevels; ++i) {
-        if (!found) {
-        std::unordered_map<uint64_t, uint64_t>::iterator page_itr;
         const uint64_t pageSize = pageSizes[i];
-            const uint64_t page_offset = virtAddr % pageSize;
+        const uint64_t page_offset = virtAddr % pageSize;
         const uint64_t page_start = virtAddr - page_offset;
 
-        page_itr = pageTables[i]->find(page_start);
-
-            if (page_itr != pageTables[i]->end()) {
-                // Located
-            physAddr = page_itr->second + page_offset;
-
-                output->verbose(CALL_INFO, 4, 0, "Page table hit: virtual address=%" PRIu64 " hit in level: %" PRIu32 ", virtual page start=%" PRIu64 ", virtual end=%" PRIu64 ", translates to phys page start=%" PRIu64 " translates to: phys address: %" PRIu64 " (offset added to phys start=%" PRIu64 ")\n",
-                    virtAddr, i, page_itr->first, page_itr->first + pageSize, page_itr->second, physAddr, page_offset);
+        if (pageTables[i]->lookup(virtAddr, physAddr)) {
+            // Located
+            output->verbose(CALL_INFO, 4, 0, "Page table hit: virtual address=%" PRIu64 " hit in level: %" PRIu32 ", virtual page start=%" PRIu64 ", virtual end=%" PRIu64 ", translates to phys page start=%" PRIu64 " translates to: phys address: %" PRIu64 " (offset added to phys start=%" PRIu64 ")\n",
+                virtAddr, i, page_start, page_start + pageSize, physAddr - page_offset, physAddr, page_offset);
 
             found = true;
             break;
         }
-        } else {
-            break;
-        }
     }
 
     if(found) {
@@ -354,14 +372,32 @@ void ArielMemoryManagerMalloc::printStats() {
     output->output("Page Table Sizes:\n");
 
     for(uint32_t i = 0; i < memoryLevels; ++i) {
-        output->output("- Demand map entries at level %" PRIu32 "         %" PRIu32 "\n",
-            i, (uint32_t) pageTables[i]->size());
+        output->output("- Demand map entries at level %" PRIu32 "         %" PRIu64 "\n",
+            i, pageTables[i]->leafCount(0));
+
+        for (uint32_t depth = 1; depth <= hugePageLevels; depth++) {
+            output->output("- Demand huge entries (%" PRIu64 " bytes) at level %" PRIu32 " %" PRIu64 "\n",
+                pageTables[i]->spanBytes(depth), i, pageTables[i]->leafCount(depth));
+        }
     }
 
     output->output("Page Table Coverages:\n");
 
     for(uint32_t i = 0; i < memoryLevels; ++i) {
         output->output("- Demand bytes at level %" PRIu32 "              %" PRIu64 "\n",
-            i, ((uint64_t) pageTables[i]->size()) * ((uint64_t) pageSizes[i]));
+            i, pageTables[i]->size() * pageSizes[i]);
+    }
+}
+
+/*
+ * Malloc pages need not be aligned, so a translation is only cached when the
+ * whole cache granule around the address lies in [pageStart, pageEnd), the
+ * part of the malloc page that belongs to the malloc.
+ */
+void ArielMemoryManagerMalloc::cacheMallocTranslation(const uint64_t virtAddr, const uint64_t physAddr, const uint64_t pageStart, const uint64_t pageEnd) {
+    const uint64_t granuleStart = virtAddr & ~(minPageSize - 1);
+
+    if (granuleStart >= pageStart && (granuleStart + minPageSize) <= pageEnd) {
+        cacheTranslation(virtAddr, physAddr);
     }
 }
@@ -48,7 +48,7 @@ class ArielMemoryManagerMalloc : public ArielMemoryManagerCache {
 #define ARIEL_MEMMGR_MALLOC_ELI_PARAMS ARIEL_ELI_MEMMGR_CACHE_PARAMS,\
             {"memorylevels",    "Number of memory levels in the system", "1"},\
             {"defaultlevel",    "Default memory level", "0"},\
-            {"pagesize%(memorylevels)d", "Page size for memory Level x", "4096"},\
+            {"pagesize%(memorylevels)d", "Page size for memory Level x, must be a power of two", "4096"},\
             {"pagecount%(memorylevels)d", "Page count for memory Level x", "131072"},\
             {"page_populate_%(memorylevels)d", "Pre-populate/partially pre-populate a page table for a level in memory, this is the file to read in.", ""}
 #define ARIEL_MEMMGR_MALLOC_ELI_STATS ARIEL_ELI_MEMMGR_CACHE_STATS, \
@@ -74,6 +74,7 @@ class ArielMemoryManagerMalloc : public ArielMemoryManagerCache {
 
     private:
         void allocate(const uint64_t size, const uint32_t level, const uint64_t virtualAddress);
+        void cacheMallocTranslation(const uint64_t virtAddr, const uint64_t physAddr, const uint64_t pageStart, const uint64_t pageEnd);
         bool canAllocateInLevel(const uint64_t size, const uint32_t level);
 
         struct mallocInfo {
@@ -90,10 +91,11 @@ class ArielMemoryManagerMalloc : public ArielMemoryManagerCache {
         uint32_t defaultLevel;
         uint32_t memoryLevels;
         uint64_t* pageSizes;
+        uint64_t minPageSize;
 
         std::deque<uint64_t>** freePages;
         std::unordered_map<uint64_t, uint64_t>** pageAllocations;
-        std::unordered_map<uint64_t, uint64_t>** pageTables;
+        ArielPageTable** pageTables;
 
         std::vector<Statistic<uint64_t>* > statBytesAlloc;
         std::vector<Statistic<uint64_t>* > statBytesFree;
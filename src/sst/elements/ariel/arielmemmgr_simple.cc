@@ -25,6 +25,10 @@ ArielMemoryManagerSimple::ArielMemoryManagerSimple(ComponentId_t id, Params& par
 
     pageSize = (uint64_t) params.find<uint64_t>("pagesize0", 4096);
     output->verbose(CALL_INFO, 2, 0, "Page size is %" PRIu64 "\n", pageSize);
+    checkPageSize(pageSize);
+
+    pageTable = new ArielPageTable(pageSize);
+    createTranslationCache(pageSize);
 
     uint64_t pageCount = (uint64_t) params.find<uint64_t>("pagecount0", 131072);
     output->verbose(CALL_INFO, 2, 0, "Page count is %" PRIu64 "\n", pageCount);
@@ -40,12 +44,13 @@ ArielMemoryManagerSimple::ArielMemoryManagerSimple(ComponentId_t id, Params& par
     std::string popFilePath = params.find<std::string>("page_populate_0", "");
     if (popFilePath != "") {
         output->verbose(CALL_INFO, 1, 0, "Populating page table from %s...\n", popFilePath.c_str());
-        populatePageTable(popFilePath, &pageTable, &freePages, pageSize);
+        populatePageTable(popFilePath, pageTable, &freePages, pageSize);
     }
 
 }
 
 ArielMemoryManagerSimple::~ArielMemoryManagerSimple() {
+    delete pageTable;
 }
 
 
@@ -67,22 +72,27 @@ void ArielMemoryManagerSimple::allocate(const uint64_t size, const uint32_t leve
 
     output->verbose(CALL_INFO, 4, 0, "Requesting rounded to %" PRIu64 " bytes\n", roundedSize);
 
-    uint64_t nextVirtPage = virtualAddress;
-    for(uint64_t bytesLeft = 0; bytesLeft < roundedSize; bytesLeft += pageSize) {
+    // Map the region page by page, pages inside a huge mapping are skipped once it is made
+    const uint64_t allocEnd = virtualAddress + roundedSize;
+    uint64_t regionStart = virtualAddress;
+    uint64_t regionEnd = allocEnd;
+
+    if (roundedSize == pageSize) {
+        demandRegion(pageTable, virtualAddress, regionStart, regionEnd);
+    }
+
+    for(uint64_t nextVirtPage = virtualAddress; nextVirtPage < allocEnd; nextVirtPage += pageSize) {
+        uint64_t physAddr;
+        if (pageTable->lookup(nextVirtPage, physAddr)) {
+            continue;
+        }
+
         if(freePages.empty()) {
                 output->fatal(CALL_INFO, -1, "Requested a memory allocation of size: %" PRIu64 " which failed due to not having enough free pages\n",
                     size);
         }
 
-        const uint64_t nextPhysPage = freePages.front();
-        freePages.pop_front();
-
-        pageTable.insert( std::pair<uint64_t, uint64_t>(nextVirtPage, nextPhysPage) );
-
-        output->verbose(CALL_INFO, 4, 0, "Allocating memory page, physical page=%" PRIu64 ", virtual page=%" PRIu64 "\n",
-                nextPhysPage, nextVirtPage);
-
-        nextVirtPage += pageSize;
+        mapFreePages(pageTable, &freePages, nextVirtPage, regionStart, regionEnd);
     }
 
     output->verbose(CALL_INFO, 4, 0, "Request leaves: %" PRIu32 " free pages\n",
@@ -106,24 +116,19 @@ uint64_t ArielMemoryManagerSimple::translateAddress(uint64_t virtAddr) {
     output->verbose(CALL_INFO, 4, 0, "Page Table: translate virtual address %" PRIu64 "\n", virtAddr);
 
     // Check the translation cache otherwise carry on
-    auto checkCache = translationCache->find(virtAddr);
-    if(checkCache != translationCache->end()) {
+    uint64_t physAddr;
+    if(translationCache->lookup(virtAddr, physAddr)) {
         statTranslationCacheHits->addData(1);
-        return checkCache->second;
+        return physAddr;
     }
 
-    std::unordered_map<uint64_t, uint64_t>::iterator page_itr;
     const uint64_t page_offset = virtAddr % pageSize;
     const uint64_t page_start = virtAddr - page_offset;
 
-    page_itr = pageTable.find(page_start);
-
-    if(page_itr != pageTable.end()) {
+    if(pageTable->lookup(virtAddr, physAddr)) {
         // Located
-        uint64_t physAddr = page_itr->second + page_offset;
-
         output->verbose(CALL_INFO, 4, 0, "Page table hit: virtual address=%" PRIu64 " hit, virtual page start=%" PRIu64 ", virtual end=%" PRIu64 ", translates to phys page start=%" PRIu64 " translates to: phys address: %" PRIu64 " (offset added to phys start=%" PRIu64 ")\n",
-                virtAddr, page_itr->first, page_itr->first + pageSize, page_itr->second, physAddr, page_offset);
+                virtAddr, page_start, page_start + pageSize, physAddr - page_offset, physAddr, page_offset);
 
         cacheTranslation(virtAddr, physAddr);
         return physAddr;
@@ -155,13 +160,18 @@ void ArielMemoryManagerSimple::printStats() {
     output->output("---------------------------------------------------------------------\n");
     output->output("Page Table Sizes:\n");
 
-    output->output("- Map entries         %" PRIu32 "\n",
-        (uint32_t) pageTable.size());
+    output->output("- Map entries         %" PRIu64 "\n",
+        pageTable->leafCount(0));
+
+    for (uint32_t depth = 1; depth <= hugePageLevels; depth++) {
+        output->output("- Huge entries (%" PRIu64 " bytes) %" PRIu64 "\n",
+            pageTable->spanBytes(depth), pageTable->leafCount(depth));
+    }
 
     output->output("Page Table Coverages:\n");
 
     output->output("- Bytes               %" PRIu64 "\n",
-        ((uint64_t) pageTable.size()) * ((uint64_t) pageSize));
+        pageTable->size() * pageSize);
 }
 
 void ArielMemoryManagerSimple::printTable() {
@@ -169,18 +179,19 @@ void ArielMemoryManagerSimple::printTable() {
     	output->output("---------------------------------------------------------------------\n");
 	output->verbose(CALL_INFO, 16, 0, "Page Table Map:\n");
 
-	for( auto table_itr : pageTable ) {
-		output->verbose(CALL_INFO, 16, 0, "-> VA: %15" PRIu64 " -> PA: %15" PRIu64 "\n",
-			table_itr.first, table_itr.second);
-	}
+	pageTable->forEach([this](const uint64_t virtAddr, const uint64_t physAddr, const uint32_t depth) {
+		output->verbose(CALL_INFO, 16, 0, "-> VA: %15" PRIu64 " -> PA: %15" PRIu64 " (%" PRIu64 " bytes)\n",
+			virtAddr, physAddr, pageTable->spanBytes(depth));
+	});
 
     	output->output("---------------------------------------------------------------------\n");
 
 }
 
 void ArielMemoryManagerSimple::get_page_info(std::unordered_map<uint64_t, uint64_t>* pagetable, std::deque<uint64_t>* freepages, uint64_t& pagesize) {
-    memcpy((void*)pagetable, (void*)(&pageTable), sizeof(pageTable));
-    memcpy((void*)freepages, (void*)(&freePages), sizeof(freePages)); 
+    pagetable->clear();
+    pageTable->exportTo(pagetable);
+    *freepages = freePages;
     pagesize = pageSize;
 
     return;
@@ -45,7 +45,7 @@ class ArielMemoryManagerSimple : public ArielMemoryManagerCache {
         )
 
 #define MEMMGR_SIMPLE_ELI_PARAMS ARIEL_ELI_MEMMGR_CACHE_PARAMS,\
-            {"pagesize0", "Page size", "4096"},\
+            {"pagesize0", "Page size, must be a power of two", "4096"},\
             {"pagecount0", "Page count", "131072"},\
             {"page_populate_0", "Pre-populate/partially pre-populate the page table, this is the file to read in.", ""}
 
@@ -67,7 +67,7 @@ class ArielMemoryManagerSimple : public ArielMemoryManagerCache {
         uint64_t pageSize;
         std::deque<uint64_t> freePages;
 
-        std::unordered_map<uint64_t, uint64_t> pageTable;
+        ArielPageTable* pageTable;
 };
 
 }
@@ -0,0 +1,309 @@
+// Copyright 2009-2023 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2023, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#ifndef _H_ARIEL_PAGE_TABLE
+#define _H_ARIEL_PAGE_TABLE
+
+#include <stdint.h>
+#include <stddef.h>
+
+#include <vector>
+#include <unordered_map>
+
+namespace SST {
+namespace ArielComponent {
+
+/*
+ * Multi-level radix page table. Each node holds 512 entries (9 bits of the
+ * virtual page number), so with 4 KiB pages a leaf at depth 1 maps 2 MiB
+ * and a leaf at depth 2 maps 1 GiB, like the x86-64 tables. An entry is
+ *
+ *   0                 unmapped
+ *   physical | 1      leaf, physical address of the start of the mapping
+ *   node pointer      next level table
+ *
+ * so page sizes must be powers of two and physical addresses even.
+ */
+class ArielPageTable {
+public:
+    static const uint32_t levelBits = 9;
+    static const uint64_t fanout = 1ULL << levelBits;
+
+    static bool isPowerOfTwo(const uint64_t value) {
+        return (value > 1) && (0 == (value & (value - 1)));
+    }
+
+    ArielPageTable(const uint64_t pageSize) : basePageSize(pageSize), pageShift(0), mappedPages(0) {
+        while ((1ULL << pageShift) < pageSize) {
+            pageShift++;
+        }
+
+        levels = (64 - pageShift + levelBits - 1) / levelBits;
+        leafCounts.resize(levels, 0);
+        root = newNode();
+    }
+
+    ~ArielPageTable() {
+        freeNode(root, levels - 1);
+    }
+
+    uint64_t getPageSize() const { return basePageSize; }
+
+    /* Bytes mapped by one leaf at depth (0 for a base page) */
+    uint64_t spanBytes(const uint32_t depth) const { return 1ULL << (pageShift + levelBits * depth); }
+    uint64_t spanPages(const uint32_t depth) const { return 1ULL << (levelBits * depth); }
+    uint32_t depthCount() const { return levels; }
+
+    bool lookup(const uint64_t virtAddr, uint64_t& physAddr) const {
+        const uint64_t* node = root;
+
+        for (uint32_t depth = levels - 1; ; depth--) {
+            const uint64_t entry = node[index(virtAddr, depth)];
+
+            if (0 == entry) {
+                return false;
+            }
+
+            if (entry & 1) {
+                physAddr = (entry & ~1ULL) + (virtAddr & (spanBytes(depth) - 1));
+                return true;
+            }
+
+            node = (const uint64_t*) entry;
+        }
+    }
+
+    /* True if nothing maps any part of the depth-sized region holding virtAddr */
+    bool isUnmapped(const uint64_t virtAddr, const uint32_t depth) const {
+        const uint64_t* node = root;
+
+        for (uint32_t d = levels - 1; d > depth; d--) {
+            const uint64_t entry = node[index(virtAddr, d)];
+
+            if (0 == entry) {
+                return true;
+            }
+
+            if (entry & 1) {
+                return false;
+            }
+
+            node = (const uint64_t*) entry;
+        }
+
+        return 0 == node[index(virtAddr, depth)];
+    }
+
+    /* Maps the depth-sized region starting at virtAddr (aligned to the region), false if any of it is mapped */
+    bool map(const uint64_t virtAddr, const uint64_t physAddr, const uint32_t depth) {
+        uint64_t* node = root;
+
+        for (uint32_t d = levels - 1; d > depth; d--) {
+            uint64_t& entry = node[index(virtAddr, d)];
+
+            if (0 == entry) {
+                entry = (uint64_t) newNode();
+            } else if (entry & 1) {
+                return false;
+            }
+
+            node = (uint64_t*) entry;
+        }
+
+        uint64_t& leaf = node[index(virtAddr, depth)];
+        if (0 != leaf) {
+            return false;
+        }
+
+        leaf = physAddr | 1;
+        leafCounts[depth]++;
+        mappedPages += spanPages(depth);
+        return true;
+    }
+
+    /* Unmaps the depth-sized region starting at virtAddr, false unless one leaf of that depth maps it.
+       Tables left empty stay allocated until the page table is destroyed */
+    bool unmap(const uint64_t virtAddr, const uint32_t depth) {
+        uint64_t* node = root;
+
+        for (uint32_t d = levels - 1; d > depth; d--) {
+            const uint64_t entry = node[index(virtAddr, d)];
+
+            if (0 == entry || (entry & 1)) {
+                return false;
+            }
+
+            node = (uint64_t*) entry;
+        }
+
+        uint64_t& leaf = node[index(virtAddr, depth)];
+        if (0 == (leaf & 1)) {
+            return false;
+        }
+
+        leaf = 0;
+        leafCounts[depth]--;
+        mappedPages -= spanPages(depth);
+        return true;
+    }
+
+    /* Number of leaves at a depth, leafCount(0) is the number of base pages mapped individually */
+    uint64_t leafCount(const uint32_t depth) const { return depth < levels ? leafCounts[depth] : 0; }
+
+    /* Mapped memory in base pages */
+    uint64_t size() const { return mappedPages; }
+
+    /* Calls visit(virtual, physical, depth) for every leaf in virtual address order */
+    template<typename Visitor>
+    void forEach(Visitor visit) const {
+        walk(root, levels - 1, 0, visit);
+    }
+
+    /* Flattens the table into base page mappings */
+    void exportTo(std::unordered_map<uint64_t, uint64_t>* table) const {
+        forEach([this, table](const uint64_t virtAddr, const uint64_t physAddr, const uint32_t depth) {
+            for (uint64_t i = 0; i < spanPages(depth); i++) {
+                (*table)[virtAddr + i * basePageSize] = physAddr + i * basePageSize;
+            }
+        });
+    }
+
+private:
+    size_t index(const uint64_t virtAddr, const uint32_t depth) const {
+        return (virtAddr >> (pageShift + levelBits * depth)) & (fanout - 1);
+    }
+
+    uint64_t* newNode() { return new uint64_t[fanout](); }
+
+    void freeNode(uint64_t* node, const uint32_t depth) {
+        if (depth > 0) {
+            for (uint64_t i = 0; i < fanout; i++) {
+                if (0 != node[i] && 0 == (node[i] & 1)) {
+                    freeNode((uint64_t*) node[i], depth - 1);
+                }
+            }
+        }
+
+        delete[] node;
+    }
+
+    template<typename Visitor>
+    void walk(const uint64_t* node, const uint32_t depth, const uint64_t base, Visitor& visit) const {
+        for (uint64_t i = 0; i < fanout; i++) {
+            const uint64_t entry = node[i];
+            const uint64_t virtAddr = base + (i << (pageShift + levelBits * depth));
+
+            if (0 == entry) {
+                continue;
+            } else if (entry & 1) {
+                visit(virtAddr, entry & ~1ULL, depth);
+            } else {
+                walk((const uint64_t*) entry, depth - 1, virtAddr, visit);
+            }
+        }
+    }
+
+    uint64_t basePageSize;
+    uint32_t pageShift;
+    uint32_t levels;
+    uint64_t* root;
+    uint64_t mappedPages;
+    std::vector<uint64_t> leafCounts;
+};
+
+/*
+ * Direct-mapped software TLB in front of the page tables. Entries cover one
+ * granule (the smallest page size of the manager) rather than one address,
+ * so every access to a recently used page hits.
+ */
+class ArielTLB {
+public:
+    ArielTLB(const uint32_t entries, const uint64_t granule) : granuleShift(0) {
+        while ((1ULL << granuleShift) < granule) {
+            granuleShift++;
+        }
+
+        size_t slots = 1;
+        while (slots < entries) {
+            slots <<= 1;
+        }
+
+        tags.resize(entries > 0 ? slots : 0);
+        frames.resize(tags.size());
+        mask = tags.size() - 1;
+        flush();
+    }
+
+    bool lookup(const uint64_t virtAddr, uint64_t& physAddr) const {
+        if (tags.empty()) {
+            return false;
+        }
+
+        const uint64_t vpn = virtAddr >> granuleShift;
+        const size_t slot = vpn & mask;
+
+        if (tags[slot] != vpn) {
+            return false;
+        }
+
+        physAddr = frames[slot] + (virtAddr & ((1ULL << granuleShift) - 1));
+        return true;
+    }
+
+    /* Returns true if a valid entry was evicted */
+    bool insert(const uint64_t virtAddr, const uint64_t physAddr) {
+        if (tags.empty()) {
+            return false;
+        }
+
+        const uint64_t vpn = virtAddr >> granuleShift;
+        const size_t slot = vpn & mask;
+        const bool evict = (invalid != tags[slot]) && (vpn != tags[slot]);
+
+        tags[slot] = vpn;
+        frames[slot] = physAddr - (virtAddr & ((1ULL << granuleShift) - 1));
+        return evict;
+    }
+
+    void flush() {
+        for (size_t i = 0; i < tags.size(); i++) {
+            tags[i] = invalid;
+        }
+    }
+
+    uint32_t capacity() const { return (uint32_t) tags.size(); }
+
+    /* Valid entries as granule-aligned virtual -> physical pairs */
+    void exportTo(std::unordered_map<uint64_t, uint64_t>* table) const {
+        for (size_t i = 0; i < tags.size(); i++) {
+            if (invalid != tags[i]) {
+                (*table)[tags[i] << granuleShift] = frames[i];
+            }
+        }
+    }
+
+private:
+    static const uint64_t invalid = ~0ULL;
+
+    uint32_t granuleShift;
+    size_t mask;
+    std::vector<uint64_t> tags;
+    std::vector<uint64_t> frames;
+};
+
+}
+}
+
+#endif
@@ -0,0 +1,292 @@
+// Copyright 2009-2023 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2023, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#ifndef _H_SST_ARIEL_STREAM
+#define _H_SST_ARIEL_STREAM
+
+#include <sst_config.h>
+
+#include <inttypes.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#include <string>
+#include <vector>
+
+#ifdef HAVE_LIBZ
+#include <zlib.h>
+#endif
+
+#include "ariel_shmem.h"
+
+namespace SST {
+namespace ArielComponent {
+
+/*
+ * A recorded tunnel stream holds every ArielCommand one core read from the
+ * tunnel, in order, so ariel.frontend.replay can feed the same commands to
+ * a later simulation. Each file starts with
+ *
+ *   uint64_t magic         "ARIELCMD"
+ *   uint32_t version       ArielStream::version
+ *   uint32_t core
+ *   uint32_t commandSize   sizeof(ArielCommand) of the recording build
+ *   uint32_t reserved
+ *
+ * followed by the raw commands. Files are gzip compressed when libz is
+ * available, the reader accepts both.
+ */
+class ArielStream {
+public:
+    static const uint64_t magic   = 0x444d434c45495241ULL;
+    static const uint32_t version = 1;
+
+    static std::string fileName(const std::string& prefix, const uint32_t core) {
+        char suffix[32];
+        snprintf(suffix, sizeof(suffix), "-%" PRIu32 ".arielcmd", core);
+        return prefix + suffix;
+    }
+};
+
+/*
+ * The file under a stream, plain or gzip compressed. Any failed or short
+ * read or write clears good(), which stays false, so the writer can check
+ * once after each block of commands and at close.
+ */
+class ArielStreamFile {
+public:
+    ArielStreamFile() : fp(NULL), ok(true) {
+#ifdef HAVE_LIBZ
+        gz = NULL;
+#endif
+    }
+
+    ~ArielStreamFile() { close(); }
+
+    bool openWrite(const std::string& path, const bool compress) {
+        ok = true;
+#ifdef HAVE_LIBZ
+        if (compress) {
+            gz = gzopen(path.c_str(), "wb1");
+            return NULL != gz;
+        }
+#endif
+        fp = fopen(path.c_str(), "wb");
+        return NULL != fp;
+    }
+
+    bool openRead(const std::string& path) {
+        ok = true;
+#ifdef HAVE_LIBZ
+        /* gzread passes uncompressed files through unchanged */
+        gz = gzopen(path.c_str(), "rb");
+        if (NULL != gz) { gzbuffer(gz, 1 << 20); }
+        return NULL != gz;
+#else
+        fp = fopen(path.c_str(), "rb");
+        return NULL != fp;
+#endif
+    }
+
+    /* Returns good(), a compressed file is only complete once it is closed */
+    bool close() {
+        if (NULL != fp) {
+            ok = (0 == fclose(fp)) && ok;
+            fp = NULL;
+        }
+#ifdef HAVE_LIBZ
+        if (NULL != gz) {
+            ok = (Z_OK == gzclose(gz)) && ok;
+            gz = NULL;
+        }
+#endif
+        return ok;
+    }
+
+    bool good() const { return ok; }
+
+    void writeBytes(const void* data, const size_t length) {
+        if (0 == length) { return; }
+#ifdef HAVE_LIBZ
+        if (NULL != gz) {
+            ok = ((int) length == gzwrite(gz, data, (unsigned) length)) && ok;
+            return;
+        }
+#endif
+        ok = (NULL != fp) && (1 == fwrite(data, length, 1, fp)) && ok;
+    }
+
+    /* Reads exactly length bytes */
+    bool readBytes(void* data, const size_t length) {
+        if (length != readSome(data, length)) {
+            ok = false;
+            return false;
+        }
+        return true;
+    }
+
+    /* Reads up to length bytes, returns how many were read (0 at the end) */
+    size_t readSome(void* data, const size_t length) {
+#ifdef HAVE_LIBZ
+        if (NULL != gz) {
+            const int bytes = gzread(gz, data, (unsigned) length);
+            return (bytes > 0) ? (size_t) bytes : 0;
+        }
+#endif
+        return (NULL != fp) ? fread(data, 1, length, fp) : 0;
+    }
+
+private:
+    FILE* fp;
+#ifdef HAVE_LIBZ
+    gzFile gz;
+#endif
+    bool ok;
+};
+
+class ArielStreamWriter {
+public:
+    ArielStreamWriter() {}
+
+    ~ArielStreamWriter() { close(); }
+
+    bool open(const std::string& path, const uint32_t core, const bool compress) {
+        if (!file.openWrite(path, compress)) { return false; }
+
+        buffer.reserve(bufferSize + sizeof(ArielCommand));
+
+        const uint64_t fileMagic = ArielStream::magic;
+        const uint32_t header[4] = { ArielStream::version, core, (uint32_t) sizeof(ArielCommand), 0 };
+
+        put(&fileMagic, sizeof(fileMagic));
+        put(header, sizeof(header));
+        return true;
+    }
+
+    /* False if any part of the stream could not be written */
+    bool close() {
+        flush();
+        return file.close();
+    }
+
+    /* False once a block of commands has failed to write */
+    bool good() const { return file.good(); }
+
+    void write(const ArielCommand& ac) {
+        put(&ac, sizeof(ArielCommand));
+
+        if (buffer.size() >= bufferSize) {
+            flush();
+        }
+    }
+
+private:
+    static const size_t bufferSize = 1 << 20;
+
+    void put(const void* data, const size_t length) {
+        const size_t offset = buffer.size();
+        buffer.resize(offset + length);
+        memcpy(&buffer[offset], data, length);
+    }
+
+    void flush() {
+        if (buffer.empty()) { return; }
+
+        file.writeBytes(buffer.data(), buffer.size());
+        buffer.clear();
+    }
+
+    ArielStreamFile file;
+    std::vector<uint8_t> buffer;
+};
+
+/* Reads commands back in blocks of readAhead commands */
+class ArielStreamReader {
+public:
+    ArielStreamReader() : core(0), count(0), next(0) {}
+
+    ~ArielStreamReader() { close(); }
+
+    /* Returns an empty string on success, otherwise why the file was rejected */
+    std::string open(const std::string& path, const uint32_t readAhead) {
+        if (!file.openRead(path)) { return "cannot open the file"; }
+
+        uint64_t fileMagic;
+        uint32_t fileVersion, commandSize, reserved;
+
+        if (!get(&fileMagic, sizeof(fileMagic)) || !get(&fileVersion, sizeof(fileVersion)) ||
+            !get(&core, sizeof(core)) || !get(&commandSize, sizeof(commandSize)) || !get(&reserved, sizeof(reserved))) {
+            return "the header is truncated";
+        }
+
+        if (ArielStream::magic != fileMagic) {
+            return "not a recorded Ariel command stream";
+        }
+
+        if (ArielStream::version != fileVersion) {
+            return "unsupported stream version";
+        }
+
+        if (sizeof(ArielCommand) != commandSize) {
+            return "recorded by an Ariel build with a different command layout";
+        }
+
+        block.resize(readAhead > 0 ? readAhead : 1);
+        count = 0;
+        next = 0;
+        return "";
+    }
+
+    void close() { file.close(); }
+
+    uint32_t getCore() const { return core; }
+
+    /* False at the end of the stream */
+    bool read(ArielCommand& ac) {
+        if (next == count) {
+            count = getBlock(block.data(), block.size());
+            next = 0;
+
+            if (0 == count) {
+                return false;
+            }
+        }
+
+        ac = block[next++];
+        return true;
+    }
+
+private:
+    bool get(void* data, const size_t length) {
+        return file.readBytes(data, length);
+    }
+
+    /* A partial command at the end of a truncated file is dropped */
+    size_t getBlock(ArielCommand* data, const size_t maxCount) {
+        return file.readSome(data, maxCount * sizeof(ArielCommand)) / sizeof(ArielCommand);
+    }
+
+    ArielStreamFile file;
+    uint32_t core;
+    std::vector<ArielCommand> block;
+    size_t count;
+    size_t next;
+};
+
+}
+}
+
+#endif
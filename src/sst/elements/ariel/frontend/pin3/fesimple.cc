@@ -52,6 +52,7 @@
 
 #include <sst/core/interprocess/mmapchild_pin3.h>
 #include "ariel_shmem.h"
+#include "ariel_batch.h"
 #include "ariel_inst_class.h"
 
 #undef __STDC_FORMAT_MACROS
@@ -73,6 +74,7 @@ KNOB<UINT32> TrapFunctionProfile    (KNOB_MODE_WRITEONCE, "pintool", "t", "0", "
 KNOB<UINT32> InterceptMemAllocations(KNOB_MODE_WRITEONCE, "pintool", "m", "1", "Should intercept multi-level memory allocations, mallocs, and frees, 1 = start enabled, 0 = start disabled");
 KNOB<string> UseMallocMap           (KNOB_MODE_WRITEONCE, "pintool", "u", "",  "Should intercept ariel_malloc_flag() and interpret using a malloc map: specify filename or leave blank for disabled");
 KNOB<UINT32> KeepMallocStackTrace   (KNOB_MODE_WRITEONCE, "pintool", "k", "1", "Should keep shadow stack and dump on malloc calls. 1 = enabled, 0 = disabled");
+KNOB<UINT32> BatchRecords           (KNOB_MODE_WRITEONCE, "pintool", "b", "0", "Pack up to this many memory operations into each tunnel command, batches are also sent at the end of every basic block (0 = one command per operation)");
 KNOB<UINT32> DefaultMemoryPool      (KNOB_MODE_WRITEONCE, "pintool", "d", "0", "Default Ariel Memory Pool");
 // GPGPUSim
 KNOB<string> SSTNamedPipe2          (KNOB_MODE_WRITEONCE, "pintool", "g", "",  "Named pipe to connect to SST simulator");
@@ -95,6 +97,8 @@ PIN_LOCK mainLock;
 
 // Instrumentation control
 UINT32 instrument_instructions;
+UINT32 batch_records;
+ArielBatchBuilder* batches;  // one per thread, only touched by that thread
 bool writeTrace;
 UINT32 funcProfileLevel;
 typedef struct {
@@ -283,12 +287,116 @@ VOID InstrumentTrace (TRACE trace, VOID* args)
 /******************** END SHADOW STACK **************************/
 /****************************************************************/
 
+/****************************************************************/
+/************************* BATCHING *****************************/
+/* Memory operations are packed into ARIEL_PERFORM_BATCH        */
+/* commands when batch_records > 0, see ariel_batch.h           */
+/****************************************************************/
+
+VOID SendBatch(UINT32 thr)
+{
+    if(!batches[thr].empty()) {
+        tunnel->writeMessage(thr, batches[thr].getCommand());
+        batches[thr].reset();
+    }
+}
+
+/* Any other command sends the thread's pending batch first so the core sees events in program order */
+VOID WriteCommand(UINT32 thr, ArielCommand& ac)
+{
+    if(batch_records > 0 && thr < core_count) {
+        SendBatch(thr);
+    }
+
+    tunnel->writeMessage(thr, ac);
+}
+
+VOID BatchInstructionRead(THREADID thr, ADDRINT* address, UINT32 readSize, BOOL first,
+            UINT32 instClass, UINT32 simdOpWidth)
+{
+    ArielBatchBuilder& batch = batches[thr];
+
+    if(!batch.fits((uint64_t) address, readSize, first, false)) {
+        SendBatch(thr);
+    }
+
+    batch.addRead((uint64_t) address, readSize, first, instClass, simdOpWidth);
+
+    if(batch.count() >= batch_records) {
+        SendBatch(thr);
+    }
+}
+
+VOID BatchInstructionWrite(THREADID thr, ADDRINT* address, UINT32 writeSize, BOOL first,
+            UINT32 instClass, UINT32 simdOpWidth)
+{
+    ArielBatchBuilder& batch = batches[thr];
+    uint8_t payload[ARIEL_MAX_PAYLOAD_SIZE];
+
+    if(!batch.fits((uint64_t) address, writeSize, first, writeTrace)) {
+        SendBatch(thr);
+    }
+
+    if(writeTrace) {
+        PIN_SafeCopy(&payload[0], address, ARIEL_MIN(writeSize, (UINT32) ARIEL_MAX_PAYLOAD_SIZE));
+    }
+
+    batch.addWrite((uint64_t) address, writeSize, writeTrace ? &payload[0] : NULL, first, instClass, simdOpWidth);
+
+    if(batch.count() >= batch_records) {
+        SendBatch(thr);
+    }
+}
+
+VOID BatchNoOp(THREADID thr)
+{
+    ArielBatchBuilder& batch = batches[thr];
+
+    if(!batch.fitsNoOp()) {
+        SendBatch(thr);
+    }
+
+    batch.addNoOp();
+
+    if(batch.count() >= batch_records) {
+        SendBatch(thr);
+    }
+}
+
+VOID EndBasicBlock(THREADID thr)
+{
+    if(thr < core_count) {
+        SendBatch(thr);
+    }
+}
+
+/* Send whatever the block recorded once its last instruction has been traced */
+VOID InstrumentBatchTrace(TRACE trace, VOID* args)
+{
+    for (BBL bbl = TRACE_BblHead(trace); BBL_Valid(bbl); bbl = BBL_Next(bbl)) {
+        INS_InsertCall(BBL_InsTail(bbl), IPOINT_BEFORE, (AFUNPTR) EndBasicBlock,
+                IARG_THREAD_ID,
+                IARG_CALL_ORDER, CALL_ORDER_LAST,
+                IARG_END);
+    }
+}
+
+/****************************************************************/
+/*********************** END BATCHING ***************************/
+/****************************************************************/
+
 VOID Fini(INT32 code, VOID* v)
 {
     if(SSTVerbosity.Value() > 0) {
         std::cout << "SSTARIEL: Execution completed, shutting down." << std::endl;
     }
 
+    if(batch_records > 0) {
+        for(UINT32 i = 0; i < core_count; i++) {
+            SendBatch(i);
+        }
+    }
+
     ArielCommand ac;
     ac.command = ARIEL_PERFORM_EXIT;
     ac.instPtr = (uint64_t) 0;
@@ -340,7 +448,7 @@ VOID WriteFlushInstructionMarker(UINT32 thr, ADDRINT ip, ADDRINT vaddr)
     ac.instPtr = (uint64_t) ip;
     ac.flushline.vaddr = (uint32_t) vaddr;
 
-    tunnel->writeMessage(thr, ac);
+    WriteCommand(thr, ac);
 }
 
 VOID WriteFenceInstructionMarker(UINT32 thr, ADDRINT ip)
@@ -349,7 +457,7 @@ VOID WriteFenceInstructionMarker(UINT32 thr, ADDRINT ip)
     ac.command = ARIEL_FENCE_INSTRUCTION;
     ac.instPtr = (uint64_t) ip;
 
-    tunnel->writeMessage(thr, ac);
+    WriteCommand(thr, ac);
 }
 
 VOID WriteInstructionRead(ADDRINT* address, UINT32 readSize, THREADID thr, ADDRINT ip,
@@ -367,7 +475,7 @@ VOID WriteInstructionRead(ADDRINT* address, UINT32 readSize, THREADID thr, ADDRI
     ac.inst.instClass = instClass;
     ac.inst.simdElemCount = simdOpWidth;
 
-    tunnel->writeMessage(thr, ac);
+    WriteCommand(thr, ac);
 }
 
 VOID WriteInstructionWrite(ADDRINT* address, UINT32 writeSize, THREADID thr, ADDRINT ip,
@@ -399,7 +507,7 @@ VOID WriteInstructionWrite(ADDRINT* address, UINT32 writeSize, THREADID thr, ADD
     }
     printf("\n");
 */
-    tunnel->writeMessage(thr, ac);
+    WriteCommand(thr, ac);
 }
 
 VOID WriteStartInstructionMarker(UINT32 thr, ADDRINT ip, UINT32 instClass, UINT32 simdOpWidth)
@@ -409,7 +517,7 @@ VOID WriteStartInstructionMarker(UINT32 thr, ADDRINT ip, UINT32 instClass, UINT3
     ac.instPtr = (uint64_t) ip;
     ac.inst.simdElemCount = simdOpWidth;
     ac.inst.instClass = instClass;
-    tunnel->writeMessage(thr, ac);
+    WriteCommand(thr, ac);
 }
 
 VOID WriteEndInstructionMarker(UINT32 thr, ADDRINT ip)
@@ -417,7 +525,7 @@ VOID WriteEndInstructionMarker(UINT32 thr, ADDRINT ip)
     ArielCommand ac;
     ac.command = ARIEL_END_INSTRUCTION;
     ac.instPtr = (uint64_t) ip;
-    tunnel->writeMessage(thr, ac);
+    WriteCommand(thr, ac);
 }
 
 VOID WriteInstructionReadWrite(THREADID thr, ADDRINT* readAddr, UINT32 readSize,
@@ -427,6 +535,12 @@ VOID WriteInstructionReadWrite(THREADID thr, ADDRINT* readAddr, UINT32 readSize,
 
     if(enable_output) {
         if(thr < core_count) {
+            if (batch_records > 0) {
+                BatchInstructionRead(thr, readAddr, readSize, true, instClass, simdOpWidth);
+                BatchInstructionWrite(thr, writeAddr, writeSize, false, instClass, simdOpWidth);
+                return;
+            }
+
             WriteStartInstructionMarker( thr, ip, instClass, simdOpWidth);
             WriteInstructionRead(  readAddr,  readSize,  thr, ip, instClass, simdOpWidth );
             WriteInstructionWrite( writeAddr, writeSize, thr, ip, instClass, simdOpWidth );
@@ -441,6 +555,11 @@ VOID WriteInstructionReadOnly(THREADID thr, ADDRINT* readAddr, UINT32 readSize,
 
     if(enable_output) {
         if(thr < core_count) {
+            if (batch_records > 0) {
+                BatchInstructionRead(thr, readAddr, readSize, first, instClass, simdOpWidth);
+                return;
+            }
+
             if (first)
                 WriteStartInstructionMarker(thr, ip, instClass, simdOpWidth);
             WriteInstructionRead(  readAddr,  readSize,  thr, ip, instClass, simdOpWidth );
@@ -455,10 +574,15 @@ VOID WriteNoOp(THREADID thr, ADDRINT ip)
 {
     if(enable_output) {
         if(thr < core_count) {
+            if (batch_records > 0) {
+                BatchNoOp(thr);
+                return;
+            }
+
             ArielCommand ac;
             ac.command = ARIEL_NOOP;
             ac.instPtr = (uint64_t) ip;
-            tunnel->writeMessage(thr, ac);
+            WriteCommand(thr, ac);
         }
     }
 }
@@ -469,6 +593,11 @@ VOID WriteInstructionWriteOnly(THREADID thr, ADDRINT* writeAddr, UINT32 writeSiz
 
     if(enable_output) {
         if(thr < core_count) {
+            if (batch_records > 0) {
+                BatchInstructionWrite(thr, writeAddr, writeSize, first, instClass, simdOpWidth);
+                return;
+            }
+
             if (first)
                 WriteStartInstructionMarker(thr, ip, instClass, simdOpWidth);
             WriteInstructionWrite(writeAddr, writeSize,  thr, ip, instClass, simdOpWidth);
@@ -755,7 +884,7 @@ void mapped_ariel_output_stats()
     ArielCommand ac;
     ac.command = ARIEL_OUTPUT_STATS;
     ac.instPtr = (uint64_t) 0;
-    tunnel->writeMessage(thr, ac);
+    WriteCommand(thr, ac);
 }
 
 // same effect as mapped_ariel_output_stats(), but it also sends a user-defined reference number back
@@ -765,7 +894,7 @@ void mapped_ariel_output_stats_buoy(uint64_t marker)
     ArielCommand ac;
     ac.command = ARIEL_OUTPUT_STATS;
     ac.instPtr = (uint64_t) marker; //user the instruction pointer slot to send the marker number
-    tunnel->writeMessage(thr, ac);
+    WriteCommand(thr, ac);
 }
 
 void mapped_ariel_flushline(void *virtualAddress)
@@ -819,7 +948,7 @@ int ariel_mlm_memcpy(void* dest, void* source, size_t size) {
     ac.dma_start.dest = ariel_dest;
     ac.dma_start.len = length;
 
-    tunnel->writeMessage(thr, ac);
+    WriteCommand(thr, ac);
 
 #ifdef ARIEL_DEBUG
     fprintf(stderr, "Done with ariel memcpy.\n");
@@ -847,7 +976,7 @@ void ariel_mlm_set_pool(int new_pool)
     ArielCommand ac;
     ac.command = ARIEL_SWITCH_POOL;
     ac.switchPool.pool = newDefaultPool;
-    tunnel->writeMessage(thr, ac);
+    WriteCommand(thr, ac);
 
     // Keep track of the default pool
     default_pool = (UINT32) new_pool;
@@ -899,7 +1028,7 @@ void* ariel_mmap_mlm(int fileID, size_t size, int level)
     std::cout<<"File ID at FESIMPLE IS : "<<ac.mlm_mmap.fileID<<std::endl;
     std::cout<<"After ******"<<std::endl;
 
-    tunnel->writeMessage(thr, ac);
+    WriteCommand(thr, ac);
 
 #ifdef ARIEL_DEBUG
     fprintf(stderr, "%u: Ariel mmap_mlm call allocates data at address: 0x%llx\n",
@@ -954,7 +1083,7 @@ void* ariel_mlm_malloc(size_t size, int level) {
         ac.mlm_map.alloc_level = allocationLevel;
     }
 
-    tunnel->writeMessage(thr, ac);
+    WriteCommand(thr, ac);
 
 #ifdef ARIEL_DEBUG
     fprintf(stderr, "%u: Ariel mlm_malloc call allocates data at address: 0x%llx\n",
@@ -999,7 +1128,7 @@ void ariel_mlm_free(void* ptr)
         ArielCommand ac;
         ac.command = ARIEL_ISSUE_TLM_FREE;
         ac.mlm_free.vaddr = virtAddr;
-        tunnel->writeMessage(thr, ac);
+        WriteCommand(thr, ac);
 
     } else {
         fprintf(stderr, "ARIEL: Call to free in Ariel did not find a matching local allocation, this memory will be leaked.\n");
@@ -1051,14 +1180,14 @@ VOID ariel_postmalloc_instrument(ADDRINT allocLocation)
                 if (toFast[thr].count == 0) {
                     toFast[thr].valid = false;
                 }
-                tunnel->writeMessage(thr, ac);
+                WriteCommand(thr, ac);
             }
         } else if (shouldOverride) {
             ac.mlm_map.alloc_level = overridePool;
-            tunnel->writeMessage(thr, ac);
+            WriteCommand(thr, ac);
         } else if (InterceptMemAllocations.Value()) {
             ac.mlm_map.alloc_level = allocationLevel;
-            tunnel->writeMessage(thr, ac);
+            WriteCommand(thr, ac);
         }
 
         /*printf("ARIEL: Created a malloc of size: %" PRIu64 " in Ariel\n",
@@ -1085,7 +1214,7 @@ __host__ cudaError_t CUDARTAPI cudaMalloc(void **devPtr, size_t size){
     ac.API.name = GPU_MALLOC;
     ac.API.CA.cuda_malloc.dev_ptr = devPtr;
     ac.API.CA.cuda_malloc.size = size;
-    tunnel->writeMessage(thr, ac);
+    WriteCommand(thr, ac);
 
     GpuCommand gc;
     bool avail = false;
@@ -1115,7 +1244,7 @@ void** CUDARTAPI __cudaRegisterFatBinary(void *fatCubin) {
     ArielCommand ac;
     ac.command = ARIEL_ISSUE_CUDA;
     ac.API.name = GPU_REG_FAT_BINARY;
-    tunnel->writeMessage(thr, ac);
+    WriteCommand(thr, ac);
 
     GpuCommand gc;
     bool avail=false;
@@ -1156,7 +1285,7 @@ void CUDARTAPI __cudaRegisterFunction(
     ac.API.CA.register_function.fat_cubin_handle = (unsigned)(unsigned long long)fatCubinHandle;
     ac.API.CA.register_function.host_fun = reinterpret_cast<uint64_t>(hostFun);
     strncpy(ac.API.CA.register_function.device_fun, deviceFun, 512);
-    tunnel->writeMessage(thr, ac);
+    WriteCommand(thr, ac);
 
     GpuCommand gc;
     bool avail=false;
@@ -1221,7 +1350,7 @@ __host__ cudaError_t CUDARTAPI cudaMemcpy(void *dst, const void *src, size_t cou
     ac.API.CA.cuda_memcpy.src = (uint64_t) src;
     ac.API.CA.cuda_memcpy.count = count;
     ac.API.CA.cuda_memcpy.kind = final_kind;
-    tunnel->writeMessage(thr, ac);
+    WriteCommand(thr, ac);
 
     if(final_kind == cudaMemcpyHostToDevice) {
         if(count <= max_page_size){
@@ -1350,7 +1479,7 @@ __host__ cudaError_t CUDARTAPI cudaConfigureCall(dim3 gridDim, dim3 blockDim, si
     ac.API.CA.cfg_call.bdz = blockDim.z;
     ac.API.CA.cfg_call.sharedMem = sharedMem;
     ac.API.CA.cfg_call.stream = stream;
-    tunnel->writeMessage(thr, ac);
+    WriteCommand(thr, ac);
 
     GpuCommand gc;
     bool avail=false;
@@ -1398,7 +1527,7 @@ __host__ cudaError_t CUDARTAPI cudaSetupArgument(const void *arg, size_t size, s
     ac.API.CA.set_arg.offset = offset;
     ac.command = ARIEL_ISSUE_CUDA;
     ac.API.name = GPU_SET_ARG;
-    tunnel->writeMessage(thr, ac);
+    WriteCommand(thr, ac);
 
     GpuCommand gc;
     bool avail=false;
@@ -1423,7 +1552,7 @@ __host__ cudaError_t CUDARTAPI cudaLaunch(const void *func){
     ac.command = ARIEL_ISSUE_CUDA;
     ac.API.name = GPU_LAUNCH;
     ac.API.CA.cuda_launch.func = reinterpret_cast<uint64_t>(func);
-    tunnel->writeMessage(thr, ac);
+    WriteCommand(thr, ac);
 
     GpuCommand gc;
     bool avail=false;
@@ -1447,7 +1576,7 @@ __host__ cudaError_t CUDARTAPI cudaFree(void *devPtr){
     ac.command = ARIEL_ISSUE_CUDA;
     ac.API.name = GPU_FREE;
     ac.API.CA.free_address = (uint64_t)devPtr;
-    tunnel->writeMessage(thr, ac);
+    WriteCommand(thr, ac);
 
     GpuCommand gc;
     bool avail=false;
@@ -1470,7 +1599,7 @@ __host__ __cudart_builtin__ cudaError_t CUDARTAPI cudaGetLastError(void){
     ArielCommand ac;
     ac.command = ARIEL_ISSUE_CUDA;
     ac.API.name = GPU_GET_LAST_ERROR;
-    tunnel->writeMessage(thr, ac);
+    WriteCommand(thr, ac);
     GpuCommand gc;
 
     bool avail=false;
@@ -1509,7 +1638,7 @@ void CUDARTAPI __cudaRegisterVar(
     ac.API.CA.register_var.size = size;
     ac.API.CA.register_var.constant = constant;
     ac.API.CA.register_var.global = global;
-    tunnel->writeMessage(thr, ac);
+    WriteCommand(thr, ac);
 
     GpuCommand gc;
     bool avail=false;
@@ -1545,7 +1674,7 @@ __host__ cudaError_t CUDARTAPI __maxActiveBlock(
     ac.API.CA.max_active_block.blockSize = blockSize;
     ac.API.CA.max_active_block.dynamicSMemSize = dynamicSMemSize;
     ac.API.CA.max_active_block.flags = flags;
-    tunnel->writeMessage(thr, ac);
+    WriteCommand(thr, ac);
 
     GpuCommand gc;
     bool avail=false;
@@ -1573,7 +1702,7 @@ VOID ariel_postfree_instrument(ADDRINT allocLocation)
     ArielCommand ac;
     ac.command = ARIEL_ISSUE_TLM_FREE;
     ac.mlm_free.vaddr = virtAddr;
-    tunnel->writeMessage(thr, ac);
+    WriteCommand(thr, ac);
 }
 
 void mapped_ariel_malloc_flag_fortran(int* mallocLocId, int* count, int* level)
@@ -1620,7 +1749,7 @@ void ariel_start_RTL_sim(RTL_shmem_info* rtl_shmem) {
 
     THREADID thr = PIN_ThreadId();
     const uint32_t thrID = (uint32_t) thr;
-    tunnel->writeMessage(thrID, acRtl);
+    WriteCommand(thrID, acRtl);
     #ifdef ARIEL_DEBUG
     fprintf(stderr, "\nMessage to add RTL Event into Ariel Event Queue successfully delivered via ArielTunnel");
     #endif
@@ -1641,7 +1770,7 @@ void ariel_update_RTL_signals(RTL_shmem_info* rtl_shmem) {
 
     THREADID thr = PIN_ThreadId();
     const uint32_t thrID = (uint32_t) thr;
-    tunnel->writeMessage(thrID, acRtl);
+    WriteCommand(thrID, acRtl);
     #ifdef ARIEL_DEBUG
     fprintf(stderr, "\nMessage to add RTL Event into Ariel Event Queue to update RTL signals successfully delivered via ArielTunnel");
     #endif
@@ -1909,6 +2038,12 @@ int main(int argc, char *argv[])
 
     core_count = MaxCoreCount.Value();
     instrument_instructions = InstrumentInstructions.Value();
+    batch_records = BatchRecords.Value();
+    batches = new ArielBatchBuilder[core_count];
+
+    if(batch_records > 0) {
+        fprintf(stderr, "ARIEL: Batching up to %" PRIu32 " memory operations per tunnel command.\n", batch_records);
+    }
 
 // Pin version specific tunnel attach
     tunnelmgr = new SST::Core::Interprocess::MMAPChild_Pin3<ArielTunnel>(SSTNamedPipe.Value());
@@ -1991,6 +2126,9 @@ int main(int argc, char *argv[])
     if (KeepMallocStackTrace.Value() == 1)
         TRACE_AddInstrumentFunction(InstrumentTrace, 0);
 
+    if (instrument_instructions && batch_records > 0)
+        TRACE_AddInstrumentFunction(InstrumentBatchTrace, 0);
+
     if (UseMallocMap.Value() != "") {
         loadFastMemLocations();
         for (unsigned int i = 0; i < core_count; i++) {
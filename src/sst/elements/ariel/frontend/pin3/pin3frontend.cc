@@ -47,6 +47,7 @@ Pin3Frontend::Pin3Frontend(ComponentId_t id, Params& params, uint32_t cores, uin
     output = new SST::Output("Pin3Frontend[@f:@l:@p] ", verbosity, 0, SST::Output::STDOUT);
 
     int instrument_instructions = params.find<int>("instrument_instructions", 1);
+    uint32_t batch_records = params.find<uint32_t>("batchrecords", 0);
     core_count = cores;
 
     /////////////////////////////////////////////////////////////////////////////////////
@@ -126,7 +127,7 @@ Pin3Frontend::Pin3Frontend(ComponentId_t id, Params& params, uint32_t cores, uin
     appLauncher = params.find<std::string>("launcher", PINTOOL_EXECUTABLE);
 
     const uint32_t launch_param_count = (uint32_t) params.find<uint32_t>("launchparamcount", 0);
-    const uint32_t pin_arg_count = 37 + launch_param_count;
+    const uint32_t pin_arg_count = 39 + launch_param_count;
 
     execute_args = (char**) malloc(sizeof(char*) * (pin_arg_count + app_argc));
 
@@ -187,6 +188,9 @@ Pin3Frontend::Pin3Frontend(ComponentId_t id, Params& params, uint32_t cores, uin
     execute_args[arg++] = const_cast<char*>("-E");
     execute_args[arg++] = (char*) malloc(buff8size);
     snprintf(execute_args[arg-1], buff8size, "%d", instrument_instructions);
+    execute_args[arg++] = const_cast<char*>("-b");
+    execute_args[arg++] = (char*) malloc(buff8size);
+    snprintf(execute_args[arg-1], buff8size, "%" PRIu32, batch_records);
     execute_args[arg++] = const_cast<char*>("-p");
     execute_args[arg++] = (char*) malloc(sizeof(char) * (shmem_region_name.length() + 1));
     strcpy(execute_args[arg-1], shmem_region_name.c_str());
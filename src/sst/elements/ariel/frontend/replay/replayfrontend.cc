@@ -0,0 +1,141 @@
+// Copyright 2009-2023 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2023, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+
+#include <sst_config.h>
+
+#include "replayfrontend.h"
+#include "arielstream.h"
+
+#include <signal.h>
+#if !defined(SST_COMPILE_MACOSX)
+#include <sys/prctl.h>
+#endif
+#include <sys/types.h>
+#include <stdio.h>
+#include <string.h>
+#include <errno.h>
+
+using namespace SST::ArielComponent;
+
+ReplayFrontend::ReplayFrontend(ComponentId_t id, Params& params, uint32_t cores, uint32_t maxCoreQueueLen, uint32_t defMemPool) :
+            ArielFrontend(id, params, cores, maxCoreQueueLen, defMemPool) {
+
+    int verbosity = params.find<int>("verbose", 0);
+    output = new SST::Output("ReplayFrontend[@f:@l:@p] ", verbosity, 0, SST::Output::STDOUT);
+
+    core_count = cores;
+
+    replay_prefix = params.find<std::string>("replaystream", "");
+    if ("" == replay_prefix) {
+        output->fatal(CALL_INFO, -1, "The replaystream parameter specifying which recording to replay was not specified\n");
+    }
+
+    read_ahead = params.find<uint32_t>("readahead", 4096);
+
+    // Check every stream now rather than in the children
+    for (uint32_t i = 0; i < core_count; i++) {
+        const std::string file = ArielStream::fileName(replay_prefix, i);
+        ArielStreamReader reader;
+        const std::string error = reader.open(file, 1);
+
+        if ("" != error) {
+            output->fatal(CALL_INFO, -1, "Cannot replay %s for core %" PRIu32 ": %s\n", file.c_str(), i, error.c_str());
+        }
+
+        if (reader.getCore() != i) {
+            output->fatal(CALL_INFO, -1, "Cannot replay %s for core %" PRIu32 ": it was recorded by core %" PRIu32 "\n",
+                    file.c_str(), i, reader.getCore());
+        }
+    }
+
+    tunnelmgr = new SST::Core::Interprocess::MMAPParent<ArielTunnel>(id, core_count, maxCoreQueueLen);
+    tunnel = tunnelmgr->getTunnel();
+
+    output->verbose(CALL_INFO, 1, 0, "Replaying %" PRIu32 " cores from %s\n", core_count, replay_prefix.c_str());
+}
+
+ReplayFrontend::~ReplayFrontend() {
+    delete tunnelmgr;
+    delete output;
+}
+
+void ReplayFrontend::init(unsigned int phase)
+{
+    // Like the Pin frontend there is nothing to run when only initializing
+    if ( phase != 0 || isSimulationRunModeInit() ) {
+        return;
+    }
+
+    // A child per core keeps each core's queue full independently of the
+    // others, the tunnel is a shared mapping so children write straight into it
+    for (uint32_t i = 0; i < core_count; i++) {
+        pid_t the_child = fork();
+        if ( the_child < 0 ) {
+            output->fatal(CALL_INFO, 1, "Fork failed to launch the replay of core %" PRIu32 ". errno = %d, errstr = %s\n",
+                    i, errno, strerror(errno));
+        }
+
+        if ( the_child == 0 ) {
+#if !defined(SST_COMPILE_MACOSX)
+            prctl(PR_SET_PDEATHSIG, SIGKILL, 0, 0, 0);
+#endif
+            replay(i);
+            _exit(0);
+        }
+
+        child_pids.push_back(the_child);
+    }
+
+    output->verbose(CALL_INFO, 1, 0, "Launched %" PRIu32 " replay processes.\n", core_count);
+}
+
+void ReplayFrontend::finish() {
+    // Children block once their queue is full, they do not exit on
+    // their own if the simulation ends first
+    for (size_t i = 0; i < child_pids.size(); i++) {
+        kill(child_pids[i], SIGKILL);
+    }
+
+    child_pids.clear();
+}
+
+void ReplayFrontend::emergencyShutdown() {
+    finish();
+}
+
+ArielTunnel* ReplayFrontend::getTunnel() {
+    return tunnel;
+}
+
+void ReplayFrontend::replay(uint32_t core) {
+    ArielStreamReader reader;
+    reader.open(ArielStream::fileName(replay_prefix, core), read_ahead);
+
+    ArielCommand ac;
+    bool exited = false;
+
+    while (reader.read(ac)) {
+        tunnel->writeMessage(core, ac);
+        exited = exited || (ARIEL_PERFORM_EXIT == ac.command);
+    }
+
+    // Recordings cut short (e.g. by --stop-at) have no exit, Pin sends it on core 0
+    if (0 == core && !exited) {
+        ac.command = ARIEL_PERFORM_EXIT;
+        ac.instPtr = 0;
+        tunnel->writeMessage(core, ac);
+    }
+}
@@ -0,0 +1,80 @@
+// Copyright 2009-2023 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2023, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#ifndef _H_REPLAY_FRONTEND
+#define _H_REPLAY_FRONTEND
+
+#include <sst/core/sst_config.h>
+#include <sst/core/component.h>
+#include <sst/core/params.h>
+#include <sst/core/interprocess/mmapparent.h>
+
+#include <stdint.h>
+#include <unistd.h>
+
+#include <string>
+#include <vector>
+
+#include "arielfrontend.h"
+#include "ariel_shmem.h"
+
+namespace SST {
+namespace ArielComponent {
+
+/** Feeds the cores the command streams recorded with the Ariel
+ * recordstream parameter. One forked child per core reads its file ahead
+ * of the simulation and writes into the tunnel, no traced binary is run.
+ */
+class ReplayFrontend : public ArielFrontend {
+    public:
+
+    /* SST ELI */
+    SST_ELI_REGISTER_SUBCOMPONENT(ReplayFrontend, "ariel", "frontend.replay", SST_ELI_ELEMENT_VERSION(1,0,0), "Ariel frontend replaying recorded command streams, does not require Pin", SST::ArielComponent::ArielFrontend)
+
+    SST_ELI_DOCUMENT_PARAMS(
+        {"verbose", "Verbosity for debugging. Increased numbers for increased verbosity.", "0"},
+        {"replaystream", "Prefix the streams were recorded with, core N reads <replaystream>-N.arielcmd", ""},
+        {"readahead", "Commands read from the file at a time", "4096"})
+
+    /* Ariel class */
+    ReplayFrontend(ComponentId_t id, Params& params, uint32_t cores, uint32_t qSize, uint32_t memPool);
+    ~ReplayFrontend();
+    virtual void emergencyShutdown();
+    virtual void init(unsigned int phase);
+    virtual void setup() {}
+    virtual void finish();
+    virtual ArielTunnel* getTunnel();
+
+    private:
+
+    void replay(uint32_t core);
+
+    SST::Output* output;
+
+    std::vector<pid_t> child_pids;
+
+    uint32_t core_count;
+    SST::Core::Interprocess::MMAPParent<ArielTunnel>* tunnelmgr;
+
+    ArielTunnel* tunnel;
+
+    std::string replay_prefix;
+    uint32_t read_ahead;
+};
+
+}
+}
+
+#endif
@@ -0,0 +1,95 @@
+import sst
+import sys
+
+# Runs Ariel from the synthetic frontend, no Pin or traced application
+# needed. Pass a batch size to compare the batched tunnel protocol with
+# one command per operation, e.g.
+#   sst synthetic.py -- 32
+# A second argument records the commands each core receives under that
+# prefix, for frontend/replay/examples/replay.py, e.g.
+#   sst synthetic.py -- 32 ariel-stream
+
+batchrecords = 0
+recordstream = ""
+if len(sys.argv) > 1:
+    batchrecords = int(sys.argv[1])
+if len(sys.argv) > 2:
+    recordstream = sys.argv[2]
+
+sst.setProgramOption("timebase", "1ps")
+
+corecount = 2
+
+ariel = sst.Component("a0", "ariel.ariel")
+ariel.addParams({
+        "verbose" : "0",
+        "corecount" : corecount,
+        "maxcorequeue" : "256",
+        "maxissuepercycle" : "2",
+        "pipetimeout" : "0",
+        "recordstream" : recordstream,
+        })
+
+frontend = ariel.setSubComponent("frontend", "ariel.frontend.synthetic")
+frontend.addParams({
+        "instructions" : "200000",
+        "blocksize" : "8",
+        "batchrecords" : batchrecords,
+        "readfraction" : "0.5",
+        "writefraction" : "0.25",
+        "footprint" : "1048576",
+        "stride" : "64",
+        "accesssize" : "8",
+        })
+
+memmgr = ariel.setSubComponent("memmgr", "ariel.MemoryManagerSimple")
+
+bus = sst.Component("bus", "memHierarchy.Bus")
+bus.addParams({
+        "bus_frequency" : "2 Ghz",
+})
+
+for core in range(corecount):
+    l1cache = sst.Component("l1cache_" + str(core), "memHierarchy.Cache")
+    l1cache.addParams({
+            "cache_frequency" : "2 Ghz",
+            "cache_size" : "64 KB",
+            "coherence_protocol" : "MSI",
+            "replacement_policy" : "lru",
+            "associativity" : "8",
+            "access_latency_cycles" : "1",
+            "cache_line_size" : "64",
+            "L1" : "1",
+            "debug" : "0",
+    })
+
+    cpu_cache_link = sst.Link("cpu_cache_link_" + str(core))
+    cpu_cache_link.connect( (ariel, "cache_link_" + str(core), "50ps"), (l1cache, "high_network_0", "50ps") )
+
+    cache_bus_link = sst.Link("cache_bus_link_" + str(core))
+    cache_bus_link.connect( (l1cache, "low_network_0", "50ps"), (bus, "high_network_" + str(core), "50ps") )
+
+memctrl = sst.Component("memory", "memHierarchy.MemController")
+memctrl.addParams({
+        "clock" : "1GHz",
+})
+
+memory = memctrl.setSubComponent("backend", "memHierarchy.simpleMem")
+memory.addParams({
+        "access_time" : "10ns",
+        "mem_size" : "2048MiB",
+})
+
+memory_link = sst.Link("mem_bus_link")
+memory_link.connect( (bus, "low_network_0", "50ps"), (memctrl, "direct_link", "50ps") )
+
+sst.setStatisticLoadLevel(5)
+sst.setStatisticOutput("sst.statOutputConsole")
+
+ariel.enableStatistics([
+      "cycles",
+      "active_cycles",
+      "instruction_count",
+      "read_requests",
+      "write_requests"
+])
@@ -0,0 +1,235 @@
+// Copyright 2009-2023 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2023, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+
+#include <sst_config.h>
+
+#include "syntheticfrontend.h"
+
+#include <signal.h>
+#if !defined(SST_COMPILE_MACOSX)
+#include <sys/prctl.h>
+#endif
+#include <sys/types.h>
+#include <stdio.h>
+#include <string.h>
+#include <errno.h>
+
+#include <algorithm>
+
+using namespace SST::ArielComponent;
+
+SyntheticFrontend::SyntheticFrontend(ComponentId_t id, Params& params, uint32_t cores, uint32_t maxCoreQueueLen, uint32_t defMemPool) :
+            ArielFrontend(id, params, cores, maxCoreQueueLen, defMemPool) {
+
+    int verbosity = params.find<int>("verbose", 0);
+    output = new SST::Output("SyntheticFrontend[@f:@l:@p] ", verbosity, 0, SST::Output::STDOUT);
+
+    core_count = cores;
+    child_pid = 0;
+
+    instructions = params.find<uint64_t>("instructions", 1000000);
+    block_size = params.find<uint32_t>("blocksize", 8);
+    batch_records = params.find<uint32_t>("batchrecords", 0);
+    read_fraction = params.find<double>("readfraction", 0.5);
+    write_fraction = params.find<double>("writefraction", 0.25);
+    footprint = params.find<uint64_t>("footprint", 1048576);
+    stride = params.find<uint64_t>("stride", 64);
+    access_size = params.find<uint32_t>("accesssize", 8);
+    write_payload = params.find<int>("writepayload", 0) != 0;
+    seed = params.find<uint64_t>("seed", 1);
+
+    if (0 == block_size) {
+        output->fatal(CALL_INFO, -1, "Parameter blocksize must be at least 1\n");
+    }
+
+    if (read_fraction < 0 || write_fraction < 0 || (read_fraction + write_fraction) > 1.0) {
+        output->fatal(CALL_INFO, -1, "Parameters readfraction (%f) and writefraction (%f) must be positive and sum to at most 1.0\n",
+                read_fraction, write_fraction);
+    }
+
+    if (0 == footprint || 0 == access_size || access_size > footprint) {
+        output->fatal(CALL_INFO, -1, "Parameter accesssize (%" PRIu32 ") must be between 1 and footprint (%" PRIu64 ")\n",
+                access_size, footprint);
+    }
+
+    tunnelmgr = new SST::Core::Interprocess::MMAPParent<ArielTunnel>(id, core_count, maxCoreQueueLen);
+    tunnel = tunnelmgr->getTunnel();
+
+    output->verbose(CALL_INFO, 1, 0, "Generating %" PRIu64 " instructions per core in blocks of %" PRIu32 ", %s\n",
+            instructions, block_size, batch_records > 0 ? "batched" : "one command per operation");
+}
+
+SyntheticFrontend::~SyntheticFrontend() {
+    delete tunnelmgr;
+    delete output;
+}
+
+void SyntheticFrontend::init(unsigned int phase)
+{
+    // Like the Pin frontend there is nothing to run when only initializing
+    if ( phase != 0 || isSimulationRunModeInit() ) {
+        return;
+    }
+
+    output->verbose(CALL_INFO, 1, 0, "Forking synthetic trace generator...\n");
+
+    // The tunnel is a shared mapping so the child writes straight into it
+    pid_t the_child = fork();
+    if ( the_child < 0 ) {
+        output->fatal(CALL_INFO, 1, "Fork failed to launch the synthetic generator. errno = %d, errstr = %s\n", errno, strerror(errno));
+    }
+
+    if ( the_child == 0 ) {
+#if !defined(SST_COMPILE_MACOSX)
+        prctl(PR_SET_PDEATHSIG, SIGKILL, 0, 0, 0);
+#endif
+        generate();
+        _exit(0);
+    }
+
+    child_pid = the_child;
+}
+
+void SyntheticFrontend::finish() {
+    // The generator blocks once the queues are full, it does not
+    // exit on its own if the simulation ends first
+    if (child_pid != 0) {
+        kill(child_pid, SIGKILL);
+        child_pid = 0;
+    }
+}
+
+void SyntheticFrontend::emergencyShutdown() {
+    finish();
+}
+
+ArielTunnel* SyntheticFrontend::getTunnel() {
+    return tunnel;
+}
+
+void SyntheticFrontend::generate() {
+    uint64_t* rng = new uint64_t[core_count];
+    uint64_t* offset = new uint64_t[core_count];
+    ArielBatchBuilder* batches = new ArielBatchBuilder[core_count];
+
+    for (uint32_t i = 0; i < core_count; i++) {
+        // xorshift state must not be zero
+        rng[i] = (seed + 1) * 0x9E3779B97F4A7C15ULL + i;
+        offset[i] = 0;
+    }
+
+    // Hand out one block at a time so every core has work while the
+    // queue of another is full
+    for (uint64_t done = 0; done < instructions; done += block_size) {
+        const uint64_t count = std::min((uint64_t) block_size, instructions - done);
+
+        for (uint32_t i = 0; i < core_count; i++) {
+            generateCore(i, count, rng[i], offset[i], batches[i]);
+        }
+    }
+
+    ArielCommand ac;
+    ac.command = ARIEL_PERFORM_EXIT;
+    ac.instPtr = 0;
+    tunnel->writeMessage(0, ac);
+
+    delete[] batches;
+    delete[] offset;
+    delete[] rng;
+}
+
+void SyntheticFrontend::generateCore(uint32_t core, uint64_t count, uint64_t& rng, uint64_t& offset, ArielBatchBuilder& batch) {
+    const uint64_t base = ((uint64_t) core + 1) << 32;
+    uint8_t payload[ARIEL_MAX_PAYLOAD_SIZE];
+
+    ArielCommand ac;
+    ac.instPtr = 0;
+
+    for (uint64_t n = 0; n < count; n++) {
+        rng ^= rng << 13;
+        rng ^= rng >> 7;
+        rng ^= rng << 17;
+
+        const double pick = (double) (rng >> 11) / 9007199254740992.0;
+        const uint64_t addr = base + offset;
+        const bool is_read = pick < read_fraction;
+        const bool is_write = !is_read && pick < (read_fraction + write_fraction);
+
+        if (is_read || is_write) {
+            offset += stride;
+            if (offset + access_size > footprint) {
+                offset = 0;
+            }
+        }
+
+        if (is_write) {
+            memset(payload, (int) (rng & 0xFF), sizeof(payload));
+        }
+
+        if (batch_records > 0) {
+            if (is_read || is_write) {
+                if (!batch.fits(addr, access_size, true, is_write && write_payload)) {
+                    sendBatch(core, batch);
+                }
+
+                if (is_read) {
+                    batch.addRead(addr, access_size, true, ARIEL_INST_INT, 1);
+                } else {
+                    batch.addWrite(addr, access_size, write_payload ? payload : NULL, true, ARIEL_INST_INT, 1);
+                }
+            } else {
+                if (!batch.fitsNoOp()) {
+                    sendBatch(core, batch);
+                }
+
+                batch.addNoOp();
+            }
+
+            if (batch.count() >= batch_records) {
+                sendBatch(core, batch);
+            }
+        } else if (is_read || is_write) {
+            ac.command = ARIEL_START_INSTRUCTION;
+            ac.inst.simdElemCount = 1;
+            ac.inst.instClass = ARIEL_INST_INT;
+            tunnel->writeMessage(core, ac);
+
+            ac.command = is_read ? ARIEL_PERFORM_READ : ARIEL_PERFORM_WRITE;
+            ac.inst.addr = addr;
+            ac.inst.size = access_size;
+            if (is_write) {
+                memcpy(ac.inst.payload, payload, std::min((uint32_t) ARIEL_MAX_PAYLOAD_SIZE, access_size));
+            }
+            tunnel->writeMessage(core, ac);
+
+            ac.command = ARIEL_END_INSTRUCTION;
+            tunnel->writeMessage(core, ac);
+        } else {
+            ac.command = ARIEL_NOOP;
+            tunnel->writeMessage(core, ac);
+        }
+    }
+
+    // End of the basic block
+    sendBatch(core, batch);
+}
+
+void SyntheticFrontend::sendBatch(uint32_t core, ArielBatchBuilder& batch) {
+    if (!batch.empty()) {
+        tunnel->writeMessage(core, batch.getCommand());
+        batch.reset();
+    }
+}
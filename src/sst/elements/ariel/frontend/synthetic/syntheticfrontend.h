@@ -0,0 +1,96 @@
+// Copyright 2009-2023 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2023, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#ifndef _H_SYNTHETIC_FRONTEND
+#define _H_SYNTHETIC_FRONTEND
+
+#include <sst/core/sst_config.h>
+#include <sst/core/component.h>
+#include <sst/core/params.h>
+#include <sst/core/interprocess/mmapparent.h>
+
+#include <stdint.h>
+#include <unistd.h>
+
+#include "arielfrontend.h"
+#include "ariel_shmem.h"
+#include "ariel_batch.h"
+
+namespace SST {
+namespace ArielComponent {
+
+/** Drives the Ariel tunnel from a forked child process with a synthetic
+ * instruction stream instead of a Pin traced application. Used to test
+ * and benchmark the tunnel and cores on machines without Pin.
+ */
+class SyntheticFrontend : public ArielFrontend {
+    public:
+
+    /* SST ELI */
+    SST_ELI_REGISTER_SUBCOMPONENT(SyntheticFrontend, "ariel", "frontend.synthetic", SST_ELI_ELEMENT_VERSION(1,0,0), "Ariel frontend generating a synthetic instruction stream, does not require Pin", SST::ArielComponent::ArielFrontend)
+
+    SST_ELI_DOCUMENT_PARAMS(
+        {"verbose", "Verbosity for debugging. Increased numbers for increased verbosity.", "0"},
+        {"instructions", "Number of instructions to generate for each core", "1000000"},
+        {"blocksize", "Instructions per basic block, batches are sent at the end of each block", "8"},
+        {"batchrecords", "Pack up to this many memory operations into each tunnel command (0 = one command per operation)", "0"},
+        {"readfraction", "Fraction of instructions that read memory", "0.5"},
+        {"writefraction", "Fraction of instructions that write memory, the rest are no-ops", "0.25"},
+        {"footprint", "Bytes of memory touched by each core", "1048576"},
+        {"stride", "Bytes between consecutive memory operations of a core", "64"},
+        {"accesssize", "Bytes read or written by each memory operation", "8"},
+        {"writepayload", "Send write payloads, set to 1 when the core has writepayloadtrace enabled", "0"},
+        {"seed", "Seed for choosing the instruction mix", "1"})
+
+    /* Ariel class */
+    SyntheticFrontend(ComponentId_t id, Params& params, uint32_t cores, uint32_t qSize, uint32_t memPool);
+    ~SyntheticFrontend();
+    virtual void emergencyShutdown();
+    virtual void init(unsigned int phase);
+    virtual void setup() {}
+    virtual void finish();
+    virtual ArielTunnel* getTunnel();
+
+    private:
+
+    void generate();
+    void generateCore(uint32_t core, uint64_t count, uint64_t& rng, uint64_t& offset, ArielBatchBuilder& batch);
+    void sendBatch(uint32_t core, ArielBatchBuilder& batch);
+
+    SST::Output* output;
+
+    pid_t child_pid;
+
+    uint32_t core_count;
+    SST::Core::Interprocess::MMAPParent<ArielTunnel>* tunnelmgr;
+
+    ArielTunnel* tunnel;
+
+    uint64_t instructions;
+    uint32_t block_size;
+    uint32_t batch_records;
+    double read_fraction;
+    double write_fraction;
+    uint64_t footprint;
+    uint64_t stride;
+    uint32_t access_size;
+    bool write_payload;
+    uint64_t seed;
+};
+
+}
+}
+
+#endif
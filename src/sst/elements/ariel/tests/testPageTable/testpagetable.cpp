@@ -0,0 +1,130 @@
+// Copyright 2009-2023 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2023, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+// Checks ArielPageTable and ArielTLB on their own, they need no SST core.
+// Prints one line per check and exits non-zero if any fails.
+
+#include <stdio.h>
+#include <inttypes.h>
+
+#include <unordered_map>
+
+#include "arielpagetable.h"
+
+using namespace SST::ArielComponent;
+
+static int failures = 0;
+
+static void check(const bool ok, const char* what) {
+    printf("%s: %s\n", ok ? "PASS" : "FAIL", what);
+    if (!ok) {
+        failures++;
+    }
+}
+
+static bool translatesTo(const ArielPageTable& table, const uint64_t virtAddr, const uint64_t expected) {
+    uint64_t physAddr = 0;
+    return table.lookup(virtAddr, physAddr) && (physAddr == expected);
+}
+
+static void testPageTable() {
+    const uint64_t page4K = 4096;
+    const uint64_t page2M = 2ULL * 1024 * 1024;
+    const uint64_t page1G = 1024ULL * 1024 * 1024;
+
+    ArielPageTable table(page4K);
+
+    check(table.spanBytes(0) == page4K && table.spanBytes(1) == page2M && table.spanBytes(2) == page1G,
+        "4K base pages give 2M and 1G leaves at depths 1 and 2");
+
+    uint64_t physAddr = 0;
+    check(!table.lookup(0x1000, physAddr), "lookup in an empty table misses");
+
+    // One page of each size, well apart
+    const uint64_t virt4K = 0x7f0000001000ULL;
+    const uint64_t virt2M = 0x7f0000200000ULL;
+    const uint64_t virt1G = 0x40000000ULL;
+
+    check(table.map(virt4K, 0x10000, 0), "map a 4K page");
+    check(table.map(virt2M, 0x20000000, 1), "map a 2M page");
+    check(table.map(virt1G, 0x80000000ULL, 2), "map a 1G page");
+
+    check(translatesTo(table, virt4K, 0x10000) && translatesTo(table, virt4K + 0xabc, 0x10abc),
+        "4K page translates with its offset");
+    check(!table.lookup(virt4K + page4K, physAddr), "the page after the 4K page is unmapped");
+    check(translatesTo(table, virt2M + 0x12345, 0x20012345) && translatesTo(table, virt2M + page2M - 1, 0x20000000 + page2M - 1),
+        "2M page translates across its whole span");
+    check(translatesTo(table, virt1G + 0x3456789, 0x83456789ULL), "1G page translates with its offset");
+
+    check(table.leafCount(0) == 1 && table.leafCount(1) == 1 && table.leafCount(2) == 1, "one leaf of each size");
+    check(table.size() == 1 + 512 + 512 * 512, "size counts base pages");
+
+    check(!table.map(virt2M + page4K, 0x30000, 0), "a 4K page inside the 2M page is rejected");
+    check(!table.map(virt2M & ~(page1G - 1), 0x40000000ULL, 2), "a 1G page over mapped pages is rejected");
+    check(!table.isUnmapped(virt2M, 1) && table.isUnmapped(virt2M + page2M, 1), "isUnmapped sees the 2M page only");
+
+    std::unordered_map<uint64_t, uint64_t> flat;
+    table.exportTo(&flat);
+    check(flat.size() == table.size() && flat[virt2M + 5 * page4K] == 0x20000000 + 5 * page4K,
+        "exportTo flattens every leaf into base pages");
+
+    check(!table.unmap(virt2M, 0), "unmap at the wrong size fails");
+    check(table.unmap(virt2M, 1), "unmap the 2M page");
+    check(!table.lookup(virt2M + 0x12345, physAddr), "the 2M page no longer translates");
+    check(table.map(virt2M + page4K, 0x30000, 0), "a 4K page can reuse the freed 2M range");
+    check(table.unmap(virt4K, 0) && table.unmap(virt1G, 2), "unmap the 4K and 1G pages");
+    check(!table.unmap(virt4K, 0), "unmap of an unmapped page fails");
+    check(table.size() == 1 && table.leafCount(2) == 0, "counts follow unmaps");
+}
+
+static void testTLB() {
+    const uint64_t page4K = 4096;
+
+    ArielTLB tlb(4, page4K);
+    uint64_t physAddr = 0;
+
+    check(tlb.capacity() == 4, "TLB capacity");
+    check(!tlb.lookup(0x1000, physAddr), "empty TLB misses");
+
+    check(!tlb.insert(0x1234, 0x9234), "insert into an empty slot evicts nothing");
+    check(tlb.lookup(0x1000, physAddr) && physAddr == 0x9000, "hit on the start of the granule");
+    check(tlb.lookup(0x1ff8, physAddr) && physAddr == 0x9ff8, "hit anywhere in the granule");
+    check(!tlb.lookup(0x2000, physAddr), "miss on the next granule");
+
+    // 0x5000 maps to the same slot as 0x1000 in a four entry TLB
+    check(tlb.insert(0x5000, 0xa000), "conflicting insert evicts");
+    check(!tlb.lookup(0x1000, physAddr) && tlb.lookup(0x5010, physAddr) && physAddr == 0xa010,
+        "only the new translation remains");
+
+    tlb.insert(0x2000, 0xb000);
+    tlb.flush();
+    check(!tlb.lookup(0x5000, physAddr) && !tlb.lookup(0x2000, physAddr), "flush invalidates every entry");
+
+    std::unordered_map<uint64_t, uint64_t> entries;
+    tlb.insert(0x3000, 0xc000);
+    tlb.exportTo(&entries);
+    check(entries.size() == 1 && entries[0x3000] == 0xc000, "exportTo lists the valid entries");
+
+    ArielTLB disabled(0, page4K);
+    check(!disabled.insert(0x1000, 0x2000) && !disabled.lookup(0x1000, physAddr), "a zero entry TLB never hits");
+}
+
+int main() {
+    testPageTable();
+    testTLB();
+
+    printf("%d failures\n", failures);
+    return (0 == failures) ? 0 : 1;
+}
@@ -3,6 +3,18 @@
 from sst_unittest import *
 from sst_unittest_support import *
 import os
+import re
+
+# Returns the Sum of the named statistic in SST console output, or None
+def ariel_stat_sum(sst_outfile, stat_name):
+    with open(sst_outfile) as f:
+        for line in f:
+            fields = line.split(" : ")
+            if len(fields) >= 3 and fields[0].strip() == stat_name:
+                match = re.match(r"Sum\.\w+ = (\d+);", fields[2].strip())
+                if match:
+                    return int(match.group(1))
+    return None
 
 ################################################################################
 # Code to support a single instance module initialize, must be called setUp method
@@ -77,6 +89,49 @@ class testcase_Ariel(SSTTestCase):
     @unittest.skipIf(not pin_loaded, "Ariel: Requires PIN, but Env Var 'INTEL_PIN_DIRECTORY' is not found or path does not exist.")
     def test_Ariel_test_snb_mlm(self):
         self.ariel_Template("ariel_snb_mlm", app="stream_mlm")
+
+    # Unit test of the page table and TLB headers, runs without SST or PIN
+    def test_Ariel_pagetable(self):
+        test_path = self.get_testsuite_dir()
+        outdir = self.get_test_output_run_dir()
+        pagetabledir = "{0}/testPageTable".format(test_path)
+        outfile = "{0}/test_Ariel_pagetable.out".format(outdir)
+
+        cmd = "make testpagetable"
+        rtn = OSCommand(cmd, set_cwd=pagetabledir).run()
+        log_debug("Ariel tests/testPageTable make result = {0}; output =\n{1}".format(rtn.result(), rtn.output()))
+        self.assertTrue(rtn.result() == 0, "testpagetable.cpp failed to compile")
+
+        cmd = "{0}/testpagetable".format(pagetabledir)
+        rtn = OSCommand(cmd, output_file_path=outfile).run()
+        self.assertTrue(rtn.result() == 0, "Ariel page table unit test failed, see {0}".format(outfile))
+
+    # The synthetic frontend needs no PIN. Core 0 sends the exit, so it
+    # runs its whole stream and its counts are known exactly, whether the
+    # stream is batched or sent one command per operation.
+    def test_Ariel_synthetic_unbatched(self):
+        self.ariel_synthetic_Template(0)
+
+    def test_Ariel_synthetic_batched(self):
+        self.ariel_synthetic_Template(32)
+
+    # Records the batched synthetic run and replays it, core 0 must see
+    # the same stream again
+    def test_Ariel_synthetic_record_replay(self):
+        outdir = self.get_test_output_run_dir()
+        prefix = "{0}/test_Ariel_synthetic_record".format(outdir)
+        self.ariel_synthetic_Template(32, recordstream=prefix)
+
+        for core in range(2):
+            self.assertTrue(os.path.isfile("{0}-{1}.arielcmd".format(prefix, core)), "Ariel did not record a command stream for core {0}".format(core))
+
+        test_path = self.get_testsuite_dir()
+        sdlfile = "{0}/../frontend/replay/examples/replay.py".format(test_path)
+        outfile = "{0}/test_Ariel_synthetic_replay.out".format(outdir)
+        errfile = "{0}/test_Ariel_synthetic_replay.err".format(outdir)
+        self.run_sst(sdlfile, outfile, errfile, set_cwd=outdir, other_args="--model-options=\"{0} 2\"".format(prefix))
+
+        self.ariel_synthetic_check("test_Ariel_synthetic_replay", outfile)
 #####
 
     def ariel_Template(self, testcase, app="", testtimeout=480):
@@ -160,6 +215,39 @@ class testcase_Ariel(SSTTestCase):
         if line_count_diff > 15:
             self.assertFalse(line_count_diff > 15, "Line count between output file {0} does not match Reference File {1}; They contain {2} different lines".format(outfile, reffile, line_count_diff))
 
+    def ariel_synthetic_Template(self, batchrecords, recordstream=""):
+        test_path = self.get_testsuite_dir()
+        outdir = self.get_test_output_run_dir()
+
+        sdlfile = "{0}/../frontend/synthetic/examples/synthetic.py".format(test_path)
+        testDataFileName = "test_Ariel_synthetic_{0}{1}".format(batchrecords, "_record" if recordstream else "")
+        outfile = "{0}/{1}.out".format(outdir, testDataFileName)
+        errfile = "{0}/{1}.err".format(outdir, testDataFileName)
+
+        self.run_sst(sdlfile, outfile, errfile, set_cwd=outdir, other_args="--model-options=\"{0} {1}\"".format(batchrecords, recordstream))
+
+        self.ariel_synthetic_check(testDataFileName, outfile)
+
+    def ariel_synthetic_check(self, testDataFileName, outfile):
+        # The stream synthetic.py asks for, see SyntheticFrontend::generateCore
+        instructions = 200000
+        rng = ((1 + 1) * 0x9E3779B97F4A7C15 + 0) & 0xFFFFFFFFFFFFFFFF
+        reads = 0
+        writes = 0
+        for n in range(instructions):
+            rng ^= (rng << 13) & 0xFFFFFFFFFFFFFFFF
+            rng ^= rng >> 7
+            rng ^= (rng << 17) & 0xFFFFFFFFFFFFFFFF
+            pick = (rng >> 11) / 9007199254740992.0
+            if pick < 0.5:
+                reads += 1
+            elif pick < 0.75:
+                writes += 1
+
+        for (stat, expected) in [ ("instruction_count", instructions), ("read_requests", reads), ("write_requests", writes) ]:
+            value = ariel_stat_sum(outfile, "a0.{0}.0".format(stat))
+            self.assertEqual(value, expected, "Ariel synthetic test {0} reported {1} = {2}, expected {3}".format(testDataFileName, stat, value, expected))
+
 #######################
 
     def _setup_ariel_test_files(self):
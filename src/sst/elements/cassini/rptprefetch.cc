@@ -0,0 +1,194 @@
+// Copyright 2009-2023 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2023, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#include "sst_config.h"
+#include "rptprefetch.h"
+
+#include <vector>
+#include "stdlib.h"
+
+#include "sst/core/params.h"
+
+using namespace SST;
+using namespace SST::Cassini;
+
+void RPTPrefetcher::notifyAccess(const CacheListenerNotification& notify) {
+    const NotifyAccessType notifyType = notify.getAccessType();
+    const Addr addr = notify.getPhysicalAddress();
+    const Addr instPtr = notify.getInstructionPointer();
+
+    if (notifyType != READ && notifyType != WRITE)
+        return;
+
+    RPTEntry& entry = table[hashIndex(instPtr, tableMask)];
+
+    if(!entry.valid || entry.instPtr != instPtr) {
+        output->verbose(CALL_INFO, 4, 0, "Allocate table entry for IP %" PRIx64 ", address %" PRIx64 "\n", instPtr, addr);
+        statTableAllocations->addData(1);
+
+        entry.valid = true;
+        entry.instPtr = instPtr;
+        entry.lastAddr = addr;
+        entry.stride = 0;
+        entry.confidence = 0;
+        return;
+    }
+
+    const int64_t stride = (int64_t) (addr - entry.lastAddr);
+    entry.lastAddr = addr;
+
+    // Repeated accesses to the same address neither confirm nor break a stride
+    if(0 == stride)
+        return;
+
+    if(stride == entry.stride) {
+        if(entry.confidence < confidenceMax)
+            entry.confidence++;
+    } else {
+        if(entry.confidence > 0)
+            entry.confidence--;
+
+        if(0 == entry.confidence)
+            entry.stride = stride;
+
+        return;
+    }
+
+    if(entry.confidence < confidenceThreshold)
+        return;
+
+    statPrefetchOpportunities->addData(1);
+
+    // Strides within a line still move forward by a whole line per prefetch
+    const int64_t lineStride = (entry.stride < (int64_t) blockSize && entry.stride > -((int64_t) blockSize)) ?
+        ((entry.stride > 0) ? (int64_t) blockSize : -((int64_t) blockSize)) : entry.stride;
+
+    const Addr accessLine = addr - (addr % blockSize);
+    Addr previousLine = accessLine;
+
+    for(uint32_t i = 0; i < degree; ++i) {
+        const Addr target = addr + (Addr) (lineStride * (int64_t) (distance + i));
+        const Addr targetLine = target - (target % blockSize);
+
+        if(targetLine != previousLine) {
+            issuePrefetch(addr, targetLine);
+            previousLine = targetLine;
+        }
+    }
+}
+
+void RPTPrefetcher::issuePrefetch(const Addr accessAddr, const Addr prefetchAddr) {
+    if(!overrunPageBoundary && (accessAddr / pageSize) != (prefetchAddr / pageSize)) {
+        output->verbose(CALL_INFO, 2, 0, "Cancel prefetch issue, %" PRIx64 " is not on the page of %" PRIx64 "\n",
+            prefetchAddr, accessAddr);
+        statPrefetchIssueCanceledByPageBoundary->addData(1);
+        return;
+    }
+
+    if(!filter.empty()) {
+        Addr& filterEntry = filter[hashIndex(prefetchAddr / blockSize, filterMask)];
+
+        if(filterEntry == prefetchAddr) {
+            output->verbose(CALL_INFO, 2, 0, "Prefetch canceled - line %" PRIx64 " is in the recent prefetch filter.\n",
+                prefetchAddr);
+            statPrefetchIssueCanceledByHistory->addData(1);
+            return;
+        }
+
+        filterEntry = prefetchAddr;
+    }
+
+    output->verbose(CALL_INFO, 2, 0, "Issue prefetch, target address: %" PRIx64 ", prefetch address: %" PRIx64 "\n",
+        accessAddr, prefetchAddr);
+    statPrefetchEventsIssued->addData(1);
+
+    std::vector<Event::HandlerBase*>::iterator callbackItr;
+
+    // Cycle over each registered call back and notify them that we want to issue a prefetch request
+    for(callbackItr = registeredCallbacks.begin(); callbackItr != registeredCallbacks.end(); callbackItr++) {
+        // Create a new read request, we cannot issue a write because the data will get
+        // overwritten and corrupt memory (even if we really do want to do a write)
+        MemEvent* newEv = new MemEvent(getName(), prefetchAddr, prefetchAddr, Command::GetS);
+        newEv->setSize(blockSize);
+        newEv->setPrefetchFlag(true);
+
+        (*(*callbackItr))(newEv);
+    }
+}
+
+RPTPrefetcher::RPTPrefetcher(ComponentId_t id, Params& params) : CacheListener(id, params) {
+    requireLibrary("memHierarchy");
+
+    const int verbosity = params.find<int>("verbose", 0);
+
+    char* new_prefix = (char*) malloc(sizeof(char) * 128);
+    snprintf(new_prefix, sizeof(char)*128, "RPTPrefetcher[%s | @f:@p:@l] ", getName().c_str());
+    output = new Output(new_prefix, verbosity, 0, Output::STDOUT);
+    free(new_prefix);
+
+    blockSize = params.find<uint64_t>("cache_line_size", 64);
+    pageSize = params.find<uint64_t>("page_size", 4096);
+    overrunPageBoundary = (params.find<uint32_t>("overrun_page_boundaries", 0) != 0);
+
+    confidenceThreshold = params.find<uint32_t>("confidence_threshold", 2);
+    confidenceMax = params.find<uint32_t>("confidence_max", 3);
+    degree = params.find<uint32_t>("degree", 2);
+    distance = params.find<uint32_t>("distance", 1);
+
+    if(0 == blockSize) {
+        output->fatal(CALL_INFO, -1, "%s, Error: cache_line_size must be greater than zero\n", getName().c_str());
+    }
+
+    if(confidenceThreshold > confidenceMax) {
+        output->fatal(CALL_INFO, -1, "%s, Error: confidence_threshold (%" PRIu32 ") cannot exceed confidence_max (%" PRIu32 ")\n",
+            getName().c_str(), confidenceThreshold, confidenceMax);
+    }
+
+    const uint64_t tableEntries = roundUpPowerOfTwo(params.find<uint64_t>("table_entries", 256));
+    RPTEntry emptyEntry = { 0, 0, 0, 0, false };
+
+    table.resize(tableEntries, emptyEntry);
+    tableMask = tableEntries - 1;
+
+    const uint64_t filterEntries = params.find<uint64_t>("filter_entries", 256);
+
+    if(filterEntries > 0) {
+        // Address 1 is never a line address, so it marks an empty filter slot
+        filter.resize(roundUpPowerOfTwo(filterEntries), (Addr) 1);
+        filterMask = filter.size() - 1;
+    } else {
+        filterMask = 0;
+    }
+
+    output->verbose(CALL_INFO, 1, 0, "RPTPrefetcher created, cache line: %" PRIu64 ", page size: %" PRIu64 ", table entries: %" PRIu64 ", degree: %" PRIu32 ", distance: %" PRIu32 "\n",
+        blockSize, pageSize, tableEntries, degree, distance);
+
+    statPrefetchOpportunities = registerStatistic<uint64_t>("prefetch_opportunities");
+    statPrefetchEventsIssued = registerStatistic<uint64_t>("prefetches_issued");
+    statPrefetchIssueCanceledByPageBoundary = registerStatistic<uint64_t>("prefetches_canceled_by_page_boundary");
+    statPrefetchIssueCanceledByHistory = registerStatistic<uint64_t>("prefetches_canceled_by_history");
+    statTableAllocations = registerStatistic<uint64_t>("table_allocations");
+}
+
+RPTPrefetcher::~RPTPrefetcher() {
+    delete output;
+}
+
+void RPTPrefetcher::registerResponseCallback(Event::HandlerBase* handler) {
+    registeredCallbacks.push_back(handler);
+}
+
+void RPTPrefetcher::printStats(Output &out) {
+}
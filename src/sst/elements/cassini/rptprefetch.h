@@ -0,0 +1,141 @@
+// Copyright 2009-2023 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2023, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+
+#ifndef _H_SST_RPT_PREFETCH
+#define _H_SST_RPT_PREFETCH
+
+#include <vector>
+
+#include <sst/core/event.h>
+#include <sst/core/sst_types.h>
+#include <sst/core/component.h>
+#include <sst/core/link.h>
+#include <sst/core/timeConverter.h>
+#include <sst/elements/memHierarchy/memEvent.h>
+#include <sst/elements/memHierarchy/cacheListener.h>
+
+#include <sst/core/output.h>
+
+using namespace SST;
+using namespace SST::MemHierarchy;
+using namespace std;
+
+namespace SST {
+namespace Cassini {
+
+/*
+ * Reference prediction table stride prefetcher. A direct-mapped table
+ * indexed by the instruction pointer of each access keeps the last address,
+ * stride and a saturating confidence for that instruction, so interleaved
+ * streams from different loads are tracked separately and every access is
+ * a single table update. Once an entry is confident, degree lines are
+ * prefetched starting distance strides ahead. Lines prefetched recently are
+ * filtered with a direct-mapped hash of line addresses.
+ *
+ * Requests without an instruction pointer all share one entry, which then
+ * behaves as a single global stride detector.
+ */
+class RPTPrefetcher : public SST::MemHierarchy::CacheListener {
+public:
+    RPTPrefetcher(ComponentId_t id, Params& params);
+    ~RPTPrefetcher();
+
+    void notifyAccess(const CacheListenerNotification& notify);
+    void registerResponseCallback(Event::HandlerBase *handler);
+    void printStats(Output &out);
+
+    SST_ELI_REGISTER_SUBCOMPONENT(
+        RPTPrefetcher,
+            "cassini",
+            "RPTPrefetcher",
+            SST_ELI_ELEMENT_VERSION(1,0,0),
+            "Reference Prediction Table (instruction pointer indexed) Stride Prefetcher",
+            SST::MemHierarchy::CacheListener
+    )
+
+    SST_ELI_DOCUMENT_PARAMS(
+        { "verbose", "Controls the verbosity of the Cassini component", "0" },
+        { "cache_line_size", "Size of the cache line the prefetcher is attached to", "64" },
+        { "table_entries", "Number of entries in the reference prediction table, rounded up to a power of two", "256" },
+        { "confidence_threshold", "Number of times a stride must repeat before prefetches are issued", "2" },
+        { "confidence_max", "Saturation value of the per-entry confidence counter", "3" },
+        { "degree", "Number of lines prefetched each time a confident entry is accessed", "2" },
+        { "distance", "How many strides ahead of the access the first prefetch is", "1" },
+        { "filter_entries", "Number of entries in the recent prefetch filter, rounded up to a power of two, 0 disables it", "256" },
+        { "page_size", "Page size for this controller", "4096" },
+        { "overrun_page_boundaries", "Allow prefetcher to run over page boundaries, 0 is no, 1 is yes", "0" }
+    )
+
+    SST_ELI_DOCUMENT_STATISTICS(
+        { "prefetches_issued", "Number of prefetch requests issued", "prefetches", 1 },
+        { "prefetches_canceled_by_page_boundary",
+                "Prefetches which would not be executed because they span over a page boundary.", "prefetches", 1 },
+        { "prefetches_canceled_by_history",
+                "Prefetches which did not get issued because the line was found in the recent prefetch filter", "prefetches", 1 },
+        { "prefetch_opportunities", "Count of accesses to a confident table entry", "prefetches", 1 },
+        { "table_allocations", "Number of times a table entry was allocated to a new instruction pointer", "entries", 2 }
+    )
+
+private:
+    struct RPTEntry {
+        Addr instPtr;
+        Addr lastAddr;
+        int64_t stride;
+        uint32_t confidence;
+        bool valid;
+    };
+
+    static uint64_t hashIndex(const uint64_t key, const uint64_t mask) {
+        return ((key * 0x9E3779B97F4A7C15ULL) >> 32) & mask;
+    }
+
+    static uint64_t roundUpPowerOfTwo(const uint64_t value) {
+        uint64_t result = 1;
+        while(result < value) {
+            result <<= 1;
+        }
+        return result;
+    }
+
+    void issuePrefetch(const Addr accessAddr, const Addr prefetchAddr);
+
+    Output* output;
+    std::vector<Event::HandlerBase*> registeredCallbacks;
+
+    std::vector<RPTEntry> table;
+    uint64_t tableMask;
+    std::vector<Addr> filter;
+    uint64_t filterMask;
+
+    uint64_t blockSize;
+    uint64_t pageSize;
+    bool overrunPageBoundary;
+    uint32_t confidenceThreshold;
+    uint32_t confidenceMax;
+    uint32_t degree;
+    uint32_t distance;
+
+    Statistic<uint64_t>* statPrefetchOpportunities;
+    Statistic<uint64_t>* statPrefetchEventsIssued;
+    Statistic<uint64_t>* statPrefetchIssueCanceledByPageBoundary;
+    Statistic<uint64_t>* statPrefetchIssueCanceledByHistory;
+    Statistic<uint64_t>* statTableAllocations;
+};
+
+} //namespace Cassini
+} //namespace SST
+
+#endif
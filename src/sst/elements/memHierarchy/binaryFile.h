@@ -0,0 +1,150 @@
+// Copyright 2009-2023 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2023, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#ifndef __SST_MEMH_BINARYFILE__
+#define __SST_MEMH_BINARYFILE__
+
+#include <sst_config.h>
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <string>
+
+#ifdef HAVE_LIBZ
+#include <zlib.h>
+#endif
+
+namespace SST {
+namespace MemHierarchy {
+
+/*
+ * A binary file which is optionally gzip compressed, shared by the
+ * checkpoint and commit trace formats. Writes may be compressed when
+ * SST was built with libz, and reads detect compression so both kinds of
+ * file are read the same way. Any failed or short read or write clears
+ * good(), which stays false, so writers can check once after a batch of
+ * writes or at close.
+ */
+class BinaryFile {
+public:
+    static bool compressionAvailable() {
+#ifdef HAVE_LIBZ
+        return true;
+#else
+        return false;
+#endif
+    }
+
+    BinaryFile() : fp(nullptr), ok(true) {
+#ifdef HAVE_LIBZ
+        gz = nullptr;
+#endif
+    }
+
+    ~BinaryFile() { close(); }
+
+    bool openWrite(const std::string& path, const bool compress) {
+        ok = true;
+#ifdef HAVE_LIBZ
+        if ( compress ) {
+            // speed matters more than ratio
+            gz = gzopen(path.c_str(), "wb1");
+            return nullptr != gz;
+        }
+#endif
+        fp = fopen(path.c_str(), "wb");
+        return nullptr != fp;
+    }
+
+    bool openRead(const std::string& path) {
+        ok = true;
+#ifdef HAVE_LIBZ
+        // gzread passes uncompressed files through unchanged
+        gz = gzopen(path.c_str(), "rb");
+        if ( nullptr != gz ) { gzbuffer(gz, 1 << 20); }
+        return nullptr != gz;
+#else
+        fp = fopen(path.c_str(), "rb");
+        return nullptr != fp;
+#endif
+    }
+
+    // Returns good(), a compressed file is only complete once it is closed
+    bool close() {
+        if ( nullptr != fp ) {
+            ok = (0 == fclose(fp)) && ok;
+            fp = nullptr;
+        }
+#ifdef HAVE_LIBZ
+        if ( nullptr != gz ) {
+            ok = (Z_OK == gzclose(gz)) && ok;
+            gz = nullptr;
+        }
+#endif
+        return ok;
+    }
+
+    // False once any read or write has failed (short file, disk full)
+    bool good() const { return ok; }
+
+    // For formats which find the contents are corrupt
+    void invalidate() { ok = false; }
+
+    void writeBytes(const void* data, const size_t length) {
+        if ( 0 == length ) { return; }
+#ifdef HAVE_LIBZ
+        if ( nullptr != gz ) {
+            ok = ((int)length == gzwrite(gz, data, (unsigned)length)) && ok;
+            return;
+        }
+#endif
+        ok = (nullptr != fp) && (1 == fwrite(data, length, 1, fp)) && ok;
+    }
+
+    // Reads exactly length bytes, on failure data is zeroed and false returned
+    bool readBytes(void* data, const size_t length) {
+        if ( 0 == length ) { return true; }
+        if ( length != readSome(data, length) ) {
+            memset(data, 0, length);
+            ok = false;
+            return false;
+        }
+        return true;
+    }
+
+    // Reads up to length bytes, returns how many were read (0 at the end)
+    size_t readSome(void* data, const size_t length) {
+#ifdef HAVE_LIBZ
+        if ( nullptr != gz ) {
+            const int bytes = gzread(gz, data, (unsigned)length);
+            return (bytes > 0) ? (size_t)bytes : 0;
+        }
+#endif
+        return (nullptr != fp) ? fread(data, 1, length, fp) : 0;
+    }
+
+private:
+    FILE* fp;
+#ifdef HAVE_LIBZ
+    gzFile gz;
+#endif
+    bool ok;
+};
+
+} // namespace MemHierarchy
+} // namespace SST
+
+#endif
@@ -0,0 +1,126 @@
+// Copyright 2009-2023 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2023, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#ifndef __SST_MEMH_CHECKPOINTFILE__
+#define __SST_MEMH_CHECKPOINTFILE__
+
+#include <sst_config.h>
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "sst/elements/memHierarchy/binaryFile.h"
+
+namespace SST {
+namespace MemHierarchy {
+
+/*
+ * Binary checkpoint files. Every file starts with a fixed header
+ *
+ *   uint64_t magic    "SSTCKPT\0"
+ *   uint32_t version  CheckpointFile::version
+ *   uint32_t kind     four character tag chosen by the writer ('MEMI', 'CORE', ...)
+ *
+ * followed by the writer's records in host byte order. Files may be gzip
+ * compressed (see BinaryFile), a compressed and an uncompressed file are
+ * restored the same way.
+ */
+class CheckpointFile : public BinaryFile {
+public:
+    static constexpr uint64_t magic   = 0x0054504b43545353ULL;
+    static constexpr uint32_t version = 1;
+
+    static constexpr uint32_t makeKind(const char a, const char b, const char c, const char d) {
+        return ((uint32_t)a << 24) | ((uint32_t)b << 16) | ((uint32_t)c << 8) | (uint32_t)d;
+    }
+
+    // True if path exists and holds a binary checkpoint (of any kind), older
+    // text checkpoints return false so callers can fall back to them
+    static bool isBinary(const std::string& path) {
+        CheckpointFile probe;
+        uint32_t       kind;
+        return probe.openRead(path) && probe.readHeader(kind);
+    }
+
+    bool openWrite(const std::string& path, const uint32_t kind, const bool compress) {
+        if ( !BinaryFile::openWrite(path, compress) ) { return false; }
+
+        write<uint64_t>(magic);
+        write<uint32_t>(version);
+        write<uint32_t>(kind);
+        return good();
+    }
+
+    // Returns false if the file is not a binary checkpoint or was written
+    // by a different version of the format
+    bool readHeader(uint32_t& kind) {
+        const uint64_t file_magic   = read<uint64_t>();
+        const uint32_t file_version = read<uint32_t>();
+        kind                        = read<uint32_t>();
+        return good() && (magic == file_magic) && (version == file_version);
+    }
+
+    template <typename T>
+    void write(const T value) {
+        writeBytes(&value, sizeof(T));
+    }
+
+    template <typename T>
+    T read() {
+        T value;
+        readBytes(&value, sizeof(T));
+        return value;
+    }
+
+    void writeString(const std::string& str) {
+        write<uint64_t>(str.size());
+        writeBytes(str.data(), str.size());
+    }
+
+    std::string readString() {
+        const uint64_t length = read<uint64_t>();
+        if ( !good() || (length > max_string) ) {
+            invalidate();
+            return std::string();
+        }
+        std::string str(length, '\0');
+        readBytes(&str[0], str.size());
+        return str;
+    }
+
+    template <typename T>
+    void writeVector(const std::vector<T>& vec) {
+        write<uint64_t>(vec.size());
+        writeBytes(vec.data(), vec.size() * sizeof(T));
+    }
+
+    template <typename T>
+    void readVector(std::vector<T>& vec) {
+        const uint64_t count = read<uint64_t>();
+        if ( !good() ) { return; }
+        vec.resize(count);
+        readBytes(vec.data(), count * sizeof(T));
+    }
+
+private:
+    // strings are paths and names, anything longer is a corrupt file
+    static constexpr uint64_t max_string = 1 << 16;
+};
+
+} // namespace MemHierarchy
+} // namespace SST
+
+#endif
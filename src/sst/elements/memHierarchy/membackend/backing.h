@@ -19,7 +19,10 @@
 #include <fcntl.h>
 #include <unistd.h>
 #include <sys/mman.h>
+#include <algorithm>
+#include <unordered_set>
 #include "sst/elements/memHierarchy/util.h"
+#include "sst/elements/memHierarchy/checkpointFile.h"
 
 namespace SST {
 namespace MemHierarchy {
@@ -92,7 +95,7 @@ private:
 #define CHECKPOINT_DBG 0
 class BackingMalloc : public Backing {
 public:
-    BackingMalloc(size_t size, bool init = false ) : m_init(init) {
+    BackingMalloc(size_t size, bool init = false ) : m_init(init), m_trackDirty(false) {
         m_allocUnit = size;
         /* Alloc unit needs to be pwr-2 */
         if (!isPowerOfTwo(m_allocUnit)) {
@@ -102,7 +105,7 @@ public:
         m_shift = log2Of(m_allocUnit);
     }
 
-    BackingMalloc( FILE* fp ) {
+    BackingMalloc( FILE* fp ) : m_trackDirty(false) {
         int num; 
         char str[80];
         fscanf(fp,"Number-of-pages: %d\n", &num );
@@ -148,6 +151,7 @@ public:
         Addr bAddr = addr >> m_shift;
         Addr offset = addr - (bAddr << m_shift);
         allocIfNeeded(bAddr);
+        markDirty(bAddr);
         m_buffer[bAddr][offset] = value;
     }
 
@@ -158,6 +162,7 @@ public:
         size_t dataOffset = 0;
 
         allocIfNeeded(bAddr);
+        markDirty(bAddr);
 
 #if CHECKPOINT_DBG 
         printf("%s() addr=%#lx size=%zu ",__func__,addr,size);
@@ -174,6 +179,7 @@ public:
                 offset = 0;
                 bAddr++;
                 allocIfNeeded(bAddr);
+                markDirty(bAddr);
             }
         }
 #if CHECKPOINT_DBG 
@@ -242,7 +248,68 @@ public:
         }
     }
 
+    /*
+     * Binary checkpoints. A full image holds every page which has been
+     * touched (all-zero pages are left out when the backing is zero
+     * initialized), an incremental image only the pages written since
+     * trackDirty() was called. Images are applied oldest first with load().
+     */
+    void trackDirty() {
+        m_trackDirty = true;
+        m_dirty.clear();
+    }
+
+    void dump( CheckpointFile& out, bool dirtyOnly ) {
+        std::vector<Addr> pages;
+        pages.reserve( dirtyOnly ? m_dirty.size() : m_buffer.size() );
+
+        if ( dirtyOnly ) {
+            pages.assign( m_dirty.begin(), m_dirty.end() );
+        } else {
+            for ( auto const& x : m_buffer ) {
+                if ( m_init && isZero( x.second ) ) continue;
+                pages.push_back( x.first );
+            }
+        }
+
+        std::sort( pages.begin(), pages.end() );
+
+        out.write<uint32_t>( m_allocUnit );
+        out.write<uint64_t>( pages.size() );
+        for ( auto const bAddr : pages ) {
+            out.write<uint64_t>( bAddr << m_shift );
+            out.writeBytes( m_buffer[bAddr], m_allocUnit );
+        }
+    }
+
+    // Returns false if the image is truncated or was saved with a different
+    // allocation unit
+    bool load( CheckpointFile& in ) {
+        if ( in.read<uint32_t>() != m_allocUnit ) return false;
+
+        uint64_t numPages = in.read<uint64_t>();
+        for ( uint64_t i = 0; i < numPages && in.good(); i++ ) {
+            Addr bAddr = in.read<uint64_t>() >> m_shift;
+            allocIfNeeded(bAddr);
+            in.readBytes( m_buffer[bAddr], m_allocUnit );
+        }
+        return in.good();
+    }
+
 private:
+    void markDirty(Addr bAddr) {
+        if ( m_trackDirty ) {
+            m_dirty.insert(bAddr);
+        }
+    }
+
+    bool isZero(const uint8_t* page) const {
+        for ( unsigned int i = 0; i < m_allocUnit; i++ ) {
+            if ( page[i] ) return false;
+        }
+        return true;
+    }
+
     void allocIfNeeded(Addr bAddr) {
         if (m_buffer.find(bAddr) == m_buffer.end()) {
             uint8_t* data = (uint8_t*) malloc(sizeof(uint8_t)*m_allocUnit);
@@ -261,6 +328,8 @@ private:
     unsigned int m_allocUnit;
     unsigned int m_shift;
     bool m_init;
+    bool m_trackDirty;
+    std::unordered_set<Addr> m_dirty;
 };
 
 }
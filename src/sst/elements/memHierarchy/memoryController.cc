@@ -14,6 +14,7 @@
 // distribution.
 
 #include <sst_config.h>
+#include <stdlib.h>
 #include <sst/core/params.h>
 
 #include "memoryController.h"
@@ -94,6 +95,33 @@ MemController::MemController(ComponentId_t id, Params &params) : Component(id),
     // Output for warnings
     out.init("", params.find<int>("verbose", 1), 0, Output::STDOUT);
 
+    std::string format = params.find<std::string>("checkpointFormat", "text");
+    if ( format != "text" && format != "binary" ) {
+        out.fatal(CALL_INFO, -1, "%s, Error - Invalid param: checkpointFormat. Must be 'text' or 'binary'. You specified: %s\n",
+                getName().c_str(), format.c_str());
+    }
+    checkpointBinary_ = ( format == "binary" );
+    checkpointCompress_ = params.find<bool>("checkpointCompress", false);
+    checkpointBaseDir_ = params.find<std::string>("checkpointBaseDir", "");
+
+    if ( checkpointCompress_ && ! CheckpointFile::compressionAvailable() ) {
+        out.verbose(CALL_INFO, 1, 0, "%s, Warning - checkpointCompress requires libz, checkpoints will not be compressed\n", getName().c_str());
+        checkpointCompress_ = false;
+    }
+    if ( ! checkpointBaseDir_.empty() && ( CHECKPOINT_SAVE != checkpoint_ || ! checkpointBinary_ ) ) {
+        out.fatal(CALL_INFO, -1, "%s, Error - checkpointBaseDir requires checkpoint='save' and checkpointFormat='binary'\n", getName().c_str());
+    }
+    if ( ! checkpointBaseDir_.empty() ) {
+        // The saved checkpoint names its base, so record a path which still
+        // works when the chain is loaded from another working directory
+        char* basePath = realpath( checkpointBaseDir_.c_str(), nullptr );
+        if ( nullptr == basePath ) {
+            out.fatal(CALL_INFO, -1, "%s, Error - unable to find checkpointBaseDir %s\n", getName().c_str(), checkpointBaseDir_.c_str());
+        }
+        checkpointBaseDir_ = basePath;
+        free( basePath );
+    }
+
     // Check for deprecated parameters and warn/fatal
     // Currently deprecated - network_num_vc, statistic, direct_link
     bool found;
@@ -326,12 +354,11 @@ MemController::MemController(ComponentId_t id, Params &params) : Component(id),
         }
     } else if (backingType == "malloc") {
         if ( CHECKPOINT_LOAD == checkpoint_ ) {
-            stringstream filename;
-            filename << checkpointDir_ << "/" << getName();
-            //printf("%s\n",filename.str().c_str());
-            auto fp = fopen(filename.str().c_str(),"r");
-            assert(fp);
-            backing_ = new Backend::BackingMalloc(fp);
+            backing_ = loadCheckpoint( checkpointDir_, sizeBytes, initBacking );
+        } else if ( ! checkpointBaseDir_.empty() ) {
+            auto backing = loadCheckpoint( checkpointBaseDir_, sizeBytes, initBacking );
+            backing->trackDirty();
+            backing_ = backing;
         } else {
             backing_ = new Backend::BackingMalloc(sizeBytes,initBacking);
         }
@@ -604,13 +631,74 @@ void MemController::finish(void) {
     memBackendConvertor_->finish(cycle);
     link_->finish();
     if ( CHECKPOINT_SAVE ==  checkpoint_ ) {
-        stringstream filename;
-        filename << checkpointDir_ << "/" << getName();
+        saveCheckpoint();
+    }
+}
+
+/*
+ * Binary checkpoints name the checkpoint they are relative to (empty for a
+ * full image), so restoring walks back to the full image and applies the
+ * incremental ones on top of it, oldest first.
+ */
+Backend::BackingMalloc* MemController::loadCheckpoint( std::string dir, size_t allocUnit, bool init ) {
+    stringstream filename;
+    filename << dir << "/" << getName();
+
+    if ( ! CheckpointFile::isBinary( filename.str() ) ) {
+        auto fp = fopen(filename.str().c_str(),"r");
+        if ( nullptr == fp ) {
+            out.fatal(CALL_INFO, -1, "%s, Error - unable to open checkpoint %s\n", getName().c_str(), filename.str().c_str());
+        }
+        auto backing = new Backend::BackingMalloc(fp);
+        fclose( fp );
+        return backing;
+    }
+
+    CheckpointFile in;
+    uint32_t kind;
+    if ( ! in.openRead( filename.str() ) || ! in.readHeader( kind ) || checkpointKind_ != kind ) {
+        out.fatal(CALL_INFO, -1, "%s, Error - %s is not a memory checkpoint\n", getName().c_str(), filename.str().c_str());
+    }
+
+    std::string base = in.readString();
+    auto backing = base.empty() ? new Backend::BackingMalloc(allocUnit,init) : loadCheckpoint( base, allocUnit, init );
+
+    if ( ! backing->load( in ) ) {
+        out.fatal(CALL_INFO, -1, "%s, Error - checkpoint %s is truncated or was saved with a different backing_size_unit\n",
+                getName().c_str(), filename.str().c_str());
+    }
+    return backing;
+}
+
+void MemController::saveCheckpoint() {
+    stringstream filename;
+    filename << checkpointDir_ << "/" << getName();
+    printf("Checkpoint component `%s` %s\n",getName().c_str(), filename.str().c_str());
+
+    if ( ! checkpointBinary_ ) {
         auto fp = fopen(filename.str().c_str(),"w+");
         assert(fp);
-        printf("Checkpoint component `%s` %s\n",getName().c_str(), filename.str().c_str());
         backing_->dump( fp );
         fclose( fp );
+        return;
+    }
+
+    auto backing = dynamic_cast<Backend::BackingMalloc*>(backing_);
+    if ( nullptr == backing ) {
+        out.fatal(CALL_INFO, -1, "%s, Error - binary checkpoints require 'malloc' backing\n", getName().c_str());
+    }
+
+    CheckpointFile ckpt;
+    if ( ! ckpt.openWrite( filename.str(), checkpointKind_, checkpointCompress_ ) ) {
+        out.fatal(CALL_INFO, -1, "%s, Error - unable to create checkpoint %s\n", getName().c_str(), filename.str().c_str());
+    }
+
+    ckpt.writeString( checkpointBaseDir_ );
+    backing->dump( ckpt, ! checkpointBaseDir_.empty() );
+    ckpt.close();
+
+    if ( ! ckpt.good() ) {
+        out.fatal(CALL_INFO, -1, "%s, Error - failed writing checkpoint %s\n", getName().c_str(), filename.str().c_str());
     }
 }
 
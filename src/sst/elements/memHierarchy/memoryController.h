@@ -57,7 +57,12 @@ public:
             {"addr_range_end",      "(uint) Highest address handled by this memory.", "uint64_t-1"},\
             {"interleave_size",     "(string) Size of interleaved chunks. E.g., to interleave 8B chunks among 3 memories, set size=8B, step=24B", "0B"},\
             {"interleave_step",     "(string) Distance between interleaved chunks. E.g., to interleave 8B chunks among 3 memories, set size=8B, step=24B", "0B"},\
-            {"customCmdMemHandler", "(string) Name of the custom command handler to load", ""}
+            {"customCmdMemHandler", "(string) Name of the custom command handler to load", ""},\
+            {"checkpoint",          "(string) 'save' writes the memory image to checkpointDir at the end of simulation, 'load' restores it from there. Requires 'malloc' backing", ""},\
+            {"checkpointDir",       "(string) Directory holding the checkpoint", ""},\
+            {"checkpointFormat",    "(string) Format of saved checkpoints, 'text' or 'binary'. Loads detect the format", "text"},\
+            {"checkpointCompress",  "(bool) Compress binary checkpoints (requires SST built with libz)", "false"},\
+            {"checkpointBaseDir",   "(string) When saving a binary checkpoint, first restore memory from this checkpoint and then save only the pages written since. The base is recorded as an absolute path. Loading the result also loads its base", ""}
 
     SST_ELI_DOCUMENT_PARAMS( MEMCONTROLLER_ELI_PARAMS )
 
@@ -142,6 +147,13 @@ protected:
 
     std::string checkpointDir_;
     enum { NO_CHECKPOINT, CHECKPOINT_LOAD, CHECKPOINT_SAVE }  checkpoint_;
+    std::string checkpointBaseDir_;
+    bool checkpointBinary_;
+    bool checkpointCompress_;
+
+    static constexpr uint32_t checkpointKind_ = CheckpointFile::makeKind('M','E','M','I');
+    Backend::BackingMalloc* loadCheckpoint( std::string dir, size_t allocUnit, bool init );
+    void saveCheckpoint();
 
     size_t memSize_;
 
@@ -108,6 +108,9 @@ hr_router::~hr_router()
     delete [] in_port_busy;
     delete [] out_port_busy;
     delete [] progress_vcs;
+    delete [] in_port_release;
+    delete [] out_port_release;
+    delete [] port_vcs_with_data;
 
     for ( int i = 0 ; i < num_ports ; i++ ) {
         delete ports[i];
@@ -121,6 +124,7 @@ hr_router::~hr_router()
 hr_router::hr_router(ComponentId_t cid, Params& params) :
     Router(cid),
     num_vcs(-1),
+    current_cycle(0),
     output(getSimulationOutput())
 {
 
@@ -230,6 +234,12 @@ hr_router::hr_router(ComponentId_t cid, Params& params) :
 
     progress_vcs = new int[num_ports];
 
+    in_port_release = new Cycle_t[num_ports];
+    out_port_release = new Cycle_t[num_ports];
+    port_vcs_with_data = new int[num_ports];
+    port_is_active.resize(num_ports, false);
+    active_ports.reserve(num_ports);
+
     std::string inspector_config = params.find<std::string>("network_inspectors", "");
     split(inspector_config,",",inspector_names);
 
@@ -249,6 +259,9 @@ hr_router::hr_router(ComponentId_t cid, Params& params) :
         in_port_busy[i] = 0;
         out_port_busy[i] = 0;
         progress_vcs[i] = -1;
+        in_port_release[i] = 0;
+        out_port_release[i] = 0;
+        port_vcs_with_data[i] = 0;
 
         std::stringstream port_name;
         port_name << "port";
@@ -327,22 +340,34 @@ hr_router::notifyEvent()
 
 
 #if !VERIFY_DECLOCKING
-    // Fix up the busy variables
-    for ( int i = 0; i < num_ports; i++ ) {
-    	// Should stop at zero, need to find a clean way to do this
-    	// with no branch.  For now it should work.
-        int64_t tmp = in_port_busy[i] - elapsed_cycles;
-    	if ( tmp < 0 ) in_port_busy[i] = 0;
-        else in_port_busy[i] = tmp;
-        tmp = out_port_busy[i] - elapsed_cycles;
-    	if ( tmp < 0 ) out_port_busy[i] = 0;
-        else out_port_busy[i] = tmp;
+    // Fix up the busy variables.  Only ports on the active list can
+    // have non-zero busy values.
+    for ( int port : active_ports ) {
+        if ( in_port_busy[port] != 0 && in_port_release[port] <= next_cycle ) in_port_busy[port] = 0;
+        if ( out_port_busy[port] != 0 && out_port_release[port] <= next_cycle ) out_port_busy[port] = 0;
     }
 #endif
     // Report skipped cycles to arbitration unit.
     arb->reportSkippedCycles(elapsed_cycles);
 }
 
+void
+hr_router::inc_port_vcs_with_data(int port)
+{
+    vcs_with_data++;
+    port_vcs_with_data[port]++;
+    activatePort(port);
+}
+
+void
+hr_router::dec_port_vcs_with_data(int port)
+{
+    // Port is removed from the active list lazily by the clock
+    // handler once its busy values have also cleared
+    vcs_with_data--;
+    port_vcs_with_data[port]--;
+}
+
 void
 hr_router::sigHandler(int signal)
 {
@@ -355,8 +380,8 @@ hr_router::dumpState(std::ostream& stream)
     stream << "Router id: " << id << std::endl;
     for ( int i = 0; i < num_ports; i++ ) {
 	ports[i]->dumpState(stream);
-	stream << "  Output_busy: " << out_port_busy[i] << std::endl;
-	stream << "  Input_Busy: " <<  in_port_busy[i] << std::endl;
+	stream << "  Output_busy: " << getBusyRemaining(out_port_busy[i],out_port_release[i]) << std::endl;
+	stream << "  Input_Busy: " <<  getBusyRemaining(in_port_busy[i],in_port_release[i]) << std::endl;
     }
 
 }
@@ -366,7 +391,8 @@ hr_router::printStatus(Output& out)
 {
     out.output("Start Router:  id = %d\n", id);
     for ( int i = 0; i < num_ports; i++ ) {
-        ports[i]->printStatus(out, out_port_busy[i], in_port_busy[i]);
+        ports[i]->printStatus(out, getBusyRemaining(out_port_busy[i],out_port_release[i]),
+                              getBusyRemaining(in_port_busy[i],in_port_release[i]));
     }
     out.output("End Router: id = %d\n", id);
 }
@@ -400,19 +426,33 @@ hr_router::clock_handler(Cycle_t cycle)
 #endif
     }
 
-    // All we need to do is arbitrate the crossbar
+    // All we need to do is arbitrate the crossbar.  Only ports on the
+    // active list can have anything to move.
 #if VERIFY_DECLOCKING
-    arb->arbitrate(ports,in_port_busy,out_port_busy,progress_vcs,clocking);
+    arb->arbitrateActive(ports,in_port_busy,out_port_busy,progress_vcs,active_ports,clocking);
 #else
-    arb->arbitrate(ports,in_port_busy,out_port_busy,progress_vcs);
+    arb->arbitrateActive(ports,in_port_busy,out_port_busy,progress_vcs,active_ports);
 #endif
 
-    // Move the events and decrement the busy values
-    for ( int i = 0; i < num_ports; i++ ) {
-        // if ( progress_vcs[i] != -1 ) {
+    current_cycle = cycle;
+
+    // Move the events.  Only ports with data at a VC head can have
+    // been granted by the arbiter, and all of those are on the active
+    // list.  Output ports picked up here get added to the end of the
+    // list, so only walk the entries that were there to start with.
+    size_t num_active = active_ports.size();
+    for ( size_t idx = 0; idx < num_active; idx++ ) {
+        int i = active_ports[idx];
         if ( progress_vcs[i] > -1 ) {
             internal_router_event* ev = ports[i]->recv(progress_vcs[i]);
-            ports[ev->getNextPort()]->send(ev,ev->getVC());
+            int next_port = ev->getNextPort();
+            ports[next_port]->send(ev,ev->getVC());
+
+            // Arbiter just set the busy values for both sides of the
+            // xbar, record when they expire
+            in_port_release[i] = cycle + in_port_busy[i];
+            out_port_release[next_port] = cycle + out_port_busy[next_port];
+            activatePort(next_port);
 
             if ( ev->getTraceType() == SimpleNetwork::Request::FULL ) {
                 output.output("TRACE(%d): %" PRIu64 " ns: Copying event (src = %d, dest = %d) "
@@ -434,11 +474,23 @@ hr_router::clock_handler(Cycle_t cycle)
         else if ( progress_vcs[i] == -2 ) {
                 xbar_stalls[i]->addData(1);
         }
+    }
 
-        // Should stop at zero, need to find a clean way to do this
-        // with no branch.  For now it should work.
-        if ( in_port_busy[i] != 0 ) in_port_busy[i]--;
-        if ( out_port_busy[i] != 0 ) out_port_busy[i]--;
+    // Release busy values that expire at the end of this cycle and
+    // drop ports that no longer have anything going on
+    for ( size_t idx = 0; idx < active_ports.size(); ) {
+        int i = active_ports[idx];
+        if ( in_port_busy[i] != 0 && in_port_release[i] <= cycle + 1 ) in_port_busy[i] = 0;
+        if ( out_port_busy[i] != 0 && out_port_release[i] <= cycle + 1 ) out_port_busy[i] = 0;
+
+        if ( port_vcs_with_data[i] == 0 && in_port_busy[i] == 0 && out_port_busy[i] == 0 ) {
+            port_is_active[i] = false;
+            active_ports[idx] = active_ports.back();
+            active_ports.pop_back();
+        }
+        else {
+            idx++;
+        }
     }
 
     return false;
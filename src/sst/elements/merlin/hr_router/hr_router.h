@@ -28,6 +28,7 @@
 #include <sst/core/shared/sharedArray.h>
 
 #include <queue>
+#include <vector>
 
 #include "sst/elements/merlin/router.h"
 
@@ -117,6 +118,32 @@ private:
     int* out_port_busy;
     int* progress_vcs;
 
+    // Cycle at which the busy values above drop back to zero.  The
+    // busy arrays are only used as flags by the arbitration units,
+    // so rather than counting them down every cycle, they are cleared
+    // when their release cycle is reached.
+    Cycle_t* in_port_release;
+    Cycle_t* out_port_release;
+
+    // Worklist of ports that have data at a VC head or a non-zero busy
+    // value.  Only these ports are visited by the clock handler.
+    std::vector<int> active_ports;
+    std::vector<bool> port_is_active;
+    int* port_vcs_with_data;
+    Cycle_t current_cycle;
+
+    inline void activatePort(int port) {
+        if ( port_is_active[port] ) return;
+        port_is_active[port] = true;
+        active_ports.push_back(port);
+    }
+    inline int getBusyRemaining(int busy, Cycle_t release) {
+        // Matches the value the old per-cycle countdown would have had
+        // at the end of the last clock cycle
+        if ( busy == 0 ) return 0;
+        return release > current_cycle + 1 ? release - current_cycle - 1 : 0;
+    }
+
     UnitAlgebra input_buf_size;
     UnitAlgebra output_buf_size;
 
@@ -147,6 +174,8 @@ public:
     void finish();
 
     void notifyEvent();
+    void inc_port_vcs_with_data(int port);
+    void dec_port_vcs_with_data(int port);
     int const* getOutputBufferCredits() {return xbar_in_credits;}
     int const* getOutputQueueLengths() {return output_queue_lengths;}
 
@@ -22,6 +22,7 @@
 #include <sst/core/link.h>
 #include <sst/core/timeConverter.h>
 
+#include <algorithm>
 #include <vector>
 #include <queue>
 
@@ -120,6 +121,8 @@ private:
 
     internal_router_event** vc_heads;
 
+    std::vector<int> port_order;
+
     // PortControl** ports;
 
 public:
@@ -168,29 +171,72 @@ public:
         // Find all ports that have data and who's inputs to the xbar
         // aren't busy.  Sort them by prioritizing on injection time.
         // Oldest gets top priority.
-        int index = 0;
         for ( int i = 0; i < num_ports; i++ ) {
-            if ( in_port_busy[i] > 0 ) {
-                index += num_vcs;
-                continue; // No need to consider port if input to xbar is busy
-            }
+            queuePort(ports, in_port_busy, i);
+        }
 
-            vc_heads = ports[i]->getVCHeads();
-            for ( int j = 0; j < num_vcs; j++ ) {
-                internal_router_event* src_event = vc_heads[j];
-                if ( src_event != NULL ) {
-                    entries[index].next_port = vc_heads[j]->getNextPort();
-                    entries[index].next_vc = vc_heads[j]->getVC();
-                    entries[index].injection_time = vc_heads[j]->getEncapsulatedEvent()->getInjectionTime();
-                    entries[index].size_in_flits = vc_heads[j]->getFlitCount();
-
-                    age_queue.push(&entries[index]);
-                }
-                index++;
-            }
+        grantQueued(ports, in_port_busy, out_port_busy, progress_vc);
+    }
+
+    // Only ports on the active list have data.  Queueing them in
+    // ascending port order pushes the same entries in the same order as
+    // a full pass, so ties in injection time break the same way.
+    void arbitrateActive(
+#if VERIFY_DECLOCKING
+                         PortInterface** ports, int* in_port_busy, int* out_port_busy, int* progress_vc,
+                         const std::vector<int>& active_ports, bool clocking
+#else
+                         PortInterface** ports, int* in_port_busy, int* out_port_busy, int* progress_vc,
+                         const std::vector<int>& active_ports
+#endif
+                         )
+    {
+        port_order.assign(active_ports.begin(), active_ports.end());
+        std::sort(port_order.begin(), port_order.end());
 
+        for ( int port : port_order ) {
+            progress_vc[port] = -1;
+            queuePort(ports, in_port_busy, port);
         }
 
+        grantQueued(ports, in_port_busy, out_port_busy, progress_vc);
+    }
+
+    void reportSkippedCycles(Cycle_t cycles) {
+    }
+
+    void dumpState(std::ostream& stream) {
+        /* stream << "Current round robin port: " << rr_port << std::endl; */
+        /* stream << "  Current round robin VC by port:" << std::endl; */
+        /* for ( int i = 0; i < num_ports; i++ ) { */
+        /*     stream << i << ": " << rr_vcs[i] << std::endl; */
+        /* } */
+    }
+
+private:
+
+    void queuePort(PortInterface** ports, int* in_port_busy, int port) {
+        if ( in_port_busy[port] > 0 ) {
+            return; // No need to consider port if input to xbar is busy
+        }
+
+        int index = port * num_vcs;
+        vc_heads = ports[port]->getVCHeads();
+        for ( int j = 0; j < num_vcs; j++ ) {
+            internal_router_event* src_event = vc_heads[j];
+            if ( src_event != NULL ) {
+                entries[index].next_port = vc_heads[j]->getNextPort();
+                entries[index].next_vc = vc_heads[j]->getVC();
+                entries[index].injection_time = vc_heads[j]->getEncapsulatedEvent()->getInjectionTime();
+                entries[index].size_in_flits = vc_heads[j]->getFlitCount();
+
+                age_queue.push(&entries[index]);
+            }
+            index++;
+        }
+    }
+
+    void grantQueued(PortInterface** ports, int* in_port_busy, int* out_port_busy, int* progress_vc) {
         while ( !age_queue.empty() ) {
 
             priority_entry_t* entry = age_queue.top();
@@ -225,25 +271,6 @@ public:
                 }
             }
         }
-
-        // std::cout << "+++++++++" << std::endl;
-        // for ( int i = 0; i < total_entries; i++ ) {
-        //     std::cout << priority[next_list][i].first << ", " << priority[cur_list][i].second << std::endl;
-        // }
-        // std::cout << "+++++++++" << std::endl;
-
-        return;
-    }
-
-    void reportSkippedCycles(Cycle_t cycles) {
-    }
-
-    void dumpState(std::ostream& stream) {
-        /* stream << "Current round robin port: " << rr_port << std::endl; */
-        /* stream << "  Current round robin VC by port:" << std::endl; */
-        /* for ( int i = 0; i < num_ports; i++ ) { */
-        /*     stream << i << ": " << rr_vcs[i] << std::endl; */
-        /* } */
     }
 
 };
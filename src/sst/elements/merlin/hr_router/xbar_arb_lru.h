@@ -22,6 +22,7 @@
 #include <sst/core/link.h>
 #include <sst/core/timeConverter.h>
 
+#include <algorithm>
 #include <vector>
 
 #include "sst/elements/merlin/router.h"
@@ -51,13 +52,20 @@ private:
     int rr_port_shadow;
 #endif
 
-    typedef std::pair<uint16_t,uint16_t> priority_entry_t;
-    priority_entry_t* priority[2];
-    priority_entry_t* cur_list;
-    priority_entry_t* next_list;
+    // Each (port,vc) entry carries a sequence number, and ascending
+    // sequence number is the priority order.  Satisfied entries move to
+    // the bottom by being given new, larger numbers; unsatisfied entries
+    // keep theirs and so stay ahead in the same relative order.  This
+    // lets a pass look at only the entries of active ports.
+    uint64_t* entry_seq;
+    uint64_t last_seq;
 
     int total_entries;
 
+    std::vector<int> check_order;
+    std::vector<int> granted;
+    std::vector<int> all_ports;
+
     internal_router_event** vc_heads;
 
     // PortControl** ports;
@@ -65,11 +73,13 @@ private:
 public:
 
     xbar_arb_lru(ComponentId_t cid, Params& param) :
-        XbarArbitration(cid)
+        XbarArbitration(cid),
+        entry_seq(NULL)
     {
     }
 
     ~xbar_arb_lru() {
+        if ( entry_seq != NULL ) delete [] entry_seq;
     }
 
     void setPorts(int num_ports_s, int num_vcs_s) {
@@ -78,19 +88,18 @@ public:
 
         total_entries = num_ports * num_vcs;
 
-        priority[0] = new priority_entry_t[total_entries];
-        priority[1] = new priority_entry_t[total_entries];
-        cur_list = priority[0];
-        next_list = priority[1];
+        entry_seq = new uint64_t[total_entries];
+        for ( int i = 0; i < total_entries; i++ ) {
+            entry_seq[i] = i;
+        }
+        last_seq = total_entries - 1;
 
-        int index = 0;
+        check_order.reserve(total_entries);
+        granted.reserve(num_ports);
         for ( int i = 0; i < num_ports; i++ ) {
-            for ( int j = 0; j < num_vcs; j++ ) {
-                cur_list[index++] = priority_entry_t(i,j);
-            }
+            all_ports.push_back(i);
         }
 
-
         vc_heads = new internal_router_event*[num_vcs];
     }
 
@@ -105,34 +114,56 @@ public:
 #endif
                    )
     {
+        arbitratePorts(ports, in_port_busy, out_port_busy, progress_vc, all_ports);
+    }
 
-        for ( int i = 0; i < num_ports; i++ ) progress_vc[i] = -1;
-
-        // std::cout << "---------" << std::endl;
-        // for ( int i = 0; i < total_entries; i++ ) {
-        //     std::cout << priority[cur_list][i].first << ", " << priority[cur_list][i].second << std::endl;
-        // }
-        // std::cout << "---------" << std::endl;
-
-        // Run through the priority list
-        // for ( priority_list_t::iterator it = priority.begin(); it != priority.end(); ) {
-        // int sat_index = total_entries - 1;
-        // int unsat_index = 0;
-
-        priority_entry_t* sat_list = &next_list[total_entries-1];
-        priority_entry_t* unsat_list = next_list;
+    // Entries of inactive ports have no event, so a full pass would
+    // leave them unsatisfied with their priority unchanged.
+    void arbitrateActive(
+#if VERIFY_DECLOCKING
+                         PortInterface** ports, int* in_port_busy, int* out_port_busy, int* progress_vc,
+                         const std::vector<int>& active_ports, bool clocking
+#else
+                         PortInterface** ports, int* in_port_busy, int* out_port_busy, int* progress_vc,
+                         const std::vector<int>& active_ports
+#endif
+                         )
+    {
+        arbitratePorts(ports, in_port_busy, out_port_busy, progress_vc, active_ports);
+    }
 
-        for ( int i = 0; i < total_entries; i++ ) {
+    void reportSkippedCycles(Cycle_t cycles) {
+    }
 
-            // const priority_entry_t& check = priority[cur_list][i];
-            const priority_entry_t& check = cur_list[i];
+    void dumpState(std::ostream& stream) {
+        /* stream << "Current round robin port: " << rr_port << std::endl; */
+        /* stream << "  Current round robin VC by port:" << std::endl; */
+        /* for ( int i = 0; i < num_ports; i++ ) { */
+        /*     stream << i << ": " << rr_vcs[i] << std::endl; */
+        /* } */
+    }
 
-            /* std::cout << check.first << ", " << check.second << std::endl; */
+private:
 
-            int port = check.first;
-            int vc = check.second;
+    void arbitratePorts(PortInterface** ports, int* in_port_busy, int* out_port_busy, int* progress_vc,
+                        const std::vector<int>& port_list) {
+        // Gather the entries to check and put them in priority order
+        check_order.clear();
+        for ( int port : port_list ) {
+            progress_vc[port] = -1;
+            for ( int vc = 0; vc < num_vcs; vc++ ) {
+                check_order.push_back(port * num_vcs + vc);
+            }
+        }
+        uint64_t* seq = entry_seq;
+        std::sort(check_order.begin(), check_order.end(), [seq](int a, int b) {
+            return seq[a] < seq[b];
+        });
 
-            // std::cout << check.first << ", " << check.second << std::endl;
+        granted.clear();
+        for ( int entry : check_order ) {
+            int port = entry / num_vcs;
+            int vc = entry % num_vcs;
 
             vc_heads = ports[port]->getVCHeads();
 
@@ -156,53 +187,21 @@ public:
                     in_port_busy[port] = src_event->getFlitCount();
                     out_port_busy[next_port] = src_event->getFlitCount();
 
-
-                    // Copy data to new list
-                    // std::cout << "putting at bottom of list" << std::endl;
-                    // next_list[sat_index--] = check;
-                    *sat_list = check;
-                    --sat_list;
+                    granted.push_back(entry);
                 }
                 else {
-                    // std::cout << "putting at top of list" << std::endl;
-                    // next_list[unsat_index++] = check;
-                    *unsat_list = check;
-                    ++unsat_list;
                     progress_vc[port] = -2;
                 }
             }
-            else {
-                // std::cout << "putting at top of list" << std::endl;
-                // next_list[unsat_index++] = check;
-                *unsat_list = check;
-                ++unsat_list;
-            }
         }
 
-        // std::cout << "+++++++++" << std::endl;
-        // for ( int i = 0; i < total_entries; i++ ) {
-        //     std::cout << priority[next_list][i].first << ", " << priority[cur_list][i].second << std::endl;
-        // }
-        // std::cout << "+++++++++" << std::endl;
-
-        // cur_list ^= next_list;
-        // next_list ^= cur_list;
-        // cur_list ^= next_list;
-        priority_entry_t* tmp = cur_list;
-        cur_list = next_list;
-        next_list = tmp;
-        return;
-    }
-
-    void reportSkippedCycles(Cycle_t cycles) {
-    }
-
-    void dumpState(std::ostream& stream) {
-        /* stream << "Current round robin port: " << rr_port << std::endl; */
-        /* stream << "  Current round robin VC by port:" << std::endl; */
-        /* for ( int i = 0; i < num_ports; i++ ) { */
-        /*     stream << i << ": " << rr_vcs[i] << std::endl; */
-        /* } */
+        // Satisfied entries go to the bottom of the list, the first
+        // one satisfied ending up last
+        uint64_t num_granted = granted.size();
+        for ( uint64_t i = 0; i < num_granted; i++ ) {
+            entry_seq[granted[i]] = last_seq + num_granted - i;
+        }
+        last_seq += num_granted;
     }
 
 };
@@ -22,6 +22,7 @@
 #include <sst/core/link.h>
 #include <sst/core/timeConverter.h>
 
+#include <algorithm>
 #include <vector>
 
 #include "sst/elements/merlin/router.h"
@@ -52,6 +53,13 @@ private:
     int *rr_vcs;
     int rr_port;
 
+    // rr_vcs[port] is only brought up to date when the port is
+    // arbitrated.  rr_vcs_valid[port] is the arbitration count it is
+    // current as of.
+    uint64_t *rr_vcs_valid;
+    uint64_t arb_count;
+    std::vector<int> port_order;
+
 #if VERIFY_DECLOCKING
     int rr_port_shadow;
 #endif
@@ -64,12 +72,14 @@ public:
 
     xbar_arb_rr(ComponentId_t cid, Params& params) :
         XbarArbitration(cid),
-        rr_vcs(NULL)
+        rr_vcs(NULL),
+        rr_vcs_valid(NULL)
     {
     }
 
     ~xbar_arb_rr() {
         if ( rr_vcs != NULL ) delete [] rr_vcs;
+        if ( rr_vcs_valid != NULL ) delete [] rr_vcs_valid;
     }
 
     void setPorts(int num_ports_s, int num_vcs_s) {
@@ -77,11 +87,15 @@ public:
         num_vcs = num_vcs_s;
 
         rr_vcs = new int[num_ports];
+        rr_vcs_valid = new uint64_t[num_ports];
         for ( int i = 0; i < num_ports; i++ ) {
             rr_vcs[i] = 0;
+            rr_vcs_valid[i] = 0;
         }
 
         rr_port = 0;
+        arb_count = 0;
+        port_order.reserve(num_ports);
 #if VERIFY_DECLOCKING
         rr_port_shadow = 0;
 #endif
@@ -100,59 +114,46 @@ public:
                    )
     {
         // Run through each of the ports, giving first pick in a round robin fashion
-        // for ( int port = rr_port, pcount = 0; pcount < num_ports; port = (port+1) % num_ports, pcount++ ) {
         for ( int port = rr_port, pcount = 0; pcount < num_ports; port = ((port != num_ports-1) ? port+1 : 0), pcount++ ) {
-
-            vc_heads = ports[port]->getVCHeads();
-
-            // Overwrite old data
-            progress_vc[port] = -1;
-            // if the output of this port is busy, nothing to do.
-            if ( in_port_busy[port] > 0 ) {
-                continue;
-            }
-
-            // See what we should progress for this port
-            // for ( int vc = rr_vcs[port], vcount = 0; vcount < num_vcs; vc = (vc+1) % num_vcs, vcount++ ) {
-            for ( int vc = rr_vcs[port], vcount = 0; vcount < num_vcs; vc = ((vc != num_vcs-1) ? (vc+1) : 0), vcount++ ) {
-
-                // If there is no event, move to next VC
-                internal_router_event* src_event = vc_heads[vc];
-                if ( src_event == NULL ) continue;
-
-                // Have an event, see if it can be progressed
-                int next_port = src_event->getNextPort();
-
-                // We can progress if the next port's input is not
-                // busy and there are enough credits.
-                if ( out_port_busy[next_port] > 0 ) continue;
-
-                // Need to see if the VC has enough credits
-                int next_vc = src_event->getVC();
-
-                // See if there is enough space
-                if ( !ports[next_port]->spaceToSend(next_vc, src_event->getFlitCount()) ) continue;
-
-                // Tell the router what to move
-                progress_vc[port] = vc;
-
-                // Need to set the busy values
-                in_port_busy[port] = src_event->getFlitCount();
-                out_port_busy[next_port] = src_event->getFlitCount();
-                break;  // Go to next port;
-            }
-            // Increemnt rr_vcs for next time
-            rr_vcs[port] = (rr_vcs[port] + 1) % num_vcs;
+            arbitratePort(ports, in_port_busy, out_port_busy, progress_vc, port);
         }
-        rr_port = (rr_port + 1) % num_ports;
+        endArbitration(
+#if VERIFY_DECLOCKING
+                       clocking
+#endif
+                       );
+    }
 
+    // Ports that aren't on the active list have no data and a free
+    // xbar input, so the only thing a full pass would do for them is
+    // advance rr_vcs.  That is caught up in arbitratePort() the next
+    // time the port is looked at.
+    void arbitrateActive(
 #if VERIFY_DECLOCKING
-        if ( clocking ) {
-            rr_port_shadow = rr_port;
+                         PortInterface** ports, int* in_port_busy, int* out_port_busy, int* progress_vc,
+                         const std::vector<int>& active_ports, bool clocking
+#else
+                         PortInterface** ports, int* in_port_busy, int* out_port_busy, int* progress_vc,
+                         const std::vector<int>& active_ports
+#endif
+                         )
+    {
+        // Keep the round robin order, starting from rr_port
+        port_order.assign(active_ports.begin(), active_ports.end());
+        int start = rr_port;
+        int count = num_ports;
+        std::sort(port_order.begin(), port_order.end(), [start, count](int a, int b) {
+            return (a - start + count) % count < (b - start + count) % count;
+        });
+
+        for ( int port : port_order ) {
+            arbitratePort(ports, in_port_busy, out_port_busy, progress_vc, port);
         }
+        endArbitration(
+#if VERIFY_DECLOCKING
+                       clocking
 #endif
-
-        return;
+                       );
     }
 
     void reportSkippedCycles(Cycle_t cycles) {
@@ -170,8 +171,76 @@ public:
         stream << "Current round robin port: " << rr_port << std::endl;
         stream << "  Current round robin VC by port:" << std::endl;
         for ( int i = 0; i < num_ports; i++ ) {
-            stream << i << ": " << rr_vcs[i] << std::endl;
+            stream << i << ": " << currentVC(i) << std::endl;
+        }
+    }
+
+private:
+
+    int currentVC(int port) {
+        // Every arbitration the port missed would have moved it on by one
+        return (rr_vcs[port] + (int)((arb_count - rr_vcs_valid[port]) % num_vcs)) % num_vcs;
+    }
+
+    void arbitratePort(PortInterface** ports, int* in_port_busy, int* out_port_busy, int* progress_vc, int port) {
+        rr_vcs[port] = currentVC(port);
+        rr_vcs_valid[port] = arb_count + 1;
+
+        vc_heads = ports[port]->getVCHeads();
+
+        // Overwrite old data
+        progress_vc[port] = -1;
+        // if the output of this port is busy, nothing to do.
+        if ( in_port_busy[port] > 0 ) {
+            return;
+        }
+
+        // See what we should progress for this port
+        // for ( int vc = rr_vcs[port], vcount = 0; vcount < num_vcs; vc = (vc+1) % num_vcs, vcount++ ) {
+        for ( int vc = rr_vcs[port], vcount = 0; vcount < num_vcs; vc = ((vc != num_vcs-1) ? (vc+1) : 0), vcount++ ) {
+
+            // If there is no event, move to next VC
+            internal_router_event* src_event = vc_heads[vc];
+            if ( src_event == NULL ) continue;
+
+            // Have an event, see if it can be progressed
+            int next_port = src_event->getNextPort();
+
+            // We can progress if the next port's input is not
+            // busy and there are enough credits.
+            if ( out_port_busy[next_port] > 0 ) continue;
+
+            // Need to see if the VC has enough credits
+            int next_vc = src_event->getVC();
+
+            // See if there is enough space
+            if ( !ports[next_port]->spaceToSend(next_vc, src_event->getFlitCount()) ) continue;
+
+            // Tell the router what to move
+            progress_vc[port] = vc;
+
+            // Need to set the busy values
+            in_port_busy[port] = src_event->getFlitCount();
+            out_port_busy[next_port] = src_event->getFlitCount();
+            break;  // Go to next port;
         }
+        // Increemnt rr_vcs for next time
+        rr_vcs[port] = (rr_vcs[port] + 1) % num_vcs;
+    }
+
+#if VERIFY_DECLOCKING
+    void endArbitration(bool clocking) {
+#else
+    void endArbitration() {
+#endif
+        arb_count++;
+        rr_port = (rr_port + 1) % num_ports;
+
+#if VERIFY_DECLOCKING
+        if ( clocking ) {
+            rr_port_shadow = rr_port;
+        }
+#endif
     }
 
 };
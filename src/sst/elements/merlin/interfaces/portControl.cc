@@ -61,6 +61,7 @@ PortControl::sendCtrlEvent(CtrlRtrEvent* ev)
         // packets, we need to add stall time
         if ( have_packets) {
             output_port_stalls->addData(getCurrentSimCycle() - start_block);
+            if ( telemetry ) telemetry->addStall(start_block, getCurrentSimCycle());
         }
     }
 }
@@ -85,6 +86,7 @@ PortControl::send(internal_router_event* ev, int vc)
         output_queue_lengths[vc] += ev->getFlitCount();
     }
 	ev->setVC(vc);
+    if ( telemetry ) telemetry->updateOccupancy(getCurrentSimCycle(), ev->getFlitCount());
 
 	output_buf[vc].push(ev);
 	if ( waiting ) {
@@ -121,7 +123,7 @@ PortControl::recv(int vc)
 	// Need to update vc_heads
 	if ( input_buf[vc].empty() ) {
 	    vc_heads[vc] = NULL;
-	    parent->dec_vcs_with_data();
+	    parent->dec_port_vcs_with_data(port_number);
 	}
 	else {
         auto event = input_buf[vc].front();
@@ -248,6 +250,7 @@ PortControl::PortControl(ComponentId_t cid, Params& params,  Router* rif, int rt
     start_block(0),
     parent(rif),
     output(getSimulationOutput()),
+    telemetry(NULL),
     cm_activated(false),
     current_incast(0),
     total_flits_incoming(0),
@@ -463,6 +466,16 @@ PortControl::PortControl(ComponentId_t cid, Params& params,  Router* rif, int rt
     }
 
     congestion_events = 0;
+
+    std::string telemetry_file = params.find<std::string>("telemetry_file","");
+    if ( telemetry_file != "" ) {
+        UnitAlgebra telemetry_bin = params.find<UnitAlgebra>("telemetry_bin","1us");
+        if ( !telemetry_bin.hasUnits("s") ) {
+            merlin_abort.fatal(CALL_INFO,-1,"PortControl: telemetry_bin must be specified in units of s: %s\n",
+                               telemetry_bin.toStringBestSI().c_str());
+        }
+        telemetry = new PortTelemetry(telemetry_file, getTimeConverter(telemetry_bin)->getFactor());
+    }
 }
 
 
@@ -552,6 +565,7 @@ PortControl::~PortControl() {
     for ( unsigned int i = 0; i < network_inspectors.size(); i++ ) {
         delete network_inspectors[i];
     }
+    if ( telemetry != NULL ) delete telemetry;
 }
 
 void
@@ -596,6 +610,12 @@ PortControl::finish() {
     for ( unsigned int i = 0; i < network_inspectors.size(); i++ ) {
         network_inspectors[i]->finish();
     }
+
+    if ( telemetry ) {
+        uint64_t time_base_fs = (getCoreTimeBase() / UnitAlgebra("1fs")).getRoundedValue();
+        telemetry->write(getRank().rank, getNumRanks().rank, getCurrentSimCycle(), time_base_fs,
+                         rtr_id, port_number, remote_rtr_id, remote_port_number, host_port);
+    }
 }
 
 RtrInitEvent* PortControl::checkInitProtocol(Event* ev, RtrInitEvent::Commands command, uint32_t line, const char* file, const char* func)
@@ -936,6 +956,7 @@ PortControl::handle_input_n2r(Event* ev)
             // packets, we need to add stall time
             if ( have_packets) {
                 output_port_stalls->addData(getCurrentSimCycle() - start_block);
+                if ( telemetry ) telemetry->addStall(start_block, getCurrentSimCycle());
             }
 	    }
 	}
@@ -960,7 +981,7 @@ PortControl::handle_input_n2r(Event* ev)
 	    if ( vc_heads[curr_vc] == NULL ) {
             topo->route_packet(port_number, rtr_event->getVC(), rtr_event);
             vc_heads[curr_vc] = rtr_event;
-            parent->inc_vcs_with_data();
+            parent->inc_port_vcs_with_data(port_number);
 	    }
 
 	    if ( event->getTraceType() != SST::Interfaces::SimpleNetwork::Request::NONE ) {
@@ -1019,6 +1040,7 @@ PortControl::handle_input_r2r(Event* ev)
             // packets, we need to add stall time
             if ( have_packets) {
                 output_port_stalls->addData(getCurrentSimCycle() - start_block);
+                if ( telemetry ) telemetry->addStall(start_block, getCurrentSimCycle());
             }
 	    }
 	}
@@ -1043,7 +1065,7 @@ PortControl::handle_input_r2r(Event* ev)
 	    if ( vc_heads[curr_vc] == NULL ) {
             topo->route_packet(port_number, event->getVC(), event);
             vc_heads[curr_vc] = event;
-            parent->inc_vcs_with_data();
+            parent->inc_port_vcs_with_data(port_number);
 	    }
 
 	    if ( event->getTraceType() != SimpleNetwork::Request::NONE ) {
@@ -1127,6 +1149,12 @@ PortControl::handle_output(Event* ev) {
 	    // Send an event to wake up again after this packet is sent.
 	    output_timing->send(size,NULL);
 
+        if ( telemetry ) {
+            SimTime_t now = getCurrentSimCycle();
+            telemetry->updateOccupancy(now, -size);
+            telemetry->addBusy(now, size * output_timing->getDefaultTimeBase()->getFactor());
+        }
+
 	    // Subtract credits
 	    port_out_credits[vc_to_send] -= size;
 	    output_buf_count[vc_to_send]++;
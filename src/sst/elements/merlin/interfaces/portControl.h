@@ -32,6 +32,7 @@
 #include <cstring>
 
 #include "sst/elements/merlin/router.h"
+#include "sst/elements/merlin/interfaces/portTelemetry.h"
 
 using namespace SST;
 
@@ -74,7 +75,10 @@ public:
         {"enable_congestion_management", "Turn on congestion management","false"},
         {"cm_outstanding_threshold", "Threshold for the amount of data outstanding to a host before congestion management can trigger","2*output_buf_size"},
         {"cm_pktsize_threshold", "Minimum size of a packet to be considered part of a stream with regards to congestion management","128B"},
-        {"cm_incast_threshold", "Numbr of hosts sending to an enpoint needed to trigger congestion management","6"}
+        {"cm_incast_threshold", "Numbr of hosts sending to an enpoint needed to trigger congestion management","6"},
+        {"telemetry_file",     "Prefix of binary file to write per-port utilization, queue occupancy and credit stall time series to at finish.  "
+                               "All ports on a rank share one file.  If empty, no telemetry is collected.", ""},
+        {"telemetry_bin",      "Width of each time bin in the telemetry time series.", "1us"}
     )
 
     // SST_ELI_DOCUMENT_STATISTICS(
@@ -245,6 +249,9 @@ private:
 
     PortInterface::OutputArbitration* output_arb;
 
+    // Binned utilization time series, NULL if not enabled
+    PortTelemetry* telemetry;
+
     // For supporting congestion management
     struct CongestionInfo {
         const int32_t  src;
@@ -0,0 +1,129 @@
+// Copyright 2009-2023 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2023, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+#include <sst_config.h>
+
+#include "portTelemetry.h"
+
+#include <cstring>
+#include <map>
+#include <mutex>
+
+using namespace SST::Merlin;
+
+// All ports on a rank share a single file.  Ports on different
+// threads can finish at the same time, so access is serialized.  The
+// file is closed once the last port using it is deleted.
+struct TelemetryFile {
+    FILE* fp;
+    int users;
+};
+
+static std::mutex telemetry_lock;
+static std::map<std::string,TelemetryFile> telemetry_files;
+
+// The file is little endian so it reads the same on any host
+static void putLE(std::vector<uint8_t>& buf, uint64_t value, size_t bytes)
+{
+    for ( size_t i = 0; i < bytes; ++i ) buf.push_back((value >> (8 * i)) & 0xff);
+}
+
+static void putLE(std::vector<uint8_t>& buf, const std::vector<float>& values)
+{
+    for ( float f : values ) {
+        uint32_t bits;
+        memcpy(&bits, &f, sizeof(bits));
+        putLE(buf, bits, sizeof(bits));
+    }
+}
+
+PortTelemetry::PortTelemetry(const std::string& file_prefix, SimTime_t bin_width) :
+    file_prefix(file_prefix),
+    bin_width(bin_width),
+    occupancy(0),
+    last_occupancy_change(0)
+{
+    std::lock_guard<std::mutex> lock(telemetry_lock);
+    auto it = telemetry_files.emplace(file_prefix, TelemetryFile{nullptr, 0}).first;
+    it->second.users++;
+}
+
+PortTelemetry::~PortTelemetry()
+{
+    std::lock_guard<std::mutex> lock(telemetry_lock);
+    auto it = telemetry_files.find(file_prefix);
+    if ( it == telemetry_files.end() ) return;
+    if ( --it->second.users == 0 ) {
+        if ( it->second.fp != nullptr ) fclose(it->second.fp);
+        telemetry_files.erase(it);
+    }
+}
+
+FILE*
+PortTelemetry::openFile(const std::string& file_prefix, int rank, int num_ranks)
+{
+    TelemetryFile& file = telemetry_files[file_prefix];
+    if ( file.fp != nullptr ) return file.fp;
+
+    std::string name = file_prefix;
+    if ( num_ranks > 1 ) name += "-" + std::to_string(rank);
+    name += ".bin";
+
+    FILE* fp = fopen(name.c_str(), "wb");
+    if ( fp == nullptr ) return nullptr;
+
+    const char magic[8] = { 'M','R','L','N','T','L','M','1' };
+    std::vector<uint8_t> header(magic, magic + sizeof(magic));
+    putLE(header, 1, sizeof(uint32_t));
+    putLE(header, 4 * sizeof(int32_t) + 2 * sizeof(uint64_t) + 2 * sizeof(uint32_t), sizeof(uint32_t));
+    fwrite(header.data(), header.size(), 1, fp);
+
+    file.fp = fp;
+    return fp;
+}
+
+void
+PortTelemetry::write(int rank, int num_ranks, SimTime_t now,
+                     uint64_t time_base_fs, int rtr_id, int port, int remote_rtr_id, int remote_port, bool host_port)
+{
+    // Close out the occupancy integral and make all the series the
+    // same length
+    updateOccupancy(now, 0);
+    size_t num_bins = now == 0 ? 0 : (now - 1) / bin_width + 1;
+    busy.resize(num_bins, 0.0f);
+    occupied.resize(num_bins, 0.0f);
+    stall.resize(num_bins, 0.0f);
+
+    std::lock_guard<std::mutex> lock(telemetry_lock);
+
+    FILE* fp = openFile(file_prefix, rank, num_ranks);
+    if ( fp == nullptr ) return;
+
+    std::vector<uint8_t> record;
+    record.reserve(4 * sizeof(int32_t) + 2 * sizeof(uint64_t) + 2 * sizeof(uint32_t) + 3 * num_bins * sizeof(float));
+    for ( int32_t id : { rtr_id, port, remote_rtr_id, remote_port } ) putLE(record, (uint32_t)id, sizeof(uint32_t));
+    putLE(record, bin_width, sizeof(uint64_t));
+    putLE(record, time_base_fs, sizeof(uint64_t));
+    putLE(record, num_bins, sizeof(uint32_t));
+    putLE(record, host_port ? 1 : 0, sizeof(uint32_t));
+    putLE(record, busy);
+    putLE(record, occupied);
+    putLE(record, stall);
+    fwrite(record.data(), record.size(), 1, fp);
+
+    // Don't need the data anymore
+    std::vector<float>().swap(busy);
+    std::vector<float>().swap(occupied);
+    std::vector<float>().swap(stall);
+}
@@ -0,0 +1,123 @@
+// -*- mode: c++ -*-
+
+// Copyright 2009-2023 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2023, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+
+#ifndef COMPONENTS_MERLIN_PORTTELEMETRY_H
+#define COMPONENTS_MERLIN_PORTTELEMETRY_H
+
+#include <sst/core/sst_types.h>
+
+#include <cstdio>
+#include <string>
+#include <vector>
+
+namespace SST {
+namespace Merlin {
+
+// Accumulates per-port link utilization, output queue occupancy and
+// credit stall time into fixed width time bins.  Each bin holds three
+// floats, so memory per port is 12 bytes times the number of bins.
+// Nothing is written until finish, at which point every port appends
+// one record to a binary file that is shared by all ports on the
+// same rank.
+//
+// File layout (all values little endian regardless of host):
+//
+//   File header, once per file:
+//     char[8]   magic "MRLNTLM1"
+//     uint32    version (1)
+//     uint32    size of a port record header in bytes
+//
+//   Port record, once per port:
+//     int32     router id
+//     int32     port number
+//     int32     remote router id (-1 for host ports)
+//     int32     remote port number (-1 for host ports)
+//     uint64    bin width in core time base units
+//     uint64    core time base in fs (1000 for the default 1ps)
+//     uint32    number of bins (N)
+//     uint32    flags (bit 0 set for host ports)
+//     float[N]  busy: fraction of the bin the link was transmitting
+//     float[N]  occupancy: average output queue occupancy in flits
+//     float[N]  stall: fraction of the bin spent with packets
+//               queued but no credits to send them
+class PortTelemetry {
+public:
+
+    PortTelemetry(const std::string& file_prefix, SimTime_t bin_width);
+    ~PortTelemetry();
+
+    // Link was busy sending for [start, start + duration)
+    void addBusy(SimTime_t start, SimTime_t duration) {
+        addInterval(busy, start, start + duration, 1.0);
+    }
+
+    // Port was stalled on credits for [start, end)
+    void addStall(SimTime_t start, SimTime_t end) {
+        addInterval(stall, start, end, 1.0);
+    }
+
+    // Output queue occupancy changed by delta flits at time now
+    void updateOccupancy(SimTime_t now, int delta) {
+        if ( occupancy != 0 ) {
+            addInterval(occupied, last_occupancy_change, now, occupancy);
+        }
+        occupancy += delta;
+        last_occupancy_change = now;
+    }
+
+    // Closes out the occupancy integral and appends this port's
+    // record to the shared file
+    void write(int rank, int num_ranks, SimTime_t now,
+               uint64_t time_base_fs, int rtr_id, int port, int remote_rtr_id, int remote_port, bool host_port);
+
+private:
+
+    std::string file_prefix;
+    SimTime_t bin_width;
+
+    std::vector<float> busy;
+    std::vector<float> occupied;
+    std::vector<float> stall;
+
+    int occupancy;
+    SimTime_t last_occupancy_change;
+
+    // Adds weight * (fraction of each bin covered by [start, end)) to
+    // the bins the interval overlaps
+    void addInterval(std::vector<float>& bins, SimTime_t start, SimTime_t end, double weight) {
+        if ( end <= start ) return;
+        size_t first = start / bin_width;
+        size_t last = (end - 1) / bin_width;
+        if ( bins.size() <= last ) bins.resize(last + 1, 0.0f);
+
+        if ( first == last ) {
+            bins[first] += weight * (end - start) / bin_width;
+            return;
+        }
+        bins[first] += weight * ((first + 1) * bin_width - start) / bin_width;
+        for ( size_t i = first + 1; i < last; ++i ) bins[i] += weight;
+        bins[last] += weight * (end - last * bin_width) / bin_width;
+    }
+
+    static FILE* openFile(const std::string& file_prefix, int rank, int num_ranks);
+};
+
+}
+}
+
+#endif // COMPONENTS_MERLIN_PORTTELEMETRY_H
@@ -829,7 +829,8 @@ class hr_router(RouterTemplate):
                                       "xbar_arb","network_inspectors","oql_track_port","oql_track_remote","num_vns","vn_remap","vn_remap_shm"])
 
         self._declareParams("params",["qos_settings"],"portcontrol.arbitration.")
-        self._declareParams("params",["output_arb", "enable_congestion_management", "cm_outstanding_threshold", "cm_incast_threshold"],"portcontrol.")
+        self._declareParams("params",["output_arb", "enable_congestion_management", "cm_outstanding_threshold", "cm_incast_threshold",
+                                      "telemetry_file", "telemetry_bin"],"portcontrol.")
 
         self._setCallbackOnWrite("qos_settings",self._qos_callback)
 
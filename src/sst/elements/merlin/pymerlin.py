@@ -207,7 +207,7 @@ class topoTorus(Topo):
                 links[name] = sst.Link(name)
             return links[name]
 
-        swap_keys = [("torus.shape","shape"),("torus.width","width"),("torus.local_ports","local_ports")]
+        swap_keys = [("torus.shape","shape"),("torus.width","width"),("torus.local_ports","local_ports"),("torus.algorithm","algorithm")]
 
         _topo_params = _params.subsetWithRename(swap_keys);
 
@@ -28,6 +28,7 @@
 #include <sst/core/interfaces/simpleNetwork.h>
 
 #include <queue>
+#include <vector>
 
 namespace SST {
 namespace Merlin {
@@ -78,6 +79,12 @@ public:
     inline void dec_vcs_with_data() { vcs_with_data--; }
     inline int get_vcs_with_data() { return vcs_with_data; }
 
+    // Per-port versions called by PortControl when a VC head is
+    // filled or drained.  Routers can override these to keep track
+    // of which ports currently have data waiting.
+    virtual void inc_port_vcs_with_data(int port) { vcs_with_data++; }
+    virtual void dec_port_vcs_with_data(int port) { vcs_with_data--; }
+
     //获取输出缓冲区的信用值（Credits）
     virtual int const* getOutputBufferCredits() = 0;
     virtual void sendCtrlEvent(CtrlRtrEvent* ev, int port = -1) = 0;
@@ -669,6 +676,21 @@ public:
     virtual void arbitrate(PortInterface** ports, int* port_busy, int* out_port_busy, int* progress_vc, bool clocking) = 0;
 #else
     virtual void arbitrate(PortInterface** ports, int* port_busy, int* out_port_busy, int* progress_vc) = 0;
+#endif
+    // Same as arbitrate(), but only the ports in active_ports can
+    // have data at a VC head, so only those need to be looked at and
+    // progress_vc is only read back for them.  Arbiters that don't
+    // override this scan every port.
+#if VERIFY_DECLOCKING
+    virtual void arbitrateActive(PortInterface** ports, int* port_busy, int* out_port_busy, int* progress_vc,
+                                 const std::vector<int>& active_ports, bool clocking) {
+        arbitrate(ports, port_busy, out_port_busy, progress_vc, clocking);
+    }
+#else
+    virtual void arbitrateActive(PortInterface** ports, int* port_busy, int* out_port_busy, int* progress_vc,
+                                 const std::vector<int>& active_ports) {
+        arbitrate(ports, port_busy, out_port_busy, progress_vc);
+    }
 #endif
     virtual void setPorts(int num_ports, int num_vcs) = 0;
     virtual bool isOkayToPauseClock() { return true; }
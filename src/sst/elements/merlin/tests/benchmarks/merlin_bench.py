@@ -0,0 +1,242 @@
+#!/usr/bin/env python
+#
+# Copyright 2009-2023 NTESS. Under the terms
+# of Contract DE-NA0003525 with NTESS, the U.S.
+# Government retains certain rights in this software.
+#
+# Copyright (c) 2009-2023, NTESS
+# All rights reserved.
+#
+# This file is part of the SST software package. For license
+# information, see the LICENSE file in the top level directory of the
+# distribution.
+
+# Configurable network used by run_merlin_bench.py to measure how fast
+# merlin simulates.  All options are passed using --model-options, for
+# example:
+#
+#   sst merlin_bench.py --model-options="--topology=torus --shape=8x8x8 --load=0.5"
+#
+# A single line starting with MERLIN_BENCH is printed at build time so
+# the driver can pick up the size of the network that was built.
+
+import os
+import sys
+import argparse
+
+import sst
+from sst.merlin.base import *
+from sst.merlin.endpoint import *
+from sst.merlin.interface import *
+from sst.merlin.topology import *
+from sst.merlin.targetgen import *
+
+sys.path.insert(0, os.path.dirname(os.path.abspath(__file__)))
+from merlin_bench_units import to_bits
+
+
+parser = argparse.ArgumentParser(prog="merlin_bench.py")
+parser.add_argument("--topology", default="torus", choices=["torus","fattree","dragonfly","hyperx"])
+# torus and hyperx
+parser.add_argument("--shape", default=None)
+parser.add_argument("--width", default=None)
+parser.add_argument("--local_ports", type=int, default=1)
+# dragonfly
+parser.add_argument("--hosts_per_router", type=int, default=4)
+parser.add_argument("--routers_per_group", type=int, default=8)
+parser.add_argument("--intergroup_links", type=int, default=1)
+parser.add_argument("--num_groups", type=int, default=9)
+# dragonfly, hyperx and fattree routing
+parser.add_argument("--algorithm", default=None)
+# router
+parser.add_argument("--num_vns", type=int, default=1)
+parser.add_argument("--link_bw", default="4GB/s")
+parser.add_argument("--xbar_bw", default="4GB/s")
+parser.add_argument("--flit_size", default="8B")
+parser.add_argument("--buf_size", default="4kB")
+parser.add_argument("--link_latency", default="20ns")
+parser.add_argument("--xbar_arb", default="merlin.xbar_arb_lru")
+# traffic
+parser.add_argument("--endpoint", default="offered_load", choices=["offered_load","trafficgen","background"])
+parser.add_argument("--load", type=float, default=0.5)
+parser.add_argument("--message_size", default="64B")
+parser.add_argument("--packets_to_send", type=int, default=1000)
+parser.add_argument("--warmup_time", default="1us")
+parser.add_argument("--collect_time", default="10us")
+parser.add_argument("--drain_time", default="10us")
+parser.add_argument("--stop_at", default="20us")
+parser.add_argument("--stats_file", default="merlin_bench_stats.csv")
+
+args = parser.parse_args(sys.argv[1:])
+
+
+class TrafficGenJob(Job):
+    def __init__(self,job_id,size):
+        Job.__init__(self,job_id,size)
+        self._declareParams("main",["num_peers","packets_to_send","packet_size","message_rate",
+                                    "delay_between_packets","link_bw"])
+        self.num_peers = size
+        self._lockVariable("num_peers")
+
+    def getName(self):
+        return "TrafficGen Job"
+
+    def build(self, nID, extraKeys):
+        nic = sst.Component("trafficgen_%d"%nID, "merlin.trafficgen")
+        self._applyStatisticsSettings(nic)
+        nic.addParams(self._getGroupParams("main"))
+        nic.addParams(extraKeys)
+        id = self._nid_map[nID]
+        nic.addParam("id", id)
+
+        # Uniform random destinations across the whole job
+        nic.addParam("PacketDest.pattern", "Uniform")
+        nic.addParam("PacketDest.RangeMin", 0)
+        nic.addParam("PacketDest.RangeMax", self.size)
+
+        networkif, port_name = self.network_interface.build(nic,"networkIF",0,self.job_id,self.size,id,True)
+        return (networkif, port_name)
+
+
+class BackgroundTrafficJob(Job):
+    def __init__(self,job_id,size):
+        Job.__init__(self,job_id,size)
+        self._declareParams("main",["offered_load","num_peers","message_size"])
+        self._declareClassVariables(["pattern"])
+        self.num_peers = size
+        self._lockVariable("num_peers")
+
+    def getName(self):
+        return "Background Traffic Job"
+
+    def build(self, nID, extraKeys):
+        nic = sst.Component("background_%d"%nID, "merlin.background_traffic")
+        self._applyStatisticsSettings(nic)
+        nic.addParams(self._getGroupParams("main"))
+        nic.addParams(extraKeys)
+        id = self._nid_map[nID]
+        nic.addParam("id", id)
+
+        self.pattern.addAsAnonymous(nic, "pattern", "pattern.")
+
+        networkif, port_name = self.network_interface.build(nic,"networkIF",0,self.job_id,self.size,id,True)
+        return (networkif, port_name)
+
+
+### Set up the topology
+if args.topology == "torus":
+    topo = topoTorus()
+    shape = args.shape if args.shape else "4x4x4"
+    topo.shape = shape
+    topo.width = args.width if args.width else "x".join(["1"] * len(shape.split("x")))
+    topo.local_ports = args.local_ports
+    num_routers = 1
+    for x in shape.split("x"): num_routers *= int(x)
+    radix = 2 * sum([int(x) for x in topo.width.split("x")]) + args.local_ports
+
+elif args.topology == "hyperx":
+    topo = topoHyperX()
+    shape = args.shape if args.shape else "4x4"
+    topo.shape = shape
+    topo.width = args.width if args.width else "x".join(["1"] * len(shape.split("x")))
+    topo.local_ports = args.local_ports
+    topo.algorithm = [args.algorithm if args.algorithm else "DOR"] * args.num_vns
+    num_routers = 1
+    for x in shape.split("x"): num_routers *= int(x)
+    radix = args.local_ports
+    for (s,w) in zip(shape.split("x"),topo.width.split("x")): radix += (int(s) - 1) * int(w)
+
+elif args.topology == "fattree":
+    topo = topoFatTree()
+    topo.shape = args.shape if args.shape else "4,4:4,4:8"
+    if args.algorithm: topo.routing_alg = args.algorithm
+    levels = [ [int(y) for y in x.split(",")] for x in topo.shape.split(":") ]
+    radix = max([ sum(l) for l in levels ])
+    num_routers = 0
+    hosts = 1
+    for l in levels: hosts *= l[0]
+    rtrs = hosts // levels[0][0]
+    for i in range(len(levels)):
+        num_routers += rtrs
+        if i + 1 < len(levels): rtrs = rtrs * levels[i][1] // levels[i+1][0]
+
+elif args.topology == "dragonfly":
+    topo = topoDragonFly()
+    topo.hosts_per_router = args.hosts_per_router
+    topo.routers_per_group = args.routers_per_group
+    topo.intergroup_links = args.intergroup_links
+    topo.num_groups = args.num_groups
+    topo.algorithm = [args.algorithm if args.algorithm else "ugal"] * args.num_vns
+    num_routers = args.routers_per_group * args.num_groups
+    # intergroup_links is per pair of groups, spread across the routers in a group
+    global_ports = ((args.num_groups - 1) * args.intergroup_links + args.routers_per_group - 1) // args.routers_per_group
+    radix = args.hosts_per_router + (args.routers_per_group - 1) + global_ports
+
+
+### Set up the routers
+router = hr_router()
+router.link_bw = args.link_bw
+router.flit_size = args.flit_size
+router.xbar_bw = args.xbar_bw
+router.input_latency = "20ns"
+router.output_latency = "20ns"
+router.input_buf_size = args.buf_size
+router.output_buf_size = args.buf_size
+router.num_vns = args.num_vns
+router.xbar_arb = args.xbar_arb
+
+# Only the per-port counters are needed to compute packet rates
+router.enableStatistics(["send_packet_count","send_bit_count"],{"type":"sst.AccumulatorStatistic","rate":"0ns"})
+
+topo.router = router
+topo.link_latency = args.link_latency
+
+
+### Set up the endpoints
+networkif = LinkControl()
+networkif.link_bw = args.link_bw
+networkif.input_buf_size = "1kB"
+networkif.output_buf_size = "1kB"
+
+num_nodes = topo.getNumNodes()
+
+if args.endpoint == "offered_load":
+    ep = OfferedLoadJob(0,num_nodes)
+    ep.offered_load = args.load
+    ep.message_size = args.message_size
+    ep.link_bw = args.link_bw
+    ep.warmup_time = args.warmup_time
+    ep.collect_time = args.collect_time
+    ep.drain_time = args.drain_time
+    ep.pattern = UniformTarget()
+
+elif args.endpoint == "trafficgen":
+    ep = TrafficGenJob(0,num_nodes)
+    ep.packets_to_send = args.packets_to_send
+    ep.packet_size = args.message_size
+    ep.link_bw = args.link_bw
+    # Inter-packet delay chosen so the average injection rate matches
+    # the requested load
+    ser_time = to_bits(args.message_size) / to_bits(args.link_bw)
+    ep.delay_between_packets = "%dps"%(int(ser_time / args.load * 1e12))
+    ep.message_rate = "1GHz"
+
+elif args.endpoint == "background":
+    ep = BackgroundTrafficJob(0,num_nodes)
+    ep.offered_load = args.load
+    ep.message_size = args.message_size
+    ep.pattern = UniformTarget()
+    sst.setProgramOption("stop-at", args.stop_at)
+
+ep.network_interface = networkif
+
+system = System()
+system.setTopology(topo)
+system.allocateNodes(ep,"linear")
+system.build()
+
+sst.setStatisticLoadLevel(1)
+sst.setStatisticOutput("sst.statOutputCSV", {"filepath" : args.stats_file, "separator" : "," })
+
+print("MERLIN_BENCH topology=%s routers=%d radix=%d endpoints=%d num_vns=%d load=%s endpoint=%s xbar_bw=%s flit_size=%s"%
+      (args.topology, num_routers, radix, num_nodes, args.num_vns, args.load, args.endpoint, args.xbar_bw, args.flit_size))
@@ -0,0 +1,24 @@
+# Copyright 2009-2023 NTESS. Under the terms
+# of Contract DE-NA0003525 with NTESS, the U.S.
+# Government retains certain rights in this software.
+#
+# Copyright (c) 2009-2023, NTESS
+# All rights reserved.
+#
+# This file is part of the SST software package. For license
+# information, see the LICENSE file in the top level directory of the
+# distribution.
+
+# Unit handling shared by merlin_bench.py (run inside sst) and
+# run_merlin_bench.py (run by python), so it must not import sst.
+
+# Converts sizes and bandwidths such as 64B or 4GB/s into bits (or bits/s)
+def to_bits(value):
+    si = { "k" : 1e3, "K" : 1e3, "M" : 1e6, "G" : 1e9, "T" : 1e12 }
+    value = value.replace("/s","")
+    mult = 8.0 if value.endswith("B") else 1.0
+    value = value[:-1]
+    if value[-1] in si:
+        mult *= si[value[-1]]
+        value = value[:-1]
+    return float(value) * mult
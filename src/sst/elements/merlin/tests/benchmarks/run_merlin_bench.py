@@ -0,0 +1,276 @@
+#!/usr/bin/env python3
+#
+# Copyright 2009-2023 NTESS. Under the terms
+# of Contract DE-NA0003525 with NTESS, the U.S.
+# Government retains certain rights in this software.
+#
+# Copyright (c) 2009-2023, NTESS
+# All rights reserved.
+#
+# This file is part of the SST software package. For license
+# information, see the LICENSE file in the top level directory of the
+# distribution.
+
+# Host throughput benchmark for merlin.  Runs merlin_bench.py over a
+# sweep of topologies, sizes, VN counts and offered loads and records
+# how fast the simulator ran each one.  For every run the report holds
+# the wall-clock time, the SST build and run loop times, peak RSS of the
+# sst process, the number of packets sent by all router ports, the
+# number of events delivered to event handlers, and the derived
+# packets/sec, events/sec and router-cycles/sec rates.
+#
+# The event count comes from the sst.profile.handler.event.count
+# profiling tool (SST 13 and later), which adds a little overhead to
+# every event delivery.  Use --no_event_count to leave profiling off.
+#
+# Examples:
+#
+#   ./run_merlin_bench.py --sizes small --output report.json
+#   ./run_merlin_bench.py --topologies torus,dragonfly --loads 0.3,0.9 --format csv
+#
+# Two reports can be compared with --compare, which prints the change
+# in packets/sec for every configuration present in both.
+
+import argparse
+import csv
+import json
+import os
+import re
+import shutil
+import subprocess
+import sys
+import tempfile
+import time
+
+from merlin_bench_units import to_bits
+
+
+# Network configurations for each topology, by size.  Each entry is a
+# set of options passed through to merlin_bench.py.
+CONFIGS = {
+    "torus" : {
+        "small"  : { "shape" : "4x4x4",    "local_ports" : 1 },
+        "medium" : { "shape" : "8x8x8",    "local_ports" : 2 },
+        "large"  : { "shape" : "16x16x16", "local_ports" : 2 },
+    },
+    "fattree" : {
+        "small"  : { "shape" : "4,4:4,4:8" },
+        "medium" : { "shape" : "8,8:8,8:16" },
+        "large"  : { "shape" : "16,16:16,16:32" },
+    },
+    "dragonfly" : {
+        "small"  : { "hosts_per_router" : 2, "routers_per_group" : 4,  "intergroup_links" : 1, "num_groups" : 9 },
+        "medium" : { "hosts_per_router" : 4, "routers_per_group" : 8,  "intergroup_links" : 1, "num_groups" : 33 },
+        "large"  : { "hosts_per_router" : 8, "routers_per_group" : 16, "intergroup_links" : 1, "num_groups" : 80 },
+    },
+    "hyperx" : {
+        "small"  : { "shape" : "4x4",   "width" : "1x1", "local_ports" : 4 },
+        "medium" : { "shape" : "8x8",   "width" : "1x1", "local_ports" : 8 },
+        "large"  : { "shape" : "8x8x8", "width" : "1x1x1", "local_ports" : 8 },
+    },
+}
+
+
+def parse_args():
+    parser = argparse.ArgumentParser(description="Measure merlin host simulation throughput")
+    parser.add_argument("--sst", default="sst", help="sst executable to use")
+    parser.add_argument("--topologies", default="torus,fattree,dragonfly,hyperx")
+    parser.add_argument("--sizes", default="small,medium")
+    parser.add_argument("--num_vns", default="1", help="comma separated list of VN counts")
+    parser.add_argument("--loads", default="0.1,0.5,0.9", help="comma separated list of offered loads")
+    parser.add_argument("--endpoint", default="offered_load", choices=["offered_load","trafficgen","background"])
+    parser.add_argument("--xbar_arb", default="merlin.xbar_arb_lru")
+    parser.add_argument("--repeat", type=int, default=1, help="number of times to run each configuration")
+    parser.add_argument("--timeout", type=int, default=3600, help="timeout per run in seconds")
+    parser.add_argument("--model_options", default="", help="extra options passed to merlin_bench.py")
+    parser.add_argument("--output", default="-", help="report file (- for stdout)")
+    parser.add_argument("--format", default="json", choices=["json","csv"])
+    parser.add_argument("--keep", action="store_true", help="keep the run directories")
+    parser.add_argument("--no_event_count", action="store_true", help="do not enable event handler profiling")
+    parser.add_argument("--compare", nargs=2, metavar=("BASE","NEW"), help="compare two JSON reports and exit")
+    return parser.parse_args()
+
+
+# Parses the output of --print-timing-info and the MERLIN_BENCH line
+# printed by merlin_bench.py
+def parse_output(text):
+    result = {}
+    for line in text.splitlines():
+        if line.startswith("MERLIN_BENCH"):
+            for item in line.split()[1:]:
+                key, value = item.split("=",1)
+                result[key] = value
+            continue
+        m = re.match(r"\s*(Build time|Run loop time|Total time):\s*([0-9.eE+-]+)\s*seconds", line)
+        if m:
+            result[m.group(1).lower().replace(" ","_")] = float(m.group(2))
+            continue
+        m = re.search(r"simulated time:\s*([0-9.]+)\s*([munpf]?s)", line, re.IGNORECASE)
+        if m:
+            scale = { "s" : 1.0, "ms" : 1e-3, "us" : 1e-6, "ns" : 1e-9, "ps" : 1e-12, "fs" : 1e-15 }
+            result["simulated_time"] = float(m.group(1)) * scale[m.group(2)]
+    return result
+
+
+# Sums a statistic across all router ports in the statistics file
+def sum_statistic(stats_file, name):
+    total = 0
+    if not os.path.exists(stats_file):
+        return None
+    with open(stats_file) as f:
+        reader = csv.reader(f)
+        header = [h.strip() for h in next(reader)]
+        stat_col = header.index("StatisticName")
+        sum_col = header.index("Sum.u64")
+        for row in reader:
+            if row[stat_col].strip() == name:
+                total += int(row[sum_col])
+    return total
+
+
+# Sums the receive counts reported by the event count profiling tool.
+# Each data line is "<name>, <recv count>, <send count>".
+def sum_event_counts(profile_file):
+    if not os.path.exists(profile_file):
+        return None
+    total = None
+    with open(profile_file) as f:
+        for line in f:
+            m = re.match(r"\s*[^,]+,\s*([0-9]+)\s*(,\s*[0-9]+\s*)?$", line)
+            if m:
+                total = (total or 0) + int(m.group(1))
+    return total
+
+
+def run_one(args, bench_script, topology, size, num_vns, load):
+    run_dir = tempfile.mkdtemp(prefix="merlin_bench_")
+    stats_file = os.path.join(run_dir, "stats.csv")
+
+    options = { "topology" : topology, "num_vns" : num_vns, "load" : load,
+                "endpoint" : args.endpoint, "xbar_arb" : args.xbar_arb, "stats_file" : stats_file }
+    options.update(CONFIGS[topology][size])
+    model_options = " ".join(["--%s=%s"%(k,v) for (k,v) in options.items()])
+    if args.model_options: model_options += " " + args.model_options
+
+    profile_file = os.path.join(run_dir, "profile.txt")
+    cmd = [ args.sst, "--print-timing-info", "--model-options=%s"%model_options ]
+    if not args.no_event_count:
+        cmd += [ "--enable-profiling=events:sst.profile.handler.event.count(level=type)[event]",
+                 "--profiling-output=%s"%profile_file ]
+    cmd.append(bench_script)
+
+    out_path = os.path.join(run_dir, "sst.out")
+    start = time.perf_counter()
+    with open(out_path, "w") as out:
+        proc = subprocess.Popen(cmd, stdout=out, stderr=subprocess.STDOUT, cwd=run_dir)
+        deadline = start + args.timeout
+        # wait4 gives the resource usage of this child only
+        while True:
+            pid, status, rusage = os.wait4(proc.pid, os.WNOHANG)
+            if pid != 0: break
+            if time.perf_counter() > deadline:
+                proc.kill()
+                pid, status, rusage = os.wait4(proc.pid, 0)
+                break
+            time.sleep(0.05)
+    wall = time.perf_counter() - start
+
+    with open(out_path) as f:
+        text = f.read()
+
+    result = { "topology" : topology, "size" : size, "num_vns" : num_vns, "load" : load,
+               "endpoint" : args.endpoint, "xbar_arb" : args.xbar_arb,
+               "exit_status" : os.waitstatus_to_exitcode(status) if hasattr(os, "waitstatus_to_exitcode") else status,
+               "wall_time" : wall }
+    # ru_maxrss is in kilobytes on Linux and bytes on macOS
+    result["peak_rss_kb"] = rusage.ru_maxrss // 1024 if sys.platform == "darwin" else rusage.ru_maxrss
+    result.update(parse_output(text))
+
+    packets = sum_statistic(stats_file, "send_packet_count")
+    bits = sum_statistic(stats_file, "send_bit_count")
+    result["packets_sent"] = packets
+    result["bits_sent"] = bits
+
+    events = None if args.no_event_count else sum_event_counts(profile_file)
+    result["events"] = events
+
+    run_time = result.get("run_loop_time", wall)
+    if packets is not None and run_time > 0:
+        result["packets_per_sec"] = packets / run_time
+    if events is not None and run_time > 0:
+        result["events_per_sec"] = events / run_time
+    # Router cycles are computed as if every router were clocked for the
+    # whole simulation, so this is an upper bound on the work done.
+    if "simulated_time" in result and "routers" in result and run_time > 0:
+        freq = to_bits(result["xbar_bw"]) / to_bits(result["flit_size"])
+        result["router_cycles"] = int(result["simulated_time"] * freq * int(result["routers"]))
+        result["router_cycles_per_sec"] = result["router_cycles"] / run_time
+
+    if result["exit_status"] != 0:
+        result["error"] = text[-2000:]
+    if not args.keep:
+        shutil.rmtree(run_dir, ignore_errors=True)
+    else:
+        result["run_dir"] = run_dir
+    return result
+
+
+def write_report(args, results):
+    out = sys.stdout if args.output == "-" else open(args.output, "w")
+    if args.format == "json":
+        json.dump({ "benchmark" : "merlin_host_throughput", "sst" : args.sst, "results" : results }, out, indent=2)
+        out.write("\n")
+    else:
+        keys = []
+        for r in results:
+            for k in r.keys():
+                if k not in keys and k != "error": keys.append(k)
+        writer = csv.DictWriter(out, fieldnames=keys, extrasaction="ignore")
+        writer.writeheader()
+        for r in results: writer.writerow(r)
+    if out is not sys.stdout: out.close()
+
+
+def compare_reports(base_file, new_file):
+    def key(r): return (r["topology"], r["size"], r["num_vns"], r["load"], r["endpoint"], r["xbar_arb"])
+    with open(base_file) as f: base = { key(r) : r for r in json.load(f)["results"] }
+    with open(new_file) as f: new = { key(r) : r for r in json.load(f)["results"] }
+    print("%-10s %-7s %4s %5s %14s %14s %8s"%("topology","size","vns","load","base pkt/s","new pkt/s","change"))
+    for k in sorted(set(base.keys()) & set(new.keys())):
+        b = base[k].get("packets_per_sec")
+        n = new[k].get("packets_per_sec")
+        if not b or not n: continue
+        print("%-10s %-7s %4s %5s %14.0f %14.0f %+7.1f%%"%(k[0],k[1],k[2],k[3],b,n,(n / b - 1.0) * 100.0))
+
+
+def main():
+    args = parse_args()
+    if args.compare:
+        compare_reports(args.compare[0], args.compare[1])
+        return 0
+
+    bench_script = os.path.join(os.path.dirname(os.path.abspath(__file__)), "merlin_bench.py")
+
+    results = []
+    for topology in args.topologies.split(","):
+        if topology not in CONFIGS:
+            print("Unknown topology: %s"%topology, file=sys.stderr)
+            return 1
+        for size in args.sizes.split(","):
+            for num_vns in [int(x) for x in args.num_vns.split(",")]:
+                for load in [float(x) for x in args.loads.split(",")]:
+                    for i in range(args.repeat):
+                        r = run_one(args, bench_script, topology, size, num_vns, load)
+                        r["iteration"] = i
+                        print("%-10s %-7s vns=%d load=%.2f: %.2fs wall, %s pkt/s"%
+                              (topology, size, num_vns, load, r["wall_time"],
+                               "%.0f"%r["packets_per_sec"] if "packets_per_sec" in r else "n/a"),
+                              file=sys.stderr)
+                        results.append(r)
+
+    write_report(args, results)
+    return 0 if all(r["exit_status"] == 0 for r in results) else 1
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -74,6 +74,12 @@ class testcase_merlin_Component(SSTTestCase):
     def test_merlin_torus_64(self):
          self.merlin_test_template("torus_64_test")
 
+    def test_merlin_torus_64_mina(self):
+         self.merlin_adaptive_test_template("torus_64_mina_test", "torus_64_test")
+
+    def test_merlin_torus_128_mina(self):
+         self.merlin_adaptive_test_template("torus_128_mina_test", "torus_128_test")
+
     def test_merlin_hyperx_128(self):
          self.merlin_test_template("hyperx_128_test")
 
@@ -135,3 +141,39 @@ class testcase_merlin_Component(SSTTestCase):
             diffdata = testing_get_diff_data(testcase)
             log_failure(diffdata)
         self.assertTrue(cmp_result, "Sorted Output file {0} does not match sorted Reference File {1}".format(outfile, reffile))
+
+    # Adaptive routing changes packet timing but not which packets are
+    # delivered, so adaptive runs are checked against the reference
+    # for the deterministic version of the same network with the
+    # cycle counts and stall counts stripped out.
+    def merlin_adaptive_test_template(self, testcase, reftestcase):
+        test_path = self.get_testsuite_dir()
+        outdir = self.get_test_output_run_dir()
+
+        testDataFileName="test_merlin_{0}".format(testcase)
+
+        sdlfile = "{0}/{1}.py".format(test_path, testcase)
+        reffile = "{0}/refFiles/test_merlin_{1}.out".format(test_path, reftestcase)
+        outfile = "{0}/{1}.out".format(outdir, testDataFileName)
+        errfile = "{0}/{1}.err".format(outdir, testDataFileName)
+        mpioutfiles = "{0}/{1}.testfile".format(outdir, testDataFileName)
+
+        self.run_sst(sdlfile, outfile, errfile, mpi_out_files=mpioutfiles)
+
+        if os_test_file(errfile, "-s"):
+            log_testing_note("merlin test {0} has a Non-Empty Error File {1}".format(testDataFileName, errfile))
+
+        def delivery_lines(filename):
+            lines = []
+            with open(filename, 'r') as fp:
+                for line in fp:
+                    if "Finished sending packets" in line or "received all packets" in line:
+                        lines.append(line.split(":", 1)[1].strip())
+                    elif "received event with dest" in line or "didn't receive" in line:
+                        lines.append(line.strip())
+            return sorted(lines)
+
+        out_lines = delivery_lines(outfile)
+        ref_lines = delivery_lines(reffile)
+        self.assertTrue(len(ref_lines) > 0, "Reference File {0} has no delivery lines".format(reffile))
+        self.assertEqual(out_lines, ref_lines, "Deliveries in output file {0} do not match Reference File {1}".format(outfile, reffile))
@@ -327,6 +327,10 @@ topo_dragonfly::topo_dragonfly(ComponentId_t cid, Params &p, int num_ports, int
 
     rng = new RNG::XORShiftRNG(rtr_id+1);
 
+    group_ports.resize(params.g * params.n * params.m);
+    group_ports_valid.resize(params.g, false);
+    candidate_weights.resize(2 * params.n * params.m);
+
     output.verbose(CALL_INFO, 1, 1, "%u:%u:  ID: %u   Params:  p = %u  a = %u  k = %u  h = %u  g = %u\n",
             group_id, router_id, rtr_id, params.p, params.a, params.k, params.h, params.g);
 }
@@ -462,48 +466,27 @@ void topo_dragonfly::route_ugal(int port, int vc, internal_router_event* ev)
         // Packet leaves the group
         else {
             // printf("Routing packet with dest.group = %d and dest.mid_group = %d\n",td_ev->dest.group,td_ev->dest.mid_group);
-            // Need to find the lowest weighted route.  Loop over all
-            // the slices.
-            int min_weight = std::numeric_limits<int>::max();
-            std::vector<std::pair<int,int> > min_ports;
-            for ( int i = 0; i < params.n; ++i ) {
-                // Direct routes
-                for ( int j = 0; j < params.m; ++j ) {
-                    int weight;
-                    int port = port_for_group(td_ev->dest.group, i, j);
-                    if ( port != -1 ) {
-                        weight = output_queue_lengths[port * num_vcs + vc];
-
-                        if ( weight == min_weight ) {
-                            min_ports.emplace_back(port,i);
-                        }
-                        else if ( weight < min_weight ) {
-                            min_weight = weight;
-                            min_ports.clear();
-                            min_ports.emplace_back(port,i);
-                        }
-                    }
-
-                    // Valiant routes
-                    port = port_for_group(td_ev->dest.mid_group, i, j);
-                    if ( port != -1 ) {
-                        weight = 2 * output_queue_lengths[port * num_vcs + vc] + vns[vn].bias;
-
-                        if ( weight == min_weight ) {
-                            min_ports.emplace_back(port,i);
-                        }
-                        else if ( weight < min_weight ) {
-                            min_weight = weight;
-                            min_ports.clear();
-                            min_ports.emplace_back(port,i);
-                        }
-                    }
-                }
+            // Need to find the lowest weighted route.  Gather the
+            // weights for all the slices, with direct and valiant
+            // routes interleaved so ties are broken the same way as
+            // searching slice by slice.
+            const int32_t* direct_ports = ports_for_group(td_ev->dest.group);
+            const int32_t* valiant_ports = ports_for_group(td_ev->dest.mid_group);
+            int num_routes = params.n * params.m;
+            int bias = vns[vn].bias;
+            int* weights = candidate_weights.data();
+            for ( int i = 0; i < num_routes; ++i ) {
+                int32_t direct_port = direct_ports[i];
+                int32_t valiant_port = valiant_ports[i];
+                int direct_weight = output_queue_lengths[std::max(direct_port,0) * num_vcs + vc];
+                int valiant_weight = 2 * output_queue_lengths[std::max(valiant_port,0) * num_vcs + vc] + bias;
+                weights[2 * i] = direct_port < 0 ? std::numeric_limits<int>::max() : direct_weight;
+                weights[2 * i + 1] = valiant_port < 0 ? std::numeric_limits<int>::max() : valiant_weight;
             }
 
-            auto& route = min_ports[rng->generateNextUInt32() % min_ports.size()];
-            td_ev->setNextPort(route.first);
-            td_ev->global_slice = route.second;
+            int route = select_min_candidate(2 * num_routes);
+            td_ev->setNextPort(route & 1 ? valiant_ports[route / 2] : direct_ports[route / 2]);
+            td_ev->global_slice = (route / 2) / params.m;
             return;
         }
     }
@@ -602,33 +585,21 @@ void topo_dragonfly::route_ugal(int port, int vc, internal_router_event* ev)
         }
 
         // Just routing through.  Need to look at all possible routes
-        // to the dest group and pick the lowest weighted route
-        int min_weight = std::numeric_limits<int>::max();
-        std::vector<std::pair<int,int> > min_ports;
-
-        // Look through all routes.  If the port is in current router,
-        // weight with 1, other weight with 2
-        for ( int i = 0; i < params.n; ++i ) {
-            for ( int j = 0; j < params.m; ++j ) {
-                int port = port_for_group(td_ev->dest.group, i, j);
-                if ( port == -1 ) continue;
-                int weight = output_queue_lengths[port * num_vcs + vc];
-
-                if ( !is_port_global(port) ) weight *= 2;
-
-                if ( weight == min_weight ) {
-                    min_ports.emplace_back(port,i);
-                }
-                else if ( weight < min_weight ) {
-                    min_weight = weight;
-                    min_ports.clear();
-                    min_ports.emplace_back(port,i);
-                }
-            }
+        // to the dest group and pick the lowest weighted route.  If
+        // the port is in current router, weight with 1, other weight
+        // with 2
+        const int32_t* ports = ports_for_group(td_ev->dest.group);
+        int num_routes = params.n * params.m;
+        int* weights = candidate_weights.data();
+        for ( int i = 0; i < num_routes; ++i ) {
+            int32_t port = ports[i];
+            int weight = output_queue_lengths[std::max(port,0) * num_vcs + vc] << !is_port_global(port);
+            weights[i] = port < 0 ? std::numeric_limits<int>::max() : weight;
         }
-        auto& route = min_ports[rng->generateNextUInt32() % min_ports.size()];
-        td_ev->setNextPort(route.first);
-        td_ev->global_slice = route.second;
+
+        int route = select_min_candidate(num_routes);
+        td_ev->setNextPort(ports[route]);
+        td_ev->global_slice = route / params.m;
         return;
     }
 
@@ -664,37 +635,24 @@ void topo_dragonfly::route_mina(int port, int vc, internal_router_event* ev)
         // Packet leaves the group
         else {
             // Need to find the lowest weighted route.  Loop over all
-            // the slices, looking only at minimal routes.  For now,
-            // just weight all paths equally.
-            int min_weight = std::numeric_limits<int>::max();
-            std::vector<std::pair<int,int> > min_ports;
+            // the slices, looking only at minimal routes.
+            const int32_t* ports = ports_for_group(td_ev->dest.group);
+            int* weights = candidate_weights.data();
             for ( int i = 0; i < params.n; ++i ) {
+                // Weight by hop count, thus favoring shorter paths.
+                // The "+ hops" on the end is to make shorter paths
+                // win ties.
+                int hops = hops_to_router(td_ev->dest.group, td_ev->dest.router, i);
                 for ( int j = 0; j < params.m; ++j ) {
-                    // Direct routes
-                    int weight;
-                    int port = port_for_group(td_ev->dest.group, i, j);
-                    if ( port != -1 ) {
-                        int hops = hops_to_router(td_ev->dest.group, td_ev->dest.router, i);
-                        // Weight by hop count, thus favoring shorter
-                        // paths.  The "+ hops" on the end is to make
-                        // shorter paths win ties.
-                        weight = hops * output_queue_lengths[port * num_vcs + vc] + hops;
-
-                        if ( weight == min_weight ) {
-                            min_ports.emplace_back(port,i);
-                        }
-                        else if ( weight < min_weight ) {
-                            min_weight = weight;
-                            min_ports.clear();
-                            min_ports.emplace_back(port,i);
-                        }
-                    }
+                    int32_t port = ports[i * params.m + j];
+                    int weight = hops * output_queue_lengths[std::max(port,0) * num_vcs + vc] + hops;
+                    weights[i * params.m + j] = port < 0 ? std::numeric_limits<int>::max() : weight;
                 }
             }
 
-            auto& route = min_ports[rng->generateNextUInt32() % min_ports.size()];
-            td_ev->setNextPort(route.first);
-            td_ev->global_slice = route.second;
+            int route = select_min_candidate(params.n * params.m);
+            td_ev->setNextPort(ports[route]);
+            td_ev->global_slice = route / params.m;
             return;
         }
     }
@@ -1134,6 +1092,44 @@ int32_t topo_dragonfly::hops_to_router(uint32_t group, uint32_t router, uint32_t
     return hops;
 }
 
+const int32_t* topo_dragonfly::ports_for_group(uint32_t group)
+{
+    int32_t* ports = &group_ports[group * params.n * params.m];
+    if ( !group_ports_valid[group] ) {
+        for ( uint32_t i = 0; i < params.n; ++i ) {
+            for ( uint32_t j = 0; j < params.m; ++j ) {
+                ports[i * params.m + j] = port_for_group(group, i, j);
+            }
+        }
+        group_ports_valid[group] = true;
+    }
+    return ports;
+}
+
+// Returns the index of a minimum weight in candidate_weights, chosen
+// uniformly among ties.  The min and tie count passes have no data
+// dependent branches so they vectorize over large slice counts.
+int topo_dragonfly::select_min_candidate(int num_candidates)
+{
+    const int* weights = candidate_weights.data();
+
+    int min_weight = std::numeric_limits<int>::max();
+    for ( int i = 0; i < num_candidates; ++i ) {
+        min_weight = std::min(min_weight, weights[i]);
+    }
+
+    int ties = 0;
+    for ( int i = 0; i < num_candidates; ++i ) {
+        ties += (weights[i] == min_weight);
+    }
+
+    int pick = rng->generateNextUInt32() % ties;
+    for ( int i = 0; i < num_candidates; ++i ) {
+        if ( weights[i] == min_weight && pick-- == 0 ) return i;
+    }
+    return 0;
+}
+
 /* returns local router port if group can't be reached from this router */
 int32_t topo_dragonfly::port_for_group(uint32_t group, uint32_t global_slice, uint32_t local_slice)
 {
@@ -300,6 +300,20 @@ private:
 
     vn_info* vns;
 
+    // Candidate ports for reaching each group, indexed by group * n * m
+    // + global_slice * m + local_slice, which is the order the routing
+    // functions search them in.  Failed links are marked with -1.  A
+    // group's entries are filled in the first time it is routed to,
+    // since failed link information isn't available until after init.
+    std::vector<int32_t> group_ports;
+    std::vector<bool> group_ports_valid;
+
+    // Scratch space for the weights of the routes being considered
+    std::vector<int> candidate_weights;
+
+    const int32_t* ports_for_group(uint32_t group);
+    int select_min_candidate(int num_candidates);
+
     void route_nonadaptive(int port, int vc, internal_router_event* ev);
     void route_adaptive_local(int port, int vc, internal_router_event* ev);
     void route_ugal(int port, int vc, internal_router_event* ev);
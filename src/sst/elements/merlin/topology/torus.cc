@@ -27,6 +27,8 @@ using namespace SST::Merlin;
 topo_torus::topo_torus(ComponentId_t cid, Params& params, int num_ports, int rtr_id, int num_vns) :
     Topology(cid),
     router_id(rtr_id),
+    output_queue_lengths(NULL),
+    num_vcs(0),
     num_vns(num_vns)
 {
 
@@ -83,10 +85,43 @@ topo_torus::topo_torus(ComponentId_t cid, Params& params, int num_ports, int rtr
 
     id_loc = new int[dimensions];
     idToLocation(router_id, id_loc);
+
+    vns = new vn_info[num_vns];
+
+    std::vector<std::string> vn_route_algos;
+    if ( params.is_value_array("algorithm") ) {
+        params.find_array<std::string>("algorithm", vn_route_algos);
+        if ( vn_route_algos.size() != num_vns ) {
+            output.fatal(CALL_INFO, -1, "ERROR: When specifying routing algorithms per VN, algorithm list length must match number of VNs (%d VNs, %lu algorithms).\n",num_vns,vn_route_algos.size());
+        }
+    }
+    else {
+        std::string route_algo = params.find<std::string>("algorithm", "DOR");
+        for ( int i = 0; i < num_vns; ++i ) vn_route_algos.push_back(route_algo);
+    }
+
+    // Setup the routing algorithms
+    int curr_vc = 0;
+    for ( int i = 0; i < num_vns; ++i ) {
+        vns[i].start_vc = curr_vc;
+        if ( !vn_route_algos[i].compare("DOR") ) {
+            vns[i].algorithm = DOR;
+            vns[i].num_vcs = 2;
+        }
+        else if ( !vn_route_algos[i].compare("MIN-A") ) {
+            vns[i].algorithm = MINA;
+            vns[i].num_vcs = 3;
+        }
+        else {
+            output.fatal(CALL_INFO,-1,"Unknown routing mode specified: %s\n",vn_route_algos[i].c_str());
+        }
+        curr_vc += vns[i].num_vcs;
+    }
 }
 
 topo_torus::~topo_torus()
 {
+    delete [] vns;
     delete [] id_loc;
     delete [] dim_size;
     delete [] dim_width;
@@ -100,45 +135,144 @@ topo_torus::route_packet(int port, int vc, internal_router_event* ev)
     int dest_router = get_dest_router(ev->getDest());
     if ( dest_router == router_id ) {
         ev->setNextPort(get_dest_local_port(ev->getDest()));
-    } else {
-        topo_torus_event *tt_ev = static_cast<topo_torus_event*>(ev);
+        return;
+    }
+
+    topo_torus_event *tt_ev = static_cast<topo_torus_event*>(ev);
+    if ( vns[ev->getVN()].algorithm == MINA ) {
+        routeMINA(port, vc, tt_ev);
+    }
+    else {
+        routeDOR(port, vc, tt_ev);
+    }
+}
+
+void
+topo_torus::routeDOR(int port, int vc, topo_torus_event* tt_ev)
+{
+    int start_vc = vns[tt_ev->getVN()].start_vc;
 
-        for ( int dim = tt_ev->routing_dim ; dim < dimensions ; dim++ ) {
-            if ( tt_ev->dest_loc[dim] != id_loc[dim] ) {
+    for ( int dim = tt_ev->routing_dim ; dim < dimensions ; dim++ ) {
+        if ( tt_ev->dest_loc[dim] != id_loc[dim] ) {
 
-                int dist_neg = id_loc[dim] - tt_ev->dest_loc[dim];
-                if ( dist_neg < 0 ) dist_neg += dim_size[dim];
-                int dist_pos = tt_ev->dest_loc[dim] - id_loc[dim];
-                if ( dist_pos < 0 ) dist_pos += dim_size[dim];
+            int dist_neg = id_loc[dim] - tt_ev->dest_loc[dim];
+            if ( dist_neg < 0 ) dist_neg += dim_size[dim];
+            int dist_pos = tt_ev->dest_loc[dim] - id_loc[dim];
+            if ( dist_pos < 0 ) dist_pos += dim_size[dim];
 
-                int go_pos = (dist_pos <= dist_neg);
+            int go_pos = (dist_pos <= dist_neg);
 
 
-                output.verbose(CALL_INFO, 1, 1, " %d to %d:  Dist Neg: %d, Dist Pos: %d\n",
-                        id_loc[dim], tt_ev->dest_loc[dim], dist_neg, dist_pos);
+            output.verbose(CALL_INFO, 1, 1, " %d to %d:  Dist Neg: %d, Dist Pos: %d\n",
+                    id_loc[dim], tt_ev->dest_loc[dim], dist_neg, dist_pos);
 
-                int p = choose_multipath(
-                        port_start[dim][(go_pos) ? 0 : 1],
-                        dim_width[dim],
-                        (go_pos)? dist_pos : dist_neg);
+            int p = choose_multipath(
+                    port_start[dim][(go_pos) ? 0 : 1],
+                    dim_width[dim],
+                    (go_pos)? dist_pos : dist_neg);
 
-                tt_ev->setNextPort(p);
+            tt_ev->setNextPort(p);
 
-                if ( id_loc[dim] == 0 && port < local_port_start ) { // Crossing dateline
-                    int new_vc = vc ^ 1;
-                    tt_ev->setVC(new_vc); // Toggle VC
-                    output.verbose(CALL_INFO, 1, 1, "Crossing dateline.  Changing from VC %d to %d\n", vc, new_vc);
-                }
+            if ( id_loc[dim] == 0 && port < local_port_start ) { // Crossing dateline
+                int new_vc = start_vc + ((vc - start_vc) ^ 1);
+                tt_ev->setVC(new_vc); // Toggle VC
+                output.verbose(CALL_INFO, 1, 1, "Crossing dateline.  Changing from VC %d to %d\n", vc, new_vc);
+            }
 
-                break;
+            break;
+
+        } else {
+            // Time to change direction
+            tt_ev->routing_dim++;
+            tt_ev->setVC(start_vc + ((vc - start_vc) & (~1))); // Reset the VC
+        }
+    }
+}
+
+// Minimal adaptive routing using Duato's protocol.  The first two VCs
+// in the VN form an escape network that is routed in dimension order
+// with dateline VCs, and the third VC may take any minimal hop.  A
+// packet on the adaptive VC takes the least loaded productive port
+// unless the escape route is less loaded, in which case it drops into
+// the escape network.  Packets never leave the escape network once
+// they enter it, so the escape channels cannot form a cycle and the
+// network stays deadlock free.
+void
+topo_torus::routeMINA(int port, int vc, topo_torus_event* tt_ev)
+{
+    int start_vc = vns[tt_ev->getVN()].start_vc;
+    int adaptive_vc = start_vc + 2;
+    int in_dim = get_port_dim(port);
+
+    // Escape route.  This is computed from scratch since the packet
+    // may be joining the escape network at this router.  The upper VC
+    // is used once the packet has passed through coordinate 0 while
+    // travelling in the current dimension.
+    int escape_port = -1;
+    int escape_vc = start_vc;
+    for ( int dim = 0 ; dim < dimensions ; dim++ ) {
+        if ( tt_ev->dest_loc[dim] == id_loc[dim] ) continue;
+
+        int dist_neg = id_loc[dim] - tt_ev->dest_loc[dim];
+        if ( dist_neg < 0 ) dist_neg += dim_size[dim];
+        int dist_pos = tt_ev->dest_loc[dim] - id_loc[dim];
+        if ( dist_pos < 0 ) dist_pos += dim_size[dim];
+
+        int go_pos = (dist_pos <= dist_neg);
+        escape_port = choose_multipath(
+                port_start[dim][(go_pos) ? 0 : 1],
+                dim_width[dim],
+                (go_pos)? dist_pos : dist_neg);
+
+        if ( in_dim == dim && (id_loc[dim] == 0 || vc == start_vc + 1) ) {
+            escape_vc = start_vc + 1;
+        }
+        tt_ev->routing_dim = dim;
+        break;
+    }
+
+    // Packets already in the escape network stay there.  Untimed
+    // data is routed before the queue lengths are available and
+    // always uses the escape route.
+    if ( vc != adaptive_vc || output_queue_lengths == NULL ) {
+        tt_ev->setNextPort(escape_port);
+        tt_ev->setVC(escape_vc);
+        return;
+    }
 
-            } else {
-                // Time to change direction
-                tt_ev->routing_dim++;
-                tt_ev->setVC(vc & (~1)); // Reset the VC
+    // Find the least loaded productive port.  In an even sized ring
+    // both directions are minimal when the destination is halfway
+    // around.
+    int min_weight = 0x7FFFFFFF;
+    int min_port = escape_port;
+    for ( int dim = 0 ; dim < dimensions ; dim++ ) {
+        if ( tt_ev->dest_loc[dim] == id_loc[dim] ) continue;
+
+        int dist_neg = id_loc[dim] - tt_ev->dest_loc[dim];
+        if ( dist_neg < 0 ) dist_neg += dim_size[dim];
+        int dist_pos = tt_ev->dest_loc[dim] - id_loc[dim];
+        if ( dist_pos < 0 ) dist_pos += dim_size[dim];
+
+        for ( int dir = 0 ; dir < 2 ; dir++ ) {
+            if ( (dir == 0 && dist_pos > dist_neg) || (dir == 1 && dist_neg > dist_pos) ) continue;
+            for ( int p = port_start[dim][dir]; p < port_start[dim][dir] + dim_width[dim]; ++p ) {
+                int weight = output_queue_lengths[p * num_vcs + adaptive_vc];
+                if ( weight < min_weight ) {
+                    min_weight = weight;
+                    min_port = p;
+                }
             }
         }
     }
+
+    if ( min_weight <= output_queue_lengths[escape_port * num_vcs + escape_vc] ) {
+        tt_ev->setNextPort(min_port);
+        tt_ev->setVC(adaptive_vc);
+    }
+    else {
+        tt_ev->setNextPort(escape_port);
+        tt_ev->setVC(escape_vc);
+    }
 }
 
 
@@ -148,7 +282,9 @@ topo_torus::process_input(RtrEvent* ev)
 {
     topo_torus_event* tt_ev = new topo_torus_event(dimensions);
     tt_ev->setEncapsulatedEvent(ev);
-    tt_ev->setVC(tt_ev->getVN() * 2);
+    // Packets using adaptive routing start on the adaptive VC
+    int vn = tt_ev->getVN();
+    tt_ev->setVC(vns[vn].algorithm == MINA ? vns[vn].start_vc + 2 : vns[vn].start_vc);
     
     // Need to figure out what the torus address is for easier
     // routing.
@@ -269,6 +405,17 @@ topo_torus::get_dest_local_port(int dest_id) const
 }
 
 
+int
+topo_torus::get_port_dim(int port) const
+{
+    if ( port >= local_port_start ) return -1;
+    for ( int dim = 0 ; dim < dimensions ; dim++ ) {
+        if ( port < port_start[dim][1] + dim_width[dim] ) return dim;
+    }
+    return -1;
+}
+
+
 int
 topo_torus::choose_multipath(int start_port, int num_ports, int dest_dist)
 {
@@ -286,4 +433,9 @@ topo_torus::getEndpointID(int port)
     return (router_id * num_local_ports) + (port - local_port_start);
 }
 
-
+void
+topo_torus::setOutputQueueLengthsArray(int const* array, int vcs)
+{
+    output_queue_lengths = array;
+    num_vcs = vcs;
+}
@@ -88,6 +88,7 @@ public:
         {"torus.width", "Number of links between routers in each dimension, specified in same manner as for shape.  "
                         "For example, 2x2x1 denotes 2 links in the x and y dimensions and one in the z dimension."},
         {"torus.local_ports", "Number of endpoints attached to each router."},
+        {"torus.algorithm", "Routing algorithm to use.", "DOR"},
 
 
         {"shape", "Shape of the torus specified as the number of routers in each dimension, where each dimension is "
@@ -95,8 +96,16 @@ public:
         {"width", "Number of links between routers in each dimension, specified in same manner as for shape.  For "
                   "example, 2x2x1 denotes 2 links in the x and y dimensions and one in the z dimension."},
         {"local_ports", "Number of endpoints attached to each router."},
+        {"algorithm", "Routing algorithm to use.  DOR is dimension order routing with two dateline VCs.  MIN-A is "
+                      "minimal adaptive routing that uses a third VC for adaptive hops and the two DOR VCs as escape "
+                      "channels.  Can be specified as an array to set the algorithm for each VN.", "DOR"}
     )
 
+    enum RouteAlgo {
+        DOR,
+        MINA
+    };
+
 
 private:
     int router_id;
@@ -111,8 +120,18 @@ private:
     int num_local_ports;
     int local_port_start;
 
+    int const* output_queue_lengths;
+    int num_vcs;
     int num_vns;
-    
+
+    struct vn_info {
+        int start_vc;
+        int num_vcs;
+        RouteAlgo algorithm;
+    };
+
+    vn_info* vns;
+
 public:
     topo_torus(ComponentId_t cid, Params& params, int num_ports, int rtr_id, int num_vns);
     ~topo_torus();
@@ -126,9 +145,11 @@ public:
     virtual PortState getPortState(int port) const;
     virtual int getEndpointID(int port);
 
+    virtual void setOutputQueueLengthsArray(int const* array, int vcs);
+
     virtual void getVCsPerVN(std::vector<int>& vcs_per_vn) {
         for ( int i = 0; i < num_vns; ++i ) {
-            vcs_per_vn[i] = 2;
+            vcs_per_vn[i] = vns[i].num_vcs;
         }
     }
     
@@ -140,6 +161,10 @@ private:
     void parseDimString(const std::string &shape, int *output) const;
     int get_dest_router(int dest_id) const;
     int get_dest_local_port(int dest_id) const;
+    int get_port_dim(int port) const;
+
+    void routeDOR(int port, int vc, topo_torus_event* ev);
+    void routeMINA(int port, int vc, topo_torus_event* ev);
 
 };
 
@@ -0,0 +1,461 @@
+// Copyright 2009-2023 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2023, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+
+#include <sst_config.h>
+#include <sst/core/params.h>
+#include <sst/elements/miranda/generators/csrgraphgen.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <utility>
+
+using namespace SST::Miranda;
+
+#define CSR_GRAPH_UNVISITED 0xFFFFFFFF
+#define CSR_GRAPH_ALIGN(addr) (((addr) + 63) & ~((uint64_t) 63))
+
+CSRGraphGenerator::CSRGraphGenerator( ComponentId_t id, Params& params ) : RequestGenerator(id, params) {
+    build(params);
+}
+
+void CSRGraphGenerator::build(Params& params) {
+    const uint32_t verbose = params.find<uint32_t>("verbose", 0);
+
+    out = new Output("CSRGraphGenerator[@p:@l]: ", verbose, 0, Output::STDOUT);
+
+    const std::string graphFile = params.find<std::string>("graph_file", "");
+    const std::string graphFormat = params.find<std::string>("graph_format", "edgelist");
+    const std::string algorithmName = params.find<std::string>("algorithm", "bfs");
+
+    if ( "" == graphFile ) {
+        out->fatal(CALL_INFO, -1, "Error: graph_file must be set\n");
+    }
+
+    if ( "bfs" == algorithmName ) {
+        algorithm = GRAPH_BFS;
+    } else if ( "pagerank" == algorithmName ) {
+        algorithm = GRAPH_PAGERANK;
+    } else if ( "cc" == algorithmName ) {
+        algorithm = GRAPH_CC;
+    } else {
+        out->fatal(CALL_INFO, -1, "Error: unknown algorithm %s, expected bfs, pagerank or cc\n", algorithmName.c_str());
+    }
+
+    // Labels only travel along out-edges, so cc finds weakly connected
+    // components only when every edge is stored in both directions
+    if ( "edgelist" == graphFormat ) {
+        loadEdgeList(graphFile, (GRAPH_CC == algorithm) || params.find<bool>("undirected", false));
+    } else if ( "csr" == graphFormat ) {
+        loadCSR(graphFile);
+    } else {
+        out->fatal(CALL_INFO, -1, "Error: unknown graph_format %s, expected edgelist or csr\n", graphFormat.c_str());
+    }
+
+    source              = params.find<uint64_t>("source", 0);
+    iterations          = params.find<uint64_t>("iterations", (GRAPH_CC == algorithm) ? 0 : 1);
+    verticesPerGenerate = params.find<uint64_t>("vertices_per_generate", 64);
+
+    if ( 0 == verticesPerGenerate ) {
+        verticesPerGenerate = 1;
+    }
+
+    if ( GRAPH_BFS == algorithm && source >= vertexCount ) {
+        out->fatal(CALL_INFO, -1, "Error: BFS source %" PRIu64 " is not a vertex of a graph with %" PRIu64 " vertices\n",
+            source, vertexCount);
+    }
+
+    wordCount = (vertexCount + 63) / 64;
+    valueWidth = (GRAPH_PAGERANK == algorithm) ? sizeof(uint64_t) : sizeof(uint32_t);
+
+    if ( GRAPH_PAGERANK != algorithm ) {
+        values.resize(vertexCount, CSR_GRAPH_UNVISITED);
+        frontier[0].resize(wordCount, 0);
+        frontier[1].resize(wordCount, 0);
+    }
+
+    layout(params.find<uint64_t>("start_address", 0));
+
+    out->verbose(CALL_INFO, 1, 0, "Loaded %s: %" PRIu64 " vertices, %" PRIu64 " edges, running %s\n",
+        graphFile.c_str(), vertexCount, (uint64_t) neighbours.size(), algorithmName.c_str());
+    out->verbose(CALL_INFO, 1, 0, "Offsets at 0x%" PRIx64 ", neighbours at 0x%" PRIx64 ", values at 0x%" PRIx64 "\n",
+        offsetsStart, neighboursStart, valuesStart);
+    out->verbose(CALL_INFO, 1, 0, "Contributions at 0x%" PRIx64 ", frontiers at 0x%" PRIx64 " and 0x%" PRIx64 "\n",
+        contribStart, frontierStart[0], frontierStart[1]);
+
+    phase = (0 == vertexCount || (GRAPH_PAGERANK == algorithm && 0 == iterations)) ? PHASE_DONE : PHASE_INIT;
+    iteration = 0;
+    cursor = 0;
+    current = 0;
+}
+
+CSRGraphGenerator::~CSRGraphGenerator() {
+    delete out;
+}
+
+void CSRGraphGenerator::loadEdgeList(const std::string& path, const bool undirected) {
+    FILE* graphFile = fopen(path.c_str(), "rt");
+
+    if ( NULL == graphFile ) {
+        out->fatal(CALL_INFO, -1, "Error: unable to open graph file %s\n", path.c_str());
+    }
+
+    std::vector< std::pair<uint32_t, uint32_t> > edges;
+    uint64_t maxVertex = 0;
+    uint64_t lineNumber = 0;
+    char line[1024];
+
+    while ( NULL != fgets(line, sizeof(line), graphFile) ) {
+        uint64_t src, dst;
+        lineNumber++;
+
+        if ( '#' == line[0] || '%' == line[0] ) {
+            continue;
+        }
+
+        if ( 2 != sscanf(line, "%" SCNu64 " %" SCNu64, &src, &dst) ) {
+            continue;
+        }
+
+        if ( src >= CSR_GRAPH_UNVISITED || dst >= CSR_GRAPH_UNVISITED ) {
+            out->fatal(CALL_INFO, -1, "Error: %s line %" PRIu64 ": vertex IDs must fit in 32 bits\n", path.c_str(), lineNumber);
+        }
+
+        maxVertex = std::max(maxVertex, std::max(src + 1, dst + 1));
+        edges.push_back(std::make_pair((uint32_t) src, (uint32_t) dst));
+
+        if ( undirected && src != dst ) {
+            edges.push_back(std::make_pair((uint32_t) dst, (uint32_t) src));
+        }
+    }
+
+    fclose(graphFile);
+
+    // Counting sort of the edges by source vertex
+    vertexCount = maxVertex;
+    offsets.assign(vertexCount + 1, 0);
+
+    for ( size_t i = 0; i < edges.size(); i++ ) {
+        offsets[edges[i].first + 1]++;
+    }
+
+    for ( uint64_t v = 0; v < vertexCount; v++ ) {
+        offsets[v + 1] += offsets[v];
+    }
+
+    std::vector<uint64_t> next(offsets.begin(), offsets.end() - 1);
+    neighbours.resize(edges.size());
+
+    for ( size_t i = 0; i < edges.size(); i++ ) {
+        neighbours[next[edges[i].first]++] = edges[i].second;
+    }
+}
+
+void CSRGraphGenerator::loadCSR(const std::string& path) {
+    FILE* graphFile = fopen(path.c_str(), "rb");
+
+    if ( NULL == graphFile ) {
+        out->fatal(CALL_INFO, -1, "Error: unable to open graph file %s\n", path.c_str());
+    }
+
+    uint64_t edgeCount = 0;
+
+    if ( 1 != fread(&vertexCount, sizeof(uint64_t), 1, graphFile) ||
+            1 != fread(&edgeCount, sizeof(uint64_t), 1, graphFile) ) {
+        out->fatal(CALL_INFO, -1, "Error: %s is too short for a CSR header\n", path.c_str());
+    }
+
+    if ( vertexCount >= CSR_GRAPH_UNVISITED ) {
+        out->fatal(CALL_INFO, -1, "Error: %s has %" PRIu64 " vertices, vertex IDs must fit in 32 bits\n",
+            path.c_str(), vertexCount);
+    }
+
+    offsets.resize(vertexCount + 1);
+    neighbours.resize(edgeCount);
+
+    if ( offsets.size() != fread(offsets.data(), sizeof(uint64_t), offsets.size(), graphFile) ||
+            neighbours.size() != fread(neighbours.data(), sizeof(uint32_t), neighbours.size(), graphFile) ) {
+        out->fatal(CALL_INFO, -1, "Error: %s is shorter than its header of %" PRIu64 " vertices and %" PRIu64 " edges\n",
+            path.c_str(), vertexCount, edgeCount);
+    }
+
+    fclose(graphFile);
+
+    if ( 0 != offsets[0] || edgeCount != offsets[vertexCount] ) {
+        out->fatal(CALL_INFO, -1, "Error: %s offsets must run from 0 to the edge count\n", path.c_str());
+    }
+
+    for ( uint64_t v = 0; v < vertexCount; v++ ) {
+        if ( offsets[v] > offsets[v + 1] ) {
+            out->fatal(CALL_INFO, -1, "Error: %s offsets decrease at vertex %" PRIu64 "\n", path.c_str(), v);
+        }
+    }
+
+    for ( uint64_t e = 0; e < edgeCount; e++ ) {
+        if ( neighbours[e] >= vertexCount ) {
+            out->fatal(CALL_INFO, -1, "Error: %s edge %" PRIu64 " points to vertex %" PRIu32 " beyond the graph\n",
+                path.c_str(), e, neighbours[e]);
+        }
+    }
+}
+
+void CSRGraphGenerator::layout(const uint64_t startAddr) {
+    offsetsStart    = CSR_GRAPH_ALIGN(startAddr);
+    neighboursStart = CSR_GRAPH_ALIGN(offsetsStart + (vertexCount + 1) * sizeof(uint64_t));
+    valuesStart     = CSR_GRAPH_ALIGN(neighboursStart + neighbours.size() * sizeof(uint32_t));
+    contribStart    = CSR_GRAPH_ALIGN(valuesStart + vertexCount * valueWidth);
+
+    const uint64_t contribBytes = (GRAPH_PAGERANK == algorithm) ? vertexCount * sizeof(uint64_t) : 0;
+    const uint64_t frontierBytes = (GRAPH_PAGERANK == algorithm) ? 0 : wordCount * sizeof(uint64_t);
+
+    frontierStart[0] = CSR_GRAPH_ALIGN(contribStart + contribBytes);
+    frontierStart[1] = CSR_GRAPH_ALIGN(frontierStart[0] + frontierBytes);
+}
+
+MemoryOpRequest* CSRGraphGenerator::pushRead(MirandaRequestQueue<GeneratorRequest*>* q, const uint64_t addr,
+        const uint64_t length, const std::vector<MemoryOpRequest*>& deps) {
+
+    MemoryOpRequest* req = new MemoryOpRequest(addr, length, READ);
+
+    for ( size_t i = 0; i < deps.size(); i++ ) {
+        req->addDependency(deps[i]->getRequestID());
+    }
+
+    q->push_back(req);
+    return req;
+}
+
+MemoryOpRequest* CSRGraphGenerator::pushWrite(MirandaRequestQueue<GeneratorRequest*>* q, const uint64_t addr,
+        const uint64_t length, const std::vector<MemoryOpRequest*>& deps) {
+
+    MemoryOpRequest* req = new MemoryOpRequest(addr, length, WRITE);
+
+    for ( size_t i = 0; i < deps.size(); i++ ) {
+        req->addDependency(deps[i]->getRequestID());
+    }
+
+    q->push_back(req);
+    return req;
+}
+
+// next[vertex / 64] |= bit, a read-modify-write of the next frontier word
+void CSRGraphGenerator::pushFrontierSet(MirandaRequestQueue<GeneratorRequest*>* q, const uint64_t vertex,
+        const std::vector<MemoryOpRequest*>& deps) {
+
+    const uint32_t next = current ^ 1;
+    const uint64_t word = vertex / 64;
+
+    MemoryOpRequest* readWord = pushRead(q, frontierAddr(next, word), sizeof(uint64_t), deps);
+    pushWrite(q, frontierAddr(next, word), sizeof(uint64_t), { readWord });
+
+    frontier[next][word] |= (1ULL << (vertex % 64));
+}
+
+void CSRGraphGenerator::generate(MirandaRequestQueue<GeneratorRequest*>* q) {
+    switch ( phase ) {
+    case PHASE_INIT:
+        generateInit(q);
+        break;
+    case PHASE_SCAN:
+        generateScanWord(q);
+        break;
+    case PHASE_CONTRIB:
+        generateContrib(q);
+        break;
+    case PHASE_GATHER:
+        generateGather(q);
+        break;
+    case PHASE_DONE:
+        break;
+    }
+}
+
+// Initialise the values (depth -1, label v or rank 1/n), cc starts with every vertex in the frontier
+void CSRGraphGenerator::generateInit(MirandaRequestQueue<GeneratorRequest*>* q) {
+    const uint64_t end = std::min(vertexCount, cursor + verticesPerGenerate);
+
+    for ( ; cursor < end; cursor++ ) {
+        pushWrite(q, valueAddr(cursor), valueWidth, {});
+
+        if ( GRAPH_CC == algorithm ) {
+            values[cursor] = (uint32_t) cursor;
+
+            if ( 0 == (cursor % 64) ) {
+                pushWrite(q, frontierAddr(current, cursor / 64), sizeof(uint64_t), {});
+            }
+
+            frontier[current][cursor / 64] |= (1ULL << (cursor % 64));
+        }
+    }
+
+    if ( cursor == vertexCount ) {
+        if ( GRAPH_BFS == algorithm ) {
+            // depth[source] = 0 and frontier[source / 64] |= bit
+            MemoryOpRequest* readWord = pushRead(q, frontierAddr(current, source / 64), sizeof(uint64_t), {});
+            pushWrite(q, frontierAddr(current, source / 64), sizeof(uint64_t), { readWord });
+            pushWrite(q, valueAddr(source), valueWidth, {});
+
+            values[source] = 0;
+            frontier[current][source / 64] |= (1ULL << (source % 64));
+        }
+
+        endPass(q);
+    }
+}
+
+// One word of the current frontier: every vertex in it visits its neighbours
+void CSRGraphGenerator::generateScanWord(MirandaRequestQueue<GeneratorRequest*>* q) {
+    const uint64_t word = cursor++;
+    uint64_t bits = frontier[current][word];
+
+    MemoryOpRequest* readWord = pushRead(q, frontierAddr(current, word), sizeof(uint64_t), {});
+
+    if ( 0 != bits ) {
+        // Clear the word so the bitmap can be reused as the frontier after next
+        pushWrite(q, frontierAddr(current, word), sizeof(uint64_t), { readWord });
+        frontier[current][word] = 0;
+    }
+
+    while ( 0 != bits ) {
+        const uint64_t v = word * 64 + __builtin_ctzll(bits);
+        bits &= bits - 1;
+
+        MemoryOpRequest* readValue = NULL;
+        uint32_t value = 0;
+
+        if ( GRAPH_CC == algorithm ) {
+            readValue = pushRead(q, valueAddr(v), valueWidth, { readWord });
+            value = values[v];
+        }
+
+        MemoryOpRequest* readStart = pushRead(q, offsetAddr(v), sizeof(uint64_t), { readWord });
+        MemoryOpRequest* readEnd   = pushRead(q, offsetAddr(v + 1), sizeof(uint64_t), { readWord });
+
+        for ( uint64_t e = offsets[v]; e < offsets[v + 1]; e++ ) {
+            const uint32_t u = neighbours[e];
+
+            MemoryOpRequest* readNeighbour = pushRead(q, neighbourAddr(e), sizeof(uint32_t), { readStart, readEnd });
+            MemoryOpRequest* readOther = pushRead(q, valueAddr(u), valueWidth, { readNeighbour });
+
+            if ( GRAPH_BFS == algorithm ) {
+                if ( CSR_GRAPH_UNVISITED == values[u] ) {
+                    values[u] = (uint32_t) (iteration + 1);
+                    pushWrite(q, valueAddr(u), valueWidth, { readOther });
+                    pushFrontierSet(q, u, { readOther });
+                }
+            } else if ( value < values[u] ) {
+                values[u] = value;
+                pushWrite(q, valueAddr(u), valueWidth, { readValue, readOther });
+                pushFrontierSet(q, u, { readValue, readOther });
+            }
+        }
+    }
+
+    if ( cursor == wordCount ) {
+        endPass(q);
+    }
+}
+
+// contrib[v] = rank[v] / degree(v)
+void CSRGraphGenerator::generateContrib(MirandaRequestQueue<GeneratorRequest*>* q) {
+    const uint64_t end = std::min(vertexCount, cursor + verticesPerGenerate);
+
+    for ( ; cursor < end; cursor++ ) {
+        MemoryOpRequest* readRank  = pushRead(q, valueAddr(cursor), valueWidth, {});
+        MemoryOpRequest* readStart = pushRead(q, offsetAddr(cursor), sizeof(uint64_t), {});
+        MemoryOpRequest* readEnd   = pushRead(q, offsetAddr(cursor + 1), sizeof(uint64_t), {});
+
+        pushWrite(q, contribAddr(cursor), sizeof(uint64_t), { readRank, readStart, readEnd });
+    }
+
+    if ( cursor == vertexCount ) {
+        endPass(q);
+    }
+}
+
+// rank[v] = base + damping * sum of contrib[u] over the neighbours u of v
+void CSRGraphGenerator::generateGather(MirandaRequestQueue<GeneratorRequest*>* q) {
+    const uint64_t end = std::min(vertexCount, cursor + verticesPerGenerate);
+
+    for ( ; cursor < end; cursor++ ) {
+        MemoryOpRequest* readStart = pushRead(q, offsetAddr(cursor), sizeof(uint64_t), {});
+        MemoryOpRequest* readEnd   = pushRead(q, offsetAddr(cursor + 1), sizeof(uint64_t), {});
+
+        std::vector<MemoryOpRequest*> sumDeps = { readStart, readEnd };
+
+        for ( uint64_t e = offsets[cursor]; e < offsets[cursor + 1]; e++ ) {
+            MemoryOpRequest* readNeighbour = pushRead(q, neighbourAddr(e), sizeof(uint32_t), { readStart, readEnd });
+            sumDeps.push_back(pushRead(q, contribAddr(neighbours[e]), sizeof(uint64_t), { readNeighbour }));
+        }
+
+        pushWrite(q, valueAddr(cursor), valueWidth, sumDeps);
+    }
+
+    if ( cursor == vertexCount ) {
+        endPass(q);
+    }
+}
+
+// Passes over the graph are separated by a fence, like the barrier between the loops of the kernel
+void CSRGraphGenerator::endPass(MirandaRequestQueue<GeneratorRequest*>* q) {
+    q->push_back(new FenceOpRequest());
+    cursor = 0;
+
+    switch ( phase ) {
+    case PHASE_INIT:
+        phase = (GRAPH_PAGERANK == algorithm) ? PHASE_CONTRIB : PHASE_SCAN;
+        break;
+
+    case PHASE_SCAN:
+        {
+            current ^= 1;
+            iteration++;
+
+            bool frontierEmpty = true;
+            for ( uint64_t w = 0; w < wordCount && frontierEmpty; w++ ) {
+                frontierEmpty = (0 == frontier[current][w]);
+            }
+
+            out->verbose(CALL_INFO, 2, 0, "Completed %s iteration %" PRIu64 "%s\n", (GRAPH_BFS == algorithm) ? "BFS" : "cc",
+                iteration, frontierEmpty ? ", frontier is empty" : "");
+
+            if ( frontierEmpty || (GRAPH_CC == algorithm && 0 != iterations && iteration >= iterations) ) {
+                phase = PHASE_DONE;
+            }
+        }
+        break;
+
+    case PHASE_CONTRIB:
+        phase = PHASE_GATHER;
+        break;
+
+    case PHASE_GATHER:
+        iteration++;
+        out->verbose(CALL_INFO, 2, 0, "Completed PageRank iteration %" PRIu64 "\n", iteration);
+        phase = (iteration >= iterations) ? PHASE_DONE : PHASE_CONTRIB;
+        break;
+
+    case PHASE_DONE:
+        break;
+    }
+}
+
+bool CSRGraphGenerator::isFinished() {
+    return PHASE_DONE == phase;
+}
+
+void CSRGraphGenerator::completed() {
+
+}
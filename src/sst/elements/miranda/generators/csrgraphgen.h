@@ -0,0 +1,140 @@
+// Copyright 2009-2023 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2023, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+
+#ifndef _H_SST_MIRANDA_CSR_GRAPH_GEN
+#define _H_SST_MIRANDA_CSR_GRAPH_GEN
+
+#include <sst/elements/miranda/mirandaGenerator.h>
+#include <sst/core/output.h>
+
+#include <vector>
+
+namespace SST {
+namespace Miranda {
+
+/*
+ * Replays the memory accesses of a scalar CSR graph kernel on a real graph.
+ * The kernel is executed functionally alongside the generator so data
+ * dependent accesses (which vertices join the frontier, which labels change)
+ * follow the input graph. The simulated memory holds, each 64-byte aligned:
+ *
+ *   offsets     (vertices + 1) x 8 bytes
+ *   neighbours  edges x 4 bytes
+ *   values      vertices x 4 bytes (bfs depth, cc label) or 8 bytes (pagerank rank)
+ *   contrib     vertices x 8 bytes (pagerank only)
+ *   frontier    two bitmaps of vertices bits (bfs and cc only)
+ */
+class CSRGraphGenerator : public RequestGenerator {
+
+public:
+	CSRGraphGenerator( ComponentId_t id, Params& params );
+	void build(Params& params);
+	~CSRGraphGenerator();
+	void generate(MirandaRequestQueue<GeneratorRequest*>* q);
+	bool isFinished();
+	void completed();
+
+	SST_ELI_REGISTER_SUBCOMPONENT(
+		CSRGraphGenerator,
+		"miranda",
+		"CSRGraphGenerator",
+		SST_ELI_ELEMENT_VERSION(1,0,0),
+		"Creates the access stream of BFS, PageRank or connected components over a CSR graph loaded from a file",
+		SST::Miranda::RequestGenerator
+	)
+
+	SST_ELI_DOCUMENT_PARAMS(
+		{ "verbose",        "Sets the verbosity output of the generator", "0" },
+		{ "graph_file",     "Graph to load, required", "" },
+		{ "graph_format",   "Format of graph_file: edgelist (text \"src dst\" per line, # or % comments) or csr (binary: uint64_t vertices, uint64_t edges, uint64_t offsets[vertices+1], uint32_t neighbours[edges])", "edgelist" },
+		{ "undirected",     "Add the reverse of every edge when loading an edge list, always done for cc", "0" },
+		{ "algorithm",      "Kernel to replay: bfs, pagerank or cc (label propagation connected components, which needs every edge in both directions so a csr graph_file must already be symmetric)", "bfs" },
+		{ "source",         "Source vertex of the BFS", "0" },
+		{ "iterations",     "Number of PageRank iterations (default 1), or maximum number of cc iterations (default 0, run to convergence)", "1" },
+		{ "start_address",  "Address of the first graph array", "0" },
+		{ "vertices_per_generate", "Vertices (one bitmap word for bfs and cc) processed on each call to the generator", "64" }
+	)
+
+private:
+	typedef enum {
+		GRAPH_BFS,
+		GRAPH_PAGERANK,
+		GRAPH_CC
+	} GraphAlgorithm;
+
+	typedef enum {
+		PHASE_INIT,
+		PHASE_SCAN,
+		PHASE_CONTRIB,
+		PHASE_GATHER,
+		PHASE_DONE
+	} GraphPhase;
+
+	void loadEdgeList(const std::string& path, const bool undirected);
+	void loadCSR(const std::string& path);
+	void layout(const uint64_t startAddr);
+
+	void generateInit(MirandaRequestQueue<GeneratorRequest*>* q);
+	void generateScanWord(MirandaRequestQueue<GeneratorRequest*>* q);
+	void generateContrib(MirandaRequestQueue<GeneratorRequest*>* q);
+	void generateGather(MirandaRequestQueue<GeneratorRequest*>* q);
+	void endPass(MirandaRequestQueue<GeneratorRequest*>* q);
+
+	MemoryOpRequest* pushRead(MirandaRequestQueue<GeneratorRequest*>* q, const uint64_t addr,
+		const uint64_t length, const std::vector<MemoryOpRequest*>& deps);
+	MemoryOpRequest* pushWrite(MirandaRequestQueue<GeneratorRequest*>* q, const uint64_t addr,
+		const uint64_t length, const std::vector<MemoryOpRequest*>& deps);
+	void pushFrontierSet(MirandaRequestQueue<GeneratorRequest*>* q, const uint64_t vertex,
+		const std::vector<MemoryOpRequest*>& deps);
+
+	uint64_t offsetAddr(const uint64_t v) const { return offsetsStart + v * sizeof(uint64_t); }
+	uint64_t neighbourAddr(const uint64_t e) const { return neighboursStart + e * sizeof(uint32_t); }
+	uint64_t valueAddr(const uint64_t v) const { return valuesStart + v * valueWidth; }
+	uint64_t contribAddr(const uint64_t v) const { return contribStart + v * sizeof(uint64_t); }
+	uint64_t frontierAddr(const uint32_t which, const uint64_t word) const {
+		return frontierStart[which] + word * sizeof(uint64_t);
+	}
+
+	Output* out;
+
+	GraphAlgorithm algorithm;
+	GraphPhase phase;
+	uint64_t vertexCount;
+	uint64_t wordCount;
+	uint64_t source;
+	uint64_t iterations;
+	uint64_t iteration;
+	uint64_t cursor;
+	uint64_t verticesPerGenerate;
+	uint32_t current;
+
+	std::vector<uint64_t> offsets;
+	std::vector<uint32_t> neighbours;
+	std::vector<uint32_t> values;
+	std::vector<uint64_t> frontier[2];
+
+	uint64_t valueWidth;
+	uint64_t offsetsStart;
+	uint64_t neighboursStart;
+	uint64_t valuesStart;
+	uint64_t contribStart;
+	uint64_t frontierStart[2];
+};
+
+}
+}
+
+#endif
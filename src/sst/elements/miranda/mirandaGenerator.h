@@ -23,7 +23,10 @@
 #include <sst/core/output.h>
 #include <sst/core/interfaces/stdMem.h>
 
+#include <atomic>
 #include <queue>
+#include <unordered_map>
+#include <vector>
 
 namespace SST {
 namespace Miranda {
@@ -39,7 +42,7 @@ typedef enum {
 
 class GeneratorRequest {
 public:
-	GeneratorRequest() {
+	GeneratorRequest() : outstandingDeps(0) {
 		reqID = nextGeneratorRequestID++;
 	}
 
@@ -51,23 +54,21 @@ public:
 		dependsOn.push_back(depReq);
 	}
 
-	void satisfyDependency(const GeneratorRequest* req) {
-		satisfyDependency(req->getRequestID());
+	const std::vector<uint64_t>& getDependencies() const {
+		return dependsOn;
 	}
 
-	void satisfyDependency(const uint64_t req) {
-		std::vector<uint64_t>::iterator searchDeps;
+	/* Called by the request queue, once when the request is queued and once as each dependency completes */
+	void setOutstandingDependencies(const uint32_t count) {
+		outstandingDeps = count;
+	}
 
-		for(searchDeps = dependsOn.begin(); searchDeps != dependsOn.end(); searchDeps++) {
-			if( req == (*searchDeps) ) {
-				dependsOn.erase(searchDeps);
-				break;
-			}
-		}
+	void satisfyDependency() {
+		outstandingDeps--;
 	}
 
 	bool canIssue() {
-		return dependsOn.empty();
+		return 0 == outstandingDeps;
 	}
 
 	uint64_t getIssueTime() const {
@@ -80,98 +81,122 @@ public:
 protected:
 	uint64_t reqID;
 	uint64_t issueTime;
+	uint32_t outstandingDeps;
 	std::vector<uint64_t> dependsOn;
 private:
 	static std::atomic<uint64_t> nextGeneratorRequestID;
 };
 
+/*
+ * Window of requests waiting to issue, held in a ring that doubles when a
+ * generator pushes more than it holds. Queued requests are registered with
+ * a scoreboard that maps each request ID to the requests waiting on it, so
+ * a completion only touches its own dependents. Dependencies are matched
+ * by ID only, a request may depend on one queued after it.
+ */
 template<typename QueueType>
 class MirandaRequestQueue {
 public:
-       	MirandaRequestQueue() {
-                        theQ = (QueueType*) malloc(sizeof(QueueType) * 16);
-                        maxCapacity = 16;
-                        curSize = 0;
-                }
-        ~MirandaRequestQueue() {
-               	free(theQ);
-        }
-
-        bool empty() const {
-               	return 0 == curSize;
-        }
-
-        void resize(const uint32_t newSize) {
-//		printf("Resizing MirandaQueue from: %" PRIu32 " to %" PRIu32 "\n",
-//			curSize, newSize);
-
-               	QueueType * newQ = (QueueType *) malloc(sizeof(QueueType) * newSize);
-               	for(uint32_t i = 0; i < curSize; ++i) {
-                       	newQ[i] = theQ[i];
-                }
-
-                free(theQ);
-               	theQ = newQ;
-               	maxCapacity = newSize;
-               	curSize = std::min(curSize, newSize);
-        }
+	MirandaRequestQueue() : head(0), curSize(0) {
+		theQ.resize(16);
+		mask = theQ.size() - 1;
+	}
+
+	bool empty() const {
+		return 0 == curSize;
+	}
+
+	void resize(const uint32_t newSize) {
+		uint32_t slots = 1;
+		while(slots < newSize) {
+			slots <<= 1;
+		}
+
+		curSize = std::min(curSize, newSize);
+		regrow(slots);
+	}
 
 	uint32_t size() const {
 		return curSize;
 	}
 
 	uint32_t capacity() const {
-		return maxCapacity;
+		return (uint32_t) theQ.size();
 	}
 
-       	QueueType at(const uint32_t index) {
-               	return theQ[index];
-       	}
+	QueueType at(const uint32_t index) {
+		return theQ[(head + index) & mask];
+	}
 
-       	void erase(const std::vector<uint32_t> eraseList) {
+	/* Removes the entries at the (ascending) indices, entries in front of them move up in place */
+	void erase(const std::vector<uint32_t>& eraseList) {
 		if(0 == eraseList.size()) {
 			return;
 		}
 
-               	QueueType* newQ = (QueueType*) malloc(sizeof(QueueType) * maxCapacity);
+		uint32_t nextSkipIndex = eraseList.size();
+		uint32_t dest = eraseList.back();
+
+		for(uint32_t i = eraseList.back() + 1; i-- > 0; ) {
+			if(nextSkipIndex > 0 && eraseList[nextSkipIndex - 1] == i) {
+				nextSkipIndex--;
+			} else {
+				theQ[(head + dest) & mask] = theQ[(head + i) & mask];
+				dest--;
+			}
+		}
+
+		head = (head + eraseList.size()) & mask;
+		curSize -= eraseList.size();
+	}
 
-               	uint32_t nextSkipIndex = 0;
-               	uint32_t nextSkip = eraseList.at(nextSkipIndex);
-                uint32_t nextNewQIndex = 0;
+	void push_back(QueueType t) {
+		if(curSize == theQ.size()) {
+			regrow(theQ.size() * 2);
+		}
 
-               	for(uint32_t i = 0; i < curSize; ++i) {
-                       	if(nextSkip == i) {
-                                nextSkipIndex++;
+		const std::vector<uint64_t>& deps = t->getDependencies();
+		for(size_t i = 0; i < deps.size(); ++i) {
+			waiters[deps[i]].push_back(t);
+		}
+		t->setOutstandingDependencies(deps.size());
 
-                                if(nextSkipIndex >= eraseList.size()) {
-                                       	nextSkip = curSize;
-                               	} else {
-                                       	nextSkip = eraseList.at(nextSkipIndex);
-                                }
-                       	} else {
-                               	newQ[nextNewQIndex] = theQ[i];
-                                nextNewQIndex++;
-                       	}
-               	}
+		theQ[(head + curSize) & mask] = t;
+		curSize++;
+	}
 
-                free(theQ);
+	/* The request with this ID has completed, release everything waiting on it */
+	void satisfyDependency(const uint64_t reqID) {
+		auto waitFind = waiters.find(reqID);
 
-               	theQ = newQ;
-		curSize = nextNewQIndex;
-        }
+		if(waitFind == waiters.end()) {
+			return;
+		}
 
-	void push_back(QueueType t) {
-                if(curSize == maxCapacity) {
-                        resize(maxCapacity + 16);
-                }
+		for(size_t i = 0; i < waitFind->second.size(); ++i) {
+			waitFind->second[i]->satisfyDependency();
+		}
 
-                theQ[curSize] = t;
-                curSize++;
-        }
+		waiters.erase(waitFind);
+	}
 private:
-        QueueType* theQ;
-        uint32_t maxCapacity;
-        uint32_t curSize;
+	void regrow(const size_t slots) {
+		std::vector<QueueType> newQ(slots);
+
+		for(uint32_t i = 0; i < curSize; ++i) {
+			newQ[i] = theQ[(head + i) & mask];
+		}
+
+		theQ.swap(newQ);
+		mask = theQ.size() - 1;
+		head = 0;
+	}
+
+	std::vector<QueueType> theQ;
+	std::unordered_map<uint64_t, std::vector<QueueType> > waiters;
+	size_t mask;
+	size_t head;
+	uint32_t curSize;
 };
 
 class MemoryOpRequest : public GeneratorRequest {
@@ -16,6 +16,7 @@
 #include <sst_config.h>
 
 #include "generators/copygen.h"
+#include "generators/csrgraphgen.h"
 #include "generators/gupsgen.h"
 #include "generators/inorderstreambench.h"
 #include "generators/nullgen.h"
@@ -0,0 +1,16 @@
+# Small directed graph for csrgraphgen.py: src dst per line
+# Vertices 0-7 are one weakly connected component, 8-10 a second one,
+# 11 has no edges of its own and only appears as a self loop
+0 1
+0 2
+1 3
+2 3
+3 4
+4 5
+5 3
+6 5
+6 7
+7 0
+8 9
+10 9
+11 11
@@ -0,0 +1,78 @@
+import sst
+import os
+
+# Define SST core options
+sst.setProgramOption("timebase", "1ps")
+
+graph_file = os.path.join(os.path.dirname(__file__), "csrgraphgen.el")
+
+# Only the statistics fixed by the generated access stream are enabled, the
+# stream follows the graph and does not depend on memory timing
+stream_stats = [
+    "read_reqs",
+    "write_reqs",
+    "split_read_reqs",
+    "split_write_reqs",
+    "total_bytes_read",
+    "total_bytes_write",
+]
+
+# Tell SST what statistics handling we want
+sst.setStatisticLoadLevel(4)
+
+def build(algorithm, gen_params):
+    cpu = sst.Component("cpu_" + algorithm, "miranda.BaseCPU")
+    cpu.addParams({
+        "verbose" : 0,
+        "clock" : "2GHz",
+        "printStats" : 1,
+    })
+
+    gen = cpu.setSubComponent("generator", "miranda.CSRGraphGenerator")
+    gen.addParams({
+        "verbose" : 0,
+        "graph_file" : graph_file,
+        "algorithm" : algorithm,
+        "vertices_per_generate" : 4,
+    })
+    gen.addParams(gen_params)
+
+    cpu.enableStatistics(stream_stats, {"type":"sst.AccumulatorStatistic"})
+
+    l1cache = sst.Component("l1cache_" + algorithm, "memHierarchy.Cache")
+    l1cache.addParams({
+        "access_latency_cycles" : "2",
+        "cache_frequency" : "2 GHz",
+        "replacement_policy" : "lru",
+        "coherence_protocol" : "MESI",
+        "associativity" : "4",
+        "cache_line_size" : "64",
+        "L1" : "1",
+        "cache_size" : "2KB"
+    })
+
+    memctrl = sst.Component("memory_" + algorithm, "memHierarchy.MemController")
+    memctrl.addParams({
+        "clock" : "1GHz",
+        "addr_range_end" : 512 * 1024 * 1024 - 1
+    })
+    memory = memctrl.setSubComponent("backend", "memHierarchy.simpleMem")
+    memory.addParams({
+        "access_time" : "100 ns",
+        "mem_size" : "512MiB",
+    })
+
+    cpu_cache_link = sst.Link("cpu_cache_link_" + algorithm)
+    cpu_cache_link.connect( (cpu, "cache_link", "1000ps"), (l1cache, "high_network_0", "1000ps") )
+    cpu_cache_link.setNoCut()
+
+    cache_mem_link = sst.Link("cache_mem_link_" + algorithm)
+    cache_mem_link.connect( (l1cache, "low_network_0", "50ps"), (memctrl, "direct_link", "50ps") )
+
+# Directed BFS from vertex 0, reaches 0-5
+build("bfs", { "source" : 0 })
+
+# Connected components always loads the edges in both directions
+build("cc", {})
+
+build("pagerank", { "iterations" : 3 })
@@ -2,6 +2,7 @@
 
 from sst_unittest import *
 from sst_unittest_support import *
+import re
 
 ################################################################################
 # Code to support a single instance module initialize, must be called setUp method
@@ -71,6 +72,45 @@ class testcase_miranda_Component(SSTTestCase):
     def test_miranda_gupsgen(self):
         self.miranda_test_template("gupsgen")
 
+    # The request counts follow the graph and not memory timing, so they
+    # are read from the statistics and checked directly
+    def test_miranda_csrgraphgen(self):
+        test_path = self.get_testsuite_dir()
+        outdir = self.get_test_output_run_dir()
+
+        sdlfile = "{0}/csrgraphgen.py".format(test_path)
+        outfile = "{0}/test_miranda_csrgraphgen.out".format(outdir)
+        errfile = "{0}/test_miranda_csrgraphgen.err".format(outdir)
+        mpioutfiles = "{0}/test_miranda_csrgraphgen.testfile".format(outdir)
+
+        self.run_sst(sdlfile, outfile, errfile, mpi_out_files=mpioutfiles, timeout_sec=240)
+
+        # (read_reqs, write_reqs, total_bytes_read, total_bytes_write) for
+        # the graph in csrgraphgen.el; every access is 4B or 8B aligned so
+        # nothing is split
+        expected = {
+            "cpu_bfs" : (37, 29, 240, 160),
+            "cpu_cc" : (164, 33, 868, 180),
+            "cpu_pagerank" : (258, 84, 1908, 672),
+        }
+
+        stats = {}
+        stat_re = re.compile(r"^\s*(\w+)\.(\w+) : Accumulator : Sum.u64 = (\d+);")
+        with open(outfile) as fp:
+            for line in fp:
+                m = stat_re.match(line)
+                if m:
+                    stats[(m.group(1), m.group(2))] = int(m.group(3))
+
+        for cpu, counts in expected.items():
+            names = ["read_reqs", "write_reqs", "total_bytes_read", "total_bytes_write"]
+            for name, value in zip(names, counts):
+                self.assertEqual(stats.get((cpu, name)), value,
+                                 "{0}.{1} in {2}".format(cpu, name, outfile))
+            for name in ["split_read_reqs", "split_write_reqs"]:
+                self.assertEqual(stats.get((cpu, name)), 0,
+                                 "{0}.{1} in {2}".format(cpu, name, outfile))
+
 #####
 
     def miranda_test_template(self, testcase, testtimeout=240):
@@ -45,7 +45,7 @@ class MMU : public SubComponent {
 
     MMU(SST::ComponentId_t id, SST::Params& params);
     virtual ~MMU() {}
-    virtual void checkpoint( std::string ) = 0;
+    virtual void checkpoint( std::string dir, bool binary ) = 0;
     virtual void checkpointLoad( std::string ) = 0;
 
     virtual void init(unsigned int phase);
@@ -161,14 +161,42 @@ int SimpleMMU::getPerms( unsigned pid, uint32_t vpn ) {
     return  pte->perms; 
 }
 
-void SimpleMMU::checkpoint( std::string dir ) {
+static constexpr uint32_t checkpointKind = MemHierarchy::CheckpointFile::makeKind('P','G','T','B');
+
+void SimpleMMU::checkpoint( std::string dir, bool binary ) {
 
     std::stringstream filename;
     filename << dir << "/" << getName();
-    auto fp = fopen(filename.str().c_str(),"w+");
 
     m_dbg.debug(CALL_INFO_LONG,1,MMU_DBG_CHECKPOINT,"Checkpoint component `%s` %s\n",getName().c_str(), filename.str().c_str());
 
+    if ( binary ) {
+        MemHierarchy::CheckpointFile ckpt;
+        if ( ! ckpt.openWrite( filename.str(), checkpointKind, false ) ) {
+            m_dbg.fatal(CALL_INFO, -1, "Error: unable to create checkpoint %s\n", filename.str().c_str());
+        }
+
+        ckpt.write<uint64_t>( m_pageTableMap.size() );
+        for ( auto & x : m_pageTableMap ) {
+            ckpt.write<uint32_t>( x.first );
+            x.second->checkpoint( ckpt );
+        }
+
+        ckpt.write<uint64_t>( m_coreToPid.size() );
+        for ( auto & x : m_coreToPid ) {
+            std::vector<uint32_t> pids( x.begin(), x.end() );
+            ckpt.writeVector( pids );
+        }
+
+        ckpt.close();
+        if ( ! ckpt.good() ) {
+            m_dbg.fatal(CALL_INFO, -1, "Error: failed writing checkpoint %s\n", filename.str().c_str());
+        }
+        return;
+    }
+
+    auto fp = fopen(filename.str().c_str(),"w+");
+
     fprintf(fp,"m_pageTableMap.size() %zu\n",m_pageTableMap.size());
     for ( auto & x : m_pageTableMap ) {
         auto pageTable = x.second;
@@ -190,11 +218,38 @@ void SimpleMMU::checkpoint( std::string dir ) {
 void SimpleMMU::checkpointLoad( std::string dir ) {
     std::stringstream filename;
     filename << dir << "/" << getName();
-    auto fp = fopen(filename.str().c_str(),"r");
-    assert(fp);
 
     m_dbg.debug(CALL_INFO_LONG,1,MMU_DBG_CHECKPOINT,"Checkpoint load component `%s` %s\n",getName().c_str(), filename.str().c_str());
 
+    if ( MemHierarchy::CheckpointFile::isBinary( filename.str() ) ) {
+        MemHierarchy::CheckpointFile ckpt;
+        uint32_t kind;
+        if ( ! ckpt.openRead( filename.str() ) || ! ckpt.readHeader( kind ) || checkpointKind != kind ) {
+            m_dbg.fatal(CALL_INFO, -1, "Error: %s is not an MMU checkpoint\n", filename.str().c_str());
+        }
+
+        uint64_t numTables = ckpt.read<uint64_t>();
+        for ( uint64_t i = 0; i < numTables && ckpt.good(); i++ ) {
+            unsigned pid = ckpt.read<uint32_t>();
+            m_pageTableMap[pid] = new PageTable( ckpt );
+        }
+
+        m_coreToPid.resize( ckpt.read<uint64_t>() );
+        for ( auto & x : m_coreToPid ) {
+            std::vector<uint32_t> pids;
+            ckpt.readVector( pids );
+            x.assign( pids.begin(), pids.end() );
+        }
+
+        if ( ! ckpt.good() ) {
+            m_dbg.fatal(CALL_INFO, -1, "Error: checkpoint %s is truncated\n", filename.str().c_str());
+        }
+        return;
+    }
+
+    auto fp = fopen(filename.str().c_str(),"r");
+    assert(fp);
+
     int size;
     assert( 1 == fscanf( fp, "m_pageTableMap.size() %d\n",&size) );
     m_dbg.debug(CALL_INFO_LONG,1,MMU_DBG_CHECKPOINT,"m_pageTableMap.size() %d\n",size);
@@ -19,6 +19,7 @@
 #include <sst/core/link.h>
 #include "mmu.h"
 #include "mmuTypes.h"
+#include "sst/elements/memHierarchy/checkpointFile.h"
 
 namespace SST {
 
@@ -44,7 +45,7 @@ class SimpleMMU : public MMU {
     )
 
     SimpleMMU(SST::ComponentId_t id, SST::Params& params);
-    void checkpoint( std::string );
+    void checkpoint( std::string dir, bool binary );
     void checkpointLoad( std::string );
 
     virtual void removeWrite( unsigned pid );
@@ -148,6 +149,26 @@ class SimpleMMU : public MMU {
                 fprintf(fp,"vpn: %d, ppn: %d, perms: %#lx \n", x.first,x.second.ppn,x.second.perms );
             }
         }
+
+        // binary form is one (vpn, ppn, perms) triple per entry, in vpn order
+        void checkpoint( MemHierarchy::CheckpointFile& ckpt ) {
+            std::vector<uint32_t> entries;
+            entries.reserve( pteMap.size() * 3 );
+            for ( auto & x : pteMap ) {
+                entries.push_back( x.first );
+                entries.push_back( x.second.ppn );
+                entries.push_back( x.second.perms );
+            }
+            ckpt.writeVector( entries );
+        }
+
+        PageTable( MemHierarchy::CheckpointFile& ckpt ) {
+            std::vector<uint32_t> entries;
+            ckpt.readVector( entries );
+            for ( size_t i = 0; i + 2 < entries.size(); i += 3 ) {
+                pteMap.emplace_hint( pteMap.end(), entries[i], PTE( entries[i+1], entries[i+2] ) );
+            }
+        }
       private:
         std::map<uint32_t,PTE> pteMap; 
     };
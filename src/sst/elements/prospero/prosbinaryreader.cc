@@ -17,6 +17,11 @@
 #include "sst_config.h"
 #include "prosbinaryreader.h"
 
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
 using namespace SST::Prospero;
 
 
@@ -31,11 +36,57 @@ ProsperoBinaryTraceReader::ProsperoBinaryTraceReader( ComponentId_t id, Params&
                     getName().c_str(), traceFile.c_str());
 	}
 
-	recordLength = sizeof(uint64_t) + sizeof(char) + sizeof(uint64_t) + sizeof(uint32_t);
-	buffer = (char*) malloc(sizeof(char) * recordLength);
+	recordLength = PROSPERO_BINARY_RECORD_LENGTH;
+	buffer = NULL;
+	readAhead = NULL;
+	mappedTrace = NULL;
+	mappedLength = 0;
+	mappedOffset = 0;
+
+	if(params.find<bool>("mmap", false)) {
+		struct stat traceStat;
+
+		if(0 != fstat(fileno(traceInput), &traceStat)) {
+			output->fatal(CALL_INFO, -1, "%s, Fatal: Unable to stat trace file: %s in binary reader.\n",
+				getName().c_str(), traceFile.c_str());
+		}
+
+		mappedLength = (size_t) traceStat.st_size;
+
+		if(mappedLength > 0) {
+			void* mapping = mmap(NULL, mappedLength, PROT_READ, MAP_PRIVATE, fileno(traceInput), 0);
+
+			if(MAP_FAILED == mapping) {
+				output->fatal(CALL_INFO, -1, "%s, Fatal: Unable to map trace file: %s in binary reader.\n",
+					getName().c_str(), traceFile.c_str());
+			}
+
+			madvise(mapping, mappedLength, MADV_SEQUENTIAL);
+			mappedTrace = (const char*) mapping;
+		}
+
+		output->verbose(CALL_INFO, 1, 0, "Mapped %" PRIu64 " bytes of binary trace %s\n",
+			(uint64_t) mappedLength, traceFile.c_str());
+	} else {
+		const size_t blockEntries = params.find<size_t>("readahead_entries", 65536);
+		const uint32_t blockCount = params.find<uint32_t>("readahead_blocks", 4);
+		const bool useThread = params.find<bool>("readahead_thread", true);
+
+		buffer = (char*) malloc(sizeof(char) * recordLength * (blockEntries > 0 ? blockEntries : 1));
+		readAhead = new ProsperoReadAhead(
+			[this](ProsperoTraceEntry* entries, size_t maxEntries) { return readBlock(entries, maxEntries); },
+			blockEntries, blockCount, useThread);
+	}
 }
 
 ProsperoBinaryTraceReader::~ProsperoBinaryTraceReader() {
+	// Stop the read-ahead before the file goes away
+	delete readAhead;
+
+	if(NULL != mappedTrace) {
+		munmap((void*) mappedTrace, mappedLength);
+	}
+
 	if(NULL != traceInput) {
 		fclose(traceInput);
 	}
@@ -45,36 +96,38 @@ ProsperoBinaryTraceReader::~ProsperoBinaryTraceReader() {
 	}
 }
 
-void ProsperoBinaryTraceReader::copy(char* target, const char* source,
-	const size_t bufferOffset, const size_t len) {
+/* Called by the read-ahead, possibly on its helper thread */
+size_t ProsperoBinaryTraceReader::readBlock(ProsperoTraceEntry* entries, const size_t maxEntries) {
+	const size_t recordsRead = fread(buffer, (size_t) recordLength, maxEntries, traceInput);
 
-	for(size_t i = 0; i < len; ++i) {
-		target[i] = source[bufferOffset + i];
+	for(size_t i = 0; i < recordsRead; ++i) {
+		prosperoDecodeBinaryRecord(&buffer[i * recordLength], entries[i]);
 	}
+
+	return recordsRead;
 }
 
-ProsperoTraceEntry* ProsperoBinaryTraceReader::readNextEntry() {
-	uint64_t reqAddress = 0;
-	uint64_t reqCycles  = 0;
-	char reqType = 'R';
-	uint32_t reqLength  = 0;
+bool ProsperoBinaryTraceReader::readEntry(ProsperoTraceEntry& entry) {
+	if(NULL != readAhead) {
+		return readAhead->read(entry);
+	}
 
-	if(feof(traceInput)) {
-		return NULL;
+	// A trailing partial record is ignored, as when reading the file
+	if(mappedOffset + recordLength > mappedLength) {
+		return false;
 	}
 
-	if(1 == fread(buffer, (size_t) recordLength, (size_t) 1, traceInput)) {
-		// We DID read an entry
-		copy((char*) &reqCycles,  buffer, (size_t) 0, sizeof(uint64_t));
-		copy((char*) &reqType,    buffer, sizeof(uint64_t), sizeof(char));
-		copy((char*) &reqAddress, buffer, sizeof(uint64_t) + sizeof(char), sizeof(uint64_t));
-		copy((char*) &reqLength,  buffer, sizeof(uint64_t) + sizeof(char) + sizeof(uint64_t), sizeof(uint32_t));
+	prosperoDecodeBinaryRecord(&mappedTrace[mappedOffset], entry);
+	mappedOffset += recordLength;
+	return true;
+}
+
+ProsperoTraceEntry* ProsperoBinaryTraceReader::readNextEntry() {
+	ProsperoTraceEntry entry;
 
-		return new ProsperoTraceEntry(reqCycles, reqAddress,
-			reqLength,
-			(reqType == 'R' || reqType == 'r') ? READ : WRITE);
+	if(readEntry(entry)) {
+		return new ProsperoTraceEntry(entry);
 	} else {
-		// Did not get a full read?
 		return NULL;
 	}
 }
@@ -18,6 +18,7 @@
 #define _H_SST_PROSPERO_BINARY_READER
 
 #include "prosreader.h"
+#include "prosreadahead.h"
 
 namespace SST {
 namespace Prospero {
@@ -28,6 +29,7 @@ public:
     ProsperoBinaryTraceReader( ComponentId_t id, Params& params, Output* out );
     ~ProsperoBinaryTraceReader();
     ProsperoTraceEntry* readNextEntry();
+    bool readEntry(ProsperoTraceEntry& entry);
 
  	SST_ELI_REGISTER_SUBCOMPONENT(
         ProsperoBinaryTraceReader,
@@ -39,16 +41,26 @@ public:
     )
 
 	SST_ELI_DOCUMENT_PARAMS(
-		{ "file", "Sets the file for the trace reader to use", "" }
+		{ "file", "Sets the file for the trace reader to use", "" },
+		{ "mmap", "Map the trace into memory and decode records in place instead of reading it", "0" },
+		{ "readahead_thread", "Read and decode the trace on a helper thread ahead of the simulation", "1" },
+		{ "readahead_entries", "Number of trace entries decoded per read-ahead block", "65536" },
+		{ "readahead_blocks", "Number of read-ahead blocks kept ready", "4" }
 	)
 
 private:
-	void copy(char* target, const char* source,
-		const size_t offset, const size_t len);
+	size_t readBlock(ProsperoTraceEntry* entries, const size_t maxEntries);
+
 	FILE* traceInput;
 	char* buffer;
 	uint32_t recordLength;
 
+	ProsperoReadAhead* readAhead;
+
+	const char* mappedTrace;
+	size_t mappedLength;
+	size_t mappedOffset;
+
 };
 
 }
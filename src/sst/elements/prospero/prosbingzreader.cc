@@ -17,6 +17,8 @@
 #include "sst_config.h"
 #include "prosbingzreader.h"
 
+#include <climits>
+
 using namespace SST::Prospero;
 
 
@@ -31,11 +33,30 @@ ProsperoCompressedBinaryTraceReader::ProsperoCompressedBinaryTraceReader( Compon
 			getName().c_str(), traceFile.c_str());
 	}
 
-	recordLength = sizeof(uint64_t) + sizeof(char) + sizeof(uint64_t) + sizeof(uint32_t);
-	buffer = (char*) malloc(sizeof(char) * recordLength);
+	gzbuffer(traceInput, 1 << 20);
+
+	const size_t blockEntries = params.find<size_t>("readahead_entries", 65536);
+	const uint32_t blockCount = params.find<uint32_t>("readahead_blocks", 4);
+	const bool useThread = params.find<bool>("readahead_thread", true);
+
+	recordLength = PROSPERO_BINARY_RECORD_LENGTH;
+
+	// gzread reads at most INT_MAX bytes at a time
+	if(blockEntries > (size_t) INT_MAX / recordLength) {
+		output->fatal(CALL_INFO, -1, "%s, Fatal: readahead_entries (%" PRIu64 ") is too large, a block may hold at most %" PRIu64 " entries.\n",
+			getName().c_str(), (uint64_t) blockEntries, (uint64_t) (INT_MAX / recordLength));
+	}
+
+	buffer = (char*) malloc(sizeof(char) * recordLength * (blockEntries > 0 ? blockEntries : 1));
+	readAhead = new ProsperoReadAhead(
+		[this](ProsperoTraceEntry* entries, size_t maxEntries) { return readBlock(entries, maxEntries); },
+		blockEntries, blockCount, useThread);
 }
 
 ProsperoCompressedBinaryTraceReader::~ProsperoCompressedBinaryTraceReader() {
+	// Stop the read-ahead before the file goes away
+	delete readAhead;
+
 	if(NULL != traceInput) {
 		gzclose(traceInput);
 	}
@@ -45,42 +66,34 @@ ProsperoCompressedBinaryTraceReader::~ProsperoCompressedBinaryTraceReader() {
 	}
 }
 
-void ProsperoCompressedBinaryTraceReader::copy(char* target, const char* source,
-	const size_t bufferOffset, const size_t len) {
+/* Called by the read-ahead, possibly on its helper thread */
+size_t ProsperoCompressedBinaryTraceReader::readBlock(ProsperoTraceEntry* entries, const size_t maxEntries) {
+	const int bytesRead = gzread(traceInput, buffer, (unsigned int) (recordLength * maxEntries));
 
-	for(size_t i = 0; i < len; ++i) {
-		target[i] = source[bufferOffset + i];
+	if(bytesRead <= 0) {
+		return 0;
 	}
-}
 
-ProsperoTraceEntry* ProsperoCompressedBinaryTraceReader::readNextEntry() {
-	output->verbose(CALL_INFO, 4, 0, "Reading next trace entry...\n");
-
-	uint64_t reqAddress = 0;
-	uint64_t reqCycles  = 0;
-	char reqType = 'R';
-	uint32_t reqLength  = 0;
+	// A trailing partial record is dropped
+	const size_t recordsRead = ((size_t) bytesRead) / recordLength;
 
-	if(gzeof(traceInput)) {
-		output->verbose(CALL_INFO, 2, 0, "End of trace file reached, returning empty request.\n");
-		return NULL;
+	for(size_t i = 0; i < recordsRead; ++i) {
+		prosperoDecodeBinaryRecord(&buffer[i * recordLength], entries[i]);
 	}
 
-	unsigned int bytesRead = gzread(traceInput, buffer, (unsigned int) recordLength);
+	return recordsRead;
+}
 
-	if(bytesRead == recordLength) {
-		// We DID read an entry
-		copy((char*) &reqCycles,  buffer, (size_t) 0, sizeof(uint64_t));
-		copy((char*) &reqType,    buffer, sizeof(uint64_t), sizeof(char));
-		copy((char*) &reqAddress, buffer, sizeof(uint64_t) + sizeof(char), sizeof(uint64_t));
-		copy((char*) &reqLength,  buffer, sizeof(uint64_t) + sizeof(char) + sizeof(uint64_t), sizeof(uint32_t));
+bool ProsperoCompressedBinaryTraceReader::readEntry(ProsperoTraceEntry& entry) {
+	return readAhead->read(entry);
+}
+
+ProsperoTraceEntry* ProsperoCompressedBinaryTraceReader::readNextEntry() {
+	ProsperoTraceEntry entry;
 
-		return new ProsperoTraceEntry(reqCycles, reqAddress,
-			reqLength,
-			(reqType == 'R' || reqType == 'r') ? READ : WRITE);
+	if(readEntry(entry)) {
+		return new ProsperoTraceEntry(entry);
 	} else {
-		output->verbose(CALL_INFO, 2, 0, "Did not read a full record from the compressed trace, returning empty request.\n");
-		// Did not get a full read?
 		return NULL;
 	}
 }
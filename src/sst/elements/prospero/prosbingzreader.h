@@ -18,6 +18,7 @@
 #define _H_SST_PROSPERO_GZ_BINARY_READER
 
 #include "prosreader.h"
+#include "prosreadahead.h"
 #include "zlib.h"
 
 namespace SST {
@@ -29,7 +30,9 @@ public:
     ProsperoCompressedBinaryTraceReader( ComponentId_t id, Params& params, Output* out );
     ~ProsperoCompressedBinaryTraceReader();
     ProsperoTraceEntry* readNextEntry();
-    
+    bool readEntry(ProsperoTraceEntry& entry);
+
+
 	SST_ELI_REGISTER_SUBCOMPONENT(
         ProsperoCompressedBinaryTraceReader,
         "prospero",
@@ -40,14 +43,19 @@ public:
 	)
 
     SST_ELI_DOCUMENT_PARAMS(
-        { "file", "Sets the file for the trace reader to use", "" }
+        { "file", "Sets the file for the trace reader to use", "" },
+        { "readahead_thread", "Decompress and decode the trace on a helper thread ahead of the simulation", "1" },
+        { "readahead_entries", "Number of trace entries decoded per read-ahead block", "65536" },
+        { "readahead_blocks", "Number of read-ahead blocks kept ready", "4" }
     )
 
 private:
-	void copy(char* target, const char* source, const size_t buffOffset, const size_t len);
+	size_t readBlock(ProsperoTraceEntry* entries, const size_t maxEntries);
+
 	gzFile traceInput;
 	char* buffer;
 	uint32_t recordLength;
+	ProsperoReadAhead* readAhead;
 
 };
 
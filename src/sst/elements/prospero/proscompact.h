@@ -0,0 +1,432 @@
+// Copyright 2009-2023 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2023, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+
+#ifndef _H_SST_PROSPERO_COMPACT
+#define _H_SST_PROSPERO_COMPACT
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/types.h>
+
+#include <string>
+#include <utility>
+#include <vector>
+
+/*
+ * Compact Prospero trace format, shared by ProsperoCompactTraceReader and
+ * the sst-prospero-compact converter (so it does not depend on SST core).
+ *
+ *   header   char magic[8] "PROSCPT1", uint32_t version, uint32_t reserved
+ *   blocks   uint32_t records, uint32_t bytes, then bytes of records
+ *   index    optional, uint64_t firstRecord and uint64_t offset per block
+ *   trailer  with an index: uint64_t indexOffset, uint64_t blocks,
+ *            uint64_t records, char magic[8] "PROSIDX1"
+ *
+ * Each record is three varints: the zigzag cycle delta, (length << 1) |
+ * isWrite, and the zigzag address delta. Deltas restart from zero in every
+ * block so a reader can start decoding at any block. The fixed size
+ * integers are stored little endian whatever the host byte order, so a
+ * trace can be read on a different machine than it was written on.
+ */
+
+namespace SST {
+namespace Prospero {
+
+#define PROSPERO_COMPACT_MAGIC       "PROSCPT1"
+#define PROSPERO_COMPACT_INDEX_MAGIC "PROSIDX1"
+#define PROSPERO_COMPACT_VERSION     1
+#define PROSPERO_COMPACT_HEADER_SIZE 16
+#define PROSPERO_COMPACT_TRAILER_SIZE 32
+#define PROSPERO_COMPACT_MAX_RECORD  30
+
+struct ProsperoCompactRecord {
+	uint64_t cycles;
+	uint64_t address;
+	uint32_t length;
+	bool     isWrite;
+};
+
+static inline uint64_t prosperoZigZag(const int64_t value) {
+	return (((uint64_t) value) << 1) ^ (uint64_t) (value >> 63);
+}
+
+static inline int64_t prosperoUnZigZag(const uint64_t value) {
+	return (int64_t) (value >> 1) ^ -((int64_t) (value & 1));
+}
+
+static inline size_t prosperoPutVarint(uint8_t* out, uint64_t value) {
+	size_t length = 0;
+
+	while(value >= 0x80) {
+		out[length++] = (uint8_t) (value | 0x80);
+		value >>= 7;
+	}
+
+	out[length++] = (uint8_t) value;
+	return length;
+}
+
+static inline void prosperoPutLE(uint8_t* out, uint64_t value, const size_t bytes) {
+	for(size_t i = 0; i < bytes; ++i) {
+		out[i] = (uint8_t) value;
+		value >>= 8;
+	}
+}
+
+static inline uint64_t prosperoGetLE(const uint8_t* in, const size_t bytes) {
+	uint64_t value = 0;
+
+	for(size_t i = bytes; i > 0; --i) {
+		value = (value << 8) | in[i - 1];
+	}
+
+	return value;
+}
+
+/* False if the varint runs past end or is longer than 64 bits */
+static inline bool prosperoGetVarint(const uint8_t*& in, const uint8_t* end, uint64_t& value) {
+	value = 0;
+
+	for(uint32_t shift = 0; shift < 64 && in < end; shift += 7) {
+		const uint8_t byte = *in++;
+		value |= ((uint64_t) (byte & 0x7F)) << shift;
+
+		if(0 == (byte & 0x80)) {
+			return true;
+		}
+	}
+
+	return false;
+}
+
+class ProsperoCompactWriter {
+public:
+	ProsperoCompactWriter() : traceFile(NULL), blockRecords(0), withIndex(true),
+		recordsInBlock(0), totalRecords(0), offset(0), prevCycles(0), prevAddress(0) {}
+
+	~ProsperoCompactWriter() { close(); }
+
+	bool open(const std::string& path, const uint32_t recordsPerBlock, const bool index) {
+		traceFile = fopen(path.c_str(), "wb");
+
+		if(NULL == traceFile) {
+			return false;
+		}
+
+		blockRecords = (recordsPerBlock > 0) ? recordsPerBlock : 1;
+		withIndex = index;
+		block.reserve((size_t) blockRecords * PROSPERO_COMPACT_MAX_RECORD);
+
+		uint8_t header[PROSPERO_COMPACT_HEADER_SIZE];
+		memset(header, 0, sizeof(header));
+		memcpy(header, PROSPERO_COMPACT_MAGIC, 8);
+		prosperoPutLE(&header[8], PROSPERO_COMPACT_VERSION, 4);
+
+		offset = 0;
+		put(header, sizeof(header));
+		return true;
+	}
+
+	void write(const uint64_t cycles, const uint64_t address, const uint32_t length, const bool isWrite) {
+		uint8_t record[PROSPERO_COMPACT_MAX_RECORD];
+		size_t used = 0;
+
+		used += prosperoPutVarint(&record[used], prosperoZigZag((int64_t) (cycles - prevCycles)));
+		used += prosperoPutVarint(&record[used], (((uint64_t) length) << 1) | (isWrite ? 1 : 0));
+		used += prosperoPutVarint(&record[used], prosperoZigZag((int64_t) (address - prevAddress)));
+
+		block.insert(block.end(), record, record + used);
+		prevCycles = cycles;
+		prevAddress = address;
+
+		if(++recordsInBlock == blockRecords) {
+			flushBlock();
+		}
+	}
+
+	/* Writes the last block and the index, false if any write failed */
+	bool close() {
+		if(NULL == traceFile) {
+			return true;
+		}
+
+		flushBlock();
+
+		if(withIndex) {
+			const uint64_t indexOffset = offset;
+
+			for(size_t i = 0; i < index.size(); ++i) {
+				put64(index[i].first);
+				put64(index[i].second);
+			}
+
+			put64(indexOffset);
+			put64(index.size());
+			put64(totalRecords);
+			put(PROSPERO_COMPACT_INDEX_MAGIC, 8);
+		}
+
+		const bool ok = (0 == ferror(traceFile));
+		fclose(traceFile);
+		traceFile = NULL;
+		return ok;
+	}
+
+	uint64_t getRecordCount() const { return totalRecords; }
+	uint64_t getByteCount() const { return offset; }
+
+private:
+	void put(const void* data, const size_t length) {
+		fwrite(data, length, 1, traceFile);
+		offset += length;
+	}
+
+	void put64(const uint64_t value) {
+		uint8_t bytes[8];
+		prosperoPutLE(bytes, value, 8);
+		put(bytes, 8);
+	}
+
+	void flushBlock() {
+		if(0 == recordsInBlock) {
+			return;
+		}
+
+		index.push_back(std::make_pair(totalRecords, offset));
+
+		uint8_t blockHeader[8];
+		prosperoPutLE(blockHeader, recordsInBlock, 4);
+		prosperoPutLE(&blockHeader[4], block.size(), 4);
+		put(blockHeader, sizeof(blockHeader));
+		put(block.data(), block.size());
+
+		totalRecords += recordsInBlock;
+		recordsInBlock = 0;
+		prevCycles = 0;
+		prevAddress = 0;
+		block.clear();
+	}
+
+	FILE* traceFile;
+	uint32_t blockRecords;
+	bool withIndex;
+	uint32_t recordsInBlock;
+	uint64_t totalRecords;
+	uint64_t offset;
+	uint64_t prevCycles;
+	uint64_t prevAddress;
+	std::vector<uint8_t> block;
+	std::vector<std::pair<uint64_t, uint64_t> > index;
+};
+
+class ProsperoCompactReader {
+public:
+	ProsperoCompactReader() : traceFile(NULL), endOffset(0), offset(0), totalRecords(0),
+		recordsLeft(0), prevCycles(0), prevAddress(0), next(NULL), end(NULL) {}
+
+	~ProsperoCompactReader() {
+		if(NULL != traceFile) {
+			fclose(traceFile);
+		}
+	}
+
+	/* Returns an empty string on success, otherwise why the file was rejected */
+	std::string open(const std::string& path) {
+		traceFile = fopen(path.c_str(), "rb");
+
+		if(NULL == traceFile) {
+			return "cannot open the file";
+		}
+
+		uint8_t header[PROSPERO_COMPACT_HEADER_SIZE];
+
+		if(1 != fread(header, sizeof(header), 1, traceFile) || 0 != memcmp(header, PROSPERO_COMPACT_MAGIC, 8)) {
+			return "not a compact Prospero trace";
+		}
+
+		if(PROSPERO_COMPACT_VERSION != prosperoGetLE(&header[8], 4)) {
+			return "unsupported compact trace version";
+		}
+
+		// The index, if present, ends the file
+		fseeko(traceFile, 0, SEEK_END);
+		endOffset = (uint64_t) ftello(traceFile);
+
+		if(endOffset >= PROSPERO_COMPACT_HEADER_SIZE + PROSPERO_COMPACT_TRAILER_SIZE) {
+			uint8_t trailer[PROSPERO_COMPACT_TRAILER_SIZE];
+
+			fseeko(traceFile, (off_t) (endOffset - PROSPERO_COMPACT_TRAILER_SIZE), SEEK_SET);
+			if(1 == fread(trailer, sizeof(trailer), 1, traceFile) &&
+				0 == memcmp(&trailer[24], PROSPERO_COMPACT_INDEX_MAGIC, 8)) {
+
+				const uint64_t indexOffset = prosperoGetLE(trailer, 8);
+				const uint64_t blockCount = prosperoGetLE(&trailer[8], 8);
+
+				if(indexOffset + blockCount * 16 + PROSPERO_COMPACT_TRAILER_SIZE == endOffset) {
+					index.resize(blockCount);
+					totalRecords = prosperoGetLE(&trailer[16], 8);
+					endOffset = indexOffset;
+
+					fseeko(traceFile, (off_t) indexOffset, SEEK_SET);
+					for(size_t i = 0; i < index.size(); ++i) {
+						uint8_t entry[16];
+
+						if(1 != fread(entry, sizeof(entry), 1, traceFile)) {
+							return "the block index is truncated";
+						}
+
+						index[i] = std::make_pair(prosperoGetLE(entry, 8), prosperoGetLE(&entry[8], 8));
+					}
+				}
+			}
+		}
+
+		fseeko(traceFile, PROSPERO_COMPACT_HEADER_SIZE, SEEK_SET);
+		offset = PROSPERO_COMPACT_HEADER_SIZE;
+		return "";
+	}
+
+	bool hasIndex() const { return !index.empty(); }
+
+	/* Positions the reader at record, false if the trace is shorter */
+	bool seek(const uint64_t record) {
+		uint64_t first = 0;
+		uint64_t blockOffset = PROSPERO_COMPACT_HEADER_SIZE;
+
+		if(hasIndex()) {
+			if(record >= totalRecords) {
+				return false;
+			}
+
+			size_t lower = 0;
+			size_t upper = index.size();
+
+			while(upper - lower > 1) {
+				const size_t middle = (lower + upper) / 2;
+
+				if(index[middle].first <= record) {
+					lower = middle;
+				} else {
+					upper = middle;
+				}
+			}
+
+			first = index[lower].first;
+			blockOffset = index[lower].second;
+		} else {
+			// Without an index walk the block headers
+			uint8_t blockHeader[8];
+
+			fseeko(traceFile, (off_t) blockOffset, SEEK_SET);
+			while(1 == fread(blockHeader, sizeof(blockHeader), 1, traceFile) &&
+				first + prosperoGetLE(blockHeader, 4) <= record) {
+				first += prosperoGetLE(blockHeader, 4);
+				blockOffset += sizeof(blockHeader) + prosperoGetLE(&blockHeader[4], 4);
+				fseeko(traceFile, (off_t) blockOffset, SEEK_SET);
+			}
+		}
+
+		fseeko(traceFile, (off_t) blockOffset, SEEK_SET);
+		offset = blockOffset;
+		recordsLeft = 0;
+
+		ProsperoCompactRecord skipped;
+		for(uint64_t i = first; i < record; ++i) {
+			if(1 != read(&skipped, 1)) {
+				return false;
+			}
+		}
+
+		return true;
+	}
+
+	/*
+	 * Decodes up to maxRecords records, returns 0 at the end of the trace.
+	 * Returns (size_t) -1 if the trace is corrupt.
+	 */
+	size_t read(ProsperoCompactRecord* records, const size_t maxRecords) {
+		size_t count = 0;
+
+		while(count < maxRecords) {
+			if(0 == recordsLeft && !loadBlock()) {
+				break;
+			}
+
+			uint64_t cycleDelta, lengthOp, addressDelta;
+
+			if(!prosperoGetVarint(next, end, cycleDelta) || !prosperoGetVarint(next, end, lengthOp) ||
+				!prosperoGetVarint(next, end, addressDelta)) {
+				return (size_t) -1;
+			}
+
+			prevCycles += (uint64_t) prosperoUnZigZag(cycleDelta);
+			prevAddress += (uint64_t) prosperoUnZigZag(addressDelta);
+
+			records[count].cycles = prevCycles;
+			records[count].address = prevAddress;
+			records[count].length = (uint32_t) (lengthOp >> 1);
+			records[count].isWrite = (lengthOp & 1) != 0;
+
+			recordsLeft--;
+			count++;
+		}
+
+		return count;
+	}
+
+private:
+	bool loadBlock() {
+		uint8_t blockHeader[8];
+
+		if(offset + sizeof(blockHeader) > endOffset || 1 != fread(blockHeader, sizeof(blockHeader), 1, traceFile)) {
+			return false;
+		}
+
+		const uint32_t blockBytes = (uint32_t) prosperoGetLE(&blockHeader[4], 4);
+
+		block.resize(blockBytes);
+		if(blockBytes > 0 && 1 != fread(block.data(), blockBytes, 1, traceFile)) {
+			return false;
+		}
+
+		offset += sizeof(blockHeader) + blockBytes;
+		recordsLeft = (uint32_t) prosperoGetLE(blockHeader, 4);
+		prevCycles = 0;
+		prevAddress = 0;
+		next = block.data();
+		end = block.data() + block.size();
+		return recordsLeft > 0;
+	}
+
+	FILE* traceFile;
+	uint64_t endOffset;
+	uint64_t offset;
+	uint64_t totalRecords;
+	std::vector<std::pair<uint64_t, uint64_t> > index;
+
+	std::vector<uint8_t> block;
+	uint32_t recordsLeft;
+	uint64_t prevCycles;
+	uint64_t prevAddress;
+	const uint8_t* next;
+	const uint8_t* end;
+};
+
+}
+}
+
+#endif
@@ -0,0 +1,100 @@
+// Copyright 2009-2023 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2023, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+
+#include "sst_config.h"
+#include "proscompactreader.h"
+
+using namespace SST::Prospero;
+
+
+ProsperoCompactTraceReader::ProsperoCompactTraceReader( ComponentId_t id, Params& params, Output* out ) :
+	ProsperoTraceReader(id, params, out) {
+
+	traceFile = params.find<std::string>("file", "");
+	traceCorrupt = false;
+
+	const std::string error = traceInput.open(traceFile);
+	if("" != error) {
+		output->fatal(CALL_INFO, -1, "%s, Fatal: Unable to read trace file: %s in compact reader: %s.\n",
+			getName().c_str(), traceFile.c_str(), error.c_str());
+	}
+
+	const uint64_t startRecord = params.find<uint64_t>("start_record", 0);
+	if(startRecord > 0) {
+		output->verbose(CALL_INFO, 1, 0, "Seeking to record %" PRIu64 " (%s)\n", startRecord,
+			traceInput.hasIndex() ? "indexed" : "no index, scanning block headers");
+
+		if(!traceInput.seek(startRecord)) {
+			output->fatal(CALL_INFO, -1, "%s, Fatal: trace file: %s has fewer than %" PRIu64 " records.\n",
+				getName().c_str(), traceFile.c_str(), startRecord);
+		}
+	}
+
+	const size_t blockEntries = params.find<size_t>("readahead_entries", 65536);
+	const uint32_t blockCount = params.find<uint32_t>("readahead_blocks", 4);
+	const bool useThread = params.find<bool>("readahead_thread", true);
+
+	records.resize(blockEntries > 0 ? blockEntries : 1);
+	readAhead = new ProsperoReadAhead(
+		[this](ProsperoTraceEntry* entries, size_t maxEntries) { return readBlock(entries, maxEntries); },
+		blockEntries, blockCount, useThread);
+}
+
+ProsperoCompactTraceReader::~ProsperoCompactTraceReader() {
+	// Stop the read-ahead before the file goes away
+	delete readAhead;
+}
+
+/* Called by the read-ahead, possibly on its helper thread */
+size_t ProsperoCompactTraceReader::readBlock(ProsperoTraceEntry* entries, const size_t maxEntries) {
+	const size_t recordsRead = traceInput.read(records.data(), maxEntries);
+
+	if((size_t) -1 == recordsRead) {
+		// Reported by readEntry on the simulation thread
+		traceCorrupt = true;
+		return 0;
+	}
+
+	for(size_t i = 0; i < recordsRead; ++i) {
+		entries[i].set(records[i].cycles, records[i].address, records[i].length,
+			records[i].isWrite ? WRITE : READ);
+	}
+
+	return recordsRead;
+}
+
+bool ProsperoCompactTraceReader::readEntry(ProsperoTraceEntry& entry) {
+	if(readAhead->read(entry)) {
+		return true;
+	}
+
+	if(traceCorrupt) {
+		output->fatal(CALL_INFO, -1, "%s, Fatal: trace file: %s is corrupt.\n",
+			getName().c_str(), traceFile.c_str());
+	}
+
+	return false;
+}
+
+ProsperoTraceEntry* ProsperoCompactTraceReader::readNextEntry() {
+	ProsperoTraceEntry entry;
+
+	if(readEntry(entry)) {
+		return new ProsperoTraceEntry(entry);
+	} else {
+		return NULL;
+	}
+}
@@ -0,0 +1,66 @@
+// Copyright 2009-2023 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2023, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+
+#ifndef _H_SST_PROSPERO_COMPACT_READER
+#define _H_SST_PROSPERO_COMPACT_READER
+
+#include "prosreader.h"
+#include "prosreadahead.h"
+#include "proscompact.h"
+
+namespace SST {
+namespace Prospero {
+
+class ProsperoCompactTraceReader : public ProsperoTraceReader {
+
+public:
+    ProsperoCompactTraceReader( ComponentId_t id, Params& params, Output* out );
+    ~ProsperoCompactTraceReader();
+    ProsperoTraceEntry* readNextEntry();
+    bool readEntry(ProsperoTraceEntry& entry);
+
+	SST_ELI_REGISTER_SUBCOMPONENT(
+        ProsperoCompactTraceReader,
+        "prospero",
+        "ProsperoCompactTraceReader",
+        SST_ELI_ELEMENT_VERSION(1,0,0),
+        "Compact (delta/varint encoded) Trace Reader, see sst-prospero-compact",
+        SST::Prospero::ProsperoTraceReader
+    )
+
+	SST_ELI_DOCUMENT_PARAMS(
+		{ "file", "Sets the file for the trace reader to use", "" },
+		{ "start_record", "Start replaying at this record, uses the block index when the trace has one", "0" },
+		{ "readahead_thread", "Decode the trace on a helper thread ahead of the simulation", "1" },
+		{ "readahead_entries", "Number of trace entries decoded per read-ahead block", "65536" },
+		{ "readahead_blocks", "Number of read-ahead blocks kept ready", "4" }
+	)
+
+private:
+	size_t readBlock(ProsperoTraceEntry* entries, const size_t maxEntries);
+
+	ProsperoCompactReader traceInput;
+	std::vector<ProsperoCompactRecord> records;
+	ProsperoReadAhead* readAhead;
+	std::string traceFile;
+	bool traceCorrupt;
+
+};
+
+}
+}
+
+#endif
@@ -86,16 +86,16 @@ ProsperoComponent::ProsperoComponent(ComponentId_t id, Params& params) :
 	output->verbose(CALL_INFO, 1, 0, "Configuration of memory interface completed.\n");
 
 	output->verbose(CALL_INFO, 1, 0, "Reading first entry from the trace reader...\n");
-	currentEntry = reader->readNextEntry();
+	const bool haveEntry = reader->readEntry(currentEntry);
 	output->verbose(CALL_INFO, 1, 0, "Read of first entry complete.\n");
 
 	output->verbose(CALL_INFO, 1, 0, "Creating memory manager with page size %" PRIu64 "...\n", pageSize);
 	memMgr = new ProsperoMemoryManager(pageSize, output);
 	output->verbose(CALL_INFO, 1, 0, "Created memory manager successfully.\n");
 
-	// We start by telling the system to continue to process as long as the first entry
-	// is not NULL
-	traceEnded = currentEntry == NULL;
+	// We start by telling the system to continue to process as long as there
+	// is a first entry
+	traceEnded = !haveEntry;
 
 	readsIssued = 0;
 	writesIssued = 0;
@@ -192,12 +192,12 @@ void ProsperoComponent::handleResponse(StandardMem::Request *ev) {
 }
 
 bool ProsperoComponent::tick(SST::Cycle_t currentCycle) {
-	if(NULL == currentEntry) {
-		output->verbose(CALL_INFO, 16, 0, "Prospero execute on cycle %" PRIu64 ", current entry is NULL, outstanding=%" PRIu32 ", maxOut=%" PRIu32 "\n",
+	if(traceEnded) {
+		output->verbose(CALL_INFO, 16, 0, "Prospero execute on cycle %" PRIu64 ", trace has ended, outstanding=%" PRIu32 ", maxOut=%" PRIu32 "\n",
 			(uint64_t) currentCycle, currentOutstanding, maxOutstanding);
 	} else {
 		output->verbose(CALL_INFO, 16, 0, "Prospero execute on cycle %" PRIu64 ", current entry time: %" PRIu64 ", outstanding=%" PRIu32 ", maxOut=%" PRIu32 "\n",
-			(uint64_t) currentCycle, (uint64_t) currentEntry->getIssueAtCycle(),
+			(uint64_t) currentCycle, (uint64_t) currentEntry.getIssueAtCycle(),
 			currentOutstanding, maxOutstanding);
 	}
 
@@ -217,17 +217,15 @@ bool ProsperoComponent::tick(SST::Cycle_t currentCycle) {
 	// Wait to see if the current operation can be issued, if yes then
 	// go ahead and issue it, otherwise we will stall
 	for(uint32_t i = 0; i < maxIssuePerCycle; ++i) {
-		if(currentCycle >= currentEntry->getIssueAtCycle()) {
+		if(currentCycle >= currentEntry.getIssueAtCycle()) {
 			if(currentOutstanding < maxOutstanding) {
 				// Issue the pending request into the memory subsystem
 				issueRequest(currentEntry);
 
-				// Obtain the next newest request
-				currentEntry = reader->readNextEntry();
-
-				// Trace reader has read all entries, time to begin draining
-				// the system, caches etc
-				if(NULL == currentEntry) {
+				// Obtain the next newest request, the reader fills in the
+				// entry in place. Once it has read all entries, it is time
+				// to begin draining the system, caches etc
+				if(!reader->readEntry(currentEntry)) {
 					traceEnded = true;
 					break;
 				}
@@ -237,7 +235,7 @@ bool ProsperoComponent::tick(SST::Cycle_t currentCycle) {
 			}
 		} else {
 			output->verbose(CALL_INFO, 8, 0, "Not issuing on cycle %" PRIu64 ", waiting for cycle: %" PRIu64 "\n",
-				(uint64_t) currentCycle, currentEntry->getIssueAtCycle());
+				(uint64_t) currentCycle, currentEntry.getIssueAtCycle());
 			// Have reached a point in the trace which is too far ahead in time
 			// so stall until we find that point
 			break;
@@ -257,13 +255,13 @@ bool ProsperoComponent::tick(SST::Cycle_t currentCycle) {
 	return false;
 }
 
-void ProsperoComponent::issueRequest(const ProsperoTraceEntry* entry) {
+void ProsperoComponent::issueRequest(const ProsperoTraceEntry& entry) {
     // Trim request size to cacheline length in case of instructions like xsave, fxsave, etc. (happens rarely)
-    const uint64_t entryAddress = entry->getAddress();
-    const uint64_t entryLength  = std::min((uint64_t) entry->getLength(), cacheLineSize);
+    const uint64_t entryAddress = entry.getAddress();
+    const uint64_t entryLength  = std::min((uint64_t) entry.getLength(), cacheLineSize);
 
     const uint64_t lineOffset   = entryAddress % cacheLineSize;
-    bool  isRead                = entry->isRead();
+    bool  isRead                = entry.isRead();
 
 	if(isRead) {
 		totalBytesRead += entryLength;
@@ -327,7 +325,4 @@ void ProsperoComponent::issueRequest(const ProsperoTraceEntry* entry) {
 
 		currentOutstanding++;
 	}
-
-	// Delete this entry, we are done converting it into a request
-	delete entry;
 }
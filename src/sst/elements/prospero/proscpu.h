@@ -82,11 +82,11 @@ private:
 
   void handleResponse( StandardMem::Request* ev );
   bool tick( Cycle_t );
-  void issueRequest(const ProsperoTraceEntry* entry);
+  void issueRequest(const ProsperoTraceEntry& entry);
 
   Output* output;
   ProsperoTraceReader* reader;
-  ProsperoTraceEntry* currentEntry;
+  ProsperoTraceEntry currentEntry;
   ProsperoMemoryManager* memMgr;
   StandardMem* cache_link;
   FILE* traceFile;
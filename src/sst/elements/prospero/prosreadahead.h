@@ -0,0 +1,185 @@
+// Copyright 2009-2023 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2023, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+
+#ifndef _H_SST_PROSPERO_READ_AHEAD
+#define _H_SST_PROSPERO_READ_AHEAD
+
+#include <cstring>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "prosreader.h"
+
+namespace SST {
+namespace Prospero {
+
+/* A binary trace record: uint64_t cycles, char op, uint64_t address, uint32_t length */
+#define PROSPERO_BINARY_RECORD_LENGTH (sizeof(uint64_t) + sizeof(char) + sizeof(uint64_t) + sizeof(uint32_t))
+
+static inline void prosperoDecodeBinaryRecord(const char* record, ProsperoTraceEntry& entry) {
+	uint64_t reqCycles;
+	char reqType;
+	uint64_t reqAddress;
+	uint32_t reqLength;
+
+	memcpy(&reqCycles,  record, sizeof(uint64_t));
+	memcpy(&reqType,    record + sizeof(uint64_t), sizeof(char));
+	memcpy(&reqAddress, record + sizeof(uint64_t) + sizeof(char), sizeof(uint64_t));
+	memcpy(&reqLength,  record + sizeof(uint64_t) + sizeof(char) + sizeof(uint64_t), sizeof(uint32_t));
+
+	entry.set(reqCycles, reqAddress, reqLength,
+		(reqType == 'R' || reqType == 'r') ? READ : WRITE);
+}
+
+/*
+ * Decodes a trace ahead of the simulation in blocks of entries. The source
+ * fills a block and returns how many entries it decoded, 0 at the end of
+ * the trace. With a helper thread the source runs concurrently and up to
+ * blockCount blocks are kept ready; otherwise blocks are filled on demand.
+ */
+class ProsperoReadAhead {
+public:
+	typedef std::function<size_t(ProsperoTraceEntry*, size_t)> BlockSource;
+
+	ProsperoReadAhead(BlockSource blockSource, const size_t blockEntries, const uint32_t blockCount,
+		const bool useThread) :
+		source(blockSource), current(NULL), next(0), stopping(false), ended(false) {
+
+		const uint32_t count = (useThread && blockCount < 2) ? 2 : ((blockCount < 1) ? 1 : blockCount);
+
+		blocks.resize(count);
+		for(uint32_t i = 0; i < count; ++i) {
+			blocks[i].entries.resize(blockEntries > 0 ? blockEntries : 1);
+			blocks[i].count = 0;
+			freeBlocks.push_back(&blocks[i]);
+		}
+
+		if(useThread) {
+			helper = std::thread(&ProsperoReadAhead::fillBlocks, this);
+		}
+	}
+
+	~ProsperoReadAhead() {
+		if(helper.joinable()) {
+			{
+				std::lock_guard<std::mutex> lock(blockLock);
+				stopping = true;
+			}
+
+			blockFreed.notify_one();
+			helper.join();
+		}
+	}
+
+	bool read(ProsperoTraceEntry& entry) {
+		if(NULL == current || next == current->count) {
+			if(!nextBlock()) {
+				return false;
+			}
+		}
+
+		entry = current->entries[next++];
+		return true;
+	}
+
+private:
+	struct Block {
+		std::vector<ProsperoTraceEntry> entries;
+		size_t count;
+	};
+
+	bool nextBlock() {
+		if(ended) {
+			return false;
+		}
+
+		if(!helper.joinable()) {
+			if(NULL == current) {
+				current = freeBlocks.front();
+			}
+
+			current->count = source(current->entries.data(), current->entries.size());
+			next = 0;
+			ended = (0 == current->count);
+			return !ended;
+		}
+
+		std::unique_lock<std::mutex> lock(blockLock);
+
+		if(NULL != current) {
+			freeBlocks.push_back(current);
+			blockFreed.notify_one();
+		}
+
+		blockFilled.wait(lock, [this] { return !filledBlocks.empty(); });
+		current = filledBlocks.front();
+		filledBlocks.pop_front();
+		next = 0;
+
+		// The helper thread queues an empty block at the end of the trace
+		ended = (0 == current->count);
+		return !ended;
+	}
+
+	void fillBlocks() {
+		std::unique_lock<std::mutex> lock(blockLock);
+
+		while(true) {
+			blockFreed.wait(lock, [this] { return stopping || !freeBlocks.empty(); });
+
+			if(stopping) {
+				break;
+			}
+
+			Block* block = freeBlocks.front();
+			freeBlocks.pop_front();
+
+			lock.unlock();
+			block->count = source(block->entries.data(), block->entries.size());
+			lock.lock();
+
+			filledBlocks.push_back(block);
+			blockFilled.notify_one();
+
+			if(0 == block->count) {
+				break;
+			}
+		}
+	}
+
+	BlockSource source;
+	std::vector<Block> blocks;
+	std::deque<Block*> freeBlocks;
+	std::deque<Block*> filledBlocks;
+	Block* current;
+	size_t next;
+
+	std::mutex blockLock;
+	std::condition_variable blockFilled;
+	std::condition_variable blockFreed;
+	bool stopping;
+	bool ended;
+	std::thread helper;
+};
+
+}
+}
+
+#endif
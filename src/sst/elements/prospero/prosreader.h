@@ -32,6 +32,8 @@ typedef enum {
 
 class ProsperoTraceEntry {
 public:
+	ProsperoTraceEntry() : cycles(0), address(0), length(0), op(READ) {}
+
 	ProsperoTraceEntry(
 		const uint64_t eCyc,
 		const uint64_t eAddr,
@@ -41,6 +43,14 @@ public:
 
 		}
 
+	void set(const uint64_t eCyc, const uint64_t eAddr, const uint32_t eLen,
+		const ProsperoTraceEntryOperation eOp) {
+		cycles = eCyc;
+		address = eAddr;
+		length = eLen;
+		op = eOp;
+	}
+
 	bool isRead() const { return op == READ;  }
 	bool isWrite() const { return op == WRITE; }
 	uint64_t getAddress() const { return address; }
@@ -48,10 +58,10 @@ public:
 	uint64_t getIssueAtCycle() const { return cycles; }
 	ProsperoTraceEntryOperation getOperationType() const { return op; }
 private:
-	const uint64_t cycles;
-	const uint64_t address;
-	const uint32_t length;
-	const ProsperoTraceEntryOperation op;
+	uint64_t cycles;
+	uint64_t address;
+	uint32_t length;
+	ProsperoTraceEntryOperation op;
 };
 
 class ProsperoTraceReader : public SubComponent {
@@ -65,6 +75,23 @@ public:
 
 	~ProsperoTraceReader() { };
 	virtual ProsperoTraceEntry* readNextEntry() { return NULL; };
+
+	/*
+	 * Fills in the next entry without allocating, returns false at the end
+	 * of the trace. Readers which only implement readNextEntry() are
+	 * adapted here.
+	 */
+	virtual bool readEntry(ProsperoTraceEntry& entry) {
+		ProsperoTraceEntry* next = readNextEntry();
+
+		if(NULL == next) {
+			return false;
+		}
+
+		entry = *next;
+		delete next;
+		return true;
+	}
 	void setOutput(Output* out) { output = out; }
 
 protected:
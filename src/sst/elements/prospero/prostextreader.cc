@@ -39,7 +39,7 @@ ProsperoTextTraceReader::~ProsperoTextTraceReader() {
 	}
 }
 
-ProsperoTraceEntry* ProsperoTextTraceReader::readNextEntry() {
+bool ProsperoTextTraceReader::readEntry(ProsperoTraceEntry& entry) {
 	uint64_t reqAddress = 0;
 	uint64_t reqCycles  = 0;
 	char reqType = 'R';
@@ -47,10 +47,21 @@ ProsperoTraceEntry* ProsperoTextTraceReader::readNextEntry() {
 
 	if(EOF == fscanf(traceInput, "%" PRIu64 " %c %" PRIu64 " %" PRIu32 "",
 		&reqCycles, &reqType, &reqAddress, &reqLength) ) {
-		return NULL;
+		return false;
 	} else {
-		return new ProsperoTraceEntry(reqCycles, reqAddress,
+		entry.set(reqCycles, reqAddress,
 			reqLength,
 			(reqType == 'R' || reqType == 'r') ? READ : WRITE);
+		return true;
+	}
+}
+
+ProsperoTraceEntry* ProsperoTextTraceReader::readNextEntry() {
+	ProsperoTraceEntry entry;
+
+	if(readEntry(entry)) {
+		return new ProsperoTraceEntry(entry);
+	} else {
+		return NULL;
 	}
 }
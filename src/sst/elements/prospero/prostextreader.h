@@ -30,6 +30,7 @@ public:
     ProsperoTextTraceReader( ComponentId_t id, Params& params, Output* out );
     ~ProsperoTextTraceReader();
     ProsperoTraceEntry* readNextEntry();
+    bool readEntry(ProsperoTraceEntry& entry);
 
 	SST_ELI_REGISTER_SUBCOMPONENT(
         ProsperoTextTraceReader,
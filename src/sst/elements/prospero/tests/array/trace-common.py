@@ -8,6 +8,7 @@ traceFile = "File Error"
 traceDir = "Dir Error"
 memSize = "4096"
 useTimingDram="no"
+readerParams = {}
 
 def main():
     global Tracetype
@@ -15,9 +16,10 @@ def main():
     global traceDir
     global memSize
     global useTimingDram
+    global readerParams
 
     try:
-        opts, args = getopt.getopt(sys.argv[1:], "", ["TraceType=","UseTimingDram=","TraceDir="])
+        opts, args = getopt.getopt(sys.argv[1:], "", ["TraceType=","UseTimingDram=","TraceDir=","ReaderParam="])
     except getopt.GetopError as err:
         print(str(err))
         sys.exit(2)
@@ -35,6 +37,9 @@ def main():
                 # print "args are ", o, "and", a
                 Tracetype = "CompressedBinary"
                 traceFile = "sstprospero-0-0-gz.trace"
+            elif a == "compact":
+                Tracetype = "Compact"
+                traceFile = "sstprospero-0-0-compact.trace"
             else:
                 print("no match a= ", a)
                 print("Found nothing for o", o)
@@ -43,6 +48,10 @@ def main():
                 useTimingDram = 'yes'
         elif o in ("--TraceDir"):
             traceDir=a
+        elif o in ("--ReaderParam"):
+            # name=value, passed to the trace reader
+            name, value = a.split("=", 1)
+            readerParams["readerParams." + name] = value
         else:
             print("no match for o", o)
             assert False, "Unknown Options !"
@@ -61,6 +70,7 @@ comp_cpu.addParams({
        "reader" : "prospero.Prospero" + Tracetype + "TraceReader",
        "readerParams.file" : traceDir + "/" + traceFile
 })
+comp_cpu.addParams(readerParams)
 comp_l1cache = sst.Component("l1cache", "memHierarchy.Cache")
 comp_l1cache.addParams({
       "access_latency_cycles" : "1",
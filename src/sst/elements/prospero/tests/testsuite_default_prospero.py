@@ -27,6 +27,7 @@ def initializeTestModule_SingleInstance(class_inst):
             class_inst._setup_prospero_test_dirs()
             class_inst._create_prospero_PIN_trace_files()
             class_inst._download_prospero_TAR_trace_files()
+            class_inst._create_prospero_compact_trace_file()
         except:
             pass
         module_init = 1
@@ -65,12 +66,39 @@ class testcase_prospero(SSTTestCase):
     def test_prospero_compressed_withtimingdram_using_TAR_traces(self):
         self.prospero_test_template("compressed", WITH_TIMINGDRAM, USE_TAR_TRACES)
 
+    # The compact trace is converted from the binary one, so the results
+    # match the binary reference files
+    def test_prospero_compact_using_TAR_traces(self):
+        self.prospero_test_template("compact", NO_TIMINGDRAM, USE_TAR_TRACES)
+
+    def test_prospero_compact_withtimingdram_using_TAR_traces(self):
+        self.prospero_test_template("compact", WITH_TIMINGDRAM, USE_TAR_TRACES)
+
     def test_prospero_text_using_TAR_traces(self):
         self.prospero_test_template("text", NO_TIMINGDRAM, USE_TAR_TRACES)
 
     def test_prospero_binary_using_TAR_traces(self):
         self.prospero_test_template("binary", NO_TIMINGDRAM, USE_TAR_TRACES)
 
+    # The binary reader's other read paths must give the same results as
+    # the default threaded read-ahead
+    def test_prospero_binary_unthreaded_using_TAR_traces(self):
+        self.prospero_test_template("binary", NO_TIMINGDRAM, USE_TAR_TRACES,
+                                    reader_params=["readahead_thread=0"], variant="unthreaded")
+
+    def test_prospero_binary_smallblocks_using_TAR_traces(self):
+        self.prospero_test_template("binary", NO_TIMINGDRAM, USE_TAR_TRACES,
+                                    reader_params=["readahead_entries=7", "readahead_blocks=2"], variant="smallblocks")
+
+    def test_prospero_binary_mmap_using_TAR_traces(self):
+        self.prospero_test_template("binary", NO_TIMINGDRAM, USE_TAR_TRACES,
+                                    reader_params=["mmap=1"], variant="mmap")
+
+    @unittest.skipIf(libz_missing, "test_prospero_compressed_unthreaded_using_TAR_traces test: Requires LIBZ, but LIBZ is not found in build configuration.")
+    def test_prospero_compressed_unthreaded_using_TAR_traces(self):
+        self.prospero_test_template("compressed", NO_TIMINGDRAM, USE_TAR_TRACES,
+                                    reader_params=["readahead_thread=0"], variant="unthreaded")
+
     def test_prospero_text_withtimingdram_using_TAR_traces(self):
         self.prospero_test_template("text", WITH_TIMINGDRAM, USE_TAR_TRACES)
 
@@ -95,7 +123,8 @@ class testcase_prospero(SSTTestCase):
 
 #####
 
-    def prospero_test_template(self, trace_name, with_timingdram, use_pin_traces, testtimeout=240):
+    def prospero_test_template(self, trace_name, with_timingdram, use_pin_traces, testtimeout=240,
+                               reader_params=[], variant=""):
         pass
         # Get the path to the test files
         test_path = self.get_testsuite_dir()
@@ -119,10 +148,18 @@ class testcase_prospero(SSTTestCase):
         # Set the various file paths
         if with_timingdram:
             testDataFileName = ("test_prospero_with_timingdram_{0}".format(trace_name))
-            otherargs = '--model-options=\"--TraceType={0} --UseTimingDram=yes --TraceDir={1}\"'.format(trace_name, prospero_trace_dir)
+            modelargs = "--TraceType={0} --UseTimingDram=yes --TraceDir={1}".format(trace_name, prospero_trace_dir)
         else:
             testDataFileName = ("test_prospero_wo_timingdram_{0}".format(trace_name))
-            otherargs = '--model-options=\"--TraceType={0} --UseTimingDram=no --TraceDir={1}\"'.format(trace_name, prospero_trace_dir)
+            modelargs = "--TraceType={0} --UseTimingDram=no --TraceDir={1}".format(trace_name, prospero_trace_dir)
+
+        # Reader variants check against the same reference file
+        refDataFileName = testDataFileName
+        for param in reader_params:
+            modelargs += " --ReaderParam={0}".format(param)
+        otherargs = '--model-options=\"{0}\"'.format(modelargs)
+        if variant != "":
+            testDataFileName = "{0}_{1}".format(testDataFileName, variant)
 
         if use_pin_traces:
             tracetype = "pin"
@@ -130,7 +167,7 @@ class testcase_prospero(SSTTestCase):
             tracetype = "tar"
 
         sdlfile = "{0}/array/trace-common.py".format(test_path)
-        reffile = "{0}/refFiles/{1}.out".format(test_path, testDataFileName)
+        reffile = "{0}/refFiles/{1}.out".format(test_path, refDataFileName)
         outfile = "{0}/{1}_using_{2}_traces.out".format(outdir, testDataFileName, tracetype)
         errfile = "{0}/{1}_using_{2}_traces.out.err".format(outdir, testDataFileName, tracetype)
         mpioutfiles = "{0}/{1}_using_{2}_traces.out.testfile".format(outdir, testDataFileName, tracetype)
@@ -272,6 +309,21 @@ class testcase_prospero(SSTTestCase):
             log_debug("Prospero build binary Traces result = {0}; output =\n{1}".format(rtn.result(), rtn.output()))
             self.assertTrue(rtn.result() == 0, "Binary Traces failed to compile")
 
+####
+
+    def _create_prospero_compact_trace_file(self):
+        log_debug("_create_prospero_compact_trace_file() Running")
+        # Convert the binary TAR trace with sst-prospero-compact
+        elem_bin_dir = sstsimulator_conf_get_value_str("SST_ELEMENT_LIBRARY", "SST_ELEMENT_LIBRARY_BINDIR", "BINDIR_UNDEFINED")
+        filepath_sst_prospero_compact_app = "{0}/sst-prospero-compact".format(elem_bin_dir)
+        self.assertTrue(os.path.isfile(filepath_sst_prospero_compact_app), "sst-prospero-compact not found in {0}".format(elem_bin_dir))
+
+        cmd = "{0} -f binary -i sstprospero-0-0-bin.trace -o sstprospero-0-0-compact.trace".format(filepath_sst_prospero_compact_app)
+        log_debug("Prospero compact Trace build cmd = {0}".format(cmd))
+        rtn = OSCommand(cmd, set_cwd=self.testProsperoTARTracesDir).run()
+        log_debug("Prospero build compact Trace result = {0}; output =\n{1}".format(rtn.result(), rtn.output()))
+        self.assertTrue(rtn.result() == 0, "Compact Trace failed to convert")
+
 ####
 
     def _download_prospero_TAR_trace_files(self):
@@ -0,0 +1,236 @@
+// Copyright 2009-2023 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2023, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+// Converts Prospero text, binary and compressed traces to the compact
+// format read by prospero.ProsperoCompactTraceReader, and back to binary.
+
+#include <sst_config.h>
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#include <string>
+
+#ifdef HAVE_LIBZ
+#include <zlib.h>
+#endif
+
+#include "../proscompact.h"
+
+using namespace SST::Prospero;
+
+#define PROSPERO_RECORD_LENGTH (sizeof(uint64_t) + sizeof(char) + sizeof(uint64_t) + sizeof(uint32_t))
+#define PROSPERO_CONVERT_BLOCK 65536
+
+void printUsage() {
+	printf("sst-prospero-compact [options] -i <input> -o <output>\n");
+	printf("\n");
+	printf("Options:\n");
+	printf("  -f <format>   Input <format> = {text, binary, compressed}, default binary\n");
+	printf("  -b <records>  Records per compact block, the unit of random seek, default 65536\n");
+	printf("  -n            Do not write the block index\n");
+	printf("  -d            Decode a compact trace into a binary trace instead\n");
+	printf("\n");
+}
+
+void encodeRecord(ProsperoCompactWriter& writer, const char* record) {
+	uint64_t reqCycles, reqAddress;
+	uint32_t reqLength;
+	char reqType;
+
+	memcpy(&reqCycles,  record, sizeof(uint64_t));
+	memcpy(&reqType,    record + sizeof(uint64_t), sizeof(char));
+	memcpy(&reqAddress, record + sizeof(uint64_t) + sizeof(char), sizeof(uint64_t));
+	memcpy(&reqLength,  record + sizeof(uint64_t) + sizeof(char) + sizeof(uint64_t), sizeof(uint32_t));
+
+	writer.write(reqCycles, reqAddress, reqLength, !(reqType == 'R' || reqType == 'r'));
+}
+
+int encodeTrace(const std::string& format, const char* inputPath, ProsperoCompactWriter& writer) {
+	static char buffer[PROSPERO_RECORD_LENGTH * PROSPERO_CONVERT_BLOCK];
+
+	if("text" == format) {
+		FILE* input = fopen(inputPath, "rt");
+		if(NULL == input) {
+			fprintf(stderr, "Error: unable to open %s\n", inputPath);
+			return 1;
+		}
+
+		uint64_t reqCycles, reqAddress;
+		uint32_t reqLength;
+		char reqType;
+
+		while(4 == fscanf(input, "%" PRIu64 " %c %" PRIu64 " %" PRIu32 "",
+			&reqCycles, &reqType, &reqAddress, &reqLength)) {
+			writer.write(reqCycles, reqAddress, reqLength, !(reqType == 'R' || reqType == 'r'));
+		}
+
+		fclose(input);
+	} else if("binary" == format) {
+		FILE* input = fopen(inputPath, "rb");
+		if(NULL == input) {
+			fprintf(stderr, "Error: unable to open %s\n", inputPath);
+			return 1;
+		}
+
+		size_t recordsRead;
+		while((recordsRead = fread(buffer, PROSPERO_RECORD_LENGTH, PROSPERO_CONVERT_BLOCK, input)) > 0) {
+			for(size_t i = 0; i < recordsRead; ++i) {
+				encodeRecord(writer, &buffer[i * PROSPERO_RECORD_LENGTH]);
+			}
+		}
+
+		fclose(input);
+#ifdef HAVE_LIBZ
+	} else if("compressed" == format) {
+		gzFile input = gzopen(inputPath, "rb");
+		if(Z_NULL == input) {
+			fprintf(stderr, "Error: unable to open %s\n", inputPath);
+			return 1;
+		}
+
+		int bytesRead;
+		while((bytesRead = gzread(input, buffer, sizeof(buffer))) > 0) {
+			const size_t recordsRead = ((size_t) bytesRead) / PROSPERO_RECORD_LENGTH;
+
+			for(size_t i = 0; i < recordsRead; ++i) {
+				encodeRecord(writer, &buffer[i * PROSPERO_RECORD_LENGTH]);
+			}
+		}
+
+		gzclose(input);
+#endif
+	} else {
+		fprintf(stderr, "Error: input format %s is not valid\n", format.c_str());
+		return 1;
+	}
+
+	return 0;
+}
+
+int decodeTrace(const char* inputPath, const char* outputPath) {
+	ProsperoCompactReader reader;
+	const std::string error = reader.open(inputPath);
+
+	if("" != error) {
+		fprintf(stderr, "Error: unable to read %s: %s\n", inputPath, error.c_str());
+		return 1;
+	}
+
+	FILE* output = fopen(outputPath, "wb");
+	if(NULL == output) {
+		fprintf(stderr, "Error: unable to open %s\n", outputPath);
+		return 1;
+	}
+
+	static ProsperoCompactRecord records[PROSPERO_CONVERT_BLOCK];
+	uint64_t total = 0;
+	size_t count;
+
+	while((count = reader.read(records, PROSPERO_CONVERT_BLOCK)) > 0) {
+		if((size_t) -1 == count) {
+			fprintf(stderr, "Error: %s is corrupt after %" PRIu64 " records\n", inputPath, total);
+			fclose(output);
+			return 1;
+		}
+
+		for(size_t i = 0; i < count; ++i) {
+			char record[PROSPERO_RECORD_LENGTH];
+			const char reqType = records[i].isWrite ? 'W' : 'R';
+
+			memcpy(record, &records[i].cycles, sizeof(uint64_t));
+			memcpy(record + sizeof(uint64_t), &reqType, sizeof(char));
+			memcpy(record + sizeof(uint64_t) + sizeof(char), &records[i].address, sizeof(uint64_t));
+			memcpy(record + sizeof(uint64_t) + sizeof(char) + sizeof(uint64_t), &records[i].length, sizeof(uint32_t));
+
+			fwrite(record, PROSPERO_RECORD_LENGTH, 1, output);
+		}
+
+		total += count;
+	}
+
+	fclose(output);
+	printf("Decoded %" PRIu64 " records\n", total);
+	return 0;
+}
+
+int main(int argc, char* argv[]) {
+	std::string format = "binary";
+	const char* inputPath = NULL;
+	const char* outputPath = NULL;
+	uint32_t blockRecords = PROSPERO_CONVERT_BLOCK;
+	bool withIndex = true;
+	bool decode = false;
+
+	for(int i = 1; i < argc; i++) {
+		if(std::strcmp(argv[i], "--help") == 0 ||
+			std::strcmp(argv[i], "-help") == 0 ||
+			std::strcmp(argv[i], "-h") == 0) {
+
+			printUsage();
+			exit(0);
+		} else if(std::strcmp(argv[i], "-n") == 0) {
+			withIndex = false;
+		} else if(std::strcmp(argv[i], "-d") == 0) {
+			decode = true;
+		} else if(i + 1 < argc && std::strcmp(argv[i], "-f") == 0) {
+			format = argv[++i];
+		} else if(i + 1 < argc && std::strcmp(argv[i], "-i") == 0) {
+			inputPath = argv[++i];
+		} else if(i + 1 < argc && std::strcmp(argv[i], "-o") == 0) {
+			outputPath = argv[++i];
+		} else if(i + 1 < argc && std::strcmp(argv[i], "-b") == 0) {
+			blockRecords = (uint32_t) std::strtoul(argv[++i], NULL, 10);
+		} else {
+			fprintf(stderr, "Error: unknown option %s\n", argv[i]);
+			printUsage();
+			exit(-1);
+		}
+	}
+
+	if(NULL == inputPath || NULL == outputPath) {
+		printUsage();
+		exit(-1);
+	}
+
+	if(decode) {
+		return decodeTrace(inputPath, outputPath);
+	}
+
+	ProsperoCompactWriter writer;
+	if(!writer.open(outputPath, blockRecords, withIndex)) {
+		fprintf(stderr, "Error: unable to open %s\n", outputPath);
+		return 1;
+	}
+
+	if(0 != encodeTrace(format, inputPath, writer)) {
+		return 1;
+	}
+
+	if(!writer.close()) {
+		fprintf(stderr, "Error: writing %s failed\n", outputPath);
+		return 1;
+	}
+
+	const uint64_t records = writer.getRecordCount();
+	const uint64_t compactBytes = writer.getByteCount();
+	const uint64_t binaryBytes = records * PROSPERO_RECORD_LENGTH;
+
+	printf("Converted %" PRIu64 " records, %" PRIu64 " bytes (%.2f bytes per record, %.2fx smaller than binary)\n",
+		records, compactBytes, records > 0 ? ((double) compactBytes) / records : 0.0,
+		compactBytes > 0 ? ((double) binaryBytes) / compactBytes : 0.0);
+	return 0;
+}
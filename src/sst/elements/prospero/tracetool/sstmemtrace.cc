@@ -25,6 +25,10 @@
 #include <iostream>
 #include <inttypes.h>
 
+#ifdef PROSPERO_LIBZ
+#include <zlib.h>
+#endif
+
 using namespace std;
 
 uint32_t max_thread_count;
@@ -36,11 +40,45 @@ uint64_t nextFileTrip;
 const char READ_OPERATION_CHAR = 'R';
 const char WRITE_OPERATION_CHAR = 'W';
 
-char RECORD_BUFFER[ sizeof(uint64_t) + sizeof(uint64_t) + sizeof(uint32_t) + sizeof(char) ];
+const UINT32 RECORD_LENGTH = sizeof(uint64_t) + sizeof(uint64_t) + sizeof(uint32_t) + sizeof(char);
 
 // We have two file pointers, one for compressed traces and one for
 // "normal" (binary or text) traces
 FILE** trace;
+#ifdef PROSPERO_LIBZ
+gzFile* traceCompressed;
+#endif
+
+// Binary and compressed records are collected in per-thread blocks. Full
+// blocks are queued for a Pin internal thread which compresses and writes
+// them, an application thread only waits when all of its blocks are queued.
+#define PROSPERO_WRITER_BLOCKS 4
+
+typedef struct {
+	char*  data;
+	UINT64 length;
+	UINT32 thread;
+	UINT64 nextFile;	// when > 0 switch the thread to this trace file after writing
+} writerBlock;
+
+typedef struct {
+	char*  blocks[PROSPERO_WRITER_BLOCKS];
+	UINT32 freeHead;
+	UINT32 freeCount;
+	char*  current;
+	UINT64 used;
+	PIN_SEMAPHORE blockFree;
+} threadWriter;
+
+threadWriter* writers;
+writerBlock* writerQueue;
+UINT32 writerQueueHead;
+UINT32 writerQueueCount;
+UINT32 writerQueueSize;
+UINT32 writerShutdown;
+PIN_MUTEX writerLock;
+PIN_SEMAPHORE writerWork;
+PIN_THREAD_UID writerThreadUID;
 
 typedef struct {
 	UINT64 threadInit;
@@ -91,6 +129,131 @@ void copy(VOID* dest, const VOID* source, int destoffset, int count) {
 	}
 }
 
+VOID OpenTraceFile(UINT32 id, UINT64 fileIndex) {
+	char buffer[256];
+
+	if(1 == trace_format) {
+		sprintf(buffer, "%s-%lu-%lu-bin.trace", KnobTraceFile.Value().c_str(),
+			(unsigned long) id, (unsigned long) fileIndex);
+		trace[id] = fopen(buffer, "wb");
+#ifdef PROSPERO_LIBZ
+	} else if(2 == trace_format) {
+		sprintf(buffer, "%s-%lu-%lu.trace.gz", KnobTraceFile.Value().c_str(),
+			(unsigned long) id, (unsigned long) fileIndex);
+		traceCompressed[id] = gzopen(buffer, "wb");
+#endif
+	}
+}
+
+VOID CloseTraceFile(UINT32 id) {
+	if(1 == trace_format) {
+		fclose(trace[id]);
+#ifdef PROSPERO_LIBZ
+	} else if(2 == trace_format) {
+		gzclose(traceCompressed[id]);
+#endif
+	}
+}
+
+// Body of the writer thread, takes full blocks off the queue until shutdown
+VOID TraceWriterThread(VOID* arg) {
+	while(true) {
+		PIN_MutexLock(&writerLock);
+
+		while(0 == writerQueueCount && 0 == writerShutdown) {
+			PIN_SemaphoreClear(&writerWork);
+			PIN_MutexUnlock(&writerLock);
+			PIN_SemaphoreWait(&writerWork);
+			PIN_MutexLock(&writerLock);
+		}
+
+		if(0 == writerQueueCount) {
+			PIN_MutexUnlock(&writerLock);
+			break;
+		}
+
+		writerBlock block = writerQueue[writerQueueHead];
+		writerQueueHead = (writerQueueHead + 1) % writerQueueSize;
+		writerQueueCount--;
+		PIN_MutexUnlock(&writerLock);
+
+		if(block.length > 0) {
+			if(1 == trace_format) {
+				fwrite(block.data, block.length, 1, trace[block.thread]);
+#ifdef PROSPERO_LIBZ
+			} else {
+				gzwrite(traceCompressed[block.thread], block.data, (unsigned) block.length);
+#endif
+			}
+		}
+
+		if(block.nextFile > 0) {
+			CloseTraceFile(block.thread);
+			OpenTraceFile(block.thread, block.nextFile);
+		}
+
+		// Hand the block back to its thread
+		threadWriter* w = &writers[block.thread];
+
+		PIN_MutexLock(&writerLock);
+		w->blocks[(w->freeHead + w->freeCount) % PROSPERO_WRITER_BLOCKS] = block.data;
+		w->freeCount++;
+		PIN_SemaphoreSet(&w->blockFree);
+		PIN_MutexUnlock(&writerLock);
+	}
+
+	PIN_ExitThread(0);
+}
+
+// Queues the current block of a thread, if takeBlock is set waits for a free one to continue recording
+VOID SubmitBlock(UINT32 thr, UINT64 nextFile, bool takeBlock) {
+	threadWriter* w = &writers[thr];
+
+	PIN_MutexLock(&writerLock);
+
+	writerBlock* block = &writerQueue[(writerQueueHead + writerQueueCount) % writerQueueSize];
+	block->data = w->current;
+	block->length = w->used;
+	block->thread = thr;
+	block->nextFile = nextFile;
+	writerQueueCount++;
+	PIN_SemaphoreSet(&writerWork);
+
+	w->current = NULL;
+	w->used = 0;
+
+	if(takeBlock) {
+		while(0 == w->freeCount) {
+			PIN_SemaphoreClear(&w->blockFree);
+			PIN_MutexUnlock(&writerLock);
+			PIN_SemaphoreWait(&w->blockFree);
+			PIN_MutexLock(&writerLock);
+		}
+
+		w->current = w->blocks[w->freeHead];
+		w->freeHead = (w->freeHead + 1) % PROSPERO_WRITER_BLOCKS;
+		w->freeCount--;
+	}
+
+	PIN_MutexUnlock(&writerLock);
+}
+
+VOID AppendRecord(UINT32 thr, const char op, UINT64 addr, UINT32 size) {
+	threadWriter* w = &writers[thr];
+
+	if(w->used + RECORD_LENGTH > KnobFileBufferSize.Value()) {
+		SubmitBlock(thr, 0, true);
+	}
+
+	char* record = &(w->current[w->used]);
+	copy(record, &(thread_instr_id[thr].insCount), 0, sizeof(uint64_t) );
+	copy(record, &op, sizeof(uint64_t), sizeof(char) );
+	copy(record, &addr, sizeof(uint64_t) + sizeof(char), sizeof(uint64_t) );
+	copy(record, &size, sizeof(uint64_t) + sizeof(char) + sizeof(uint64_t), sizeof(uint32_t) );
+
+	w->used += RECORD_LENGTH;
+}
+
 VOID PerformInstrumentCountCheck(THREADID id) {
 	if(id >= max_thread_count) {
 		return;
@@ -122,18 +285,11 @@ VOID RecordMemRead(VOID * addr, UINT32 size, THREADID thr)
 		(int) size);
 	thread_instr_id[thr].readCount++;
     } else if (1 == trace_format || 2 == trace_format) {
-	copy(RECORD_BUFFER, &(thread_instr_id[thr].insCount), 0, sizeof(uint64_t) );
-    	copy(RECORD_BUFFER, &READ_OPERATION_CHAR, sizeof(uint64_t), sizeof(char) );
-    	copy(RECORD_BUFFER, &ma_addr, sizeof(uint64_t) + sizeof(char), sizeof(uint64_t) );
-    	copy(RECORD_BUFFER, &size, sizeof(uint64_t) + sizeof(char) + sizeof(uint64_t), sizeof(uint32_t) );
-
-	if(1 == trace_format) {
-		if(thr < max_thread_count && (traceEnabled > 0)) {
-    			fwrite(RECORD_BUFFER, sizeof(uint64_t) + sizeof(uint64_t) + sizeof(uint32_t) + sizeof(char), 1, trace[thr]);
-			thread_instr_id[thr].readCount++;
-		}
-	}
+	if(thr < max_thread_count && (traceEnabled > 0)) {
+		AppendRecord(thr, READ_OPERATION_CHAR, ma_addr, size);
+		thread_instr_id[thr].readCount++;
 	}
+    }
 
 #ifdef PROSPERO_DEBUG
      printf("PROSPERO: Completed into RecordMemRead...\n");
@@ -159,18 +315,11 @@ VOID RecordMemWrite(VOID * addr, UINT32 size, THREADID thr)
 		(int) size);
 	thread_instr_id[thr].writeCount++;
     } else if(1 == trace_format || 2 == trace_format) {
-    	copy(RECORD_BUFFER, &(thread_instr_id[thr].insCount), 0, sizeof(uint64_t) );
-    	copy(RECORD_BUFFER, &WRITE_OPERATION_CHAR, sizeof(uint64_t), sizeof(char) );
-    	copy(RECORD_BUFFER, &ma_addr, sizeof(uint64_t) + sizeof(char), sizeof(uint64_t) );
-    	copy(RECORD_BUFFER, &size, sizeof(uint64_t) + sizeof(char) + sizeof(uint64_t), sizeof(uint32_t) );
-
-	if(1 == trace_format) {
-		if(thr < max_thread_count && (traceEnabled > 0)) {
-	   		fwrite(RECORD_BUFFER, sizeof(uint64_t) + sizeof(uint64_t) + sizeof(uint32_t) + sizeof(char), 1, trace[thr]);
-			thread_instr_id[thr].writeCount++;
-		}
-	}
+	if(thr < max_thread_count && (traceEnabled > 0)) {
+		AppendRecord(thr, WRITE_OPERATION_CHAR, ma_addr, size);
+		thread_instr_id[thr].writeCount++;
 	}
+    }
 #ifdef PROSPERO_DEBUG
      printf("PROSPERO: Completed into RecordMemWrite...\n");
 #endif
@@ -183,22 +332,17 @@ VOID IncrementInstructionCount(THREADID id) {
 	if(thread_instr_id[id].insCount >= (nextFileTrip * thread_instr_id[id].currentFile)) {
 		char buffer[256];
 
-		if(trace_format == 0 || trace_format == 1) {
+		if(trace_format == 0) {
 			fclose(trace[id]);
 
-			if(trace_format == 0) {
-				sprintf(buffer, "%s-%lu-%lu.trace",
-					KnobTraceFile.Value().c_str(),
-					(unsigned long) id,
-					(unsigned long) thread_instr_id[id].currentFile);
-				trace[id] = fopen(buffer, "wt");
-			} else {
-				sprintf(buffer,	"%s-%lu-%lu-bin.trace",
-                                        KnobTraceFile.Value().c_str(),
-					(unsigned long) id,
-					(unsigned long) thread_instr_id[id].currentFile);
-                                trace[id] = fopen(buffer, "wb");
-			}
+			sprintf(buffer, "%s-%lu-%lu.trace",
+				KnobTraceFile.Value().c_str(),
+				(unsigned long) id,
+				(unsigned long) thread_instr_id[id].currentFile);
+			trace[id] = fopen(buffer, "wt");
+		} else if(id < max_thread_count) {
+			// The writer thread switches files once the records before the trip are written
+			SubmitBlock(id, thread_instr_id[id].currentFile, true);
 		}
 		thread_instr_id[id].currentFile++;
 	}
@@ -280,15 +424,38 @@ VOID InstrumentSpecificRoutine(RTN rtn, VOID* v) {
 	}
 }
 
+// Internal threads have to finish before Fini, so drain the writer here
+VOID PrepareForFini(VOID *v)
+{
+    if(0 == trace_format) {
+	return;
+    }
+
+    for(UINT32 i = 0; i < max_thread_count; ++i) {
+	SubmitBlock(i, 0, false);
+    }
+
+    PIN_MutexLock(&writerLock);
+    writerShutdown = 1;
+    PIN_SemaphoreSet(&writerWork);
+    PIN_MutexUnlock(&writerLock);
+
+    PIN_WaitForThreadTermination(writerThreadUID, PIN_INFINITE_TIMEOUT, NULL);
+}
+
 VOID Fini(INT32 code, VOID *v)
 {
     printf("PROSPERO: Tracing is complete, closing trace files...\n");
     std::cout << "PROSPERO: Main thread exists with " << thread_instr_id[0].insCount << " instructions" << std::endl;
 
-    if( (0 == trace_format) || (1 == trace_format)) {
+    if(0 == trace_format) {
 	for(UINT32 i = 0; i < max_thread_count; ++i) {
     		fclose(trace[i]);
 	}
+    } else {
+	for(UINT32 i = 0; i < max_thread_count; ++i) {
+		CloseTraceFile(i);
+	}
     }
 
     printf("PROSPERO: Thread read entries:     %" PRIu64 "\n", thread_instr_id[0].readCount);
@@ -349,19 +516,51 @@ int main(int argc, char *argv[])
     } else if(KnobTraceFormat.Value() == "binary") {
 	printf("PROSPERO: Tracing will be recorded in uncompressed binary format.\n");
 	trace_format = 1;
+#ifdef PROSPERO_LIBZ
+    } else if(KnobTraceFormat.Value() == "compressed") {
+	printf("PROSPERO: Tracing will be recorded in compressed binary format.\n");
+	trace_format = 2;
+	traceCompressed = (gzFile*) malloc(sizeof(gzFile) * max_thread_count);
+#endif
+    } else {
+	std::cerr << "Error: Unknown trace format: " << KnobTraceFormat.Value() << "." << std::endl;
+        exit(-1);
+    }
 
-	for(UINT32 i = 0; i < max_thread_count; ++i) {
-		sprintf(nameBuffer, "%s-%lu-0-bin.trace", KnobTraceFile.Value().c_str(), (unsigned long) i);
-		trace[i] = fopen(nameBuffer, "wb");
+    if(0 != trace_format) {
+	if(KnobFileBufferSize.Value() < RECORD_LENGTH) {
+		std::cerr << "Error: trace buffer must hold at least one record (" << RECORD_LENGTH << " bytes)." << std::endl;
+		exit(-1);
 	}
 
+	writers = (threadWriter*) malloc(sizeof(threadWriter) * max_thread_count);
+	writerQueueSize = max_thread_count * PROSPERO_WRITER_BLOCKS;
+	writerQueue = (writerBlock*) malloc(sizeof(writerBlock) * writerQueueSize);
+	writerQueueHead = 0;
+	writerQueueCount = 0;
+	writerShutdown = 0;
+
+	PIN_MutexInit(&writerLock);
+	PIN_SemaphoreInit(&writerWork);
+
 	for(UINT32 i = 0; i < max_thread_count; ++i) {
-		fileBuffers[i] = (char*) malloc(sizeof(char) * KnobFileBufferSize.Value());
-		setvbuf(trace[i], fileBuffers[i], _IOFBF, (size_t) KnobFileBufferSize.Value());
+		OpenTraceFile(i, 0);
+
+		for(UINT32 j = 0; j < PROSPERO_WRITER_BLOCKS; ++j) {
+			writers[i].blocks[j] = (char*) malloc(sizeof(char) * KnobFileBufferSize.Value());
+		}
+
+		writers[i].current = writers[i].blocks[0];
+		writers[i].used = 0;
+		writers[i].freeHead = 1;
+		writers[i].freeCount = PROSPERO_WRITER_BLOCKS - 1;
+		PIN_SemaphoreInit(&writers[i].blockFree);
+	}
+
+	if(INVALID_THREADID == PIN_SpawnInternalThread(TraceWriterThread, NULL, 0, &writerThreadUID)) {
+		std::cerr << "Error: Unable to start the trace writer thread." << std::endl;
+		exit(-1);
 	}
-    } else {
-	std::cerr << "Error: Unknown trace format: " << KnobTraceFormat.Value() << "." << std::endl;
-        exit(-1);
     }
 
     posix_memalign((void**) &thread_instr_id, 64, sizeof(threadRecord) * max_thread_count);
@@ -389,6 +588,7 @@ int main(int argc, char *argv[])
 	RTN_AddInstrumentFunction(InstrumentSpecificRoutine, 0);
  //   }
 
+    PIN_AddPrepareForFiniFunction(PrepareForFini, 0);
     PIN_AddFiniFunction(Fini, 0);
 
     // Never returns
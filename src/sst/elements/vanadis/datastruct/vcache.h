@@ -70,6 +70,10 @@ public:
         return data_values.find(key)->second;
     }
 
+    // Like find() but leaves the replacement order alone, for observers
+    // which must not change what the cache evicts
+    T peek(const I& key) const { return data_values.find(key)->second; }
+
     void store(const I& key, T value) {
         if (LIKELY(contains(key))) {
             send_key_to_front(key);
@@ -590,6 +590,7 @@ public:
 
                                             //											speculated_ins->setSpeculatedDirection(
                                             // BRANCH_NOT_TAKEN );
+                                            branch_predictor->predictFallThrough(ip);
                                             speculated_ins->setSpeculatedAddress(ip + 8);
 
                                             // We don't urgh.. let's just carry on
@@ -196,6 +196,7 @@ public:
                                             ip, ip + 4, bundle->pcIncrement());
                                     }
 
+                                    branch_predictor->predictFallThrough(ip);
                                     ip += bundle->pcIncrement();
                                     next_spec_ins->setSpeculatedAddress(ip);
                                     bundle_has_branch = true;
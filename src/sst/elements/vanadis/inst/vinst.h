@@ -19,6 +19,7 @@
 #include "decoder/visaopts.h"
 #include "inst/regfile.h"
 #include "inst/regstack.h"
+#include "inst/vinstpool.h"
 #include "inst/vinsttype.h"
 #include "inst/vregfmt.h"
 
@@ -48,48 +49,20 @@ public:
         count_isa_fp_reg_in(c_isa_fp_reg_in),
         count_isa_fp_reg_out(c_isa_fp_reg_out)
     {
-        phys_int_regs_in = (count_phys_int_reg_in > 0) ? new uint16_t[count_phys_int_reg_in] : nullptr;
-        std::memset(phys_int_regs_in, 0, count_phys_int_reg_in * sizeof( uint16_t ));
-
-        phys_int_regs_out = (count_phys_int_reg_out > 0) ? new uint16_t[count_phys_int_reg_out] : nullptr;
-        std::memset(phys_int_regs_out, 0, count_phys_int_reg_out * sizeof( uint16_t ) );
-  
-        isa_int_regs_in = (count_isa_int_reg_in > 0) ? new uint16_t[count_isa_int_reg_in] : nullptr;
-        std::memset(isa_int_regs_in, 0, count_isa_int_reg_in * sizeof( uint16_t ));
- 
-        isa_int_regs_out = (count_isa_int_reg_out > 0) ? new uint16_t[count_isa_int_reg_out] : nullptr;
-        std::memset(isa_int_regs_out, 0, count_isa_int_reg_out * sizeof( uint16_t ) );
-
-        phys_fp_regs_in = (count_phys_fp_reg_in > 0) ? new uint16_t[count_phys_fp_reg_in] : nullptr;
-        std::memset(phys_fp_regs_in, 0, count_phys_fp_reg_in * sizeof( uint16_t ));
-
-        phys_fp_regs_out = (count_phys_fp_reg_out > 0) ? new uint16_t[count_phys_fp_reg_out] : nullptr;
-        std::memset(phys_fp_regs_out, 0, count_phys_fp_reg_out * sizeof( uint16_t ));
-
-        isa_fp_regs_in = (count_isa_fp_reg_in > 0) ? new uint16_t[count_isa_fp_reg_in] : nullptr;
-        std::memset(isa_fp_regs_in, 0, count_isa_fp_reg_in * sizeof( uint16_t ) );
-
-        isa_fp_regs_out = (count_isa_fp_reg_out > 0) ? new uint16_t[count_isa_fp_reg_out] : nullptr;
-        std::memset(isa_fp_regs_out, 0, count_isa_fp_reg_out * sizeof( uint16_t ));
-  
+        allocateRegisterStorage();
+
         trapError             = false;
         hasExecuted           = false;
         hasIssued             = false;
         enduOpGroup           = false;
         isFrontOfROB          = false;
         hasROBSlot            = false;
+        memOrderViolation     = false;
     }
 
     virtual ~VanadisInstruction()
     {
-        if ( phys_int_regs_in != nullptr ) delete[] phys_int_regs_in;
-        if ( phys_int_regs_out != nullptr ) delete[] phys_int_regs_out;
-        if ( isa_int_regs_in != nullptr ) delete[] isa_int_regs_in;
-        if ( isa_int_regs_out != nullptr ) delete[] isa_int_regs_out;
-        if ( phys_fp_regs_in != nullptr ) delete[] phys_fp_regs_in;
-        if ( phys_fp_regs_out != nullptr ) delete[] phys_fp_regs_out;
-        if ( isa_fp_regs_in != nullptr ) delete[] isa_fp_regs_in;
-        if ( isa_fp_regs_out != nullptr ) delete[] isa_fp_regs_out;
+        releaseRegisterStorage();
     }
 
     VanadisInstruction(const VanadisInstruction& copy_me) :
@@ -111,52 +84,20 @@ public:
         enduOpGroup           = copy_me.enduOpGroup;
         isFrontOfROB          = false;
         hasROBSlot            = false;
+        memOrderViolation     = false;
 
-        phys_int_regs_in  = (count_phys_int_reg_in > 0) ? new uint16_t[count_phys_int_reg_in] : nullptr;
-        phys_int_regs_out = (count_phys_int_reg_out > 0) ? new uint16_t[count_phys_int_reg_out] : nullptr;
-
-        isa_int_regs_in  = (count_isa_int_reg_in > 0) ? new uint16_t[count_isa_int_reg_in] : nullptr;
-        isa_int_regs_out = (count_isa_int_reg_out > 0) ? new uint16_t[count_isa_int_reg_out] : nullptr;
-
-        phys_fp_regs_in  = (count_phys_fp_reg_in > 0) ? new uint16_t[count_phys_fp_reg_in] : nullptr;
-        phys_fp_regs_out = (count_phys_fp_reg_out > 0) ? new uint16_t[count_phys_fp_reg_out] : nullptr;
-
-        isa_fp_regs_in  = (count_isa_fp_reg_in > 0) ? new uint16_t[count_isa_fp_reg_in] : nullptr;
-        isa_fp_regs_out = (count_isa_fp_reg_out > 0) ? new uint16_t[count_isa_fp_reg_out] : nullptr;
-
-        for ( uint16_t i = 0; i < count_phys_int_reg_in; ++i ) {
-            phys_int_regs_in[i] = copy_me.phys_int_regs_in[i];
-        }
-
-        for ( uint16_t i = 0; i < count_phys_int_reg_out; ++i ) {
-            phys_int_regs_out[i] = copy_me.phys_int_regs_out[i];
-        }
-
-        for ( uint16_t i = 0; i < count_isa_int_reg_in; ++i ) {
-            isa_int_regs_in[i] = copy_me.isa_int_regs_in[i];
-        }
-
-        for ( uint16_t i = 0; i < count_isa_int_reg_out; ++i ) {
-            isa_int_regs_out[i] = copy_me.isa_int_regs_out[i];
-        }
-
-        for ( uint16_t i = 0; i < count_phys_fp_reg_in; ++i ) {
-            phys_fp_regs_in[i] = copy_me.phys_fp_regs_in[i];
-        }
-
-        for ( uint16_t i = 0; i < count_phys_fp_reg_out; ++i ) {
-            phys_fp_regs_out[i] = copy_me.phys_fp_regs_out[i];
-        }
-
-        for ( uint16_t i = 0; i < count_isa_fp_reg_in; ++i ) {
-            isa_fp_regs_in[i] = copy_me.isa_fp_regs_in[i];
-        }
-
-        for ( uint16_t i = 0; i < count_isa_fp_reg_out; ++i ) {
-            isa_fp_regs_out[i] = copy_me.isa_fp_regs_out[i];
-        }
+        // Both instructions have the same register counts and so the same
+        // layout, copy every list in one go
+        allocateRegisterStorage();
+        std::memcpy(reg_storage, copy_me.reg_storage, countRegisterSlots() * sizeof(uint16_t));
     }
 
+    // Dynamic instructions are cloned from the micro-op cache on every fetch
+    // and deleted at retire, so their storage is recycled rather than going
+    // back to the heap
+    static void* operator new(size_t size) { return VanadisInstructionPool::allocate(size); }
+    static void  operator delete(void* ptr, size_t size) { VanadisInstructionPool::release(ptr, size); }
+
     void writeIntRegs(char* buffer, size_t max_buff_size)
     {
         size_t index_so_far = 0;
@@ -333,6 +274,11 @@ public:
 
     void flagError() { trapError = true; }
 
+    // Set by the LSQ when a load was allowed to go ahead of an older store
+    // which turned out to write the same bytes, the load must be replayed
+    bool violatesMemoryOrder() const { return memOrderViolation; }
+    void flagMemoryOrderViolation() { memOrderViolation = true; }
+
     virtual bool performIntRegisterRecovery() const { return true; }
     virtual bool performFPRegisterRecovery() const { return true; }
 
@@ -349,6 +295,20 @@ public:
     }
 
 protected:
+    // Change the number of integer registers after construction. Every
+    // register list is cleared, so the caller must fill them in again.
+    void resizeIntRegisters(const uint16_t c_int_reg_in, const uint16_t c_int_reg_out)
+    {
+        releaseRegisterStorage();
+
+        count_isa_int_reg_in   = c_int_reg_in;
+        count_phys_int_reg_in  = c_int_reg_in;
+        count_isa_int_reg_out  = c_int_reg_out;
+        count_phys_int_reg_out = c_int_reg_out;
+
+        allocateRegisterStorage();
+    }
+
     const uint64_t ins_address;
     const uint32_t hw_thread;
 
@@ -378,8 +338,54 @@ protected:
     bool enduOpGroup;
     bool isFrontOfROB;
     bool hasROBSlot;
+    bool memOrderViolation;
 
     const VanadisDecoderOptions* isa_options;
+
+private:
+    // All eight register lists share one block. Almost every instruction
+    // fits in the inline slots, only instructions which name many registers
+    // (SYSCALL) need to go to the heap.
+    static constexpr uint32_t inline_reg_slots = 16;
+
+    uint16_t  inline_regs[inline_reg_slots];
+    uint16_t* reg_storage;
+
+    uint32_t countRegisterSlots() const
+    {
+        return (uint32_t)count_isa_int_reg_in + count_isa_int_reg_out + count_isa_fp_reg_in + count_isa_fp_reg_out +
+               count_phys_int_reg_in + count_phys_int_reg_out + count_phys_fp_reg_in + count_phys_fp_reg_out;
+    }
+
+    uint16_t* takeRegisterSlots(uint16_t*& next, const uint16_t count)
+    {
+        uint16_t* slots = (count > 0) ? next : nullptr;
+        next += count;
+        return slots;
+    }
+
+    void allocateRegisterStorage()
+    {
+        const uint32_t slots = countRegisterSlots();
+
+        reg_storage = (slots <= inline_reg_slots) ? inline_regs : new uint16_t[slots];
+        std::memset(reg_storage, 0, slots * sizeof(uint16_t));
+
+        uint16_t* next    = reg_storage;
+        isa_int_regs_in   = takeRegisterSlots(next, count_isa_int_reg_in);
+        isa_int_regs_out  = takeRegisterSlots(next, count_isa_int_reg_out);
+        isa_fp_regs_in    = takeRegisterSlots(next, count_isa_fp_reg_in);
+        isa_fp_regs_out   = takeRegisterSlots(next, count_isa_fp_reg_out);
+        phys_int_regs_in  = takeRegisterSlots(next, count_phys_int_reg_in);
+        phys_int_regs_out = takeRegisterSlots(next, count_phys_int_reg_out);
+        phys_fp_regs_in   = takeRegisterSlots(next, count_phys_fp_reg_in);
+        phys_fp_regs_out  = takeRegisterSlots(next, count_phys_fp_reg_out);
+    }
+
+    void releaseRegisterStorage()
+    {
+        if ( reg_storage != inline_regs ) { delete[] reg_storage; }
+    }
 };
 
 } // namespace Vanadis
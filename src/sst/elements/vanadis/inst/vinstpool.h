@@ -0,0 +1,123 @@
+// Copyright 2009-2023 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2023, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#ifndef _H_VANADIS_INSTRUCTION_POOL
+#define _H_VANADIS_INSTRUCTION_POOL
+
+#include <cstddef>
+#include <new>
+
+namespace SST {
+namespace Vanadis {
+
+// Recycles the storage of dynamic instructions. Every fetch clones an
+// instruction out of the micro-op cache and every retire (or pipeline
+// clear) deletes it, so after warm up the number of live instructions is
+// bounded by the ROBs plus the micro-op cache and the pool stops growing.
+//
+// Blocks are kept on free lists per size class. The lists are per
+// simulation thread: a core's instructions are only created and destroyed
+// on the thread which owns the core, so no locking is needed. Each list
+// holds at most max_free_blocks blocks, anything released beyond that goes
+// back to the heap, and the lists are emptied when their thread exits.
+class VanadisInstructionPool {
+public:
+    // Enough for the ROBs and micro-op caches of several cores per thread
+    static constexpr size_t max_free_blocks = 8192;
+
+    static void* allocate(const size_t size) {
+        const size_t size_class = sizeClass(size);
+
+        if ( size_class >= num_size_classes ) { return ::operator new(size); }
+
+        FreeLists& lists = freeLists();
+
+        if ( nullptr != lists.head[size_class] ) {
+            FreeBlock* block         = lists.head[size_class];
+            lists.head[size_class]   = block->next;
+            lists.count[size_class] -= 1;
+            return block;
+        }
+
+        return ::operator new((size_class + 1) * granularity);
+    }
+
+    static void release(void* ptr, const size_t size) {
+        if ( nullptr == ptr ) { return; }
+
+        const size_t size_class = sizeClass(size);
+        FreeLists&   lists      = freeLists();
+
+        if ( size_class >= num_size_classes || lists.count[size_class] >= max_free_blocks ) {
+            ::operator delete(ptr);
+            return;
+        }
+
+        FreeBlock* block         = static_cast<FreeBlock*>(ptr);
+        block->next              = lists.head[size_class];
+        lists.head[size_class]   = block;
+        lists.count[size_class] += 1;
+    }
+
+    // Number of free blocks held for this thread
+    static size_t freeBlocks() {
+        size_t total = 0;
+        for ( size_t i = 0; i < num_size_classes; ++i ) {
+            total += freeLists().count[i];
+        }
+        return total;
+    }
+
+    // Return every free block held for this thread to the heap
+    static void trim() { freeLists().trim(); }
+
+private:
+    struct FreeBlock {
+        FreeBlock* next;
+    };
+
+    static constexpr size_t granularity      = 16;
+    static constexpr size_t num_size_classes = 64;
+
+    struct FreeLists {
+        FreeBlock* head[num_size_classes]  = {};
+        size_t     count[num_size_classes] = {};
+
+        ~FreeLists() { trim(); }
+
+        void trim() {
+            for ( size_t i = 0; i < num_size_classes; ++i ) {
+                while ( nullptr != head[i] ) {
+                    FreeBlock* block = head[i];
+                    head[i]          = block->next;
+                    ::operator delete(block);
+                }
+                count[i] = 0;
+            }
+        }
+    };
+
+    static size_t sizeClass(const size_t size) { return (size - 1) / granularity; }
+
+    static FreeLists& freeLists() {
+        thread_local FreeLists lists;
+        return lists;
+    }
+};
+
+} // namespace Vanadis
+} // namespace SST
+
+#endif
@@ -58,6 +58,16 @@ public:
     virtual VanadisDelaySlotRequirement getDelaySlotType() const { return delayType; }
     uint64_t                            getInstructionWidth() const { return ins_width; }
 
+    // Where execution continues if the branch is not taken, this is also
+    // the return address written by a linking branch
+    uint64_t getNotTakenAddress() { return calculateStandardNotTakenAddress(); }
+
+    // Linking branches (calls) write a return address to a real register
+    bool writesLinkRegister() const
+    {
+        return (count_isa_int_reg_out > 0) && (isa_int_regs_out[0] != isa_options->getRegisterIgnoreWrites());
+    }
+
 protected:
     uint64_t calculateStandardNotTakenAddress()
     {
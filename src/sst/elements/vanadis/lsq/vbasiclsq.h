@@ -25,9 +25,13 @@
 #include "util/vsignx.h"
 #include "inst/vstorecond.h"
 
+#include <algorithm>
 #include <cassert>
 #include <cinttypes>
 #include <cstdint>
+#include <map>
+#include <unordered_map>
+#include <utility>
 #include <vector>
 #include <queue>
 
@@ -54,7 +58,10 @@ public:
             { "max_loads", "Set the maximum number of loads permitted in the queue", "16" },
             { "address_mask", "Can mask off address bits if needed during construction of a operation", "0xFFFFFFFFFFFFFFFF"},
             { "issues_per_cycle", "Maximum number of issues the LSQ can attempt per cycle.", "2"},
-            { "cache_line_width", "Number of bytes in a (L1) cache line", "64"}
+            { "cache_line_width", "Number of bytes in a (L1) cache line", "64"},
+            { "store_forwarding", "Forward data from the store buffer to loads which are fully covered by an older store", "0"},
+            { "forwarding_latency", "Number of cycles to return a value forwarded from the store buffer", "1"},
+            { "store_set_entries", "Number of entries in the store-set table used to predict which loads may issue ahead of older unissued stores, 0 disables prediction", "0"}
         )
 
     SST_ELI_DOCUMENT_STATISTICS({ "bytes_read", "Count all the bytes read for data operations", "bytes", 1 },
@@ -70,12 +77,22 @@ public:
                                 { "stores_in_flight", "Count the number of stores which are in-flight", "operations", 1},
                                 { "store_buffer_entries", "Count the number of stores held in the store buffer", "operations", 1},
                                 { "split_stores", "Count the number of stores which are fractured due to cache boundaries", "operations", 1},
-                                { "split_loads", "Count the number of loads which are fractured due to cache boundaries", "operations", 1})
+                                { "split_loads", "Count the number of loads which are fractured due to cache boundaries", "operations", 1},
+                                { "loads_forwarded", "Count the number of loads which received their value from the store buffer", "operations", 1},
+                                { "forward_stalls", "Count the number of load issue attempts held because an older store overlaps the load but cannot forward to it", "operations", 1},
+                                { "loads_bypassed_stores", "Count the number of loads which were issued ahead of older unissued stores", "operations", 1},
+                                { "memory_order_violations", "Count the number of loads issued ahead of an older store to the same address which must be replayed", "operations", 1},
+                                { "functional_loads", "Count the number of loads answered from the functional view of memory while the core fast-forwards", "operations", 1},
+                                { "functional_line_fills", "Count the number of cache lines read into the functional view of memory while the core fast-forwards", "operations", 1})
 
     VanadisBasicLoadStoreQueue(ComponentId_t id, Params& params, int coreid, int hwthreads) : VanadisLoadStoreQueue(id, params, coreid, hwthreads),
         max_stores(params.find<size_t>("max_stores", 8)),
         max_loads(params.find<size_t>("max_loads", 16)),
-        max_issue_attempts_per_cycle(params.find("issues_per_cycle", 2)) {
+        max_issue_attempts_per_cycle(params.find("issues_per_cycle", 2)),
+        store_forwarding(params.find<bool>("store_forwarding", false)),
+        forwarding_latency(params.find<uint64_t>("forwarding_latency", 1)),
+        functional_memory(false),
+        functional_generation(0) {
 
         std_mem_handlers = new VanadisBasicLoadStoreQueue::StandardMemHandlers(this, output);
 
@@ -92,10 +109,15 @@ public:
         op_q_index = 0;
         op_q_size = 0;
 
+        next_syscall_write = 0;
+
         stores_pending.resize(hw_threads);
         stores_pending_index = 0;
         stores_pending_size = 0;
 
+        bypassing_loads.resize(hw_threads);
+        store_set_table.resize(params.find<uint32_t>("store_set_entries", 0), invalid_store_set);
+
         stat_loads_issued = registerStatistic<uint64_t>("loads_issued", "1");
         stat_stores_issued = registerStatistic<uint64_t>("stores_issued", "1");
         stat_fences_issued = registerStatistic<uint64_t>("fences_issued", "1");
@@ -111,6 +133,14 @@ public:
         stat_stores_pending = registerStatistic<uint64_t>("stores_in_flight", "1");
         stat_loads_pending = registerStatistic<uint64_t>("loads_in_flight", "1");
         stat_op_q_size = registerStatistic<uint64_t>("operations_pending");
+
+        stat_loads_forwarded = registerStatistic<uint64_t>("loads_forwarded", "1");
+        stat_forward_stalls = registerStatistic<uint64_t>("forward_stalls", "1");
+        stat_loads_bypassed = registerStatistic<uint64_t>("loads_bypassed_stores", "1");
+        stat_order_violations = registerStatistic<uint64_t>("memory_order_violations", "1");
+
+        stat_functional_loads = registerStatistic<uint64_t>("functional_loads", "1");
+        stat_functional_fills = registerStatistic<uint64_t>("functional_line_fills", "1");
     }
 
     virtual ~VanadisBasicLoadStoreQueue() {
@@ -149,6 +179,86 @@ public:
         stat_fences_issued->addData(1);
     }
 
+    // Store-set prediction: a load may go ahead of the older stores unless the
+    // table places it in the same set as one of them (they have collided before)
+    bool pushBypassingStores(VanadisLoadInstruction* load_me,
+            const std::vector<VanadisStoreInstruction*>& older_stores) override {
+        if(store_set_table.empty() || (load_me->getTransactionType() != MEM_TRANSACTION_NONE)) {
+            return false;
+        }
+
+        const uint32_t load_set = store_set_table[storeSetIndex(load_me->getInstructionAddress())];
+
+        if(load_set != invalid_store_set) {
+            for(VanadisStoreInstruction* store_ins : older_stores) {
+                if(store_set_table[storeSetIndex(store_ins->getInstructionAddress())] == load_set) {
+                    return false;
+                }
+            }
+        }
+
+        push(load_me);
+        bypassing_loads[load_me->getHWThread()].push_back(new VanadisBasicBypassingLoadEntry(load_me, older_stores));
+        stat_loads_bypassed->addData(1);
+
+        return true;
+    }
+
+    void setFunctionalMemory(bool enable) override {
+        output->verbose(CALL_INFO, 2, 0, "%s functional view of memory\n", enable ? "enable" : "disable");
+
+        functional_memory = enable;
+        invalidateFunctionalMemory();
+    }
+
+    // fills which are still in flight belong to an older generation and are
+    // dropped when they return
+    void invalidateFunctionalMemory() override {
+        functional_lines.clear();
+        functional_generation++;
+    }
+
+    bool writeSyscallData(const uint32_t hw_thr, const uint64_t address, const std::vector<uint8_t>& data,
+                          std::function<void(bool)> done) override {
+        if(data.empty()) {
+            return false;
+        }
+
+        const uint64_t write_id = next_syscall_write++;
+        VanadisSyscallWrite& write = syscall_writes[write_id];
+        write.remaining = 0;
+        write.success = true;
+        write.done = done;
+
+        // one request per cache line, like any other store
+        for(uint64_t offset = 0; offset < data.size(); ) {
+            const uint64_t write_address = address + offset;
+            const uint64_t width = std::min((uint64_t) data.size() - offset,
+                cache_line_width - (write_address % cache_line_width));
+
+            std::vector<uint8_t> payload(data.begin() + offset, data.begin() + offset + width);
+            StandardMem::Request* req = new StandardMem::Write(write_address & address_mask, width, payload,
+                false, 0, write_address, 0, hw_thr);
+
+            syscall_write_reqs[req->getID()] = write_id;
+            write.remaining++;
+            memInterface->send(req);
+
+            // keep the functional view in step, as writeFunctionalLines does for stores
+            auto line_itr = functional_lines.find(lineAddress(write_address));
+            if(line_itr != functional_lines.end() && !line_itr->second.empty()) {
+                std::copy(payload.begin(), payload.end(), line_itr->second.begin() + (write_address % cache_line_width));
+            }
+
+            offset += width;
+        }
+
+        output->verbose(CALL_INFO, 9, VANADIS_DBG_LSQ_STORE_FLG, "-> write %zu bytes of system call data to 0x%" PRI_ADDR " in %" PRIu32 " requests (thr: %" PRIu32 ")\n",
+            data.size(), address, write.remaining, hw_thr);
+
+        return true;
+    }
+
     void clearLSQByThreadID(const uint32_t thread) override {
         // Iterate over the queue, anything with a matching thread ID is
         // first deleted and then removed from the queue, otherwise entry
@@ -175,6 +285,20 @@ public:
             delete (*store_itr);
             store_itr = stores_pending[thread].erase(store_itr);
         }
+
+        for(auto fwd_itr = forwarded_loads.begin(); fwd_itr != forwarded_loads.end(); ) {
+            if( fwd_itr->second->tid == thread ) {
+                delete fwd_itr->second;
+                fwd_itr = forwarded_loads.erase(fwd_itr);
+            } else {
+                ++fwd_itr;
+            }
+        }
+
+        for(auto bypass_itr = bypassing_loads[thread].begin(); bypass_itr != bypassing_loads[thread].end(); ) {
+            delete (*bypass_itr);
+            bypass_itr = bypassing_loads[thread].erase(bypass_itr);
+        }
     }
 
     // must be implemented to allow the memory system to initialize itself during
@@ -241,6 +365,14 @@ public:
         stat_stores_pending->addData(std_stores_in_flight.size());
         stat_store_buffer_entries->addData(stores_pending_size);
 
+        // complete loads which were satisfied from the store buffer, these go through
+        // the same path as a response from the data cache
+        while(!forwarded_loads.empty() && (forwarded_loads.front().first <= cycle)) {
+            StandardMem::ReadResp* forward_resp = forwarded_loads.front().second;
+            forwarded_loads.pop_front();
+            forward_resp->handle(std_mem_handlers);
+        }
+
         // this can be called multiple times per cycle
         for(uint32_t attempt = 0; attempt < max_issue_attempts_per_cycle; ++attempt) {
             if (op_q_size == 0)
@@ -272,6 +404,14 @@ protected:
             out->verbose(CALL_INFO, 16, VANADIS_DBG_LSQ_LOAD_FLG, "-> handle read-response (virt-addr: 0x%" PRI_ADDR ")\n", ev->vAddr);
             lsq->stat_loaded_bytes->addData(ev->size);
 
+            auto fill_itr = lsq->functional_fills.find(ev->getID());
+            if(fill_itr != lsq->functional_fills.end()) {
+                lsq->installFunctionalLine(fill_itr->second.first, fill_itr->second.second, ev);
+                lsq->functional_fills.erase(fill_itr);
+                delete ev;
+                return;
+            }
+
             auto load_itr = lsq->loads_pending.begin();
             VanadisBasicLoadPendingEntry* load_entry = nullptr;
 
@@ -461,6 +601,14 @@ protected:
                 return;
             }
 
+            auto syscall_itr = lsq->syscall_write_reqs.find(ev->getID());
+            if(syscall_itr != lsq->syscall_write_reqs.end()) {
+                lsq->completeSyscallWrite(syscall_itr->second, !ev->getFail());
+                lsq->syscall_write_reqs.erase(syscall_itr);
+                delete ev;
+                return;
+            }
+
             // this was not a standard store OR was removed by a branch mis-predict but we need to find
             // out now
             int thr = ev->tid;
@@ -643,6 +791,10 @@ protected:
                 store_ins->getValueRegisterType() == STORE_FP_REGISTER);
         }
 
+        if(UNLIKELY(functional_memory)) {
+            writeFunctionalLines(store_entry, store_ins, store_address, store_width);
+        }
+
         switch(store_ins->getTransactionType()) {
         case MEM_TRANSACTION_NONE:
         {
@@ -933,9 +1085,21 @@ protected:
                             load_ins->getInstructionAddress(), load_ins->getHWThread(), load_address, load_width);
                     }
 
+                    if(UNLIKELY(!bypassing_loads[thr].empty())) {
+                        recordBypassingLoadAddress(load_ins, load_address, load_width);
+                    }
+
+                    VanadisBasicStorePendingEntry* forward_store = nullptr;
+
                     // check to see if loading from this address would conflict with a store which
-                    // we have pending, if yes, wait for conflict to clear and then we can proceed
-                    if(UNLIKELY(checkStoreConflict(load_ins->getHWThread(), load_address, load_width))) {
+                    // we have pending, if yes, either take the value from that store or wait for the
+                    // conflict to clear and then we can proceed
+                    if(UNLIKELY(checkStoreConflict(load_ins->getHWThread(), load_address, load_width)) &&
+                        (!store_forwarding || (nullptr == (forward_store = findForwardingStore(load_ins, load_address, load_width))))) {
+                        if(store_forwarding) {
+                            stat_forward_stalls->addData(1);
+                        }
+
                         if(output->getVerboseLevel() >= 16) {
                             output->verbose(CALL_INFO, 16, 0, "---> load ins: 0x%" PRI_ADDR " / thr: %" PRIu32 " conflicts with store entry, will not issue until conflict is resolved (load-addr: 0x%" PRI_ADDR " / width: %" PRIu32 ")\n",
                                 load_ins->getInstructionAddress(), load_ins->getHWThread(), load_address, load_width);
@@ -944,6 +1108,15 @@ protected:
                         // tell caller we would not issue
                         //output->verbose(CALL_INFO, 16, 0, "--> cycle: %" PRIu64 " issue LOAD failed: cannot execute\n", cycle);
                         return false;
+                    } else if(UNLIKELY(nullptr != forward_store)) {
+                        forwardLoad(cycle, load_ins, forward_store, load_address, load_width);
+
+                    } else if(UNLIKELY(functional_memory) && (load_ins->getTransactionType() == MEM_TRANSACTION_NONE)) {
+                        // lines which are not in the functional view yet are being read,
+                        // try again once they arrive
+                        if(!functionalLoad(cycle, load_ins, load_address, load_width)) {
+                            return false;
+                        }
 
                     // Drain store q to ensure that a paired SC/Unlock can be issued close to the LL/Lock
                     } else if((load_ins->getTransactionType() == MEM_TRANSACTION_LLSC_LOAD) || (load_ins->getTransactionType() == MEM_TRANSACTION_LOCK)) {
@@ -996,6 +1169,10 @@ protected:
 
                 store_ins->computeStoreAddress(output, hw_thr_reg, &store_address, &store_width);
 
+                if(UNLIKELY(!bypassing_loads[thr].empty())) {
+                    checkOrderViolations(store_ins, store_address, store_ins->trapsError() ? 0 : store_width);
+                }
+
                 if(store_ins->trapsError()) {
                     output->verbose(CALL_INFO, 16, 0, "----> warning: 0x%" PRI_ADDR " / thr: %" PRIu32 " traps error, marks executed and does not process.\n",
                         store_ins->getInstructionAddress(), store_ins->getHWThread());
@@ -1120,11 +1297,265 @@ protected:
         return conflicts;
     }
 
+    // The youngest older store overlapping the load holds the newest value of every
+    // byte it writes, it can forward only if it covers the whole load. Anything else
+    // (partial overlap, atomics, partial stores) waits for the store to drain.
+    VanadisBasicStorePendingEntry* findForwardingStore(VanadisLoadInstruction* load_ins,
+            const uint64_t address, const uint64_t width) {
+        if(load_ins->getTransactionType() != MEM_TRANSACTION_NONE) {
+            return nullptr;
+        }
+
+        std::deque<VanadisBasicStorePendingEntry*>& thr_stores = stores_pending[load_ins->getHWThread()];
+
+        for(auto store_itr = thr_stores.rbegin(); store_itr != thr_stores.rend(); store_itr++) {
+            VanadisBasicStorePendingEntry* store_entry = (*store_itr);
+
+            if(store_entry->storeAddressOverlaps(address, width)) {
+                VanadisStoreInstruction* store_ins = store_entry->getStoreInstruction();
+
+                const bool covers_load = (store_entry->getStoreAddress() <= address) &&
+                    ((address + width) <= (store_entry->getStoreAddress() + store_entry->getStoreWidth()));
+
+                if(covers_load && (store_ins->getTransactionType() == MEM_TRANSACTION_NONE) &&
+                    !store_ins->isPartialStore() && !store_entry->isDispatched()) {
+                    return store_entry;
+                }
+
+                return nullptr;
+            }
+        }
+
+        return nullptr;
+    }
+
+    void forwardLoad(uint64_t cycle, VanadisLoadInstruction* load_ins, VanadisBasicStorePendingEntry* store_entry,
+            const uint64_t load_address, const uint64_t load_width) {
+        VanadisStoreInstruction* store_ins = store_entry->getStoreInstruction();
+        std::vector<uint8_t> payload(load_width);
+
+        registerFiles->at(store_entry->getHWThread())->copyFromRegister(store_ins->getValueRegisterType() == STORE_FP_REGISTER ?
+            store_ins->getPhysFPRegIn(0) : store_ins->getPhysIntRegIn(1),
+            store_ins->getRegisterOffset() + (load_address - store_entry->getStoreAddress()), &payload[0], load_width,
+            store_ins->getValueRegisterType() == STORE_FP_REGISTER);
+
+        if(output->getVerboseLevel() >= 9) {
+            output->verbose(CALL_INFO, 9, VANADIS_DBG_LSQ_LOAD_FLG, "---> load ins: 0x%" PRI_ADDR " / thr: %" PRIu32 " forwarded from store ins: 0x%" PRI_ADDR " (load-addr: 0x%" PRI_ADDR " / width: %" PRIu64 ")\n",
+                load_ins->getInstructionAddress(), load_ins->getHWThread(), store_ins->getInstructionAddress(), load_address, load_width);
+        }
+
+        completeLoadLocally(cycle + forwarding_latency, load_ins, load_address, load_width, payload);
+        stat_loads_forwarded->addData(1);
+    }
+
+    // build the response the data cache would have returned, the request is never sent,
+    // and deliver it to the load at ready_cycle
+    void completeLoadLocally(const uint64_t ready_cycle, VanadisLoadInstruction* load_ins, const uint64_t load_address,
+            const uint64_t load_width, const std::vector<uint8_t>& payload) {
+        StandardMem::Read* local_req = new StandardMem::Read(load_address & address_mask, load_width, 0,
+            load_address, load_ins->getInstructionAddress(), load_ins->getHWThread());
+        StandardMem::ReadResp* local_resp = static_cast<StandardMem::ReadResp*>(local_req->makeResponse());
+        local_resp->data = payload;
+        delete local_req;
+
+        VanadisBasicLoadPendingEntry* load_entry = new VanadisBasicLoadPendingEntry(load_ins, load_address, load_width);
+        load_entry->addRequest(local_resp->getID());
+        loads_pending.push_back(load_entry);
+
+        forwarded_loads.emplace_back(ready_cycle, local_resp);
+    }
+
+    uint64_t lineAddress(const uint64_t address) const {
+        return address - (address % cache_line_width);
+    }
+
+    // Answers the load from the functional view of memory, returns false if one of
+    // the lines it needs has to be read from the memory system first
+    bool functionalLoad(uint64_t cycle, VanadisLoadInstruction* load_ins, const uint64_t load_address,
+            const uint64_t load_width) {
+        const uint64_t last_line = lineAddress(load_address + load_width - 1);
+        bool lines_present = true;
+
+        for(uint64_t line = lineAddress(load_address); line <= last_line; line += cache_line_width) {
+            auto line_itr = functional_lines.find(line);
+
+            if(line_itr == functional_lines.end()) {
+                fillFunctionalLine(line, load_ins->getHWThread());
+                lines_present = false;
+            } else if(line_itr->second.empty()) {
+                // the line could not be read, let the timed path report the error
+                issueLoad(load_ins, load_address, load_width);
+                return true;
+            }
+        }
+
+        if(!lines_present) {
+            return false;
+        }
+
+        std::vector<uint8_t> payload(load_width);
+
+        for(uint64_t i = 0; i < load_width; ++i) {
+            const uint64_t address = load_address + i;
+            payload[i] = functional_lines[lineAddress(address)][address % cache_line_width];
+        }
+
+        if(output->getVerboseLevel() >= 9) {
+            output->verbose(CALL_INFO, 9, VANADIS_DBG_LSQ_LOAD_FLG, "---> load ins: 0x%" PRI_ADDR " / thr: %" PRIu32 " answered from functional memory (load-addr: 0x%" PRI_ADDR " / width: %" PRIu64 ")\n",
+                load_ins->getInstructionAddress(), load_ins->getHWThread(), load_address, load_width);
+        }
+
+        completeLoadLocally(cycle, load_ins, load_address, load_width, payload);
+        stat_functional_loads->addData(1);
+        return true;
+    }
+
+    void fillFunctionalLine(const uint64_t line, const uint32_t hw_thr) {
+        for(auto& fill : functional_fills) {
+            if(fill.second.first == line && fill.second.second == functional_generation) {
+                return;
+            }
+        }
+
+        StandardMem::Read* fill_req = new StandardMem::Read(line & address_mask, cache_line_width, 0, line, 0, hw_thr);
+        functional_fills[fill_req->getID()] = std::make_pair(line, functional_generation);
+        memInterface->send(fill_req);
+        stat_functional_fills->addData(1);
+    }
+
+    void installFunctionalLine(const uint64_t line, const uint64_t generation, StandardMem::ReadResp* ev) {
+        if(generation != functional_generation) {
+            return;
+        }
+
+        // an empty line marks one which could not be read
+        functional_lines[line] = ev->getFail() ? std::vector<uint8_t>() : ev->data;
+    }
+
+    // stores go to memory as normal, the functional view is updated at the same time
+    // so later loads see them. Atomic stores may not change memory so their lines are
+    // read again.
+    void writeFunctionalLines(VanadisBasicStorePendingEntry* store_entry, VanadisStoreInstruction* store_ins,
+            const uint64_t store_address, const uint64_t store_width) {
+        if(store_ins->getTransactionType() != MEM_TRANSACTION_NONE) {
+            for(uint64_t line = lineAddress(store_address); line <= lineAddress(store_address + store_width - 1); line += cache_line_width) {
+                functional_lines.erase(line);
+            }
+            return;
+        }
+
+        std::vector<uint8_t> payload(store_width);
+
+        registerFiles->at(store_entry->getHWThread())->copyFromRegister(store_ins->getValueRegisterType() == STORE_FP_REGISTER ?
+            store_ins->getPhysFPRegIn(0) : store_ins->getPhysIntRegIn(1), store_ins->getRegisterOffset(), &payload[0], store_width,
+            store_ins->getValueRegisterType() == STORE_FP_REGISTER);
+
+        for(uint64_t i = 0; i < store_width; ++i) {
+            const uint64_t address = store_address + i;
+            auto line_itr = functional_lines.find(lineAddress(address));
+
+            if(line_itr != functional_lines.end() && !line_itr->second.empty()) {
+                line_itr->second[address % cache_line_width] = payload[i];
+            }
+        }
+    }
+
+    uint32_t storeSetIndex(const uint64_t ins_address) const {
+        return (ins_address >> 2) % store_set_table.size();
+    }
+
+    // place the load and store in the same set, merging sets if both already have one
+    void trainStoreSet(const uint64_t load_ins_address, const uint64_t store_ins_address) {
+        uint32_t& load_set  = store_set_table[storeSetIndex(load_ins_address)];
+        uint32_t& store_set = store_set_table[storeSetIndex(store_ins_address)];
+
+        if(load_set == invalid_store_set && store_set == invalid_store_set) {
+            load_set  = storeSetIndex(load_ins_address);
+            store_set = load_set;
+        } else if(load_set == invalid_store_set) {
+            load_set = store_set;
+        } else if(store_set == invalid_store_set) {
+            store_set = load_set;
+        } else {
+            load_set  = std::min(load_set, store_set);
+            store_set = load_set;
+        }
+    }
+
+    void recordBypassingLoadAddress(VanadisLoadInstruction* load_ins, const uint64_t address, const uint64_t width) {
+        for(VanadisBasicBypassingLoadEntry* bypass_entry : bypassing_loads[load_ins->getHWThread()]) {
+            if(bypass_entry->getInstruction() == load_ins) {
+                bypass_entry->setLoadAddress(address, width);
+                break;
+            }
+        }
+    }
+
+    void completeSyscallWrite(const uint64_t write_id, const bool success) {
+        auto write_itr = syscall_writes.find(write_id);
+        VanadisSyscallWrite& write = write_itr->second;
+
+        write.success = write.success && success;
+
+        if(0 == --write.remaining) {
+            std::function<void(bool)> done = write.done;
+            const bool write_success = write.success;
+            syscall_writes.erase(write_itr);
+            done(write_success);
+        }
+    }
+
+    // called as each store computes its address, any load which went ahead of it and
+    // reads the bytes it writes has the wrong value and is flagged so the core replays it
+    void checkOrderViolations(VanadisStoreInstruction* store_ins, const uint64_t store_address, const uint64_t store_width) {
+        std::deque<VanadisBasicBypassingLoadEntry*>& thr_loads = bypassing_loads[store_ins->getHWThread()];
+
+        for(auto load_itr = thr_loads.begin(); load_itr != thr_loads.end(); ) {
+            VanadisBasicBypassingLoadEntry* bypass_entry = (*load_itr);
+            VanadisLoadInstruction* load_ins = bypass_entry->getLoadInstruction();
+
+            if(bypass_entry->removeStore(store_ins) && bypass_entry->loadAddressOverlaps(store_address, store_width) &&
+                !load_ins->violatesMemoryOrder()) {
+                if(output->getVerboseLevel() >= 9) {
+                    output->verbose(CALL_INFO, 9, VANADIS_DBG_LSQ_LOAD_FLG, "---> load ins: 0x%" PRI_ADDR " / thr: %" PRIu32 " went ahead of store ins: 0x%" PRI_ADDR " to 0x%" PRI_ADDR ", flag ordering violation\n",
+                        load_ins->getInstructionAddress(), load_ins->getHWThread(), store_ins->getInstructionAddress(), store_address);
+                }
+
+                load_ins->flagMemoryOrderViolation();
+                trainStoreSet(load_ins->getInstructionAddress(), store_ins->getInstructionAddress());
+                stat_order_violations->addData(1);
+            }
+
+            if(0 == bypass_entry->countStores()) {
+                delete bypass_entry;
+                load_itr = thr_loads.erase(load_itr);
+            } else {
+                load_itr++;
+            }
+        }
+    }
+
     // Per-hardware-thread queues
     std::vector< std::deque<VanadisBasicLoadStoreEntry*> > op_q;
     std::vector< std::deque<VanadisBasicStorePendingEntry*> > stores_pending;
     std::deque<VanadisBasicLoadPendingEntry*> loads_pending;
     std::set<StandardMem::Request::id_t> std_stores_in_flight;
+    std::deque< std::pair<uint64_t, StandardMem::ReadResp*> > forwarded_loads;
+    std::vector< std::deque<VanadisBasicBypassingLoadEntry*> > bypassing_loads;
+    std::vector<uint32_t> store_set_table;
+    std::unordered_map<uint64_t, std::vector<uint8_t>> functional_lines;
+    std::map<StandardMem::Request::id_t, std::pair<uint64_t, uint64_t>> functional_fills;
+
+    // writes made for system calls answered in the core, see writeSyscallData
+    struct VanadisSyscallWrite {
+        uint32_t remaining;
+        bool success;
+        std::function<void(bool)> done;
+    };
+
+    std::unordered_map<StandardMem::Request::id_t, uint64_t> syscall_write_reqs;
+    std::unordered_map<uint64_t, VanadisSyscallWrite> syscall_writes;
+    uint64_t next_syscall_write;
     int op_q_index; // Next hw_thread to check in op_q queues
     int stores_pending_index; // Next hw thread to check in stores_pending q's
     size_t op_q_size;
@@ -1138,6 +1569,15 @@ protected:
 
     const uint32_t max_issue_attempts_per_cycle;
 
+    const bool store_forwarding;
+    const uint64_t forwarding_latency;
+
+    // see VanadisLoadStoreQueue::setFunctionalMemory
+    bool functional_memory;
+    uint64_t functional_generation;
+
+    static constexpr uint32_t invalid_store_set = UINT32_MAX;
+
     uint64_t cache_line_width;
     uint64_t address_mask;
 
@@ -1155,6 +1595,12 @@ protected:
     Statistic<uint64_t>* stat_split_loads;
     Statistic<uint64_t>* stat_stored_bytes;
     Statistic<uint64_t>* stat_loaded_bytes;
+    Statistic<uint64_t>* stat_loads_forwarded;
+    Statistic<uint64_t>* stat_forward_stalls;
+    Statistic<uint64_t>* stat_loads_bypassed;
+    Statistic<uint64_t>* stat_order_violations;
+    Statistic<uint64_t>* stat_functional_loads;
+    Statistic<uint64_t>* stat_functional_fills;
 };
 
 } // namespace Vanadis
@@ -259,5 +259,48 @@ protected:
     const uint64_t load_width;
 };
 
+// Tracks a load which was accepted ahead of older stores that had not been
+// issued yet. The record lives until every one of those stores has computed
+// its address, if any of them overlaps the load the ordering was violated.
+class VanadisBasicBypassingLoadEntry : public VanadisBasicLoadEntry {
+public:
+    VanadisBasicBypassingLoadEntry(VanadisLoadInstruction* load_ins,
+        const std::vector<VanadisStoreInstruction*>& older_stores) :
+        VanadisBasicLoadEntry(load_ins), bypassed_stores(older_stores),
+        load_address(0), load_width(0) {}
+
+    void setLoadAddress(const uint64_t address, const uint64_t width) {
+        load_address = address;
+        load_width   = width;
+    }
+
+    // remove a bypassed store, returns false if the load did not go ahead of it
+    bool removeStore(VanadisStoreInstruction* store_ins) {
+        for(auto store_itr = bypassed_stores.begin(); store_itr != bypassed_stores.end(); store_itr++) {
+            if((*store_itr) == store_ins) {
+                bypassed_stores.erase(store_itr);
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    size_t countStores() const {
+        return bypassed_stores.size();
+    }
+
+    // width is zero until the load has computed its address
+    bool loadAddressOverlaps(const uint64_t store_address, const uint64_t store_width) const {
+        return (load_width > 0) && (store_width > 0) &&
+            (load_address < (store_address + store_width)) && (store_address < (load_address + load_width));
+    }
+
+protected:
+    std::vector<VanadisStoreInstruction*> bypassed_stores;
+    uint64_t load_address;
+    uint64_t load_width;
+};
+
 }
 }
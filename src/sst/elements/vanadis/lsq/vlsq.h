@@ -27,6 +27,7 @@
 #include <cassert>
 #include <cinttypes>
 #include <cstdint>
+#include <functional>
 #include <vector>
 #include <queue>
 
@@ -106,6 +107,35 @@ public:
     virtual void push(VanadisLoadInstruction* load_me) = 0;
     virtual void push(VanadisFenceInstruction* fence) = 0;
 
+    /*
+     * Memory dependence prediction - the core offers a load which is ready to issue
+     * but has older stores (older_stores, oldest first) which have not been issued yet.
+     * If the LSQ predicts the load is independent of them it accepts the load and
+     * returns true, it is then responsible for detecting an ordering violation when
+     * those stores arrive and flagging the load. By default loads are kept in order.
+     */
+    virtual bool pushBypassingStores(VanadisLoadInstruction* load_me,
+        const std::vector<VanadisStoreInstruction*>& older_stores) { return false; }
+
+    /*
+     * Functional view of memory, used while the core fast-forwards. Loads are
+     * answered from a core-private copy of the lines they touch, which is read
+     * from the memory system the first time a line is used, and stores update
+     * that copy as well as being written through to memory. The core drops the
+     * copy whenever the OS may have changed memory. LSQs which do not support
+     * this keep sending every access to memory.
+     */
+    virtual void setFunctionalMemory(bool enable) {}
+    virtual void invalidateFunctionalMemory() {}
+
+    // Writes the results of a system call the core answers itself into
+    // application memory, outside of any instruction. done is called once
+    // the whole write has completed, with false if any part of it failed.
+    // Returns false when the queue cannot do this, the call then goes to
+    // the OS instead
+    virtual bool writeSyscallData(const uint32_t hw_thr, const uint64_t address, const std::vector<uint8_t>& data,
+                                  std::function<void(bool)> done) { return false; }
+
     virtual void tick(uint64_t cycle) = 0;
 
     virtual void clearLSQByThreadID(const uint32_t thread) = 0;
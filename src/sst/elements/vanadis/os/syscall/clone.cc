@@ -229,6 +229,7 @@ void VanadisCloneSyscall::handleEvent( VanadisCoreEvent* ev )
 
     req->setIntRegs( resp->intRegs );
     req->setFpRegs( resp->fpRegs );
+    req->setThreadInfo( m_newThread->getpid(), m_newThread->gettid(), m_os->getOSStartTimeNano() );
 
      m_output->verbose(CALL_INFO, 3, VANADIS_OS_DBG_SYSCALL, "[syscall-clone] core=%d thread=%d tid=%d instPtr=%" PRI_ADDR "\n",
                  m_threadID->core, m_threadID->hwThread, m_newThread->gettid(), resp->getInstPtr() );
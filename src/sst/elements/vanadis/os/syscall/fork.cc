@@ -70,6 +70,7 @@ void VanadisForkSyscall::handleEvent( VanadisCoreEvent* ev )
     VanadisStartThreadForkReq* req = new VanadisStartThreadForkReq( m_threadID->hwThread, resp->getInstPtr(), resp->getTlsPtr() );
     req->setIntRegs( resp->intRegs );
     req->setFpRegs( resp->fpRegs );
+    req->setThreadInfo( m_child->getpid(), m_child->gettid(), m_os->getOSStartTimeNano() );
 
 #if 0 // debug
     printf("thread=%d instPtr=%" PRI_ADDR "\n",resp->getThread(), resp->getInstPtr() );
@@ -23,12 +23,14 @@
 #include <sys/fcntl.h>
 #include <sys/mman.h>
 
+#include <cerrno>
 #include <functional>
 #include <tuple>
 
 #include "inst/isatable.h"
 #include "inst/regfile.h"
 #include "inst/vsyscall.h"
+#include "lsq/vlsq.h"
 #include "os/callev/voscallall.h"
 #include "os/vstartthreadreq.h"
 #include "os/resp/voscallresp.h"
@@ -50,9 +52,14 @@ public:
         regFile = nullptr;
         isaTable = nullptr;
         tls_address = nullptr;
+        lsq = nullptr;
 
         hw_thr = 0;
         core_id = 0;
+
+        os_link = nullptr;
+        local_link = nullptr;
+        local_pending = false;
     }
 
     virtual ~VanadisCPUOSHandler() { delete output; }
@@ -63,6 +70,7 @@ public:
     void setHWThread(const uint32_t newThr) { hw_thr = newThr; }
     void setRegisterFile(VanadisRegisterFile* newFile) { regFile = newFile; }
     void setISATable(VanadisISATable* newTable) { isaTable = newTable; }
+    void setLoadStoreQueue(VanadisLoadStoreQueue* newLSQ) { lsq = newLSQ; }
 
     virtual std::tuple<bool,bool> handleSysCall(VanadisSysCallInstruction* syscallIns) = 0;
     virtual void recvSyscallResp( VanadisSyscallResponse* os_resp ) = 0;
@@ -71,8 +79,51 @@ public:
         os_link = link;
     } 
 
+    // Calls which do not need shared OS state are answered by the handler, the
+    // response is returned to the core through this link so it sees the link
+    // latency. Without a link the handler answers only the calls it always
+    // has and they complete immediately
+    void setLocalSyscallLink( SST::Link* link ) {
+        local_link = link;
+    }
+
+    // a new thread is running on this hardware thread
+    virtual void resetThreadState() {}
+    // the OS tells the core about the thread it started, see _VanadisStartThreadBaseReq
+    virtual void setThreadInfo( _VanadisStartThreadBaseReq* req ) {}
+
 protected:
 
+    void completeLocally( int thr, int64_t return_code ) {
+        VanadisSyscallResponse* resp = new VanadisSyscallResponse( return_code );
+
+        if ( nullptr == local_link ) {
+            recvSyscallResp( resp );
+        } else {
+            resp->setHWThread( thr );
+            local_link->send( resp );
+            local_pending = true;
+        }
+    }
+
+    // Calls which only return data to the application, and need nothing
+    // from the OS to produce it, write it through the LSQ and complete
+    // once the write has. Returns false if the call must go to the OS
+    bool completeLocallyWithData( int thr, uint64_t addr, std::vector<uint8_t>& data, int64_t return_code ) {
+        if ( nullptr == local_link || nullptr == lsq ) {
+            return false;
+        }
+
+        // a write which fails returns EFAULT, as Linux does
+        if ( ! lsq->writeSyscallData( thr, addr, data,
+                [this, thr, return_code]( bool success ) { completeLocally( thr, success ? return_code : -EFAULT ); } ) ) {
+            return false;
+        }
+
+        local_pending = true;
+        return true;
+    }
+
     void sendSyscallEvent( VanadisSyscallEvent* ev ) {
         os_link->send( ev );
     }
@@ -90,6 +141,10 @@ protected:
 
     uint64_t* tls_address;
 
+    VanadisLoadStoreQueue* lsq;
+    SST::Link* local_link;
+    bool local_pending;
+
 private:
     SST::Link* os_link;
 };
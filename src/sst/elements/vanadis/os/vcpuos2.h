@@ -18,6 +18,8 @@
 
 #include "os/vcpuos.h"
 
+#include <cstring>
+
 namespace SST {
 namespace Vanadis {
 
@@ -72,13 +74,20 @@ namespace Vanadis {
     using VanadisCPUOSHandler2< T1, BitType, RegZero, OsCodeReg, LinkReg >::getOsCode; \
     using VanadisCPUOSHandler2< T1, BitType, RegZero, OsCodeReg, LinkReg >::tls_address; \
     using VanadisCPUOSHandler2< T1, BitType, RegZero, OsCodeReg, LinkReg >::install; \
+    using VanadisCPUOSHandler2< T1, BitType, RegZero, OsCodeReg, LinkReg >::completeLocally; \
+    using VanadisCPUOSHandler2< T1, BitType, RegZero, OsCodeReg, LinkReg >::completeLocallyWithData; \
+    using VanadisCPUOSHandler2< T1, BitType, RegZero, OsCodeReg, LinkReg >::gettimeLocally; \
+    using VanadisCPUOSHandler2< T1, BitType, RegZero, OsCodeReg, LinkReg >::recordReturnCode; \
     using VanadisCPUOSHandler2< T1, BitType, RegZero, OsCodeReg, LinkReg >::instPtr;
 
 template <class T1, VanadisOSBitType BitType, int regZero, int OsCodeReg, int LinkReg >
 class VanadisCPUOSHandler2 : public VanadisCPUOSHandler {
 
 public:
-    VanadisCPUOSHandler2(ComponentId_t id, Params& params, const char* isaName ) : VanadisCPUOSHandler(id,params), m_isaName(isaName) { }
+    VanadisCPUOSHandler2(ComponentId_t id, Params& params, const char* isaName ) : VanadisCPUOSHandler(id,params), m_isaName(isaName) {
+        resetThreadState();
+        m_pendingId = nullptr;
+    }
 
     typedef std::function<VanadisSyscallEvent*(int)> FuncPtr;
 
@@ -107,6 +116,8 @@ public:
         uint64_t call_link_value = getLinkReg();
 
         flushLSQ = false;
+        local_pending = false;
+        m_pendingId = nullptr;
         const uint32_t hw_thr = syscallIns->getHWThread();
 
         const uint64_t os_code = getOsCode();
@@ -127,7 +138,29 @@ public:
             sendSyscallEvent(call_ev);
             return std::make_tuple(false,flushLSQ);
         } else {
-            return std::make_tuple(true,flushLSQ);
+            // a call answered through the local link completes when the response arrives
+            return std::make_tuple(!local_pending,flushLSQ);
+        }
+    }
+
+    // pid and tid do not change for the life of a thread. The OS sends them
+    // when it starts the thread, and if it didn't they are kept once the OS
+    // has answered, so either way they are returned without leaving the core
+    void resetThreadState() {
+        m_pid = -1;
+        m_tid = -1;
+        m_osStartTimeNano = -1;
+    }
+
+    void setThreadInfo( _VanadisStartThreadBaseReq* req ) {
+        if ( req->getPid() >= 0 ) {
+            m_pid = req->getPid();
+        }
+        if ( req->getTid() >= 0 ) {
+            m_tid = req->getTid();
+        }
+        if ( req->getOSStartTimeNano() >= 0 ) {
+            m_osStartTimeNano = req->getOSStartTimeNano();
         }
     }
 
@@ -152,7 +185,7 @@ protected:
 
         printf("Warning: VANADIS_SYSCALL_%s_%s not implemented returning success\n",m_isaName,__func__);
 
-        recvSyscallResp(new VanadisSyscallResponse(0));
+        completeLocally(hw_thr, 0);
         return nullptr;
     }
 
@@ -173,6 +206,14 @@ protected:
         output->verbose(CALL_INFO, 8, 0,
                             "sched_getaffinity( %" PRIdXX ", %" PRIdXX", %#" PRIxXX " )\n", pid, cpusetsize, maskAddr );
 
+        // every CPU is available for scheduling, which is all the OS would answer
+        if ( 0 == pid ) {
+            std::vector<uint8_t> payload( 128, 0xff );
+            if ( completeLocallyWithData( hw_thr, maskAddr, payload, 0 ) ) {
+                return nullptr;
+            }
+        }
+
         return new VanadisSyscallGetaffinityEvent(core_id, hw_thr, BitType, pid, cpusetsize, maskAddr );
     }
     VanadisSyscallEvent* MPROTECT( int hw_thr ) {
@@ -193,7 +234,7 @@ protected:
 
     VanadisSyscallEvent* RT_SIGACTION( int hw_thr ) {
         printf("Warning: VANADIS_SYSCALL_%s_%s not implemented returning success\n",m_isaName,__func__);
-        recvSyscallResp(new VanadisSyscallResponse(0));
+        completeLocally(hw_thr, 0);
         return nullptr;
     }
 
@@ -206,7 +247,7 @@ protected:
         output->verbose(CALL_INFO, 8, 0, "rt_sigprocmask( %" PRIdXX ", %#" PRIxXX ", %#" PRIxXX ", %" PRIdXX ")\n", how, set_in, set_out, set_size);
         printf("Warning: VANADIS_SYSCALL_%s_%s not implemented returning success\n",m_isaName,__func__);
 
-        recvSyscallResp(new VanadisSyscallResponse(0));
+        completeLocally(hw_thr, 0);
         return nullptr;
     }
 
@@ -217,7 +258,7 @@ protected:
         output->verbose(CALL_INFO, 8, 0, "unmap( %#" PRIxXX", %" PRIuXX " )\n", addr, len);
 
         if ((0 == addr)) {
-            recvSyscallResp(new VanadisSyscallResponse(-22));
+            completeLocally(hw_thr, -22);
             return nullptr;
         } else {
             return new VanadisSyscallMemoryUnMapEvent(core_id, hw_thr, BitType, addr, len);
@@ -243,7 +284,7 @@ protected:
 
     VanadisSyscallEvent* GETPID( int hw_thr ) {
         output->verbose(CALL_INFO, 8, 0, "getpid()\n");
-        return new VanadisSyscallGetxEvent(core_id, hw_thr, BitType,SYSCALL_OP_GETPID);
+        return getCachedId(hw_thr, m_pid, SYSCALL_OP_GETPID);
     }
 
     VanadisSyscallEvent* GETPGID( int hw_thr ) {
@@ -257,7 +298,50 @@ protected:
 
     VanadisSyscallEvent* GETTID( int hw_thr ) {
         output->verbose(CALL_INFO, 8, 0, "gettid()\n");
-        return new VanadisSyscallGetxEvent(core_id, hw_thr, BitType,SYSCALL_OP_GETTID);
+        return getCachedId(hw_thr, m_tid, SYSCALL_OP_GETTID);
+    }
+
+    VanadisSyscallEvent* getCachedId( int hw_thr, int64_t& id, VanadisSyscallOp op ) {
+        if ( nullptr == local_link ) {
+            return new VanadisSyscallGetxEvent(core_id, hw_thr, BitType, op);
+        }
+
+        if ( id >= 0 ) {
+            output->verbose(CALL_INFO, 9, 0, "answered locally: %" PRId64 "\n", id);
+            completeLocally(hw_thr, id);
+            return nullptr;
+        }
+
+        m_pendingId = &id;
+        return new VanadisSyscallGetxEvent(core_id, hw_thr, BitType, op);
+    }
+
+    // The OS answers clock_gettime with its own start time plus the simulated
+    // time, which the core can do as well once it has been told the start time
+    bool gettimeLocally( int hw_thr, uint64_t time_addr ) {
+        if ( m_osStartTimeNano < 0 ) {
+            return false;
+        }
+
+        const uint64_t sim_time_ns = getCurrentSimTimeNano() + m_osStartTimeNano;
+        const uint64_t sim_seconds = sim_time_ns / 1000000000ULL;
+        const uint64_t sim_ns = sim_time_ns % 1000000000ULL;
+
+        // same layout as VanadisGettime64Syscall, tv_nsec is a long
+        std::vector<uint8_t> payload( VanadisOSBitType::VANADIS_OS_64B == BitType ? 16 : 12 );
+        memcpy( payload.data(), &sim_seconds, sizeof(sim_seconds) );
+        memcpy( payload.data() + sizeof(sim_seconds), &sim_ns, payload.size() - sizeof(sim_seconds) );
+
+        output->verbose(CALL_INFO, 9, 0, "answered locally: %" PRIu64 " ns\n", sim_time_ns);
+        return completeLocallyWithData( hw_thr, time_addr, payload, 0 );
+    }
+
+    // called by the ISA handlers with the return code of every response
+    void recordReturnCode( int64_t return_code ) {
+        if ( nullptr != m_pendingId && return_code >= 0 ) {
+            *m_pendingId = return_code;
+        }
+        m_pendingId = nullptr;
     }
 
     VanadisSyscallEvent* READ( int hw_thr ) {
@@ -398,6 +482,10 @@ protected:
     }
 private:
     std::map<int,FuncPtr> m_functionMap;
+    int64_t m_pid;
+    int64_t m_tid;
+    int64_t m_osStartTimeNano;
+    int64_t* m_pendingId;
     bool flushLSQ;
     const char* m_isaName;
 };
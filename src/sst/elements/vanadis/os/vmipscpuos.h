@@ -211,7 +211,7 @@ public:
         } else {
             assert(0);
         }
-        recvSyscallResp(new VanadisSyscallResponse(0));
+        completeLocally(hw_thr, 0);
         return nullptr;
     }
 
@@ -260,7 +260,7 @@ public:
         if ( flags & MIPS_MAP_FIXED ) {
             output->verbose(CALL_INFO, 8, 0,"mmap2() we don't support MAP_FIXED return error EEXIST\n");
 
-            recvSyscallResp(new VanadisSyscallResponse(-EEXIST));
+            completeLocally(hw_thr, -EEXIST);
             return nullptr;
         } else {
 
@@ -275,6 +275,10 @@ public:
 
         output->verbose(CALL_INFO, 8, 0, "clock_gettime64( %" PRId32 ", %#" PRIx32 ")\n", clk_type, time_addr);
 
+        if ( gettimeLocally( hw_thr, time_addr ) ) {
+            return nullptr;
+        }
+
         return new VanadisSyscallGetTime64Event(core_id, hw_thr, VanadisOSBitType::VANADIS_OS_32B, clk_type, time_addr);
     }
 
@@ -297,6 +301,7 @@ public:
         const uint16_t rc_reg = isaTable->getIntPhysReg(2);
         const int32_t rc_val = (int32_t)os_resp->getReturnCode();
         regFile->setIntReg(rc_reg, rc_val);
+        recordReturnCode(rc_val);
 
         if (os_resp->isSuccessful()) {
             if (rc_val < 0) {
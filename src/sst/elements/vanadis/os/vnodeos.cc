@@ -17,6 +17,7 @@
 #include <sst_config.h>
 #include <sst/core/component.h>
 
+#include <chrono>
 #include <functional>
 
 #include "vanadisDbgFlags.h"
@@ -62,6 +63,17 @@ VanadisNodeOSComponent::VanadisNodeOSComponent(SST::ComponentId_t id, SST::Param
     } else {
         m_checkpoint = NO_CHECKPOINT;
     }
+
+    std::string ckptFormat = params.find<std::string>("checkpointFormat", "text");
+    if ( ckptFormat != "text" && ckptFormat != "binary" ) {
+        output->fatal(CALL_INFO, -1, "Error: checkpointFormat must be 'text' or 'binary' (got %s).\n", ckptFormat.c_str());
+    }
+    m_checkpointBinary = ( ckptFormat == "binary" );
+
+    m_checkpointBaseDir = params.find<std::string>("checkpointBaseDir", "");
+    if ( ! m_checkpointBaseDir.empty() && CHECKPOINT_SAVE != m_checkpoint ) {
+        output->fatal(CALL_INFO, -1, "Error: checkpointBaseDir requires checkpoint to be 'save'.\n");
+    }
     const uint32_t core_count = params.find<uint32_t>("cores", 0);
     const uint32_t hardwareThreadCount = params.find<uint32_t>("hardwareThreadCount", 1);
     
@@ -112,13 +124,18 @@ VanadisNodeOSComponent::VanadisNodeOSComponent(SST::ComponentId_t id, SST::Param
         // we don't use it
     }
 
+    m_preload = params.find<bool>("preload", false);
+    if ( m_preload && nullptr == m_mmu ) {
+        output->fatal(CALL_INFO, -1, "Error: preload requires useMMU\n");
+    }
+
     m_nodeNum = params.find<int>("node_id", -1);
 
     m_coreInfoMap.resize( core_count, hardwareThreadCount ); 
 
     int numProcess = 0;
 
-if ( CHECKPOINT_LOAD != m_checkpoint ) {
+if ( checkpointRestoreDir().empty() ) {
     while( 1 ) {
         std::string name("process" + std::to_string(numProcess) );
         Params tmp = params.get_scoped_params(name);
@@ -149,7 +166,7 @@ if ( CHECKPOINT_LOAD != m_checkpoint ) {
     }
 
 } else {
-    numProcess = checkpointLoad(m_checkpointDir);
+    numProcess = checkpointLoad(checkpointRestoreDir());
 }
 
     // make sure we have a thread for each process
@@ -212,6 +229,22 @@ VanadisNodeOSComponent::init(unsigned int phase) {
         m_mmu->init(phase);
     }
 
+    // untimed writes are queued by the memory interface until memory is reachable
+    if ( 0 == phase && m_preload && checkpointRestoreDir().empty() ) {
+        auto start = std::chrono::steady_clock::now();
+
+        placeProcesses();
+
+        unsigned numPages = 0;
+        for ( const auto kv : m_threadMap ) {
+            numPages += preloadProcess( kv.second );
+        }
+
+        std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+        output->verbose(CALL_INFO, 0, 0, "preloaded %u pages (%" PRIu64 " bytes) for %zu processes in %.3f seconds\n",
+            numPages, (uint64_t) numPages * m_pageSize, m_threadMap.size(), elapsed.count() );
+    }
+
     // do we need to check for this, really?
     for (Link* next_link : core_links) {
         while (SST::Event* ev = next_link->recvUntimedData()) {
@@ -223,16 +256,28 @@ VanadisNodeOSComponent::init(unsigned int phase) {
 void
 VanadisNodeOSComponent::setup() {
 
-    if ( CHECKPOINT_LOAD == m_checkpoint ) return;
+    if ( ! checkpointRestoreDir().empty() ) return;
+
+    // preloaded processes were placed during init
+    if ( ! m_preload ) {
+        placeProcesses();
+    }
 
     // start all of the processes
+    for ( const auto kv : m_threadMap ) {
+        startProcess( kv.second ); 
+    }
+}
+
+void
+VanadisNodeOSComponent::placeProcesses() {
     for ( const auto kv : m_threadMap ) {
         OS::HwThreadID* tmp = m_availHwThreads.front();
         m_availHwThreads.pop();
 
         m_threadMap[kv.first]->setHwThread( *tmp );
 
-        startProcess( *tmp, kv.second ); 
+        m_startStackPtr[kv.first] = configureProcessMemory( *tmp, kv.second );
         delete tmp;
     }
 }
@@ -258,8 +303,8 @@ VanadisNodeOSComponent::checkpoint( std::string dir )
     auto fp = fopen(filename.str().c_str(),"w+");
     assert(fp);
 
-    m_mmu->checkpoint( dir );
-    m_physMemMgr->checkpoint( output, dir );
+    m_mmu->checkpoint( dir, m_checkpointBinary );
+    m_physMemMgr->checkpoint( output, dir, m_checkpointBinary );
 
     // dump ELF map
     fprintf(fp,"m_elfMap.size() %zu\n",m_elfMap.size());
@@ -320,7 +365,7 @@ int VanadisNodeOSComponent::checkpointLoad( std::string dir )
     size_t size; 
     int numProcess = 0;
     std::stringstream filename;
-    filename << m_checkpointDir << "/" << getName();
+    filename << dir << "/" << getName();
     output->verbose(CALL_INFO, 0, VANADIS_DBG_CHECKPOINT,"Checkpoint component `%s` %s\n",getName().c_str(), filename.str().c_str());
 
     auto fp = fopen(filename.str().c_str(),"r");
@@ -516,8 +561,8 @@ void VanadisNodeOSComponent::copyPage( uint64_t physFrom, uint64_t physTo, unsig
     readPage( physFrom, data, pageSize, tmp );
 }
 
-void
-VanadisNodeOSComponent::startProcess( OS::HwThreadID& threadID, OS::ProcessInfo* process ) 
+uint64_t
+VanadisNodeOSComponent::configureProcessMemory( OS::HwThreadID& threadID, OS::ProcessInfo* process ) 
 {
     int pid = process->getpid();
 
@@ -554,13 +599,109 @@ VanadisNodeOSComponent::startProcess( OS::HwThreadID& threadID, OS::ProcessInfo*
 
     process->printRegions("after app runtime setup");
 
-    m_coreInfoMap.at(threadID.core).setProcess( threadID.hwThread, process );
+    return stack_pointer;
+}
+
+void
+VanadisNodeOSComponent::startProcess( OS::ProcessInfo* process ) 
+{
+    m_coreInfoMap.at(process->getCore()).setProcess( process->getHwThread(), process );
 
+    uint64_t stack_pointer = m_startStackPtr.at( process->gettid() );
     uint64_t entry = process->getEntryPoint();
     output->verbose(CALL_INFO, 1, VANADIS_OS_DBG_APP_INIT,
         "stack_pointer=%#" PRIx64 " entry=%#" PRIx64 "\n",stack_pointer, entry );
     
-    core_links.at(threadID.core)->send( new VanadisStartThreadFirstReq( threadID.hwThread, entry, stack_pointer ) );
+    VanadisStartThreadFirstReq* req = new VanadisStartThreadFirstReq( process->getHwThread(), entry, stack_pointer );
+    req->setThreadInfo( process->getpid(), process->gettid(), m_osStartTimeNano );
+    core_links.at(process->getCore())->send( req );
+}
+
+// Maps and writes the pages a process touches first, its loadable ELF segments,
+// program headers and initial stack, so they are not faulted in one at a time
+unsigned
+VanadisNodeOSComponent::preloadProcess( OS::ProcessInfo* process ) 
+{
+    unsigned numPages = 0;
+    VanadisELFInfo* elfInfo = process->getElfInfo();
+
+    for ( size_t i = 0; i < elfInfo->countProgramHeaders(); ++i ) {
+        const VanadisELFProgramHeaderEntry* hdr = elfInfo->getProgramHeader(i);
+        if ( PROG_HEADER_LOAD == hdr->getHeaderType() ) {
+            auto region = process->findMemRegion( hdr->getVirtualMemoryStart() );
+            numPages += preloadRegion( process, region, region->addr, region->end() );
+        }
+    }
+
+    // only the part of the stack region holding the initial stack has data
+    for ( const char* name : { "phdr", "stack" } ) {
+        auto region = process->findMemRegion( std::string(name) );
+        auto backing = region->backing;
+        numPages += preloadRegion( process, region, backing->dataStartAddr, backing->dataStartAddr + backing->data.size() );
+    }
+
+    return numPages;
+}
+
+// Same as a page fault on each page in [start,end) of the region, but the
+// data is sent as a single untimed write per page
+unsigned
+VanadisNodeOSComponent::preloadRegion( OS::ProcessInfo* process, OS::MemoryRegion* region, uint64_t start, uint64_t end ) 
+{
+    unsigned numPages = 0;
+    unsigned pid = process->getpid();
+
+    for ( uint64_t virtAddr = start; virtAddr < end; virtAddr += m_pageSize ) {
+        uint32_t vpn = virtAddr >> m_pageShift;
+
+        // segments can share a page
+        if ( m_mmu->getPerms( pid, vpn ) > -1 ) {
+            continue;
+        }
+
+        OS::Page* page = nullptr;
+        uint8_t* data = nullptr;
+
+        if ( region->backing->elfInfo ) {
+            page = checkPageCache( region->backing->elfInfo, vpn );
+            if ( nullptr == page ) {
+                data = readElfPage( output, region->backing->elfInfo, vpn, m_pageSize );
+            }
+        } else {
+            data = region->readData( virtAddr, m_pageSize );
+        }
+
+        if ( nullptr == page ) {
+            try {
+                page = allocPage( );
+            } catch ( int err ) {
+                output->fatal(CALL_INFO, -1, "Error: ran out of physical memory\n");
+            }
+            process->mapVirtToPage( vpn, page );
+        } else {
+            page->incRefCnt();
+        }
+
+        m_mmu->map( pid, vpn, page->getPPN(), m_pageSize, region->perms );
+
+        if ( nullptr == data ) {
+            output->verbose(CALL_INFO, 2, VANADIS_OS_DBG_INIT,"preload vpn=%d using cached ppn=%d\n", vpn, page->getPPN());
+            continue;
+        }
+
+        if ( region->backing->elfInfo && 0 == region->name.compare("text") ) {
+            updatePageCache( region->backing->elfInfo, vpn, page );
+        }
+
+        output->verbose(CALL_INFO, 2, VANADIS_OS_DBG_INIT,"preload vpn=%d ppn=%d\n", vpn, page->getPPN());
+
+        std::vector<uint8_t> buffer( data, data + m_pageSize );
+        mem_if->sendUntimedData( new StandardMem::Write( (uint64_t) page->getPPN() << m_pageShift, m_pageSize, buffer ) );
+        delete [] data;
+        ++numPages;
+    }
+
+    return numPages;
 }
 
 void VanadisNodeOSComponent::writeMem( OS::ProcessInfo* process, uint64_t virtAddr, std::vector<uint8_t>* data, int perms, unsigned pageSize, Callback* callback )
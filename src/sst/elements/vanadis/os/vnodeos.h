@@ -57,6 +57,11 @@ public:
                             { "physMemSize", "Size of available physical memory in bytes, with units. Ex: 2GiB", NULL },
                             { "page_size", "Size of a page, in bytes", "4096" },
                             { "useMMU", "Whether an MMU subcomponent is being used.", "False" },
+                            { "checkpoint", "'save' writes the OS state to checkpointDir when the application requests a checkpoint, 'load' restores it from there", "" },
+                            { "checkpointDir", "Directory holding the checkpoint", "" },
+                            { "checkpointFormat", "Format of saved page tables and physical memory allocator state, 'text' or 'binary'. Loads detect the format", "text" },
+                            { "checkpointBaseDir", "When saving, first restore from the checkpoint in this directory (set the same on the cores and memory)", "" },
+                            { "preload", "Write each process's ELF segments, program headers and initial stack into memory during init instead of faulting them in. Requires useMMU", "False" },
                             { "process%(processnum)d.env_count", "Number of environment variables to pass to the process", "0"},
                             { "process%(processnum)d.env%(argnum)d", "Environment variable to pass to the process. Example: 'OMPNUMTHREADS=64'. 'argnum' should be contiguous starting at 0 and ending at env_count-1", ""},
                             { "proccess%(processnum)d.exe", "Name of executable, including path", NULL},
@@ -168,7 +173,11 @@ private:
 
     void pageFault( PageFault* );
     void pageFaultFini( PageFault*, bool success = true );
-    void startProcess( OS::HwThreadID&, OS::ProcessInfo* process );
+    void placeProcesses();
+    uint64_t configureProcessMemory( OS::HwThreadID&, OS::ProcessInfo* process );
+    void startProcess( OS::ProcessInfo* process );
+    unsigned preloadProcess( OS::ProcessInfo* process );
+    unsigned preloadRegion( OS::ProcessInfo* process, OS::MemoryRegion* region, uint64_t start, uint64_t end );
     void copyPage(uint64_t physFrom, uint64_t physTo, unsigned pageSize, Callback* );
 
     void sendMemoryEvent(VanadisSyscall* syscall, StandardMem::Request* ev ) {
@@ -177,6 +186,7 @@ private:
     }
 
     uint64_t getNanoSeconds() { return getCurrentSimTimeNano() + m_osStartTimeNano;  }
+    uint64_t getOSStartTimeNano() { return m_osStartTimeNano; }
 
     void writePage( uint64_t physAddr, uint8_t* data, unsigned page_size, Callback* callback )
     {
@@ -385,6 +395,10 @@ private:
 
     std::queue< OS::HwThreadID* > m_availHwThreads;
 
+    // initial stack pointer of each process, set when its memory is configured
+    std::unordered_map<uint32_t,uint64_t>           m_startStackPtr;
+    bool                                            m_preload;
+
     std::map< int, OS::Device* > m_deviceList;
 
     int m_currentTid;
@@ -396,8 +410,15 @@ private:
     }
 
     std::string m_checkpointDir;
+    std::string m_checkpointBaseDir;
+    bool m_checkpointBinary;
     enum { NO_CHECKPOINT, CHECKPOINT_LOAD, CHECKPOINT_SAVE }  m_checkpoint;
 
+    // the checkpoint this run starts from, if any
+    std::string checkpointRestoreDir() {
+        return CHECKPOINT_LOAD == m_checkpoint ? m_checkpointDir : m_checkpointBaseDir;
+    }
+
     void checkpoint( std::string dir );
     int checkpointLoad( std::string dir );
     std::deque<uint64_t> m_flushPages;
@@ -24,6 +24,7 @@
 #include <assert.h>
 
 #include "vanadisDbgFlags.h"
+#include "sst/elements/memHierarchy/checkpointFile.h"
 
 #define FOUR_KB 4096
 #define TWO_MB ( 1024*1024*2)
@@ -90,6 +91,14 @@ class PhysMemManager {
             }
         }
 
+        void checkpoint( SST::MemHierarchy::CheckpointFile& ckpt ) {
+            ckpt.writeVector( m_bitMap );
+        }
+
+        void checkpointLoad( SST::MemHierarchy::CheckpointFile& ckpt ) {
+            ckpt.readVector( m_bitMap );
+        }
+
       private:
 
       private:
@@ -136,19 +145,50 @@ class PhysMemManager {
         }
     }
 
-    void checkpoint( SST::Output* output, std::string dir ) {
+    void checkpoint( SST::Output* output, std::string dir, bool binary ) {
         std::stringstream filename;
         filename << dir << "/" << "PhysMemManager";
-        auto fp = fopen(filename.str().c_str(),"w+");
 
         output->verbose(CALL_INFO, 0, VANADIS_DBG_CHECKPOINT,"PhysMemManager %s\n", filename.str().c_str());
 
+        if ( binary ) {
+            SST::MemHierarchy::CheckpointFile ckpt;
+            if ( ! ckpt.openWrite( filename.str(), checkpointKind, false ) ) {
+                output->fatal(CALL_INFO, -1, "Error: unable to create checkpoint %s\n", filename.str().c_str());
+            }
+            ckpt.write<uint64_t>( m_numAllocated );
+            m_bitMap.checkpoint( ckpt );
+            ckpt.close();
+            if ( ! ckpt.good() ) {
+                output->fatal(CALL_INFO, -1, "Error: failed writing checkpoint %s\n", filename.str().c_str());
+            }
+            return;
+        }
+
+        auto fp = fopen(filename.str().c_str(),"w+");
+
         fprintf(fp,"m_numAllocated %d\n",m_numAllocated);
         m_bitMap.checkpoint(fp);
     }
     void checkpointLoad( SST::Output* output , std::string dir ) {
         std::stringstream filename;
         filename << dir << "/" << "PhysMemManager";
+
+        if ( SST::MemHierarchy::CheckpointFile::isBinary( filename.str() ) ) {
+            SST::MemHierarchy::CheckpointFile ckpt;
+            uint32_t kind;
+            if ( ! ckpt.openRead( filename.str() ) || ! ckpt.readHeader( kind ) || checkpointKind != kind ) {
+                output->fatal(CALL_INFO, -1, "Error: %s is not a physical memory checkpoint\n", filename.str().c_str());
+            }
+            m_numAllocated = ckpt.read<uint64_t>();
+            m_bitMap.checkpointLoad( ckpt );
+            if ( ! ckpt.good() ) {
+                output->fatal(CALL_INFO, -1, "Error: checkpoint %s is truncated\n", filename.str().c_str());
+            }
+            output->verbose(CALL_INFO, 0, VANADIS_DBG_CHECKPOINT,"m_numAllocated %" PRIu64 "\n",m_numAllocated);
+            return;
+        }
+
         auto fp = fopen(filename.str().c_str(),"r");
         assert(fp);
 
@@ -158,6 +198,8 @@ class PhysMemManager {
     }
 
   private:
+    static constexpr uint32_t checkpointKind = SST::MemHierarchy::CheckpointFile::makeKind('P','M','E','M');
+
     int calcNumNeeded( PageSize pageSize ) {
         switch( pageSize ) {
           case FourKB: return 1;
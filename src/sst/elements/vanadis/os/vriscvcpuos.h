@@ -24,6 +24,7 @@
 #include "os/vcpuos2.h"
 #include "os/voscallev.h"
 #include <functional>
+#include <sst/core/rng/xorshift.h>
 
 #include <fcntl.h>
 
@@ -166,6 +167,16 @@ public:
 
         output->verbose(CALL_INFO, 8, 0, "getrandom( %" PRIu64 ", %" PRIu64 ", %#" PRIx64 ")\n", buf, buflen, flags);
 
+        // the same bytes VanadisGetrandomSyscall would write
+        std::vector<uint8_t> payload( buflen );
+        RNG::XORShiftRNG rng(272727);
+        for ( auto& val : payload ) {
+            val = rng.generateNextUInt32() % 255;
+        }
+        if ( completeLocallyWithData( hw_thr, buf, payload, buflen ) ) {
+            return nullptr;
+        }
+
         return new VanadisSyscallGetrandomEvent(core_id, hw_thr, VanadisOSBitType::VANADIS_OS_64B, buf, buflen, flags );
     }
 
@@ -241,7 +252,7 @@ public:
         if ( map_flags & RISCV_MAP_FIXED ) {
             output->verbose(CALL_INFO, 8, 0,"mmap() we don't support MAP_FIXED return error EEXIST\n");
 
-            recvSyscallResp(new VanadisSyscallResponse(-EEXIST));
+            completeLocally(hw_thr, -EEXIST);
             return nullptr;
         } else {
 
@@ -275,6 +286,10 @@ public:
         output->verbose(CALL_INFO, 8, 0,
                             "clock_gettime64( %" PRId64 ", 0x%" PRI_ADDR " )\n", clk_type, time_addr);
 
+        if ( gettimeLocally( hw_thr, time_addr ) ) {
+            return nullptr;
+        }
+
         return new VanadisSyscallGetTime64Event(core_id, hw_thr, VanadisOSBitType::VANADIS_OS_64B, clk_type, time_addr);
     }
 
@@ -290,7 +305,7 @@ public:
 
         printf("Warning: VANADIS_SYSCALL_RISCV_RT_SIGPROCMASK not implemented return success\n");
 
-        recvSyscallResp(new VanadisSyscallResponse(0));
+        completeLocally(hw_thr, 0);
         return nullptr;
     }
 
@@ -325,6 +340,7 @@ public:
         const uint16_t rc_reg = isaTable->getIntPhysReg( VANADIS_SYSCALL_RISCV_RET_REG );
         const int64_t rc_val = (int64_t)os_resp->getReturnCode();
         regFile->setIntReg(rc_reg, rc_val);
+        recordReturnCode(rc_val);
 
         delete os_resp;
     }
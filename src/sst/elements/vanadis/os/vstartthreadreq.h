@@ -23,10 +23,10 @@ namespace Vanadis {
 
 class _VanadisStartThreadBaseReq : public SST::Event {
 public:
-    _VanadisStartThreadBaseReq() : SST::Event(), thread(0), instPtr(0), stackAddr(0), argAddr(0), tlsAddr(0) { }
+    _VanadisStartThreadBaseReq() : SST::Event(), thread(0), instPtr(0), stackAddr(0), argAddr(0), tlsAddr(0), pid(-1), tid(-1), osStartTimeNano(-1) { }
 
     _VanadisStartThreadBaseReq( int thread, uint64_t instPtr, uint64_t stackAddr, uint64_t argAddr, uint64_t tlsAddr ) : 
-        SST::Event(), thread(thread), stackAddr(stackAddr), instPtr(instPtr), argAddr(argAddr), tlsAddr(tlsAddr) {}
+        SST::Event(), thread(thread), stackAddr(stackAddr), instPtr(instPtr), argAddr(argAddr), tlsAddr(tlsAddr), pid(-1), tid(-1), osStartTimeNano(-1) {}
 
     virtual ~_VanadisStartThreadBaseReq() {}
 
@@ -40,6 +40,17 @@ public:
     std::vector<uint64_t>& getIntRegs() { return intRegs; }
     std::vector<uint64_t>& getFpRegs() { return fpRegs; }
 
+    // What the core needs to answer getpid, gettid and clock_gettime for
+    // the thread without asking the OS
+    void setThreadInfo( int64_t newPid, int64_t newTid, int64_t newOSStartTimeNano ) {
+        pid = newPid;
+        tid = newTid;
+        osStartTimeNano = newOSStartTimeNano;
+    }
+    int64_t getPid() { return pid; }
+    int64_t getTid() { return tid; }
+    int64_t getOSStartTimeNano() { return osStartTimeNano; }
+
 
 private:
     void serialize_order(SST::Core::Serialization::serializer& ser) override {
@@ -49,6 +60,9 @@ private:
         ser& stackAddr;
         ser& argAddr;
         ser& tlsAddr;
+        ser& pid;
+        ser& tid;
+        ser& osStartTimeNano;
         ser& intRegs;
         ser& fpRegs;
     }
@@ -60,6 +74,9 @@ private:
     int64_t stackAddr;
     int64_t argAddr;
     int64_t tlsAddr;
+    int64_t pid;
+    int64_t tid;
+    int64_t osStartTimeNano;
 
     std::vector<uint64_t> intRegs;
     std::vector<uint64_t> fpRegs;
@@ -6,12 +6,10 @@ mh_debug=0
 dbgAddr="0"
 stopDbg="0"
 
-checkpointDir = ""
-checkpoint = ""
-
-#checkpointDir = "checkpoint0"
-#checkpoint = "load"
-#checkpoint = "save"
+# e.g. VANADIS_CHECKPOINT_DIR=checkpoint0 with VANADIS_CHECKPOINT=save, then load
+checkpointDir = os.getenv("VANADIS_CHECKPOINT_DIR", "")
+checkpoint = os.getenv("VANADIS_CHECKPOINT", "")
+checkpointFormat = os.getenv("VANADIS_CHECKPOINT_FORMAT", "text")
 
 pythonDebug=False
 
@@ -75,8 +73,20 @@ exe_name= full_exe_name.split("/")[-1]
 verbosity = int(os.getenv("VANADIS_VERBOSE", 0))
 os_verbosity = os.getenv("VANADIS_OS_VERBOSE", verbosity)
 pipe_trace_file = os.getenv("VANADIS_PIPE_TRACE", "")
+bbv_file = os.getenv("VANADIS_BBV_FILE", "")
+bbv_interval = os.getenv("VANADIS_BBV_INTERVAL", 100000000)
+bbv_block_map_file = os.getenv("VANADIS_BBV_BLOCK_MAP_FILE", "")
 lsq_ld_entries = os.getenv("VANADIS_LSQ_LD_ENTRIES", 16)
 lsq_st_entries = os.getenv("VANADIS_LSQ_ST_ENTRIES", 8)
+lsq_store_forwarding = os.getenv("VANADIS_LSQ_STORE_FORWARDING", 0)
+lsq_store_set_entries = os.getenv("VANADIS_LSQ_STORE_SET_ENTRIES", 0)
+
+fast_forward_insts = os.getenv("VANADIS_FAST_FORWARD_INSTS", 0)
+issue_queue_entries = os.getenv("VANADIS_ISSUE_QUEUE_ENTRIES", 0)
+os_preload = os.getenv("VANADIS_OS_PRELOAD", 0)
+local_syscalls = os.getenv("VANADIS_LOCAL_SYSCALLS", 0)
+commit_trace = os.getenv("VANADIS_COMMIT_TRACE", "")
+commit_trace_compress = os.getenv("VANADIS_COMMIT_TRACE_COMPRESS", 0)
 
 rob_slots = os.getenv("VANADIS_ROB_SLOTS", 64)
 retires_per_cycle = os.getenv("VANADIS_RETIRES_PER_CYCLE", 4)
@@ -88,6 +98,7 @@ integer_arith_units = int(os.getenv("VANADIS_INTEGER_ARITH_UNITS", 2))
 fp_arith_cycles = int(os.getenv("VANADIS_FP_ARITH_CYCLES", 8))
 fp_arith_units = int(os.getenv("VANADIS_FP_ARITH_UNITS", 2))
 branch_arith_cycles = int(os.getenv("VANADIS_BRANCH_ARITH_CYCLES", 2))
+branch_unit = os.getenv("VANADIS_BRANCH_UNIT", "VanadisBasicBranchUnit")
 
 cpu_clock = os.getenv("VANADIS_CPU_CLOCK", "2.3GHz")
 
@@ -141,8 +152,10 @@ osParams = {
     "page_size"  : 4096,
     "physMemSize" : physMemSize,
     "useMMU" : True,
+    "preload" : os_preload,
     "checkpointDir" : checkpointDir,
-    "checkpoint" : checkpoint
+    "checkpoint" : checkpoint,
+    "checkpointFormat" : checkpointFormat
 }
 
 
@@ -216,7 +229,8 @@ memCtrlParams = {
       "debug_level" : mh_debug_level,
       "debug" : mh_debug,
       "checkpointDir" : checkpointDir,
-      "checkpoint" : checkpoint
+      "checkpoint" : checkpoint,
+      "checkpointFormat" : checkpointFormat
 }
 
 memParams = {
@@ -245,9 +259,10 @@ decoderParams = {
 
 osHdlrParams = { }
 
-branchPredParams = {
-    "branch_entries" : 32
-}
+# Only the basic unit has a branch cache, the others use their defaults
+branchPredParams = { }
+if branch_unit == "VanadisBasicBranchUnit":
+    branchPredParams["branch_entries"] = 32
 
 cpuParams = {
     "clock" : cpu_clock,
@@ -263,6 +278,9 @@ cpuParams = {
     "print_int_reg" : False,
     "print_fp_reg" : False,
     "pipeline_trace_file" : pipe_trace_file,
+    "bbv_file" : bbv_file,
+    "bbv_interval" : bbv_interval,
+    "bbv_block_map_file" : bbv_block_map_file,
     "reorder_slots" : rob_slots,
     "decodes_per_cycle" : decodes_per_cycle,
     "issues_per_cycle" :  issues_per_cycle,
@@ -271,8 +289,13 @@ cpuParams = {
     "start_verbose_when_issue_address": dbgAddr,
     "stop_verbose_when_retire_address": stopDbg,
     "print_rob" : False,
+    "fast_forward_insts" : fast_forward_insts,
+    "issue_queue_entries" : issue_queue_entries,
+    "local_syscalls" : local_syscalls,
+    "commit_trace_compress" : commit_trace_compress,
     "checkpointDir" : checkpointDir,
-    "checkpoint" : checkpoint
+    "checkpoint" : checkpoint,
+    "checkpointFormat" : checkpointFormat
 }
 
 lsqParams = {
@@ -280,6 +303,8 @@ lsqParams = {
     "address_mask" : 0xFFFFFFFF,
     "max_stores" : lsq_st_entries,
     "max_loads" : lsq_ld_entries,
+    "store_forwarding" : lsq_store_forwarding,
+    "store_set_entries" : lsq_store_set_entries,
 }
 
 l1dcacheParams = {
@@ -345,6 +370,8 @@ class CPU_Builder:
         cpu = sst.Component(prefix, vanadis_cpu_type)
         cpu.addParams( cpuParams )
         cpu.addParam( "core_id", cpuId )
+        if commit_trace:
+            cpu.addParam( "commit_trace_file", commit_trace if numCpus == 1 else "{0}.cpu{1}".format(commit_trace, cpuId) )
         cpu.enableAllStatistics()
 
         # CPU.decoder
@@ -359,7 +386,7 @@ class CPU_Builder:
             os_hdlr.addParams( osHdlrParams )
 
             # CPU.decocer.branch_pred
-            branch_pred = decode.setSubComponent( "branch_unit", "vanadis.VanadisBasicBranchUnit" )
+            branch_pred = decode.setSubComponent( "branch_unit", "vanadis." + branch_unit )
             branch_pred.addParams( branchPredParams )
             branch_pred.enableAllStatistics()
 
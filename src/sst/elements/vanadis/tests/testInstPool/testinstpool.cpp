@@ -0,0 +1,160 @@
+// Copyright 2009-2023 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2023, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+// Checks VanadisInstructionPool on its own, it needs no SST core.
+// Allocates and releases blocks the way fetch and retire do and checks
+// the free lists are reused, stay bounded and can be trimmed.
+// Prints one line per check and exits non-zero if any fails.
+
+#include <stdio.h>
+#include <string.h>
+
+#include <set>
+#include <thread>
+#include <vector>
+
+#include "inst/vinstpool.h"
+
+using namespace SST::Vanadis;
+
+static int failures = 0;
+
+static void check(const bool ok, const char* what) {
+    printf("%s: %s\n", ok ? "PASS" : "FAIL", what);
+    if (!ok) {
+        failures++;
+    }
+}
+
+static void testReuse() {
+    check(VanadisInstructionPool::freeBlocks() == 0, "pool starts empty");
+
+    std::vector<void*> blocks;
+    for (int i = 0; i < 100; i++) {
+        void* block = VanadisInstructionPool::allocate(120);
+        memset(block, 0xa5, 120);
+        blocks.push_back(block);
+    }
+    check(VanadisInstructionPool::freeBlocks() == 0, "allocating from an empty pool caches nothing");
+
+    std::set<void*> released(blocks.begin(), blocks.end());
+    for (void* block : blocks) {
+        VanadisInstructionPool::release(block, 120);
+    }
+    check(VanadisInstructionPool::freeBlocks() == 100, "released blocks are cached");
+
+    // Sizes in the same 16 byte class share a list
+    bool reused = true;
+    blocks.clear();
+    for (int i = 0; i < 100; i++) {
+        void* block = VanadisInstructionPool::allocate(113 + (i % 16));
+        reused = reused && (released.count(block) == 1);
+        blocks.push_back(block);
+    }
+    check(reused, "allocations in the same size class reuse released blocks");
+    check(VanadisInstructionPool::freeBlocks() == 0, "reused blocks leave the free list");
+
+    // A different class does not take blocks from another
+    void* other = VanadisInstructionPool::allocate(200);
+    check(released.count(other) == 0, "a different size class does not reuse the block");
+    VanadisInstructionPool::release(other, 200);
+
+    for (void* block : blocks) {
+        VanadisInstructionPool::release(block, 120);
+    }
+    check(VanadisInstructionPool::freeBlocks() == 101, "blocks of both classes are cached");
+
+    VanadisInstructionPool::trim();
+    check(VanadisInstructionPool::freeBlocks() == 0, "trim empties the free lists");
+
+    VanadisInstructionPool::release(nullptr, 120);
+    check(VanadisInstructionPool::freeBlocks() == 0, "releasing null is ignored");
+}
+
+static void testBound() {
+    // Retire a burst larger than the cap, e.g. a pipeline clear on a huge ROB
+    const size_t burst = VanadisInstructionPool::max_free_blocks + 1000;
+
+    std::vector<void*> blocks;
+    for (size_t i = 0; i < burst; i++) {
+        blocks.push_back(VanadisInstructionPool::allocate(64));
+    }
+    for (void* block : blocks) {
+        VanadisInstructionPool::release(block, 64);
+    }
+    check(VanadisInstructionPool::freeBlocks() == VanadisInstructionPool::max_free_blocks,
+        "a size class holds at most max_free_blocks blocks");
+
+    blocks.clear();
+    for (size_t i = 0; i < 10; i++) {
+        blocks.push_back(VanadisInstructionPool::allocate(64));
+    }
+    check(VanadisInstructionPool::freeBlocks() == VanadisInstructionPool::max_free_blocks - 10,
+        "allocating from a full class takes from its free list");
+    for (void* block : blocks) {
+        VanadisInstructionPool::release(block, 64);
+    }
+
+    // Larger than any class goes straight to the heap
+    void* big = VanadisInstructionPool::allocate(4096);
+    VanadisInstructionPool::release(big, 4096);
+    check(VanadisInstructionPool::freeBlocks() == VanadisInstructionPool::max_free_blocks,
+        "blocks larger than the largest class are not cached");
+
+    VanadisInstructionPool::trim();
+    check(VanadisInstructionPool::freeBlocks() == 0, "trim empties a full free list");
+}
+
+static void testThreads() {
+    // Each simulation thread has its own lists
+    for (int i = 0; i < 10; i++) {
+        VanadisInstructionPool::release(VanadisInstructionPool::allocate(48), 48);
+    }
+    const size_t mainBlocks = VanadisInstructionPool::freeBlocks();
+
+    size_t threadStart = 1;
+    size_t threadEnd   = 0;
+    std::thread worker([&]() {
+        threadStart = VanadisInstructionPool::freeBlocks();
+        std::vector<void*> blocks;
+        for (int i = 0; i < 50; i++) {
+            blocks.push_back(VanadisInstructionPool::allocate(48));
+        }
+        for (void* block : blocks) {
+            VanadisInstructionPool::release(block, 48);
+        }
+        threadEnd = VanadisInstructionPool::freeBlocks();
+    });
+    worker.join();
+
+    check(mainBlocks == 1, "alloc/release pairs keep a single cached block");
+    check(threadStart == 0 && threadEnd == 50, "a new thread starts with its own empty lists");
+    check(VanadisInstructionPool::freeBlocks() == mainBlocks, "another thread does not change this thread's lists");
+
+    VanadisInstructionPool::trim();
+}
+
+int main() {
+    testReuse();
+    testBound();
+    testThreads();
+
+    if (failures > 0) {
+        printf("%d check(s) failed\n", failures);
+        return 1;
+    }
+    printf("All checks passed\n");
+    return 0;
+}
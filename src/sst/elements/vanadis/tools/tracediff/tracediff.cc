@@ -13,12 +13,18 @@
 // information, see the LICENSE file in the top level directory of the
 // distribution.
 
+#include "vcommittrace.h"
+
 #include <cassert>
+#include <cinttypes>
 #include <cstdio>
 #include <cstdlib>
 #include <cstring>
 #include <string>
 
+using SST::Vanadis::VanadisCommitTrace;
+using SST::Vanadis::VanadisCommitTraceReader;
+
 void
 read_line(FILE* input_file, char* buffer) {
     buffer[0] = '\0';
@@ -48,6 +54,121 @@ generate_error(int left_line, int right_line, const char* error_msg) {
     fprintf(stderr, "Error left-line: %d, right-line: %d, cause: %s\n", left_line, right_line, error_msg);
 }
 
+void
+print_record(const char* side, const VanadisCommitTrace::Record& record) {
+    fprintf(stderr, "%s: pc: 0x%" PRIx64 " ins: ", side, record.pc);
+
+    if (record.flags & VanadisCommitTrace::FLAG_NO_INS_WORD) {
+        fprintf(stderr, "unknown");
+    } else {
+        fprintf(stderr, "0x%08" PRIx32, record.ins_word);
+    }
+
+    for (const auto& next_write : record.int_writes) {
+        fprintf(stderr, " r%" PRIu16 "=0x%" PRIx64, next_write.reg, next_write.value);
+    }
+
+    for (const auto& next_write : record.fp_writes) {
+        fprintf(stderr, " f%" PRIu16 "=0x%" PRIx64, next_write.reg, next_write.value);
+    }
+
+    for (const auto& next_op : record.mem_ops) {
+        fprintf(stderr, " %s[0x%" PRIx64 ", %" PRIu8 "]=0x%" PRIx64,
+                (VanadisCommitTrace::STORE == next_op.kind) ? "store" : "load", next_op.addr, next_op.width,
+                next_op.value);
+    }
+
+    fprintf(stderr, "\n");
+}
+
+// Returns the reason the records differ, or nullptr if they match. An
+// instruction word is only compared when both traces could read it.
+const char*
+compare_records(const VanadisCommitTrace::Record& left, const VanadisCommitTrace::Record& right) {
+    if (left.pc != right.pc) {
+        return "Instruction addresses do not match.";
+    }
+
+    if (!((left.flags | right.flags) & VanadisCommitTrace::FLAG_NO_INS_WORD) && (left.ins_word != right.ins_word)) {
+        return "Instruction words do not match.";
+    }
+
+    if (left.int_writes.size() != right.int_writes.size()) {
+        return "Number of integer register writes does not match.";
+    }
+
+    for (size_t i = 0; i < left.int_writes.size(); ++i) {
+        if ((left.int_writes[i].reg != right.int_writes[i].reg) ||
+            (left.int_writes[i].value != right.int_writes[i].value)) {
+            return "Integer register writes do not match.";
+        }
+    }
+
+    if (left.fp_writes.size() != right.fp_writes.size()) {
+        return "Number of floating-point register writes does not match.";
+    }
+
+    for (size_t i = 0; i < left.fp_writes.size(); ++i) {
+        if ((left.fp_writes[i].reg != right.fp_writes[i].reg) ||
+            (left.fp_writes[i].value != right.fp_writes[i].value)) {
+            return "Floating-point register writes do not match.";
+        }
+    }
+
+    if (left.mem_ops.size() != right.mem_ops.size()) {
+        return "Number of memory accesses does not match.";
+    }
+
+    for (size_t i = 0; i < left.mem_ops.size(); ++i) {
+        if ((left.mem_ops[i].kind != right.mem_ops[i].kind) || (left.mem_ops[i].width != right.mem_ops[i].width) ||
+            (left.mem_ops[i].addr != right.mem_ops[i].addr) || (left.mem_ops[i].value != right.mem_ops[i].value)) {
+            return "Memory accesses do not match.";
+        }
+    }
+
+    return nullptr;
+}
+
+// Compares two binary commit traces record by record and stops at the first
+// difference
+int
+diff_commit_traces(VanadisCommitTraceReader& left_trace, VanadisCommitTraceReader& right_trace) {
+    VanadisCommitTrace::Record left_record;
+    VanadisCommitTrace::Record right_record;
+
+    int record_index = 1;
+
+    while (true) {
+        const bool left_valid = left_trace.next(left_record);
+        const bool right_valid = right_trace.next(right_record);
+
+        if (!left_valid || !right_valid) {
+            if (left_valid != right_valid) {
+                generate_error(record_index, record_index,
+                               left_valid ? "Right trace end reached, but left trace end not reached, left trace is longer."
+                                          : "Left trace end but right trace end not reached, right trace is longer.");
+                return 1;
+            }
+
+            break;
+        }
+
+        const char* mismatch = compare_records(left_record, right_record);
+
+        if (nullptr != mismatch) {
+            print_record("left", left_record);
+            print_record("right", right_record);
+            generate_error(record_index, record_index, mismatch);
+            return 1;
+        }
+
+        record_index++;
+    }
+
+    printf("%d instructions match.\n", record_index - 1);
+    return 0;
+}
+
 int
 main(int argc, char* argv[]) {
 
@@ -55,13 +176,31 @@ main(int argc, char* argv[]) {
     char* right_file_path = NULL;
 
     if (argc < 3) {
-        fprintf(stderr, "usage: tracediff <file1> <file2>\n");
+        fprintf(stderr, "usage: tracediff <file1> <file2>\n"
+                        "compares two text traces line by line, or two Vanadis commit traces by record\n");
         exit(1);
     }
 
     left_file_path = argv[1];
     right_file_path = argv[2];
 
+    // Binary commit traces from Vanadis (commit_trace_file) are compared
+    // record by record, anything else is compared as text
+    {
+        VanadisCommitTraceReader left_trace;
+        VanadisCommitTraceReader right_trace;
+
+        const bool left_binary = left_trace.open(left_file_path);
+        const bool right_binary = right_trace.open(right_file_path);
+
+        if (left_binary && right_binary) {
+            return diff_commit_traces(left_trace, right_trace);
+        } else if (left_binary != right_binary) {
+            fprintf(stderr, "Only one of %s and %s is a commit trace.\n", left_file_path, right_file_path);
+            exit(1);
+        }
+    }
+
     FILE* left_file = fopen(left_file_path, "rt");
     FILE* right_file = fopen(right_file_path, "rt");
 
@@ -21,6 +21,7 @@
 
 #include "os/resp/vosexitresp.h"
 
+#include <algorithm>
 #include <cstdio>
 #include <sst/core/output.h>
 #include <vector>
@@ -70,6 +71,19 @@ VANADIS_COMPONENT::VANADIS_COMPONENT(SST::ComponentId_t id, SST::Params& params)
         m_checkpoint = NO_CHECKPOINT;
     }
 
+    std::string ckpt_format = params.find<std::string>("checkpointFormat", "text");
+    if ( ckpt_format != "text" && ckpt_format != "binary" ) {
+        output->fatal(CALL_INFO, -1, "Error: checkpointFormat must be 'text' or 'binary' (got %s).\n", ckpt_format.c_str());
+    }
+    m_checkpointBinary = ( ckpt_format == "binary" );
+
+    // Restoring from a base checkpoint and saving again later gives an
+    // incremental checkpoint of memory, see MemController
+    m_checkpointBaseDir = params.find<std::string>("checkpointBaseDir", "");
+    if ( ! m_checkpointBaseDir.empty() && CHECKPOINT_SAVE != m_checkpoint ) {
+        output->fatal(CALL_INFO, -1, "Error: checkpointBaseDir requires checkpoint to be 'save'.\n");
+    }
+
     std::string clock_rate = params.find<std::string>("clock", "1GHz");
     output->verbose(CALL_INFO, 2, 0, "Registering clock at %s.\n", clock_rate.c_str());
     cpuClockHandler = new Clock::Handler<VANADIS_COMPONENT>(this, &VANADIS_COMPONENT::tick);
@@ -113,6 +127,13 @@ VANADIS_COMPONENT::VANADIS_COMPONENT(SST::ComponentId_t id, SST::Params& params)
         output->fatal(CALL_INFO, -1, "Error: was unable to configureLink %s \n", "os_link");
     }
 
+    local_syscall_link = nullptr;
+    if ( params.find<bool>("local_syscalls", false) ) {
+        const std::string local_latency = params.find<std::string>("local_syscall_latency", "1ns");
+        local_syscall_link = configureSelfLink("local_syscall", local_latency,
+            new Event::Handler<VANADIS_COMPONENT>(this, &VANADIS_COMPONENT::recvOSEvent));
+    }
+
     //////////////////////////////////////////////////////////////////////////////////////
 
     char* decoder_name = new char[64];
@@ -146,6 +167,7 @@ VANADIS_COMPONENT::VANADIS_COMPONENT(SST::ComponentId_t id, SST::Params& params)
 
 
         thread_decoders[i]->getOSHandler()->setOS_link(os_link);
+        thread_decoders[i]->getOSHandler()->setLocalSyscallLink(local_syscall_link);
 
         if ( 0 == thread_decoders[i]->getInsCacheLineWidth() ) {
             output->verbose(
@@ -329,6 +351,7 @@ VANADIS_COMPONENT::VANADIS_COMPONENT(SST::ComponentId_t id, SST::Params& params)
         thread_decoders[i]->getOSHandler()->setHWThread(i);
         thread_decoders[i]->getOSHandler()->setRegisterFile(register_files[i]);
         thread_decoders[i]->getOSHandler()->setISATable(retire_isa_tables[i]);
+        thread_decoders[i]->getOSHandler()->setLoadStoreQueue(lsq);
     }
 
     //////////////////////////////////////////////////////////////////////////////////////
@@ -343,6 +366,44 @@ VANADIS_COMPONENT::VANADIS_COMPONENT(SST::ComponentId_t id, SST::Params& params)
     output->verbose(CALL_INFO, 8, 0, "-> Decodes/cycle:                %" PRIu32 "\n", decodes_per_cycle);
     output->verbose(CALL_INFO, 8, 0, "-> Retires/cycle:                %" PRIu32 "\n", retires_per_cycle);
 
+    const uint32_t iq_entries = params.find<uint32_t>("issue_queue_entries", 0);
+    dispatches_per_cycle      = params.find<uint32_t>("dispatches_per_cycle", issues_per_cycle);
+    m_curDispatchHwThread     = 0;
+
+    iq_int_arith = nullptr;
+    iq_int_div   = nullptr;
+    iq_fp_arith  = nullptr;
+    iq_fp_div    = nullptr;
+    iq_branch    = nullptr;
+    iq_mem       = nullptr;
+
+    rob_dispatched.resize(hw_threads, 0);
+    unissued_stores.resize(hw_threads);
+    load_bypass_blocked.resize(hw_threads, 0);
+
+    if ( iq_entries > 0 ) {
+        iq_int_arith = new VanadisIssueQueue("int-arith", params.find<uint32_t>("issue_queue_int_arith_entries", iq_entries), false);
+        iq_int_div   = new VanadisIssueQueue("int-div", params.find<uint32_t>("issue_queue_int_div_entries", iq_entries), false);
+        iq_fp_arith  = new VanadisIssueQueue("fp-arith", params.find<uint32_t>("issue_queue_fp_arith_entries", iq_entries), false);
+        iq_fp_div    = new VanadisIssueQueue("fp-div", params.find<uint32_t>("issue_queue_fp_div_entries", iq_entries), false);
+        iq_branch    = new VanadisIssueQueue("branch", params.find<uint32_t>("issue_queue_branch_entries", iq_entries), false);
+        iq_mem       = new VanadisIssueQueue("mem", params.find<uint32_t>("issue_queue_mem_entries", iq_entries), true);
+
+        issue_queues = { iq_int_arith, iq_int_div, iq_fp_arith, iq_fp_div, iq_branch, iq_mem };
+
+        for ( VanadisIssueQueue* next_iq : issue_queues ) {
+            if ( 0 == next_iq->capacity() ) {
+                output->fatal(CALL_INFO, -1, "Error: issue queue %s must have at least one entry.\n", next_iq->getName());
+            }
+
+            output->verbose(CALL_INFO, 8, 0, "-> Issue queue %-9s entries: %" PRIu32 "\n", next_iq->getName(), (uint32_t)next_iq->capacity());
+        }
+
+        int_reg_ready.resize(int_reg_count, 1);
+        fp_reg_ready.resize(fp_reg_count, 1);
+        iq_thread_blocked.resize(hw_threads, 0);
+    }
+
     std::string pipeline_trace_path = params.find<std::string>("pipeline_trace_file", "");
 
     if ( pipeline_trace_path == "" ) {
@@ -360,12 +421,111 @@ VANADIS_COMPONENT::VANADIS_COMPONENT(SST::ComponentId_t id, SST::Params& params)
 
     setVerboseWhenIssueAddress( params.find<std::string>("start_verbose_when_issue_address", "") );
 
+    fast_forward_insts         = params.find<uint64_t>("fast_forward_insts", 0);
+    fast_forward_until_address = params.find<uint64_t>("fast_forward_until_address", 0);
+    fast_forward_width         = params.find<uint32_t>("fast_forward_width", 64);
+    ins_fast_forwarded         = 0;
+
+    std::string ff_symbol = params.find<std::string>("fast_forward_until_symbol", "");
+
+    if ( ff_symbol != "" ) {
+        std::string ff_exe = params.find<std::string>("fast_forward_executable", "");
+
+        if ( ff_exe == "" ) {
+            output->fatal(CALL_INFO, -1, "Error: fast_forward_until_symbol requires fast_forward_executable to be set.\n");
+        }
+
+        // readBinaryELFInfo does not return if fatal error is encountered
+        VanadisELFInfo* elf_info = readBinaryELFInfo(output, ff_exe.c_str());
+
+        for ( size_t i = 0; i < elf_info->countSymbols(); ++i ) {
+            const VanadisSymbolTableEntry* symbol = elf_info->getSymbol(i);
+
+            if ( ff_symbol == symbol->getName() ) {
+                fast_forward_until_address = symbol->getAddress();
+                break;
+            }
+        }
+
+        delete elf_info;
+
+        if ( 0 == fast_forward_until_address ) {
+            output->fatal(CALL_INFO, -1, "Error: unable to find symbol %s in %s for fast_forward_until_symbol.\n",
+                ff_symbol.c_str(), ff_exe.c_str());
+        }
+    }
+
+    fast_forward = (fast_forward_insts > 0) || (fast_forward_until_address > 0);
+
+    if ( fast_forward ) {
+        if ( 0 == fast_forward_width ) {
+            output->fatal(CALL_INFO, -1, "Error: fast_forward_width must be at least 1.\n");
+        }
+
+        output->verbose(CALL_INFO, 1, 0, "Fast-forwarding until %" PRIu64 " instructions retired or address 0x%" PRI_ADDR " issues, %" PRIu32 " instructions/cycle\n",
+            fast_forward_insts, fast_forward_until_address, fast_forward_width);
+
+        if ( params.find<bool>("fast_forward_functional_memory", true) ) {
+            lsq->setFunctionalMemory(true);
+        }
+    }
+
+    std::string bbv_path = params.find<std::string>("bbv_file", "");
+    bbv_block_map_path   = params.find<std::string>("bbv_block_map_file", "");
+    bbv_max_intervals    = params.find<uint64_t>("bbv_max_intervals", 0);
+    bbv_stop             = false;
+    bbv_collectors.resize(hw_threads, nullptr);
+
+    if ( bbv_path != "" ) {
+        const uint64_t bbv_interval = params.find<uint64_t>("bbv_interval", 100000000);
+
+        if ( 0 == bbv_interval ) { output->fatal(CALL_INFO, -1, "Error: bbv_interval must be at least 1.\n"); }
+
+        for ( uint32_t i = 0; i < hw_threads; ++i ) {
+            std::string thr_bbv_path = (hw_threads > 1) ? (bbv_path + "." + std::to_string(i)) : bbv_path;
+
+            output->verbose(CALL_INFO, 8, 0, "Opening a basic block vector output at: %s\n", thr_bbv_path.c_str());
+            FILE* bbv_out = fopen(thr_bbv_path.c_str(), "wt");
+
+            if ( bbv_out == nullptr ) {
+                output->fatal(CALL_INFO, -1, "Failed to open basic block vector file: %s\n", thr_bbv_path.c_str());
+            }
+
+            bbv_collectors[i] = new VanadisBasicBlockVector(bbv_out, bbv_interval);
+        }
+    }
+
+    std::string commit_trace_path = params.find<std::string>("commit_trace_file", "");
+    bool        commit_compress   = params.find<bool>("commit_trace_compress", false);
+    commit_traces.resize(hw_threads, nullptr);
+
+    if ( commit_compress && !VanadisCommitTrace::compressionAvailable() ) {
+        output->verbose(CALL_INFO, 1, 0, "Warning: commit_trace_compress requires libz, the commit trace will not be compressed\n");
+        commit_compress = false;
+    }
+
+    if ( commit_trace_path != "" ) {
+        for ( uint32_t i = 0; i < hw_threads; ++i ) {
+            std::string thr_trace_path =
+                (hw_threads > 1) ? (commit_trace_path + "." + std::to_string(i)) : commit_trace_path;
+
+            output->verbose(CALL_INFO, 8, 0, "Opening a commit trace at: %s\n", thr_trace_path.c_str());
+            commit_traces[i] = new VanadisCommitTraceWriter();
+
+            if ( !commit_traces[i]->open(thr_trace_path.c_str(), core_id, i, commit_compress) ) {
+                output->fatal(CALL_INFO, -1, "Failed to open commit trace file: %s\n", thr_trace_path.c_str());
+            }
+        }
+    }
+
     // Register statistics ///////////////////////////////////////////////////////
     stat_ins_retired          = registerStatistic<uint64_t>("instructions_retired", "1");
     stat_ins_decoded          = registerStatistic<uint64_t>("instructions_decoded", "1");
+    stat_ins_dispatched       = registerStatistic<uint64_t>("instructions_dispatched", "1");
     stat_ins_issued           = registerStatistic<uint64_t>("instructions_issued", "1");
     stat_loads_issued         = registerStatistic<uint64_t>("loads_issued", "1");
     stat_stores_issued        = registerStatistic<uint64_t>("stores_issued", "1");
+    stat_ins_fast_forwarded   = registerStatistic<uint64_t>("instructions_fast_forwarded", "1");
     stat_branch_mispredicts   = registerStatistic<uint64_t>("branch_mispredicts", "1");
     stat_branches             = registerStatistic<uint64_t>("branches", "1");
     stat_cycles               = registerStatistic<uint64_t>("cycles", "1");
@@ -388,8 +548,32 @@ VANADIS_COMPONENT::~VANADIS_COMPONENT()
         delete rob[i];
     }
 
+    for ( VanadisIssueQueue* next_iq : issue_queues ) {
+        delete next_iq;
+    }
+
     if ( pipelineTrace != nullptr ) { fclose(pipelineTrace); }
 
+    for ( uint32_t i = 0; i < bbv_collectors.size(); ++i ) {
+        if ( nullptr == bbv_collectors[i] ) { continue; }
+
+        if ( bbv_block_map_path != "" ) {
+            std::string thr_map_path = (hw_threads > 1) ? (bbv_block_map_path + "." + std::to_string(i)) : bbv_block_map_path;
+            FILE*       map_out      = fopen(thr_map_path.c_str(), "wt");
+
+            if ( map_out != nullptr ) {
+                bbv_collectors[i]->writeBlockMap(map_out);
+                fclose(map_out);
+            }
+        }
+
+        delete bbv_collectors[i];
+    }
+
+    for ( VanadisCommitTraceWriter* next_trace : commit_traces ) {
+        delete next_trace;
+    }
+
 	for( VanadisFloatingPointFlags* next_fp_flags : fp_flags ) {
 		delete next_fp_flags;
 	}
@@ -408,6 +592,8 @@ VANADIS_COMPONENT::startThread(int thr, uint64_t stackStart, uint64_t instructio
     halted_masks[thr]            = false;
     uint64_t initial_config_ip = thread_decoders[thr]->getInstructionPointer();
 
+    thread_decoders[thr]->getOSHandler()->resetThreadState();
+
     // This wasn't provided, or its explicitly set to zero which means
     // we should auto-calculate it
     output->verbose(CALL_INFO, 8, 0, "Configuring core-%d, thread-%d entry point = %p stack = %#" PRIx64  "\n", core_id, thr, (void*)instructionPointer, stackStart);
@@ -561,8 +747,9 @@ VANADIS_COMPONENT::performIssue(const uint64_t cycle, int hwThr, uint32_t& rob_s
                             if(unallocated_memory_op_seen) {
                                 // the instruction should not be allocated because memory operations
                                 // must be issued to the LSQ in order to maintain memory ordering
-                                // semantics
-                                allocate_fu = 1;
+                                // semantics, unless it is a load the LSQ predicts does not depend on
+                                // the older stores which are still waiting
+                                allocate_fu = (INST_LOAD == ins_type) ? allocateBypassingLoad(ins) : 1;
                             } else {
                                 allocate_fu = allocateFunctionalUnit(ins);
                             }
@@ -606,6 +793,7 @@ VANADIS_COMPONENT::performIssue(const uint64_t cycle, int hwThr, uint32_t& rob_s
                                 // we have seen a memory operation which is not issued, downstream operations
                                 // cannot issue yet to maintain ordering
                                 unallocated_memory_op_seen = true;
+                                noteUnissuedMemoryOp(ins);
                             }
                         }
                     } else {
@@ -613,6 +801,7 @@ VANADIS_COMPONENT::performIssue(const uint64_t cycle, int hwThr, uint32_t& rob_s
                             // we have seen a memory operation which is not issued, downstream operations
                             // cannot issue yet to maintain ordering
                             unallocated_memory_op_seen = true;
+                            noteUnissuedMemoryOp(ins);
                         }
                     }
 
@@ -670,6 +859,238 @@ VANADIS_COMPONENT::performIssue(const uint64_t cycle, int hwThr, uint32_t& rob_s
     return issued_an_ins ? 0 : 1;
 }
 
+VanadisIssueQueue*
+VANADIS_COMPONENT::selectIssueQueue(VanadisInstruction* ins)
+{
+    switch ( ins->getInstFuncType() ) {
+    case INST_INT_DIV:
+        return iq_int_div;
+    case INST_FP_ARITH:
+        return iq_fp_arith;
+    case INST_FP_DIV:
+        return iq_fp_div;
+    case INST_BRANCH:
+        return iq_branch;
+    case INST_LOAD:
+    case INST_STORE:
+    case INST_FENCE:
+    case INST_SYSCALL:
+        return iq_mem;
+    default:
+        return iq_int_arith;
+    }
+}
+
+// Rename instructions in program order from the ROB into the issue queues.
+// Because renaming happens in order, only true dependencies remain and they
+// are tracked with the physical register ready bits.
+int
+VANADIS_COMPONENT::performDispatch(const uint64_t cycle)
+{
+    uint32_t dispatched = 0;
+
+    for ( uint32_t t = 0; t < hw_threads && dispatched < dispatches_per_cycle; ++t ) {
+        const uint32_t i = (m_curDispatchHwThread + t) % hw_threads;
+
+        if ( halted_masks[i] ) { continue; }
+
+        VanadisCircularQueue<VanadisInstruction*>* thr_rob = rob[i];
+
+        while ( dispatched < dispatches_per_cycle && rob_dispatched[i] < thr_rob->size() ) {
+            VanadisInstruction* ins = thr_rob->peekAt(rob_dispatched[i]);
+
+            // Issued while fast-forwarding, nothing to do
+            if ( ins->completedIssue() ) {
+                rob_dispatched[i]++;
+                continue;
+            }
+
+            // SYSCALLs read and write the architectural registers in place,
+            // so wait until everything older has retired
+            if ( INST_SYSCALL == ins->getInstFuncType() && rob_dispatched[i] > 0 ) { break; }
+
+            VanadisIssueQueue* queue = selectIssueQueue(ins);
+
+            if ( queue->full() || (int_register_stack->unused() < ins->countISAIntRegOut()) ||
+                 (fp_register_stack->unused() < ins->countISAFPRegOut()) ) {
+                break;
+            }
+
+            assignRegistersToInstruction(
+                thread_decoders[i]->countISAIntReg(), thread_decoders[i]->countISAFPReg(), ins, int_register_stack,
+                fp_register_stack, issue_isa_tables[i]);
+
+            for ( uint16_t k = 0; k < ins->countISAIntRegOut(); ++k ) {
+                int_reg_ready[ins->getPhysIntRegOut(k)] = 0;
+            }
+
+            for ( uint16_t k = 0; k < ins->countISAFPRegOut(); ++k ) {
+                fp_reg_ready[ins->getPhysFPRegOut(k)] = 0;
+            }
+
+#ifdef VANADIS_BUILD_DEBUG
+            if ( output->getVerboseLevel() >= 8 ) {
+                ins->printToBuffer(instPrintBuffer, 1024);
+                output->verbose(
+                    CALL_INFO, 8, VANADIS_DBG_ISSUE_FLG, "%" PRIu32 ": ----> Dispatched to %s queue: %s / 0x%" PRI_ADDR "\n",
+                    i, queue->getName(), instPrintBuffer, ins->getInstructionAddress());
+            }
+#endif
+            queue->push(ins);
+            rob_dispatched[i]++;
+            dispatched++;
+        }
+    }
+
+    m_curDispatchHwThread = (m_curDispatchHwThread + 1) % hw_threads;
+    stat_ins_dispatched->addData(dispatched);
+
+    return 0;
+}
+
+bool
+VANADIS_COMPONENT::operandsReady(VanadisInstruction* ins) const
+{
+    for ( uint16_t k = 0; k < ins->countISAIntRegIn(); ++k ) {
+        if ( !int_reg_ready[ins->getPhysIntRegIn(k)] ) { return false; }
+    }
+
+    for ( uint16_t k = 0; k < ins->countISAFPRegIn(); ++k ) {
+        if ( !fp_reg_ready[ins->getPhysFPRegIn(k)] ) { return false; }
+    }
+
+    return true;
+}
+
+// Select the oldest ready instructions from each queue, up to the issue width
+int
+VANADIS_COMPONENT::performQueueIssue(const uint64_t cycle)
+{
+    for ( VanadisIssueQueue* queue : issue_queues ) {
+        if ( ins_issued_this_cycle >= issues_per_cycle ) { break; }
+
+        if ( queue->inOrder() ) {
+            std::fill(iq_thread_blocked.begin(), iq_thread_blocked.end(), 0);
+            resetUnissuedMemoryOps();
+        }
+
+        std::deque<VanadisInstruction*>& entries = queue->getEntries();
+
+        for ( auto q_itr = entries.begin(); q_itr != entries.end() && ins_issued_this_cycle < issues_per_cycle; ) {
+            VanadisInstruction* ins = (*q_itr);
+            const uint32_t      thr = ins->getHWThread();
+
+            if ( queue->inOrder() && iq_thread_blocked[thr] ) {
+                // Only a load which the LSQ predicts is independent of the
+                // older stores still waiting here may leave out of order
+                if ( INST_LOAD != ins->getInstFuncType() || !operandsReady(ins) || 0 != allocateBypassingLoad(ins) ) {
+                    noteUnissuedMemoryOp(ins);
+                    q_itr++;
+                    continue;
+                }
+            }
+            else {
+                if ( !operandsReady(ins) ) {
+                    if ( queue->inOrder() ) {
+                        iq_thread_blocked[thr] = 1;
+                        noteUnissuedMemoryOp(ins);
+                    }
+                    q_itr++;
+                    continue;
+                }
+
+                if ( 0 != allocateFunctionalUnit(ins) ) {
+                    if ( queue->inOrder() ) {
+                        iq_thread_blocked[thr] = 1;
+                        noteUnissuedMemoryOp(ins);
+                        q_itr++;
+                        continue;
+                    }
+
+                    // Every unit of this type is busy this cycle
+                    break;
+                }
+            }
+
+#ifdef VANADIS_BUILD_DEBUG
+            if ( output->getVerboseLevel() >= 8 ) {
+                ins->printToBuffer(instPrintBuffer, 1024);
+                output->verbose(
+                    CALL_INFO, 8, VANADIS_DBG_ISSUE_FLG, "%" PRIu32 ": ----> Issued from %s queue: %s / 0x%" PRI_ADDR "\n",
+                    thr, queue->getName(), instPrintBuffer, ins->getInstructionAddress());
+            }
+#endif
+            ins->markIssued();
+            ins_issued_this_cycle++;
+
+            if ( ins->countISAIntRegOut() > 0 || ins->countISAFPRegOut() > 0 ) {
+                pending_wakeup.push_back(ins);
+            }
+
+            q_itr = entries.erase(q_itr);
+        }
+    }
+
+    return 0;
+}
+
+// Mark the output registers of every completed instruction as ready. This
+// runs at the start of the cycle so that everything which completed in the
+// previous cycle (including responses from the LSQ and the OS) wakes up its
+// consumers before any of those instructions can retire.
+void
+VANADIS_COMPONENT::wakeupIssuedInstructions()
+{
+    for ( size_t i = 0; i < pending_wakeup.size(); ) {
+        VanadisInstruction* ins = pending_wakeup[i];
+
+        if ( ins->completedExecution() ) {
+            const uint32_t thr      = ins->getHWThread();
+            const uint16_t zero_reg = isa_options[thr]->getRegisterIgnoreWrites();
+
+            for ( uint16_t k = 0; k < ins->countISAIntRegOut(); ++k ) {
+                const uint16_t phys_reg = ins->getPhysIntRegOut(k);
+
+                // Consumers read the physical register directly, so writes
+                // to the zero register have to be discarded here
+                if ( ins->getISAIntRegOut(k) == zero_reg ) {
+                    register_files[thr]->setIntReg<uint64_t>(phys_reg, 0);
+                }
+
+                int_reg_ready[phys_reg] = 1;
+            }
+
+            for ( uint16_t k = 0; k < ins->countISAFPRegOut(); ++k ) {
+                fp_reg_ready[ins->getPhysFPRegOut(k)] = 1;
+            }
+
+            pending_wakeup[i] = pending_wakeup.back();
+            pending_wakeup.pop_back();
+        }
+        else {
+            i++;
+        }
+    }
+}
+
+void
+VANADIS_COMPONENT::clearIssueQueues(const uint32_t hw_thr)
+{
+    for ( VanadisIssueQueue* next_iq : issue_queues ) {
+        next_iq->clearByHWThreadID(hw_thr);
+    }
+
+    for ( size_t i = 0; i < pending_wakeup.size(); ) {
+        if ( pending_wakeup[i]->getHWThread() == hw_thr ) {
+            pending_wakeup[i] = pending_wakeup.back();
+            pending_wakeup.pop_back();
+        }
+        else {
+            i++;
+        }
+    }
+}
+
 int
 VANADIS_COMPONENT::performExecute(const uint64_t cycle)
 {
@@ -747,6 +1168,86 @@ void VANADIS_COMPONENT::printRob(int rob_num, VanadisCircularQueue<VanadisInstru
     }
 }
 
+// Adds a retired micro-op to the commit trace of its thread, must be called
+// before the registers it wrote are released
+void
+VANADIS_COMPONENT::traceCommit(VanadisCommitTraceWriter* trace, VanadisInstruction* ins)
+{
+    const uint32_t       ins_thread = ins->getHWThread();
+    VanadisRegisterFile* reg_file   = register_files[ins_thread];
+
+    if ( !trace->continues(ins->getInstructionAddress()) ) {
+        // the word is the next four bytes, taken from the decoder without
+        // disturbing its cache, it may be missing if the line was evicted
+        uint32_t   ins_word      = 0;
+        const bool have_ins_word = thread_decoders[ins_thread]->getInstructionLoader()->peekPredecodeBytes(
+            ins->getInstructionAddress(), (uint8_t*)&ins_word, sizeof(ins_word));
+
+        trace->beginInstruction(ins->getInstructionAddress(), ins_word, have_ins_word);
+
+        // the previous instruction may have filled a block which was written out
+        if ( UNLIKELY(!trace->good()) ) {
+            output->fatal(CALL_INFO, -1, "Error: writing the commit trace of hardware thread %" PRIu32 " failed.\n", ins_thread);
+        }
+    }
+
+    auto readInt = [reg_file](const uint16_t phys_reg) -> uint64_t {
+        return (4 == reg_file->getIntRegWidth()) ? reg_file->getIntReg<uint32_t>(phys_reg)
+                                                 : reg_file->getIntReg<uint64_t>(phys_reg);
+    };
+
+    auto readFP = [reg_file](const uint16_t phys_reg) -> uint64_t {
+        return (4 == reg_file->getFPRegWidth()) ? reg_file->getFPReg<uint32_t>(phys_reg)
+                                                : reg_file->getFPReg<uint64_t>(phys_reg);
+    };
+
+    for ( uint16_t i = 0; i < ins->countISAIntRegOut(); ++i ) {
+        trace->addIntWrite(ins->getISAIntRegOut(i), readInt(ins->getPhysIntRegOut(i)));
+    }
+
+    for ( uint16_t i = 0; i < ins->countISAFPRegOut(); ++i ) {
+        trace->addFPWrite(ins->getISAFPRegOut(i), readFP(ins->getPhysFPRegOut(i)));
+    }
+
+    uint64_t mem_addr  = 0;
+    uint16_t mem_width = 0;
+
+    switch ( ins->getInstFuncType() ) {
+    case INST_LOAD:
+    {
+        VanadisLoadInstruction* load_ins = (VanadisLoadInstruction*)ins;
+        load_ins->computeLoadAddress(reg_file, &mem_addr, &mem_width);
+
+        uint64_t value = 0;
+        if ( LOAD_FP_REGISTER == load_ins->getValueRegisterType() ) {
+            if ( ins->countPhysFPRegOut() > 0 ) { value = readFP(ins->getPhysFPRegOut(0)); }
+        }
+        else if ( ins->countPhysIntRegOut() > 0 ) {
+            value = readInt(ins->getPhysIntRegOut(0));
+        }
+
+        trace->addMemoryOp(VanadisCommitTrace::LOAD, (uint8_t)mem_width, mem_addr, value);
+    } break;
+    case INST_STORE:
+    {
+        VanadisStoreInstruction* store_ins = (VanadisStoreInstruction*)ins;
+        store_ins->computeStoreAddress(output, reg_file, &mem_addr, &mem_width);
+
+        uint64_t value = (STORE_FP_REGISTER == store_ins->getValueRegisterType())
+                             ? readFP(store_ins->getValueRegister())
+                             : readInt(store_ins->getValueRegister());
+
+        // partial stores take their bytes from part way along the register
+        value >>= (8 * store_ins->getRegisterOffset());
+        if ( mem_width < 8 ) { value &= ((UINT64_C(1) << (8 * mem_width)) - 1); }
+
+        trace->addMemoryOp(VanadisCommitTrace::STORE, (uint8_t)mem_width, mem_addr, value);
+    } break;
+    default:
+        break;
+    }
+}
+
 int
 VANADIS_COMPONENT::performRetire(int rob_num, VanadisCircularQueue<VanadisInstruction*>* rob, const uint64_t cycle)
 {
@@ -788,6 +1289,18 @@ VANADIS_COMPONENT::performRetire(int rob_num, VanadisCircularQueue<VanadisInstru
         delete[] inst_asm_buffer;
     }
 
+    // A load which went ahead of an older store to the same bytes read a stale
+    // value, everything older has now retired so replay from the load
+    if ( UNLIKELY(rob_front->violatesMemoryOrder()) ) {
+#ifdef VANADIS_BUILD_DEBUG
+        output->verbose(
+            CALL_INFO, 8, VANADIS_DBG_RETIRE_FLG, "----> memory order violation at 0x%" PRI_ADDR ", replay thread %" PRIu32 "\n",
+            rob_front->getInstructionAddress(), ins_thread);
+#endif
+        handleMisspeculate(ins_thread, rob_front->getInstructionAddress());
+        return 0;
+    }
+
     if ( rob_front->completedIssue() && rob_front->completedExecution() ) {
         bool     perform_cleanup       = true;
         bool     perform_delay_cleanup = false;
@@ -819,6 +1332,13 @@ VANADIS_COMPONENT::performRetire(int rob_num, VanadisCircularQueue<VanadisInstru
                     VanadisInstruction* delay_ins = rob->peekAt(1);
 
                     if ( delay_ins->completedExecution() ) {
+                        // the branch and its delay slot retire together, so a
+                        // replay of the delay slot has to include the branch
+                        if ( UNLIKELY(delay_ins->violatesMemoryOrder()) ) {
+                            handleMisspeculate(ins_thread, rob_front->getInstructionAddress());
+                            return 0;
+                        }
+
                         if ( UNLIKELY(delay_ins->trapsError()) ) {
                             output->fatal(
                                 CALL_INFO, -1,
@@ -877,8 +1397,7 @@ VANADIS_COMPONENT::performRetire(int rob_num, VanadisCircularQueue<VanadisInstru
                 }
                 }
 #endif
-                thread_decoders[ins_thread]->getBranchPredictor()->push(
-                    spec_ins->getInstructionAddress(), pipeline_reset_addr);
+                thread_decoders[ins_thread]->getBranchPredictor()->update(spec_ins, pipeline_reset_addr);
 
                 if ( stop_verbose_when_retire_address > 0 && (rob_front->getInstructionAddress() == stop_verbose_when_retire_address) ) {
                     output->setVerboseLevel(0);
@@ -915,6 +1434,8 @@ VANADIS_COMPONENT::performRetire(int rob_num, VanadisCircularQueue<VanadisInstru
         if ( perform_cleanup ) {
             rob->pop();
 
+            if ( rob_dispatched[ins_thread] > 0 ) { rob_dispatched[ins_thread]--; }
+
 #ifdef VANADIS_BUILD_DEBUG
             if ( output->getVerboseLevel() >= 8 ) {
                 char* inst_asm_buffer = new char[32768];
@@ -939,6 +1460,10 @@ VANADIS_COMPONENT::performRetire(int rob_num, VanadisCircularQueue<VanadisInstru
 				rob_front->updateFPFlags();
 			}
 
+            if ( UNLIKELY(nullptr != commit_traces[ins_thread]) ) {
+                traceCommit(commit_traces[ins_thread], rob_front);
+            }
+
             recoverRetiredRegisters(
                 rob_front, int_register_stack, fp_register_stack,
                 issue_isa_tables[ins_thread], retire_isa_tables[ins_thread]);
@@ -962,6 +1487,8 @@ VANADIS_COMPONENT::performRetire(int rob_num, VanadisCircularQueue<VanadisInstru
             if ( perform_delay_cleanup ) {
 
                 VanadisInstruction* delay_ins = rob->pop();
+
+                if ( rob_dispatched[ins_thread] > 0 ) { rob_dispatched[ins_thread]--; }
 #ifdef VANADIS_BUILD_DEBUG
                 output->verbose(
                     CALL_INFO, 8, VANADIS_DBG_RETIRE_FLG, "----> Retire delay: 0x%" PRI_ADDR " / %s\n", delay_ins->getInstructionAddress(),
@@ -977,6 +1504,10 @@ VANADIS_COMPONENT::performRetire(int rob_num, VanadisCircularQueue<VanadisInstru
 					rob_front->updateFPFlags();
 				}
 
+                if ( UNLIKELY(nullptr != commit_traces[ins_thread]) ) {
+                    traceCommit(commit_traces[ins_thread], delay_ins);
+                }
+
                 recoverRetiredRegisters(
                     delay_ins, int_register_stack, fp_register_stack, issue_isa_tables[delay_ins->getHWThread()],
                     retire_isa_tables[delay_ins->getHWThread()]);
@@ -991,6 +1522,21 @@ VANADIS_COMPONENT::performRetire(int rob_num, VanadisCircularQueue<VanadisInstru
                 delete delay_ins;
             }
 
+            // A branch (and its delay slot) completes the commit trace record
+            // even when it jumps to itself
+            if ( UNLIKELY(nullptr != commit_traces[ins_thread]) && rob_front->isSpeculated() ) {
+                commit_traces[ins_thread]->endInstruction();
+            }
+
+            // A branch (and its delay slot) ends the basic block
+            if ( UNLIKELY(nullptr != bbv_collectors[ins_thread]) ) {
+                if ( bbv_collectors[ins_thread]->retire(
+                         rob_front->getInstructionAddress(), perform_delay_cleanup ? 2 : 1, rob_front->isSpeculated()) &&
+                     (bbv_max_intervals > 0) && (bbv_collectors[ins_thread]->countIntervals() >= bbv_max_intervals) ) {
+                    bbv_stop = true;
+                }
+            }
+
 #ifdef VANADIS_BUILD_DEBUG
             if ( output->getVerboseLevel() > 0 ) {
                 if(print_retire_tables) {
@@ -1095,6 +1641,137 @@ VANADIS_COMPONENT::performRetire(int rob_num, VanadisCircularQueue<VanadisInstru
     return 0;
 }
 
+// Functional fast-forward. Instructions are taken from the ROB strictly in
+// program order and executed directly against the register file as soon as
+// everything ahead of them has completed, so no dependency tracking or
+// functional unit latency is modelled. Loads and stores are handed to the
+// LSQ, which answers them from its functional view of memory (see
+// VanadisLoadStoreQueue::setFunctionalMemory), and SYSCALLs are still
+// handled by the OS at retire. Branches retire immediately after they
+// execute, so wrong-path instructions are never executed.
+int
+VANADIS_COMPONENT::performFastForward(const uint64_t cycle, uint32_t hw_thr)
+{
+    VanadisCircularQueue<VanadisInstruction*>* thr_rob = rob[hw_thr];
+
+    for ( uint32_t i = 0; i < fast_forward_width; ++i ) {
+        if ( halted_masks[hw_thr] ) { break; }
+
+        const uint32_t retired_before = ins_retired_this_cycle;
+        const int      retire_status  = performRetire(hw_thr, thr_rob, cycle);
+
+        if ( ins_retired_this_cycle != retired_before ) {
+            ins_fast_forwarded += ins_retired_this_cycle - retired_before;
+            continue;
+        }
+
+        // ROB is empty or we are waiting on the OS to complete a SYSCALL
+        if ( 1 == retire_status || 3 == retire_status ) { break; }
+
+        VanadisInstruction* ins = nullptr;
+
+        for ( size_t j = 0; j < thr_rob->size(); ++j ) {
+            if ( !thr_rob->peekAt(j)->completedExecution() ) {
+                ins = thr_rob->peekAt(j);
+                break;
+            }
+        }
+
+        // Everything in the ROB has executed and is waiting on retire (e.g.
+        // a branch whose delay slot has not been decoded yet)
+        if ( nullptr == ins ) { break; }
+
+        const auto ins_type = ins->getInstFuncType();
+        const bool completes_elsewhere =
+            (ins_type == INST_LOAD || ins_type == INST_STORE || ins_type == INST_FENCE || ins_type == INST_SYSCALL);
+
+        if ( !ins->completedIssue() ) {
+            // Switch before anything is issued so the detailed pipeline
+            // picks up from an instruction it has not seen yet
+            if ( (fast_forward_insts > 0 && ins_fast_forwarded >= fast_forward_insts) ||
+                 (ins->getInstructionAddress() == fast_forward_until_address) ) {
+                switchToDetailed(ins->getInstructionAddress());
+                return 1;
+            }
+
+            if ( int_register_stack->unused() < ins->countISAIntRegOut() ||
+                 fp_register_stack->unused() < ins->countISAFPRegOut() ) {
+                break;
+            }
+
+            switch ( ins_type ) {
+            case INST_LOAD:
+                if ( lsq->loadFull() ) { return 1; }
+                stat_loads_issued->addData(1);
+                lsq->push((VanadisLoadInstruction*)ins);
+                break;
+            case INST_STORE:
+                if ( lsq->storeFull() ) { return 1; }
+                stat_stores_issued->addData(1);
+                lsq->push((VanadisStoreInstruction*)ins);
+                break;
+            case INST_FENCE:
+                lsq->push((VanadisFenceInstruction*)ins);
+                break;
+            case INST_SYSCALL:
+                if ( lsq->storeBufferSize() != 0 || lsq->loadSize() != 0 ) { return 1; }
+                break;
+            default:
+                break;
+            }
+
+            assignRegistersToInstruction(
+                thread_decoders[hw_thr]->countISAIntReg(), thread_decoders[hw_thr]->countISAFPReg(), ins,
+                int_register_stack, fp_register_stack, issue_isa_tables[hw_thr]);
+
+            ins->markIssued();
+            ins_issued_this_cycle++;
+        }
+
+        // Completed by the LSQ or by the OS at retire
+        if ( completes_elsewhere ) { break; }
+
+        if ( ins_type == INST_NOOP || ins_type == INST_FAULT ) {
+            ins->markExecuted();
+        }
+        else {
+            ins->execute(output, register_files[hw_thr]);
+        }
+
+        // Some instructions only execute once they are at the front of the
+        // ROB, the next retire attempt will mark them
+        if ( !ins->completedExecution() ) { continue; }
+
+        resetZeroRegister(hw_thr);
+    }
+
+    return 0;
+}
+
+void
+VANADIS_COMPONENT::switchToDetailed(uint64_t ins_addr)
+{
+    fast_forward = false;
+    lsq->setFunctionalMemory(false);
+
+    output->verbose(
+        CALL_INFO, 1, 0,
+        "Fast-forward complete at cycle %" PRIu64 " after %" PRIu64 " instructions, switching to detailed mode at 0x%" PRI_ADDR "\n",
+        current_cycle, ins_fast_forwarded, ins_addr);
+}
+
+void
+VANADIS_COMPONENT::resetZeroRegister(uint32_t hw_thr)
+{
+    const uint16_t zero_reg = isa_options[hw_thr]->getRegisterIgnoreWrites();
+
+    if ( zero_reg < isa_options[hw_thr]->countISAIntRegisters() ) {
+        VanadisISATable* thr_issue_table = issue_isa_tables[hw_thr];
+        const uint16_t   zero_phys_reg   = thr_issue_table->getIntPhysReg(zero_reg);
+        register_files[hw_thr]->setIntReg<uint64_t>(zero_phys_reg, 0);
+    }
+}
+
 bool
 VANADIS_COMPONENT::mapInstructiontoFunctionalUnit(
     VanadisInstruction* ins, std::vector<VanadisFunctionalUnit*>& functional_units)
@@ -1202,6 +1879,48 @@ VANADIS_COMPONENT::allocateFunctionalUnit(VanadisInstruction* ins)
     return allocated_fu ? 0 : 1;
 }
 
+// Offer a load which is blocked behind older unissued stores to the LSQ,
+// returns 0 if the LSQ accepted it (same convention as allocateFunctionalUnit)
+int
+VANADIS_COMPONENT::allocateBypassingLoad(VanadisInstruction* ins)
+{
+    const uint32_t thr = ins->getHWThread();
+
+    if ( load_bypass_blocked[thr] || lsq->loadFull() ) { return 1; }
+
+    if ( lsq->pushBypassingStores((VanadisLoadInstruction*)ins, unissued_stores[thr]) ) {
+        stat_loads_issued->addData(1);
+        return 0;
+    }
+
+    return 1;
+}
+
+// Loads may only be reordered around stores, once any other memory operation
+// (or a load which could not go ahead) is waiting everything behind it stays
+// in program order
+void
+VANADIS_COMPONENT::noteUnissuedMemoryOp(VanadisInstruction* ins)
+{
+    const uint32_t thr = ins->getHWThread();
+
+    if ( INST_STORE == ins->getInstFuncType() ) {
+        unissued_stores[thr].push_back((VanadisStoreInstruction*)ins);
+    }
+    else {
+        load_bypass_blocked[thr] = 1;
+    }
+}
+
+void
+VANADIS_COMPONENT::resetUnissuedMemoryOps()
+{
+    for ( uint32_t i = 0; i < hw_threads; ++i ) {
+        unissued_stores[i].clear();
+        load_bypass_blocked[i] = 0;
+    }
+}
+
 bool
 VANADIS_COMPONENT::tick(SST::Cycle_t cycle)
 {
@@ -1264,13 +1983,11 @@ VANADIS_COMPONENT::tick(SST::Cycle_t cycle)
 #endif
 
     for ( uint32_t i = 0; i < hw_threads; ++i ) {
-        const uint16_t zero_reg = isa_options[i]->getRegisterIgnoreWrites();
+        resetZeroRegister(i);
+    }
 
-        if ( zero_reg < isa_options[i]->countISAIntRegisters() ) {
-            VanadisISATable* thr_issue_table = issue_isa_tables[i];
-            const uint16_t   zero_phys_reg   = thr_issue_table->getIntPhysReg(zero_reg);
-            register_files[i]->setIntReg<uint64_t>(zero_phys_reg, 0);
-        }
+    if ( !issue_queues.empty() ) {
+        wakeupIssuedInstructions();
     }
 
     #ifdef VANADIS_BUILD_DEBUG
@@ -1283,7 +2000,16 @@ VANADIS_COMPONENT::tick(SST::Cycle_t cycle)
 #endif
     // Retire
     // //////////////////////////////////////////////////////////////////////////
-{
+if ( UNLIKELY(fast_forward) ) {
+    // Fast-forward replaces the issue, execute and retire stages for
+    // every thread until the switch condition is met
+    for ( uint32_t i = 0; i < hw_threads && fast_forward; ++i ) {
+        if ( !halted_masks[i] ) { performFastForward(cycle, i); }
+    }
+
+    stat_ins_fast_forwarded->addData(ins_retired_this_cycle);
+}
+else {
     std::vector<int>  rc(hw_threads,0);
     auto cnt = hw_threads;
     for ( uint32_t i = 0; i < retires_per_cycle; ++i ) {
@@ -1307,10 +2033,10 @@ VANADIS_COMPONENT::tick(SST::Cycle_t cycle)
             break;
         }
     }
-}
 
     // Record how many instructions we retired this cycle
     stat_ins_retired->addData(ins_retired_this_cycle);
+}
 
     // Execute
     // //////////////////////////////////////////////////////////////////////////
@@ -1334,14 +2060,21 @@ VANADIS_COMPONENT::tick(SST::Cycle_t cycle)
             "<==========================================================\n");
     }
 #endif
+if ( LIKELY(!fast_forward) && !issue_queues.empty() ) {
+    // Select from the queues before dispatching so an instruction spends at
+    // least a cycle in its issue queue
+    performQueueIssue(cycle);
+    performDispatch(cycle);
+}
+else if ( LIKELY(!fast_forward) ) {
     // Clear our temps on a per-thread basis
     for ( uint32_t i = 0; i < hw_threads; ++i ) {
         resetRegisterUseTemps(thread_decoders[i]->countISAIntReg(), thread_decoders[i]->countISAFPReg());
     }
 
-{
     std::vector<uint32_t> rob_start(hw_threads,0);
     std::vector<int> unallocated_memory_op_seen(hw_threads,false);
+    resetUnissuedMemoryOps();
 
     // Attempt to perform issues, cranking through the entire ROB call by call or until we
     // reach the max issues this cycle
@@ -1381,8 +2114,15 @@ VANADIS_COMPONENT::tick(SST::Cycle_t cycle)
             "<==========================================================\n");
     }
 #endif
-    for ( uint32_t i = 0; i < decodes_per_cycle; ++i ) {
+    // Fast-forward can consume far more than the detailed decode width,
+    // so keep the ROB topped up until the decoders stop making progress
+    const uint32_t decode_calls = UNLIKELY(fast_forward) ? fast_forward_width : decodes_per_cycle;
+
+    for ( uint32_t i = 0; i < decode_calls; ++i ) {
+        const uint32_t decoded_before = ins_decoded_this_cycle;
+
         if ( performDecode(cycle) != 0 ) { break; }
+        if ( UNLIKELY(fast_forward) && decoded_before == ins_decoded_this_cycle ) { break; }
     }
 
     stat_ins_decoded->addData(ins_decoded_this_cycle);
@@ -1437,6 +2177,12 @@ VANADIS_COMPONENT::tick(SST::Cycle_t cycle)
         //primaryComponentOKToEndSim();
         return true;
     }
+    else if ( UNLIKELY(bbv_stop) ) {
+        output->verbose(CALL_INFO, 1, 0, "Wrote %" PRIu64 " basic block vector intervals at cycle %" PRIu64 ". Core stops processing.\n",
+            bbv_max_intervals, current_cycle);
+        primaryComponentOKToEndSim();
+        return true;
+    }
     else {
         return false;
     }
@@ -1796,19 +2542,30 @@ VANADIS_COMPONENT::recoverRetiredRegisters(
 void
 VANADIS_COMPONENT::setup()
 {
-    if ( CHECKPOINT_LOAD == m_checkpoint ) {
+    if ( CHECKPOINT_LOAD == m_checkpoint || ! m_checkpointBaseDir.empty() ) {
         std::stringstream filename;
-        filename << m_checkpointDir << "/" << getName();
+        filename << ( CHECKPOINT_LOAD == m_checkpoint ? m_checkpointDir : m_checkpointBaseDir ) << "/" << getName();
         output->verbose(CALL_INFO, 0, VANADIS_DBG_CHECKPOINT,"checkpoint file %s\n",filename.str().c_str());
-        auto fp = fopen(filename.str().c_str(),"r");
-        assert(fp);
-        checkpointLoad(fp);
+
+        if ( MemHierarchy::CheckpointFile::isBinary( filename.str() ) ) {
+            checkpointLoadBinary( filename.str() );
+        } else {
+            auto fp = fopen(filename.str().c_str(),"r");
+            assert(fp);
+            checkpointLoad(fp);
+            fclose(fp);
+        }
     } 
 }
 
 void
 VANADIS_COMPONENT::finish()
 {
+    for ( uint32_t i = 0; i < commit_traces.size(); ++i ) {
+        if ( nullptr != commit_traces[i] && !commit_traces[i]->close() ) {
+            output->fatal(CALL_INFO, -1, "Error: writing the commit trace of hardware thread %" PRIu32 " failed.\n", i);
+        }
+    }
 
     if ( LIKELY( nullptr == m_checkpointing ) ) return;
 
@@ -1817,12 +2574,17 @@ VANADIS_COMPONENT::finish()
 
         std::stringstream filename;
         filename << m_checkpointDir << "/" << getName();
-        auto fp = fopen(filename.str().c_str(),"w+");
-        assert(fp);
 
         output->verbose(CALL_INFO, 0, VANADIS_DBG_CHECKPOINT,"Checkpoint component `%s` %s\n",getName().c_str(), filename.str().c_str());
 
-        checkpoint(fp); 
+        if ( m_checkpointBinary ) {
+            checkpointBinary( filename.str() );
+        } else {
+            auto fp = fopen(filename.str().c_str(),"w+");
+            assert(fp);
+            checkpoint(fp); 
+            fclose(fp);
+        }
     }
 }
 
@@ -1928,6 +2690,7 @@ VANADIS_COMPONENT::handleMisspeculate(const uint32_t hw_thr, const uint64_t new_
     clearFuncUnit(hw_thr, fu_branch);
 
     lsq->clearLSQByThreadID(hw_thr);
+    clearIssueQueues(hw_thr);
     //resetRegisterStacks(hw_thr);
     clearROBMisspeculate(hw_thr);
 
@@ -1936,6 +2699,7 @@ VANADIS_COMPONENT::handleMisspeculate(const uint32_t hw_thr, const uint64_t new_
 
     // Notify the decoder we need a clear and reset to new instruction pointer
     thread_decoders[hw_thr]->setInstructionPointerAfterMisspeculate(output, new_ip);
+    thread_decoders[hw_thr]->getBranchPredictor()->pipelineFlushed();
 
 #ifdef VANADIS_BUILD_DEBUG
     if(output->getVerboseLevel() >= 16) {
@@ -1958,10 +2722,14 @@ VANADIS_COMPONENT::clearROBMisspeculate(const uint32_t hw_thr)
     VanadisCircularQueue<VanadisInstruction*>* thr_rob = rob[hw_thr];
     stat_rob_cleared_entries->addData(thr_rob->size());
 
-    // Delete all the instructions which we aren't going to process
+    // Delete all the instructions which we aren't going to process. With
+    // issue queues, instructions are renamed at dispatch rather than issue.
+    // SYSCALLs are excluded because they do not take registers from the
+    // free lists.
     for ( size_t i = 0; i < thr_rob->size(); ++i ) {
         VanadisInstruction* next_ins = thr_rob->peekAt(i);
-        if ( next_ins->completedIssue() )  {
+        if ( next_ins->completedIssue() ||
+             (i < rob_dispatched[hw_thr] && INST_SYSCALL != next_ins->getInstFuncType()) )  {
             next_ins->returnOutRegs( int_register_stack, fp_register_stack  );
         }
         delete next_ins;
@@ -1969,6 +2737,7 @@ VANADIS_COMPONENT::clearROBMisspeculate(const uint32_t hw_thr)
 
     // clear the ROB entries and reset
     thr_rob->clear();
+    rob_dispatched[hw_thr] = 0;
 }
 
 void
@@ -1997,6 +2766,11 @@ VANADIS_COMPONENT::syscallReturn(uint32_t thr)
 #endif
     syscall_ins->markExecuted();
 
+    // The SYSCALL may retire before the start of the next cycle
+    if ( !issue_queues.empty() ) {
+        wakeupIssuedInstructions();
+    }
+
     if ( UNLIKELY( nullptr != m_checkpointing ) ) {
         if ( m_checkpointing[thr] ) {
             output->verbose(CALL_INFO, 0, VANADIS_DBG_CHECKPOINT,"%s() checkpoint halt thread %d\n",__func__,thr);
@@ -2008,6 +2782,12 @@ VANADIS_COMPONENT::syscallReturn(uint32_t thr)
 void VANADIS_COMPONENT::recvOSEvent(SST::Event* ev) {
     output->verbose(CALL_INFO, 8, 0, "-> recv os response\n");
 
+    // The OS may have written to this process's memory (syscall results,
+    // new thread stacks) so the functional view is stale
+    if ( UNLIKELY(fast_forward) ) {
+        lsq->invalidateFunctionalMemory();
+    }
+
     VanadisSyscallResponse* os_resp = dynamic_cast<VanadisSyscallResponse*>(ev);
 
     if (nullptr != os_resp) {
@@ -2030,6 +2810,7 @@ void VANADIS_COMPONENT::recvOSEvent(SST::Event* ev) {
         VanadisStartThreadFirstReq* os_req = dynamic_cast<VanadisStartThreadFirstReq*>(ev);
         if ( nullptr != os_req ) {
             startThread( os_req->getThread(), os_req->getStackAddr(), os_req->getInstPtr() );
+            thread_decoders[os_req->getThread()]->getOSHandler()->setThreadInfo( os_req );
         } else {
 
             VanadisStartThreadForkReq* req = dynamic_cast<VanadisStartThreadForkReq*>(ev);
@@ -2102,6 +2883,7 @@ void VANADIS_COMPONENT::startThreadClone( VanadisStartThreadCloneReq* req )
     auto reg_file = register_files[hw_thr];
 
     resetHwThread( hw_thr );
+    thr_decoder->getOSHandler()->setThreadInfo( req );
 
     output->verbose(CALL_INFO, 8, 0,"instPtr=%#" PRIx64 " stackAddr=%#" PRIx64 " argAddr=%#" PRIx64 " tlsAddr=%#" PRIx64 "\n",
         req->getInstPtr(), req->getStackAddr(), req->getArgAddr(), req->getTlsAddr() );
@@ -2138,6 +2920,7 @@ void VANADIS_COMPONENT::startThreadFork( VanadisStartThreadForkReq* req )
     auto reg_file = register_files[hw_thr];
 
     resetHwThread( hw_thr );
+    thr_decoder->getOSHandler()->setThreadInfo( req );
 
     output->verbose(CALL_INFO, 8, 0,"start thread fork, thread=%d instPtr=%#" PRIx64 " tlsPtr=%#" PRIx64 "\n",
                 req->getThread(), req->getInstPtr(), req->getTlsAddr() );
@@ -2255,6 +3038,119 @@ VANADIS_COMPONENT::checkpointLoad(FILE* fp)
     }
 }
 
+/*
+ * Binary core checkpoint, per hardware thread:
+ *   uint8_t  active
+ *   uint64_t resume address, thread local storage pointer   (active only)
+ *   uint64_t integer and floating point register values     (counted vectors)
+ * Registers are saved by ISA register number, the issue and retire ISA
+ * tables are rebuilt by the pipeline reset when the thread restarts.
+ */
+void
+VANADIS_COMPONENT::checkpointBinary(const std::string& path)
+{
+    MemHierarchy::CheckpointFile ckpt;
+
+    if ( ! ckpt.openWrite(path, checkpoint_kind, false) ) {
+        output->fatal(CALL_INFO, -1, "Error: unable to create checkpoint %s\n", path.c_str());
+    }
+
+    ckpt.write<uint32_t>(hw_threads);
+
+    for ( uint32_t i = 0; i < hw_threads; i++ ) {
+        ckpt.write<uint8_t>(m_checkpointing[i] ? 1 : 0);
+
+        if ( ! m_checkpointing[i] ) { continue; }
+
+        auto isa_table   = retire_isa_tables[i];
+        auto reg_file    = register_files[i];
+        auto thr_decoder = thread_decoders[i];
+
+        // the front of the ROB is the checkpoint system call
+        ckpt.write<uint64_t>(rob[i]->peekAt(0)->getInstructionAddress() + 4);
+        ckpt.write<uint64_t>(thr_decoder->getThreadLocalStoragePointer());
+
+        std::vector<uint64_t> int_regs(isa_table->getNumIntRegs());
+        for ( size_t j = 0; j < int_regs.size(); j++ ) {
+            int_regs[j] = reg_file->getIntReg<uint64_t>(isa_table->getIntPhysReg(j));
+        }
+
+        std::vector<uint64_t> fp_regs(isa_table->getNumFpRegs());
+        for ( size_t j = 0; j < fp_regs.size(); j++ ) {
+            if ( VANADIS_REGISTER_MODE_FP32 == thr_decoder->getFPRegisterMode() ) {
+                fp_regs[j] = reg_file->getFPReg<uint32_t>(isa_table->getFPPhysReg(j));
+            } else {
+                fp_regs[j] = reg_file->getFPReg<uint64_t>(isa_table->getFPPhysReg(j));
+            }
+        }
+
+        ckpt.writeVector(int_regs);
+        ckpt.writeVector(fp_regs);
+    }
+
+    ckpt.close();
+
+    if ( ! ckpt.good() ) {
+        output->fatal(CALL_INFO, -1, "Error: failed writing checkpoint %s\n", path.c_str());
+    }
+}
+
+void
+VANADIS_COMPONENT::checkpointLoadBinary(const std::string& path)
+{
+    MemHierarchy::CheckpointFile ckpt;
+    uint32_t                     kind;
+
+    if ( ! ckpt.openRead(path) || ! ckpt.readHeader(kind) || checkpoint_kind != kind ) {
+        output->fatal(CALL_INFO, -1, "Error: %s is not a Vanadis core checkpoint\n", path.c_str());
+    }
+
+    if ( ckpt.read<uint32_t>() != hw_threads ) {
+        output->fatal(CALL_INFO, -1, "Error: checkpoint %s was saved with a different number of hardware threads\n", path.c_str());
+    }
+
+    for ( uint32_t hw_thr = 0; hw_thr < hw_threads && ckpt.good(); hw_thr++ ) {
+        if ( 0 == ckpt.read<uint8_t>() ) { continue; }
+
+        auto isa_table   = retire_isa_tables[hw_thr];
+        auto reg_file    = register_files[hw_thr];
+        auto thr_decoder = thread_decoders[hw_thr];
+
+        const uint64_t start_addr = ckpt.read<uint64_t>();
+        thr_decoder->setThreadLocalStoragePointer(ckpt.read<uint64_t>());
+
+        std::vector<uint64_t> int_regs;
+        std::vector<uint64_t> fp_regs;
+        ckpt.readVector(int_regs);
+        ckpt.readVector(fp_regs);
+
+        if ( int_regs.size() != (size_t)isa_table->getNumIntRegs() || fp_regs.size() != (size_t)isa_table->getNumFpRegs() ) {
+            output->fatal(CALL_INFO, -1, "Error: checkpoint %s does not match the register counts of this ISA\n", path.c_str());
+        }
+
+        for ( size_t i = 0; i < int_regs.size(); i++ ) {
+            reg_file->setIntReg<uint64_t>(isa_table->getIntPhysReg(i), int_regs[i]);
+        }
+
+        for ( size_t i = 0; i < fp_regs.size(); i++ ) {
+            if ( VANADIS_REGISTER_MODE_FP32 == thr_decoder->getFPRegisterMode() ) {
+                reg_file->setFPReg<uint32_t>(isa_table->getFPPhysReg(i), (uint32_t)fp_regs[i]);
+            } else {
+                reg_file->setFPReg<uint64_t>(isa_table->getFPPhysReg(i), fp_regs[i]);
+            }
+        }
+
+        output->verbose(CALL_INFO, 0, VANADIS_DBG_CHECKPOINT,"set thread %" PRIu32 " start address %#" PRIx64 "\n",hw_thr,start_addr);
+
+        halted_masks[hw_thr] = false;
+        handleMisspeculate(hw_thr, start_addr);
+    }
+
+    if ( ! ckpt.good() ) {
+        output->fatal(CALL_INFO, -1, "Error: checkpoint %s is truncated\n", path.c_str());
+    }
+}
+
 void VANADIS_COMPONENT::getThreadState( VanadisGetThreadStateReq* req )
 {
     int hw_thr = req->getThread();
@@ -2317,7 +3213,9 @@ VANADIS_COMPONENT::resetHwThread(uint32_t thr)
     auto reg_file = register_files[thr];
     auto thr_rob = rob[thr];
 
+    clearIssueQueues(thr);
     thr_rob->clear();
+    rob_dispatched[thr] = 0;
 
 #if 0
     output->setVerboseLevel( 16 );
@@ -2328,6 +3226,7 @@ VANADIS_COMPONENT::resetHwThread(uint32_t thr)
 #endif
 
     decoder->getInstructionLoader()->clearCache();
+    decoder->getOSHandler()->resetThreadState();
 
     reg_file->init();
 
@@ -25,13 +25,18 @@
 #include "lsq/vlsq.h"
 #include "lsq/vbasiclsq.h"
 #include "velf/velfinfo.h"
+#include "vbbv.h"
+#include "vcommittrace.h"
 #include "vfpflags.h"
 #include "vfuncunit.h"
+#include "vissuequeue.h"
 
 #include "os/vgetthreadstate.h"
 #include "os/vdumpregsreq.h"
 #include "os/vcheckpointreq.h"
 
+#include "sst/elements/memHierarchy/checkpointFile.h"
+
 #include <array>
 #include <limits>
 #include <set>
@@ -141,6 +146,14 @@ public:
         { "fetches_per_cycle", "Number of instruction fetches per cycle", "2" },
         { "retires_per_cycle", "Number of instruction retires per cycle", "2" },
         { "decodes_per_cycle", "Number of instruction decodes per cycle", "2" },
+        { "issue_queue_entries", "Entries in each issue queue. When non-zero, instructions are renamed in order into per functional unit type issue queues and issue when their physical source registers are ready. When 0, instructions issue directly from the reorder buffer", "0" },
+        { "issue_queue_int_arith_entries", "Entries in the integer arithmetic issue queue (also holds no-ops)", "issue_queue_entries" },
+        { "issue_queue_int_div_entries", "Entries in the integer division issue queue", "issue_queue_entries" },
+        { "issue_queue_fp_arith_entries", "Entries in the floating point arithmetic issue queue", "issue_queue_entries" },
+        { "issue_queue_fp_div_entries", "Entries in the floating point division issue queue", "issue_queue_entries" },
+        { "issue_queue_branch_entries", "Entries in the branch issue queue", "issue_queue_entries" },
+        { "issue_queue_mem_entries", "Entries in the memory issue queue (loads, stores, fences and system calls, issued in program order)", "issue_queue_entries" },
+        { "dispatches_per_cycle", "Number of instructions renamed into the issue queues per cycle", "issues_per_cycle" },
         { "dcache_line_width", "Width of a line for the data cache, in bytes. (Currently not used but may be in the future).", "64"},
         { "icache_line_width", "Width of a line for the instruction cache, in bytes", "64"},
         { "print_retire_tables", "Print registers during retirement step (default is yes)", "true" },
@@ -148,7 +161,25 @@ public:
         { "print_int_reg", "Print integer registers true/false, auto set to true if verbose > 16", "false" },
         { "print_fp_reg", "Print floating-point registers true/false, auto set to "
                           "true if verbose > 16", "false" },
-        { "print_rob", "Print reorder buffer state during issue and retire", "true"} )
+        { "print_rob", "Print reorder buffer state during issue and retire", "true"},
+        { "fast_forward_insts", "Execute functionally, bypassing the timed pipeline, until this many instructions have retired and then switch to detailed mode. 0 disables the count condition", "0" },
+        { "fast_forward_until_address", "Execute functionally until this instruction address is about to issue and then switch to detailed mode", "0" },
+        { "fast_forward_until_symbol", "Execute functionally until the function with this symbol name (e.g. an empty vanadis_enable() marker called by the application) is entered. Requires fast_forward_executable", "" },
+        { "fast_forward_executable", "Executable used to resolve fast_forward_until_symbol", "" },
+        { "fast_forward_width", "Maximum number of instructions each hardware thread executes per cycle while fast-forwarding", "64" },
+        { "fast_forward_functional_memory", "Answer loads and stores from the LSQ's functional view of memory while fast-forwarding. The view is private to the core, so disable this when threads on different cores share memory during fast-forward", "true" },
+        { "bbv_file", "Write a SimPoint basic block vector of the retired instructions to this file (one file per hardware thread, suffixed with the thread number when there is more than one). Empty disables collection", "" },
+        { "bbv_interval", "Number of retired instructions in each basic block vector interval", "100000000" },
+        { "bbv_max_intervals", "Stop the core once a hardware thread has written this many basic block vector intervals, 0 runs to completion", "0" },
+        { "bbv_block_map_file", "At the end of simulation write the branch address which ends each basic block id to this file", "" },
+        { "commit_trace_file", "Write a binary trace of the retired instructions, their register writes and memory accesses, to this file for comparison with tracediff (one file per hardware thread, suffixed with the thread number when there is more than one). Empty disables the trace", "" },
+        { "commit_trace_compress", "Compress the commit trace with gzip, requires SST built with libz", "false" },
+        { "local_syscalls", "Answer getpid, gettid, clock_gettime, getrandom and sched_getaffinity in the core, using the ids and OS start time sent with each thread and writing results through the LSQ. Calls answered in the core, including the ones which are not implemented, complete after local_syscall_latency", "false" },
+        { "local_syscall_latency", "Latency of a system call answered in the core", "1ns" },
+        { "checkpoint", "'save' writes the core state to checkpointDir when the application requests a checkpoint, 'load' restores it from there", "" },
+        { "checkpointDir", "Directory holding the checkpoint", "" },
+        { "checkpointFormat", "Format of saved checkpoints, 'text' or 'binary'. Loads detect the format", "text" },
+        { "checkpointBaseDir", "When saving, first restore from the checkpoint in this directory (set the same on the OS and memory)", "" } )
 
     SST_ELI_DOCUMENT_STATISTICS(
         { "cycles", "Number of cycles the core executed", "cycles", 1 },
@@ -161,10 +192,12 @@ public:
         { "instructions_issued", "Number of instructions issued", "instructions", 1 },
         { "instructions_retired", "Number of instructions retired", "instructions", 1 },
         { "instructions_decoded", "Number of instructions decoded", "instructions", 1 },
+        { "instructions_dispatched", "Number of instructions renamed into the issue queues (only when issue_queue_entries is set)", "instructions", 1 },
         { "branch_mispredicts", "Number of retired branches which were mis-predicted", "instructions", 1 },
         { "branches", "Number of retired branches", "instructions", 1 },
         { "loads_issued", "Number of load instructions issued to the LSQ", "instructions", 1 },
         { "stores_issued", "Number of store instructions issued to the LSQ", "instructions", 1 },
+        { "instructions_fast_forwarded", "Number of instructions retired in fast-forward mode (not included in instructions_retired)", "instructions", 1 },
         { "phys_int_reg_in_use", "Number of physical integer registers that are in use each cycle", "registers", 1 },
         { "phys_fp_reg_in_use", "Number of physical floating point registers than are in use each cycle", "registers",
           1 })
@@ -240,11 +273,24 @@ private:
     int  performFetch(const uint64_t cycle);
     int  performDecode(const uint64_t cycle);
     int  performIssue(const uint64_t cycle, int hwThr, uint32_t& rob_start, int& unallocated_memory_op_seen);
+    int  performDispatch(const uint64_t cycle);
+    int  performQueueIssue(const uint64_t cycle);
+    void wakeupIssuedInstructions();
+    bool operandsReady(VanadisInstruction* ins) const;
+    void clearIssueQueues(const uint32_t hw_thr);
+    VanadisIssueQueue* selectIssueQueue(VanadisInstruction* ins);
     int  performExecute(const uint64_t cycle);
     int  performRetire(int rob_num, VanadisCircularQueue<VanadisInstruction*>* rob, const uint64_t cycle);
+    int  performFastForward(const uint64_t cycle, uint32_t hw_thr);
+    void switchToDetailed(uint64_t ins_addr);
+    void resetZeroRegister(uint32_t hw_thr);
     int  allocateFunctionalUnit(VanadisInstruction* ins);
+    int  allocateBypassingLoad(VanadisInstruction* ins);
+    void noteUnissuedMemoryOp(VanadisInstruction* ins);
+    void resetUnissuedMemoryOps();
     bool mapInstructiontoFunctionalUnit(VanadisInstruction* ins, std::vector<VanadisFunctionalUnit*>& functional_units);
     void printRob(int rob_num, VanadisCircularQueue<VanadisInstruction*>* rob);
+    void traceCommit(VanadisCommitTraceWriter* trace, VanadisInstruction* ins);
 
     bool checkVerboseAddr( uint64_t addr ) {
         for ( auto& it : start_verbose_when_issue_address ) {
@@ -307,6 +353,36 @@ private:
     std::vector<uint8_t*> tmp_not_issued_fp_reg_read;
     std::vector<uint8_t*> tmp_fp_reg_write;
 
+    // Issue queue scheduling, only used when issue_queue_entries > 0
+    std::vector<VanadisIssueQueue*> issue_queues;
+    VanadisIssueQueue*              iq_int_arith;
+    VanadisIssueQueue*              iq_int_div;
+    VanadisIssueQueue*              iq_fp_arith;
+    VanadisIssueQueue*              iq_fp_div;
+    VanadisIssueQueue*              iq_branch;
+    VanadisIssueQueue*              iq_mem;
+    uint32_t                        dispatches_per_cycle;
+    uint32_t                        m_curDispatchHwThread;
+
+    // Number of entries at the front of each ROB which have been renamed
+    std::vector<uint32_t> rob_dispatched;
+
+    // Physical register ready bits, cleared when a register is allocated
+    // at dispatch and set when the writing instruction completes
+    std::vector<uint8_t> int_reg_ready;
+    std::vector<uint8_t> fp_reg_ready;
+
+    // Issued instructions which write registers and have not yet woken
+    // their consumers
+    std::vector<VanadisInstruction*> pending_wakeup;
+    std::vector<uint8_t>             iq_thread_blocked;
+
+    // Stores which have not issued yet, in program order, and whether any
+    // other memory operation is waiting ahead of the scan point. Rebuilt
+    // each cycle so the LSQ can decide if a load may go ahead of them.
+    std::vector<std::vector<VanadisStoreInstruction*>> unissued_stores;
+    std::vector<uint8_t>                               load_bypass_blocked;
+
     std::list<VanadisInsCacheLoadRecord*>* icache_load_records;
 
     VanadisLoadStoreQueue* lsq;
@@ -331,9 +407,11 @@ private:
 
     Statistic<uint64_t>* stat_ins_retired;
     Statistic<uint64_t>* stat_ins_decoded;
+    Statistic<uint64_t>* stat_ins_dispatched;
     Statistic<uint64_t>* stat_ins_issued;
     Statistic<uint64_t>* stat_loads_issued;
     Statistic<uint64_t>* stat_stores_issued;
+    Statistic<uint64_t>* stat_ins_fast_forwarded;
     Statistic<uint64_t>* stat_branch_mispredicts;
     Statistic<uint64_t>* stat_branches;
     Statistic<uint64_t>* stat_cycles;
@@ -353,13 +431,36 @@ private:
 
     std::vector<VanadisFloatingPointFlags*> fp_flags;
 
+    // Functional fast-forward, see performFastForward
+    bool     fast_forward;
+    uint64_t fast_forward_insts;
+    uint64_t fast_forward_until_address;
+    uint32_t fast_forward_width;
+    uint64_t ins_fast_forwarded;
+
+    // SimPoint profiling, one collector per hardware thread (nullptr when off)
+    std::vector<VanadisBasicBlockVector*> bbv_collectors;
+    std::string bbv_block_map_path;
+    uint64_t    bbv_max_intervals;
+    bool        bbv_stop;
+
+    // Commit traces, one writer per hardware thread (nullptr when off)
+    std::vector<VanadisCommitTraceWriter*> commit_traces;
+
     SST::Link* os_link;
+    SST::Link* local_syscall_link;
 
     bool* m_checkpointing;
     std::string m_checkpointDir;
+    std::string m_checkpointBaseDir;
+    bool m_checkpointBinary;
     enum { NO_CHECKPOINT, CHECKPOINT_LOAD, CHECKPOINT_SAVE } m_checkpoint;
     void checkpoint(FILE*);
     void checkpointLoad(FILE*);
+    void checkpointBinary(const std::string& path);
+    void checkpointLoadBinary(const std::string& path);
+
+    static constexpr uint32_t checkpoint_kind = MemHierarchy::CheckpointFile::makeKind('C', 'O', 'R', 'E');
 };
 
 } // namespace Vanadis
@@ -0,0 +1,139 @@
+// Copyright 2009-2023 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2023, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#ifndef _H_VANADIS_BBV
+#define _H_VANADIS_BBV
+
+#include <algorithm>
+#include <cinttypes>
+#include <cstdint>
+#include <cstdio>
+#include <unordered_map>
+#include <vector>
+
+namespace SST {
+namespace Vanadis {
+
+// Collects a basic block vector for one hardware thread. A basic block is
+// named by the address of the branch which ends it, every retired
+// instruction is charged to the block it belongs to, and once an interval
+// has retired enough instructions the counts are written out as one line
+// of a SimPoint frequency vector file:
+//
+//   T:<block-id>:<instructions> :<block-id>:<instructions> ...
+//
+// Intervals only end on a block boundary, so an interval may be longer than
+// requested by at most one block. Block ids are dense and start at 1, the
+// branch address of each id can be written to a separate file at the end
+// of simulation.
+class VanadisBasicBlockVector {
+public:
+    VanadisBasicBlockVector(FILE* bbv_out, const uint64_t length) :
+        bbv_file(bbv_out), interval_length(length), block_ins(0), interval_ins(0),
+        intervals_written(0) {}
+
+    ~VanadisBasicBlockVector() {
+        // the tail of the run is a (short) interval of its own
+        if ( !touched_blocks.empty() ) { writeInterval(); }
+
+        fclose(bbv_file);
+    }
+
+    // Returns true when the instructions complete an interval
+    bool retire(const uint64_t ins_addr, const uint32_t ins_count, const bool ends_block) {
+        block_ins += ins_count;
+        interval_ins += ins_count;
+
+        if ( !ends_block ) { return false; }
+
+        recordBlock(ins_addr);
+
+        if ( interval_ins >= interval_length ) {
+            writeInterval();
+            return true;
+        }
+
+        return false;
+    }
+
+    uint64_t countIntervals() const { return intervals_written; }
+
+    void writeBlockMap(FILE* map_out) const {
+        std::vector<uint64_t> block_addrs(block_ids.size());
+
+        for ( auto& next_block : block_ids ) {
+            block_addrs[next_block.second - 1] = next_block.first;
+        }
+
+        for ( size_t i = 0; i < block_addrs.size(); ++i ) {
+            fprintf(map_out, "%" PRIu64 " 0x%" PRIx64 "\n", (uint64_t)(i + 1), block_addrs[i]);
+        }
+    }
+
+private:
+    void recordBlock(const uint64_t branch_addr) {
+        auto block_itr = block_ids.find(branch_addr);
+
+        uint32_t block_id;
+
+        if ( block_itr == block_ids.end() ) {
+            block_id = (uint32_t)block_ids.size() + 1;
+            block_ids.insert(std::make_pair(branch_addr, block_id));
+            block_counts.push_back(0);
+        }
+        else {
+            block_id = block_itr->second;
+        }
+
+        if ( 0 == block_counts[block_id - 1] ) { touched_blocks.push_back(block_id); }
+
+        block_counts[block_id - 1] += block_ins;
+        block_ins = 0;
+    }
+
+    void writeInterval() {
+        std::sort(touched_blocks.begin(), touched_blocks.end());
+
+        fprintf(bbv_file, "T");
+
+        for ( const uint32_t next_id : touched_blocks ) {
+            fprintf(bbv_file, ":%" PRIu32 ":%" PRIu64 " ", next_id, block_counts[next_id - 1]);
+            block_counts[next_id - 1] = 0;
+        }
+
+        fprintf(bbv_file, "\n");
+        fflush(bbv_file);
+
+        touched_blocks.clear();
+        interval_ins = 0;
+        intervals_written++;
+    }
+
+    FILE*          bbv_file;
+    const uint64_t interval_length;
+
+    uint64_t block_ins;
+    uint64_t interval_ins;
+    uint64_t intervals_written;
+
+    std::unordered_map<uint64_t, uint32_t> block_ids;
+    std::vector<uint64_t>                  block_counts;
+    std::vector<uint32_t>                  touched_blocks;
+};
+
+} // namespace Vanadis
+} // namespace SST
+
+#endif
@@ -0,0 +1,61 @@
+// Copyright 2009-2023 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2023, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+
+#ifndef _H_VANADIS_BRANCH_UNIT_BIMODAL
+#define _H_VANADIS_BRANCH_UNIT_BIMODAL
+
+#include "vbranch/vbranchtable.h"
+
+namespace SST {
+namespace Vanadis {
+
+class VanadisBimodalBranchUnit : public VanadisTableBranchUnit {
+
+public:
+    SST_ELI_REGISTER_SUBCOMPONENT(VanadisBimodalBranchUnit, "vanadis", "VanadisBimodalBranchUnit",
+                                          SST_ELI_ELEMENT_VERSION(1, 0, 0),
+                                          "Predicts branch direction with a table of two bit counters indexed "
+                                          "by the branch address",
+                                          SST::Vanadis::VanadisBranchUnit)
+
+    SST_ELI_DOCUMENT_PARAMS(VANADIS_TABLE_BRANCH_ELI_PARAMS,
+                            { "pht_entries", "Number of two bit counters, must be a power of two", "4096" })
+
+    SST_ELI_DOCUMENT_STATISTICS(VANADIS_TABLE_BRANCH_ELI_STATISTICS)
+
+    VanadisBimodalBranchUnit(ComponentId_t id, Params& params) : VanadisTableBranchUnit(id, params) {
+        // start weakly taken so loop branches are right after one iteration
+        counters.resize(checkTableSize("pht_entries", params.find<uint32_t>("pht_entries", 4096)), 2);
+        counter_mask = counters.size() - 1;
+    }
+
+protected:
+    bool predictTaken(const uint64_t ins_addr, const uint64_t history) override {
+        return counterTaken(counters[(ins_addr >> 2) & counter_mask]);
+    }
+
+    void trainDirection(const uint64_t ins_addr, const uint64_t history, const bool taken) override {
+        trainCounter(counters[(ins_addr >> 2) & counter_mask], taken);
+    }
+
+    std::vector<uint8_t> counters;
+    uint32_t counter_mask;
+};
+
+} // namespace Vanadis
+} // namespace SST
+
+#endif
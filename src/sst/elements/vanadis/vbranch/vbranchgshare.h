@@ -0,0 +1,85 @@
+// Copyright 2009-2023 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2023, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+
+#ifndef _H_VANADIS_BRANCH_UNIT_GSHARE
+#define _H_VANADIS_BRANCH_UNIT_GSHARE
+
+#include "vbranch/vbranchtable.h"
+
+#include <algorithm>
+
+namespace SST {
+namespace Vanadis {
+
+class VanadisGShareBranchUnit : public VanadisTableBranchUnit {
+
+public:
+    SST_ELI_REGISTER_SUBCOMPONENT(VanadisGShareBranchUnit, "vanadis", "VanadisGShareBranchUnit",
+                                          SST_ELI_ELEMENT_VERSION(1, 0, 0),
+                                          "Predicts branch direction with a table of two bit counters indexed "
+                                          "by the branch address XOR the global branch history",
+                                          SST::Vanadis::VanadisBranchUnit)
+
+    SST_ELI_DOCUMENT_PARAMS(VANADIS_TABLE_BRANCH_ELI_PARAMS,
+                            { "pht_entries", "Number of two bit counters, must be a power of two", "4096" },
+                            { "history_length", "Number of global history bits hashed into the index (at most 64)", "12" })
+
+    SST_ELI_DOCUMENT_STATISTICS(VANADIS_TABLE_BRANCH_ELI_STATISTICS)
+
+    VanadisGShareBranchUnit(ComponentId_t id, Params& params) : VanadisTableBranchUnit(id, params) {
+        counters.resize(checkTableSize("pht_entries", params.find<uint32_t>("pht_entries", 4096)), 2);
+        counter_mask = counters.size() - 1;
+
+        // at least one bit so folding always makes progress
+        index_bits = 1;
+        while((UINT32_C(1) << index_bits) < counters.size()) {
+            index_bits++;
+        }
+
+        const uint32_t history_length = std::min(params.find<uint32_t>("history_length", 12), 64u);
+        history_mask = (history_length >= 64) ? UINT64_MAX : ((UINT64_C(1) << history_length) - 1);
+    }
+
+protected:
+    bool predictTaken(const uint64_t ins_addr, const uint64_t history) override {
+        return counterTaken(counters[index(ins_addr, history)]);
+    }
+
+    void trainDirection(const uint64_t ins_addr, const uint64_t history, const bool taken) override {
+        trainCounter(counters[index(ins_addr, history)], taken);
+    }
+
+    // history longer than the index is folded down rather than dropped
+    uint32_t index(const uint64_t ins_addr, const uint64_t history) const {
+        uint64_t hashed = (ins_addr >> 2);
+
+        for(uint64_t h = (history & history_mask); h != 0; h >>= index_bits) {
+            hashed ^= h;
+        }
+
+        return hashed & counter_mask;
+    }
+
+    std::vector<uint8_t> counters;
+    uint32_t counter_mask;
+    uint32_t index_bits;
+    uint64_t history_mask;
+};
+
+} // namespace Vanadis
+} // namespace SST
+
+#endif
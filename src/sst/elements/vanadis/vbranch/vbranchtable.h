@@ -0,0 +1,275 @@
+// Copyright 2009-2023 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2023, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#ifndef _H_VANADIS_BRANCH_UNIT_TABLE
+#define _H_VANADIS_BRANCH_UNIT_TABLE
+
+#include "vbranch/vbranchunit.h"
+
+#include <sst/core/output.h>
+
+#include <cinttypes>
+#include <cstdint>
+#include <vector>
+
+#define VANADIS_TABLE_BRANCH_ELI_PARAMS                                                                       \
+    { "btb_entries", "Number of entries in the branch target buffer, must be a power of two", "512" },        \
+    { "ras_entries", "Number of entries in the return address stack, 0 disables return prediction", "16" }
+
+#define VANADIS_TABLE_BRANCH_ELI_STATISTICS                                                                   \
+    { "btb_hit", "Counts the number of branches found in the branch target buffer", "hits", 1 },            \
+    { "btb_miss", "Counts the number of branches not found in the branch target buffer", "misses", 1 },     \
+    { "direction_mispredicts", "Counts the number of retired conditional branches whose predicted target was wrong", "branches", 1 }, \
+    { "return_mispredicts", "Counts the number of retired returns whose predicted target was wrong", "branches", 1 }
+
+namespace SST {
+namespace Vanadis {
+
+enum class VanadisBranchKind : uint8_t { CONDITIONAL, CALL, RETURN };
+
+// Shared front end for the array based predictors. Targets come from a
+// direct mapped branch target buffer and returns from a return address
+// stack, derived classes only choose the direction of other branches.
+//
+// Predictions are made at decode in program order, so global history and
+// the return stack are updated speculatively there and a second copy of
+// both is kept at retire. Every pipeline flush, whether for a mispredicted
+// branch or anything else which restarts fetch, resets the speculative
+// copies from the retired ones.
+// Every branch which retires was predicted with exactly the history that
+// retired ahead of it, so the direction tables are trained at retire using
+// the retired history and no per-branch checkpoint is needed.
+class VanadisTableBranchUnit : public VanadisBranchUnit {
+
+public:
+    VanadisTableBranchUnit(ComponentId_t id, Params& params) : VanadisBranchUnit(id, params) {
+        btb.resize(checkTableSize("btb_entries", params.find<uint32_t>("btb_entries", 512)));
+        btb_mask = btb.size() - 1;
+
+        const uint32_t ras_entries = params.find<uint32_t>("ras_entries", 16);
+        spec_ras.resize(ras_entries);
+        retired_ras.resize(ras_entries);
+
+        spec_history    = 0;
+        retired_history = 0;
+
+        stat_btb_hits = registerStatistic<uint64_t>("btb_hit", "1");
+        stat_btb_misses = registerStatistic<uint64_t>("btb_miss", "1");
+        stat_direction_mispredicts = registerStatistic<uint64_t>("direction_mispredicts", "1");
+        stat_return_mispredicts = registerStatistic<uint64_t>("return_mispredicts", "1");
+    }
+
+    virtual ~VanadisTableBranchUnit() {}
+
+    bool contains(const uint64_t addr) override {
+        const VanadisBranchTargetEntry& entry = btb[btbIndex(addr)];
+        return entry.valid && (entry.ins_addr == addr);
+    }
+
+    uint64_t predictAddress(const uint64_t addr) override {
+        const VanadisBranchTargetEntry& entry = btb[btbIndex(addr)];
+
+        if(!entry.valid || (entry.ins_addr != addr)) {
+            return 0;
+        }
+
+        stat_btb_hits->addData(1);
+
+        uint64_t predicted_addr = entry.target;
+
+        switch(entry.kind) {
+        case VanadisBranchKind::CALL:
+            spec_ras.push(entry.fall_through);
+            break;
+        case VanadisBranchKind::RETURN:
+            if(!spec_ras.empty()) {
+                predicted_addr = spec_ras.pop();
+            }
+            break;
+        case VanadisBranchKind::CONDITIONAL:
+            if(!predictTaken(addr, spec_history)) {
+                predicted_addr = entry.fall_through;
+            }
+            break;
+        }
+
+        spec_history = (spec_history << 1) | ((predicted_addr != entry.fall_through) ? 1 : 0);
+        return predicted_addr;
+    }
+
+    void predictFallThrough(const uint64_t addr) override {
+        stat_btb_misses->addData(1);
+        spec_history <<= 1;
+    }
+
+    // Only called by units which do not know about the instruction, record
+    // the target and let update() fill in everything else
+    void push(const uint64_t ins_addr, const uint64_t pred_addr) override {
+        VanadisBranchTargetEntry& entry = btb[btbIndex(ins_addr)];
+
+        if(!entry.valid || (entry.ins_addr != ins_addr)) {
+            entry.valid        = true;
+            entry.ins_addr     = ins_addr;
+            entry.fall_through = pred_addr;
+            entry.kind         = VanadisBranchKind::CONDITIONAL;
+        }
+
+        entry.target = pred_addr;
+    }
+
+    void update(VanadisSpeculatedInstruction* branch_ins, const uint64_t target_addr) override {
+        const uint64_t ins_addr     = branch_ins->getInstructionAddress();
+        const uint64_t fall_through = branch_ins->getNotTakenAddress();
+        const bool     taken        = (target_addr != fall_through);
+        const bool     mispredicted = (branch_ins->getSpeculatedAddress() != target_addr);
+
+        // Calls are recognised by the link register, returns by going back
+        // to the most recent call which has not returned yet
+        VanadisBranchKind kind = VanadisBranchKind::CONDITIONAL;
+
+        if(branch_ins->writesLinkRegister()) {
+            kind = VanadisBranchKind::CALL;
+            retired_ras.push(fall_through);
+        } else if(!retired_ras.empty() && (retired_ras.peek() == target_addr)) {
+            kind = VanadisBranchKind::RETURN;
+            retired_ras.pop();
+
+            if(mispredicted) {
+                stat_return_mispredicts->addData(1);
+            }
+        } else {
+            trainDirection(ins_addr, retired_history, taken);
+
+            if(mispredicted) {
+                stat_direction_mispredicts->addData(1);
+            }
+        }
+
+        retired_history = (retired_history << 1) | (taken ? 1 : 0);
+
+        // Branches which have never been taken are left out of the target
+        // buffer, falling through is already the right prediction for them
+        VanadisBranchTargetEntry& entry = btb[btbIndex(ins_addr)];
+
+        if(taken || (entry.valid && (entry.ins_addr == ins_addr))) {
+            if(taken) {
+                entry.target = target_addr;
+            }
+
+            entry.valid        = true;
+            entry.ins_addr     = ins_addr;
+            entry.fall_through = fall_through;
+            entry.kind         = kind;
+        }
+    }
+
+    // Anything fetched after the flush point is gone, so the speculative
+    // history and return stack go back to what has actually retired
+    void pipelineFlushed() override {
+        spec_history = retired_history;
+        spec_ras     = retired_ras;
+    }
+
+protected:
+    // Direction of a branch which is not a call or a return
+    virtual bool predictTaken(const uint64_t ins_addr, const uint64_t history) = 0;
+    virtual void trainDirection(const uint64_t ins_addr, const uint64_t history, const bool taken) = 0;
+
+    uint32_t checkTableSize(const char* param_name, const uint32_t entries) {
+        if((0 == entries) || (0 != (entries & (entries - 1)))) {
+            SST::Output output("[branch-unit]: ", 0, 0, SST::Output::STDOUT);
+            output.fatal(CALL_INFO, -1, "Error: %s (%" PRIu32 ") must be a non-zero power of two.\n", param_name, entries);
+        }
+
+        return entries;
+    }
+
+    // Two bit saturating counters, taken when the upper bit is set
+    static bool counterTaken(const uint8_t counter) { return counter >= 2; }
+
+    static void trainCounter(uint8_t& counter, const bool taken) {
+        if(taken) {
+            counter += (counter < 3) ? 1 : 0;
+        } else {
+            counter -= (counter > 0) ? 1 : 0;
+        }
+    }
+
+    struct VanadisBranchTargetEntry {
+        VanadisBranchTargetEntry() : ins_addr(0), target(0), fall_through(0),
+            kind(VanadisBranchKind::CONDITIONAL), valid(false) {}
+
+        uint64_t ins_addr;
+        uint64_t target;
+        uint64_t fall_through;
+        VanadisBranchKind kind;
+        bool valid;
+    };
+
+    // Fixed size stack, when full the oldest return address is overwritten
+    class VanadisReturnStack {
+    public:
+        VanadisReturnStack() : top(0), count(0) {}
+
+        void resize(const uint32_t entries) { addrs.resize(entries, 0); }
+
+        bool empty() const { return 0 == count; }
+
+        void push(const uint64_t addr) {
+            if(addrs.empty()) {
+                return;
+            }
+
+            top = (top + 1) % addrs.size();
+            addrs[top] = addr;
+            count += (count < addrs.size()) ? 1 : 0;
+        }
+
+        uint64_t peek() const { return addrs[top]; }
+
+        uint64_t pop() {
+            const uint64_t addr = addrs[top];
+            top = (top + addrs.size() - 1) % addrs.size();
+            count--;
+            return addr;
+        }
+
+    protected:
+        std::vector<uint64_t> addrs;
+        uint32_t top;
+        uint32_t count;
+    };
+
+    uint32_t btbIndex(const uint64_t addr) const { return (addr >> 2) & btb_mask; }
+
+    std::vector<VanadisBranchTargetEntry> btb;
+    uint32_t btb_mask;
+
+    VanadisReturnStack spec_ras;
+    VanadisReturnStack retired_ras;
+
+    uint64_t spec_history;
+    uint64_t retired_history;
+
+    Statistic<uint64_t>* stat_btb_hits;
+    Statistic<uint64_t>* stat_btb_misses;
+    Statistic<uint64_t>* stat_direction_mispredicts;
+    Statistic<uint64_t>* stat_return_mispredicts;
+};
+
+} // namespace Vanadis
+} // namespace SST
+
+#endif
@@ -0,0 +1,235 @@
+// Copyright 2009-2023 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2023, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+
+#ifndef _H_VANADIS_BRANCH_UNIT_TAGE
+#define _H_VANADIS_BRANCH_UNIT_TAGE
+
+#include "vbranch/vbranchtable.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace SST {
+namespace Vanadis {
+
+// TAGE style predictor: a bimodal base table backed by tagged tables which
+// are indexed with geometrically longer slices of the global history. The
+// longest matching table provides the prediction, a misprediction allocates
+// an entry in a longer table.
+class VanadisTAGEBranchUnit : public VanadisTableBranchUnit {
+
+public:
+    SST_ELI_REGISTER_SUBCOMPONENT(VanadisTAGEBranchUnit, "vanadis", "VanadisTAGEBranchUnit",
+                                          SST_ELI_ELEMENT_VERSION(1, 0, 0),
+                                          "Predicts branch direction with a bimodal table and tagged tables "
+                                          "using geometrically increasing global history lengths (TAGE)",
+                                          SST::Vanadis::VanadisBranchUnit)
+
+    SST_ELI_DOCUMENT_PARAMS(VANADIS_TABLE_BRANCH_ELI_PARAMS,
+                            { "base_entries", "Number of two bit counters in the base table, must be a power of two", "4096" },
+                            { "tagged_tables", "Number of tagged tables", "4" },
+                            { "tagged_entries", "Number of entries in each tagged table, must be a power of two", "1024" },
+                            { "tag_bits", "Number of tag bits in each tagged entry (2 to 16)", "9" },
+                            { "min_history", "History length used by the shortest tagged table", "4" },
+                            { "max_history", "History length used by the longest tagged table (at most 64)", "64" },
+                            { "useful_reset_period", "Number of updates between halving the useful counters of all tagged entries", "262144" })
+
+    SST_ELI_DOCUMENT_STATISTICS(VANADIS_TABLE_BRANCH_ELI_STATISTICS)
+
+    VanadisTAGEBranchUnit(ComponentId_t id, Params& params) : VanadisTableBranchUnit(id, params) {
+        base.resize(checkTableSize("base_entries", params.find<uint32_t>("base_entries", 4096)), 2);
+        base_mask = base.size() - 1;
+
+        const uint32_t table_count = std::max(params.find<uint32_t>("tagged_tables", 4), 1u);
+        const uint32_t table_entries = checkTableSize("tagged_entries", params.find<uint32_t>("tagged_entries", 1024));
+
+        tag_bits = std::min(std::max(params.find<uint32_t>("tag_bits", 9), 2u), 16u);
+        tag_mask = (UINT32_C(1) << tag_bits) - 1;
+
+        index_bits = 0;
+        while((UINT32_C(1) << index_bits) < table_entries) {
+            index_bits++;
+        }
+        index_mask = table_entries - 1;
+
+        const uint32_t max_history = std::min(std::max(params.find<uint32_t>("max_history", 64), 1u), 64u);
+        const uint32_t min_history = std::min(std::max(params.find<uint32_t>("min_history", 4), 1u), max_history);
+
+        useful_reset_period = params.find<uint64_t>("useful_reset_period", 262144);
+        updates = 0;
+
+        tables.resize(table_count);
+        history_lengths.resize(table_count);
+
+        for(uint32_t i = 0; i < table_count; ++i) {
+            const double ratio = (table_count > 1) ? ((double) i / (double) (table_count - 1)) : 0.0;
+
+            tables[i].resize(table_entries);
+            history_lengths[i] = (uint32_t) std::lround(min_history * std::pow((double) max_history / (double) min_history, ratio));
+        }
+
+        table_index.resize(table_count);
+        table_tag.resize(table_count);
+    }
+
+protected:
+    struct VanadisTAGEEntry {
+        VanadisTAGEEntry() : tag(0), counter(0), useful(0), valid(false) {}
+
+        uint16_t tag;
+        int8_t counter;     // three bit signed, taken when >= 0
+        uint8_t useful;     // two bit
+        bool valid;         // tag 0 is a real tag, empty entries must not match it
+    };
+
+    bool predictTaken(const uint64_t ins_addr, const uint64_t history) override {
+        int provider = -1;
+        int alternate = -1;
+
+        lookup(ins_addr, history, provider, alternate);
+
+        return (provider >= 0) ? (tables[provider][table_index[provider]].counter >= 0) :
+            counterTaken(base[(ins_addr >> 2) & base_mask]);
+    }
+
+    void trainDirection(const uint64_t ins_addr, const uint64_t history, const bool taken) override {
+        int provider = -1;
+        int alternate = -1;
+
+        lookup(ins_addr, history, provider, alternate);
+
+        uint8_t& base_counter = base[(ins_addr >> 2) & base_mask];
+
+        const bool alternate_taken = (alternate >= 0) ? (tables[alternate][table_index[alternate]].counter >= 0) :
+            counterTaken(base_counter);
+        bool predicted_taken = alternate_taken;
+
+        if(provider >= 0) {
+            VanadisTAGEEntry& entry = tables[provider][table_index[provider]];
+            predicted_taken = (entry.counter >= 0);
+
+            // an entry is useful when it gets right what the shorter history would not
+            if(predicted_taken != alternate_taken) {
+                if(predicted_taken == taken) {
+                    entry.useful += (entry.useful < 3) ? 1 : 0;
+                } else {
+                    entry.useful -= (entry.useful > 0) ? 1 : 0;
+                }
+            }
+
+            if(taken) {
+                entry.counter += (entry.counter < 3) ? 1 : 0;
+            } else {
+                entry.counter -= (entry.counter > -4) ? 1 : 0;
+            }
+        } else {
+            trainCounter(base_counter, taken);
+        }
+
+        if((predicted_taken != taken) && ((provider + 1) < (int) tables.size())) {
+            bool allocated = false;
+
+            for(int i = provider + 1; i < (int) tables.size(); ++i) {
+                VanadisTAGEEntry& entry = tables[i][table_index[i]];
+
+                if(0 == entry.useful) {
+                    entry.tag = table_tag[i];
+                    entry.counter = taken ? 0 : -1;
+                    entry.valid = true;
+                    allocated = true;
+                    break;
+                }
+            }
+
+            // no room, age the candidates so one frees up eventually
+            if(!allocated) {
+                for(int i = provider + 1; i < (int) tables.size(); ++i) {
+                    VanadisTAGEEntry& entry = tables[i][table_index[i]];
+                    entry.useful -= (entry.useful > 0) ? 1 : 0;
+                }
+            }
+        }
+
+        updates++;
+
+        if((useful_reset_period > 0) && (0 == (updates % useful_reset_period))) {
+            for(auto& table : tables) {
+                for(VanadisTAGEEntry& entry : table) {
+                    entry.useful >>= 1;
+                }
+            }
+        }
+    }
+
+    // XOR together length bits of history in chunks of the requested width
+    static uint32_t foldHistory(const uint64_t history, const uint32_t length, const uint32_t bits) {
+        uint64_t remaining = (length >= 64) ? history : (history & ((UINT64_C(1) << length) - 1));
+        uint32_t folded = 0;
+
+        for(; remaining != 0; remaining >>= bits) {
+            folded ^= (uint32_t) (remaining & ((UINT64_C(1) << bits) - 1));
+        }
+
+        return folded;
+    }
+
+    // Fills in the index and tag for every table, provider is the longest
+    // matching table and alternate the next longest (-1 for none)
+    void lookup(const uint64_t ins_addr, const uint64_t history, int& provider, int& alternate) {
+        const uint64_t pc = ins_addr >> 2;
+
+        for(int i = (int) tables.size() - 1; i >= 0; --i) {
+            const uint32_t length = history_lengths[i];
+
+            table_index[i] = (uint32_t) (pc ^ (pc >> index_bits) ^
+                ((index_bits > 0) ? foldHistory(history, length, index_bits) : 0)) & index_mask;
+            table_tag[i] = (uint16_t) ((pc ^ foldHistory(history, length, tag_bits) ^
+                (foldHistory(history, length, tag_bits - 1) << 1)) & tag_mask);
+
+            const VanadisTAGEEntry& entry = tables[i][table_index[i]];
+
+            if(entry.valid && (entry.tag == table_tag[i])) {
+                if(provider < 0) {
+                    provider = i;
+                } else if(alternate < 0) {
+                    alternate = i;
+                }
+            }
+        }
+    }
+
+    std::vector<uint8_t> base;
+    uint32_t base_mask;
+
+    std::vector< std::vector<VanadisTAGEEntry> > tables;
+    std::vector<uint32_t> history_lengths;
+    uint32_t index_bits;
+    uint32_t index_mask;
+    uint32_t tag_bits;
+    uint32_t tag_mask;
+
+    // scratch space for lookup()
+    std::vector<uint32_t> table_index;
+    std::vector<uint16_t> table_tag;
+
+    uint64_t useful_reset_period;
+    uint64_t updates;
+};
+
+} // namespace Vanadis
+} // namespace SST
+
+#endif
@@ -38,7 +38,22 @@ public:
     virtual ~VanadisBranchUnit() {}
 
     virtual void push(const uint64_t ins_addr, const uint64_t pred_addr) = 0;
+
+    // Called at retire with the resolved branch. Predictors which model
+    // direction, history or calls and returns override this to see the
+    // whole instruction, others only need the address and target.
+    virtual void update(VanadisSpeculatedInstruction* branch_ins, const uint64_t target_addr) {
+        push(branch_ins->getInstructionAddress(), target_addr);
+    }
+    // Called whenever the thread's pipeline is flushed, for a retired
+    // branch mispredict or anything else (exceptions, syscalls, fences
+    // which restart fetch). Predictors which keep speculative state
+    // rebuild it from their retired state here.
+    virtual void pipelineFlushed() {}
     virtual uint64_t predictAddress(const uint64_t addr) = 0;
+    // Called at decode for a branch the unit does not contain, the decoder
+    // falls through which is a not-taken prediction
+    virtual void predictFallThrough(const uint64_t addr) {}
     virtual bool contains(const uint64_t addr) = 0;
 };
 
@@ -0,0 +1,281 @@
+// Copyright 2009-2023 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2023, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#ifndef _H_VANADIS_COMMIT_TRACE
+#define _H_VANADIS_COMMIT_TRACE
+
+#include <sst_config.h>
+
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+#include "sst/elements/memHierarchy/binaryFile.h"
+
+namespace SST {
+namespace Vanadis {
+
+// Binary trace of the instructions retired by one hardware thread, used to
+// compare a run against a reference simulator (see tools/tracediff). The file
+// starts with
+//
+//   uint64_t magic      "VCOMMIT\0"
+//   uint32_t version    VanadisCommitTrace::version
+//   uint32_t core
+//   uint32_t hw_thread
+//   uint32_t reserved
+//
+// followed by one record per instruction, all fields in host byte order
+//
+//   uint64_t pc
+//   uint32_t ins_word
+//   uint8_t  int_writes, fp_writes, mem_ops, flags
+//   int_writes x { uint16_t isa_reg, uint64_t value }
+//   fp_writes  x { uint16_t isa_reg, uint64_t value }
+//   mem_ops    x { uint8_t kind, uint8_t width, uint64_t addr, uint64_t value }
+//
+// Stores record the value written, loads the value of the register they
+// load. Files may be gzip compressed, the reader detects this.
+class VanadisCommitTrace {
+public:
+    static constexpr uint64_t magic   = 0x0054494d4d4f4356ULL;
+    static constexpr uint32_t version = 1;
+
+    // the instruction word could not be read, ins_word is 0
+    static constexpr uint8_t FLAG_NO_INS_WORD = 0x1;
+
+    enum MemoryKind : uint8_t { LOAD = 0, STORE = 1 };
+
+    struct RegisterWrite {
+        uint16_t reg;
+        uint64_t value;
+    };
+
+    struct MemoryOp {
+        uint8_t  kind;
+        uint8_t  width;
+        uint64_t addr;
+        uint64_t value;
+    };
+
+    struct Record {
+        uint64_t pc;
+        uint32_t ins_word;
+        uint8_t  flags;
+
+        std::vector<RegisterWrite> int_writes;
+        std::vector<RegisterWrite> fp_writes;
+        std::vector<MemoryOp>      mem_ops;
+
+        void clear() {
+            pc       = 0;
+            ins_word = 0;
+            flags    = 0;
+            int_writes.clear();
+            fp_writes.clear();
+            mem_ops.clear();
+        }
+    };
+
+    static bool compressionAvailable() { return SST::MemHierarchy::BinaryFile::compressionAvailable(); }
+};
+
+// Records are built up one micro-op at a time, micro-ops of an instruction
+// retire back to back so a record is complete when an instruction with a
+// different address retires, after a control transfer, or at close.
+class VanadisCommitTraceWriter {
+public:
+    VanadisCommitTraceWriter() : open_record(false) {}
+
+    ~VanadisCommitTraceWriter() { close(); }
+
+    bool open(const char* path, const uint32_t core, const uint32_t hw_thread, const bool compress) {
+        if ( !file.openWrite(path, compress) ) { return false; }
+
+        buffer.reserve(buffer_size + max_record);
+
+        put<uint64_t>(VanadisCommitTrace::magic);
+        put<uint32_t>(VanadisCommitTrace::version);
+        put<uint32_t>(core);
+        put<uint32_t>(hw_thread);
+        put<uint32_t>(0);
+        return true;
+    }
+
+    // False if any part of the trace could not be written
+    bool close() {
+        endInstruction();
+        flush();
+        return file.close();
+    }
+
+    // False once a block of records has failed to write
+    bool good() const { return file.good(); }
+
+    // True if a micro-op at pc belongs to the instruction being recorded
+    bool continues(const uint64_t pc) const { return open_record && (pc == record.pc); }
+
+    void beginInstruction(const uint64_t pc, const uint32_t ins_word, const bool have_ins_word) {
+        endInstruction();
+
+        record.clear();
+        record.pc       = pc;
+        record.ins_word = ins_word;
+        record.flags    = have_ins_word ? 0 : VanadisCommitTrace::FLAG_NO_INS_WORD;
+        open_record     = true;
+    }
+
+    void addIntWrite(const uint16_t reg, const uint64_t value) {
+        if ( record.int_writes.size() < max_entries ) { record.int_writes.push_back({ reg, value }); }
+    }
+
+    void addFPWrite(const uint16_t reg, const uint64_t value) {
+        if ( record.fp_writes.size() < max_entries ) { record.fp_writes.push_back({ reg, value }); }
+    }
+
+    void addMemoryOp(const uint8_t kind, const uint8_t width, const uint64_t addr, const uint64_t value) {
+        if ( record.mem_ops.size() < max_entries ) { record.mem_ops.push_back({ kind, width, addr, value }); }
+    }
+
+    void endInstruction() {
+        if ( !open_record ) { return; }
+
+        put<uint64_t>(record.pc);
+        put<uint32_t>(record.ins_word);
+        put<uint8_t>((uint8_t)record.int_writes.size());
+        put<uint8_t>((uint8_t)record.fp_writes.size());
+        put<uint8_t>((uint8_t)record.mem_ops.size());
+        put<uint8_t>(record.flags);
+
+        for ( const auto& next_write : record.int_writes ) {
+            put<uint16_t>(next_write.reg);
+            put<uint64_t>(next_write.value);
+        }
+
+        for ( const auto& next_write : record.fp_writes ) {
+            put<uint16_t>(next_write.reg);
+            put<uint64_t>(next_write.value);
+        }
+
+        for ( const auto& next_op : record.mem_ops ) {
+            put<uint8_t>(next_op.kind);
+            put<uint8_t>(next_op.width);
+            put<uint64_t>(next_op.addr);
+            put<uint64_t>(next_op.value);
+        }
+
+        open_record = false;
+
+        if ( buffer.size() >= buffer_size ) { flush(); }
+    }
+
+private:
+    // records are written in large blocks, so tracing costs little more than
+    // filling the buffer
+    static constexpr size_t buffer_size = 1 << 20;
+    static constexpr size_t max_entries = 255;
+    static constexpr size_t max_record  = 16 + (3 * max_entries * 18);
+
+    template <typename T>
+    void put(const T value) {
+        const size_t offset = buffer.size();
+        buffer.resize(offset + sizeof(T));
+        std::memcpy(&buffer[offset], &value, sizeof(T));
+    }
+
+    void flush() {
+        if ( buffer.empty() ) { return; }
+
+        file.writeBytes(buffer.data(), buffer.size());
+        buffer.clear();
+    }
+
+    SST::MemHierarchy::BinaryFile file;
+    std::vector<uint8_t>          buffer;
+    VanadisCommitTrace::Record    record;
+    bool                          open_record;
+};
+
+class VanadisCommitTraceReader {
+public:
+    VanadisCommitTraceReader() : core(0), hw_thread(0) {}
+
+    ~VanadisCommitTraceReader() { close(); }
+
+    // False if the file cannot be opened or is not a commit trace
+    bool open(const char* path) {
+        if ( !file.openRead(path) ) { return false; }
+
+        uint64_t file_magic;
+        uint32_t file_version, reserved;
+
+        if ( !get(file_magic) || !get(file_version) || !get(core) || !get(hw_thread) || !get(reserved) ) {
+            return false;
+        }
+
+        return (VanadisCommitTrace::magic == file_magic) && (VanadisCommitTrace::version == file_version);
+    }
+
+    void close() { file.close(); }
+
+    uint32_t getCore() const { return core; }
+    uint32_t getHWThread() const { return hw_thread; }
+
+    // False at the end of the trace (or if it is truncated)
+    bool next(VanadisCommitTrace::Record& record) {
+        uint8_t int_count, fp_count, mem_count;
+
+        record.clear();
+
+        if ( !get(record.pc) || !get(record.ins_word) || !get(int_count) || !get(fp_count) || !get(mem_count) ||
+             !get(record.flags) ) {
+            return false;
+        }
+
+        record.int_writes.resize(int_count);
+        for ( auto& next_write : record.int_writes ) {
+            if ( !get(next_write.reg) || !get(next_write.value) ) { return false; }
+        }
+
+        record.fp_writes.resize(fp_count);
+        for ( auto& next_write : record.fp_writes ) {
+            if ( !get(next_write.reg) || !get(next_write.value) ) { return false; }
+        }
+
+        record.mem_ops.resize(mem_count);
+        for ( auto& next_op : record.mem_ops ) {
+            if ( !get(next_op.kind) || !get(next_op.width) || !get(next_op.addr) || !get(next_op.value) ) {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+private:
+    template <typename T>
+    bool get(T& value) {
+        return file.readBytes(&value, sizeof(T));
+    }
+
+    SST::MemHierarchy::BinaryFile file;
+    uint32_t core;
+    uint32_t hw_thread;
+};
+
+} // namespace Vanadis
+} // namespace SST
+
+#endif
@@ -205,6 +205,27 @@ public:
         return filled;
     }
 
+    // Copies bytes already in the predecode cache without counting as a use,
+    // returns false if any of them are not cached
+    bool peekPredecodeBytes(const uint64_t addr, uint8_t* buffer, const size_t buffer_req) const {
+        if ( (buffer_req > cache_line_width) || !hasPredecodeAt(addr, buffer_req) ) { return false; }
+
+        const uint64_t inst_line_offset     = (addr % cache_line_width);
+        const uint64_t cache_line_start     = addr - inst_line_offset;
+        const uint64_t bytes_from_this_line =
+            std::min(static_cast<uint64_t>(buffer_req), cache_line_width - inst_line_offset);
+
+        std::memcpy(buffer, &predecode_cache->peek(cache_line_start)[inst_line_offset], bytes_from_this_line);
+
+        if ( bytes_from_this_line < buffer_req ) {
+            std::memcpy(
+                &buffer[bytes_from_this_line], predecode_cache->peek(cache_line_start + cache_line_width),
+                (buffer_req - bytes_from_this_line));
+        }
+
+        return true;
+    }
+
     void cacheDecodedBundle(VanadisInstructionBundle* bundle) {
         switch(loader_mode) {
         case VanadisInstructionLoaderMode::LRU_CACHE_MODE:
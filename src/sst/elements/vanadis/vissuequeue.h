@@ -0,0 +1,83 @@
+// Copyright 2009-2023 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2023, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#ifndef _H_VANADIS_ISSUE_QUEUE
+#define _H_VANADIS_ISSUE_QUEUE
+
+#include <cinttypes>
+#include <cstdint>
+#include <deque>
+
+#include "inst/vinst.h"
+
+namespace SST {
+namespace Vanadis {
+
+// Holds instructions which have been renamed (so their physical registers
+// are fixed) but not yet issued to a functional unit. Entries are kept in
+// dispatch order, which is program order per hardware thread, so the
+// scheduler can select the oldest ready instruction first.
+class VanadisIssueQueue {
+public:
+    VanadisIssueQueue(const char* queue_name, uint32_t entries, bool issue_in_order)
+        : name(queue_name), max_entries(entries), in_order(issue_in_order) {}
+
+    const char* getName() const { return name; }
+
+    size_t size() const { return pending_issue.size(); }
+    size_t capacity() const { return max_entries; }
+    bool   full() const { return pending_issue.size() >= max_entries; }
+
+    // Instructions from the same hardware thread must leave this queue in
+    // program order (memory operations, so the LSQ sees them in order)
+    bool inOrder() const { return in_order; }
+
+    void push(VanadisInstruction* ins) { pending_issue.push_back(ins); }
+
+    std::deque<VanadisInstruction*>& getEntries() { return pending_issue; }
+
+    // The instructions are owned by the ROB, so only drop our references
+    void clearByHWThreadID(const uint32_t hw_thr) {
+        for (auto q_itr = pending_issue.begin(); q_itr != pending_issue.end();) {
+            if ((*q_itr)->getHWThread() == hw_thr) {
+                q_itr = pending_issue.erase(q_itr);
+            } else {
+                q_itr++;
+            }
+        }
+    }
+
+    void print(SST::Output* output) {
+        uint32_t index = 0;
+
+        for (VanadisInstruction* next_ins : pending_issue) {
+            output->verbose(CALL_INFO, 16, 0, "----> issue-queue: %s %" PRIu32 " entries / entry: %" PRIu32 " / thr: %" PRIu32 " / %s / 0x%" PRI_ADDR "\n",
+                name, (uint32_t) pending_issue.size(), index++, next_ins->getHWThread(), next_ins->getInstCode(),
+                next_ins->getInstructionAddress());
+        }
+    }
+
+private:
+    const char* name;
+    const uint32_t max_entries;
+    const bool in_order;
+
+    std::deque<VanadisInstruction*> pending_issue;
+};
+
+} // namespace Vanadis
+} // namespace SST
+
+#endif